@@ -4,7 +4,7 @@
 //
 //  AUTHOR: Song Ho Ahn (song.ahn@gmail.com)
 // CREATED: 2009-04-15
-// UPDATED: 2017-09-06
+// UPDATED: 2026-10-18
 ///////////////////////////////////////////////////////////////////////////////
 
 #ifdef _WIN32
@@ -16,6 +16,7 @@
 #include <fstream>
 #include "BitmapFont.h"
 #include "Tga.h"
+#include "TextureLoader.h"
 
 // static member definition
 Vertex2 BitmapFont::quadVertices[4];
@@ -24,7 +25,7 @@ Vertex2 BitmapFont::quadVertices[4];
 // ctor
 ///////////////////////////////////////////////////////////////////////////////
 BitmapFont::BitmapFont() : size(0), base(0), bitmapWidth(0), bitmapHeight(0),
-                           bitmapWidthInv(1), bitmapHeightInv(1)
+                           bitmapWidthInv(1), bitmapHeightInv(1), textureLoader(0)
 {
     color[0] = color[1] = color[2] = color[3] = 1.0f;
     scale.x = scale.y = 1.0f;
@@ -562,6 +563,15 @@ void BitmapFont::setAngle(float x, float y, float z)
 ///////////////////////////////////////////////////////////////////////////////
 GLuint BitmapFont::loadBitmap(const std::string& name)
 {
+    // decode and upload on the background, the texture ID is valid immediately
+    if(textureLoader)
+    {
+        TextureParams params;
+        params.grayFormat = GL_ALPHA;
+        params.wrap = GL_CLAMP;
+        return textureLoader->load(name, params);
+    }
+
     Image::Tga tga;
     tga.read(name.c_str());
     GLint format;
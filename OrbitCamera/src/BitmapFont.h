@@ -4,7 +4,7 @@
 //
 //  AUTHOR: Song Ho Ahn (song.ahn@gmail.com)
 // CREATED: 2009-04-15
-// UPDATED: 2012-03-16
+// UPDATED: 2026-10-18
 ///////////////////////////////////////////////////////////////////////////////
 
 #ifndef BITMAP_FONT_H
@@ -24,6 +24,8 @@
 #include "Vectors.h"
 #include "Tokenizer.h"
 
+class TextureLoader;
+
 
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -63,6 +65,7 @@ public:
     void setScale(float x, float y);
     void setScale(const Vector2& scale);
     void setAngle(float z);
+    void setTextureLoader(TextureLoader* loader) { textureLoader = loader; }   // load pages asynchronously
     //void setAngle(float x, float y, float z);
 
     short getHeight() const                 { return size; }
@@ -98,6 +101,7 @@ private:
 
     //short pageCount;
     std::vector<GLuint> pages;
+    TextureLoader* textureLoader;       // NULL for synchronous loading
     std::map<short, BitmapCharacter> characters;
     std::map<std::pair<short, short>, short> kernings;
     std::string path;
@@ -10,7 +10,7 @@
 //
 //  AUTHOR: Song Ho Ahn (song.ahn@gamil.com)
 // CREATED: 2016-05-29
-// UPDATED: 2017-10-25
+// UPDATED: 2026-10-18
 ///////////////////////////////////////////////////////////////////////////////
 
 #include <string>
@@ -20,6 +20,11 @@
 #include "Log.h"
 using namespace Win;
 
+// constants
+const char* STATS_FILE = "timing.csv";      // written when the window is destroyed
+const char* TRACE_FILE = "trace.json";      // open with chrome://tracing
+const char* RENDER_FILE = "render.csv";     // GL calls per frame of the last frames
+
 
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -37,6 +42,14 @@ ControllerGL1::ControllerGL1(ModelGL* model, ViewGL* view)
 ///////////////////////////////////////////////////////////////////////////////
 int ControllerGL1::destroy()
 {
+    // save percentiles of draw time of the last frames
+    if(model->saveTimingStats(STATS_FILE))
+        Win::log("Saved draw timings to %s.", STATS_FILE);
+    if(model->saveTrace(TRACE_FILE))
+        Win::log("Saved profiler trace to %s.", TRACE_FILE);
+    if(model->saveRenderStats(RENDER_FILE))
+        Win::log("Saved render stats to %s.", RENDER_FILE);
+
     // close OpenGL Rendering Context (RC)
     view->closeContext(handle);
     Win::log("Closed OpenGL rendering context for screen 1.");
@@ -97,6 +110,10 @@ int ControllerGL1::paint()
     view->activateContext(); // make current
     model->draw(1);
     view->swapBuffers();
+
+    // keep repainting until all textures are uploaded
+    if(model->isLoadingTextures())
+        ::InvalidateRect(handle, 0, FALSE);
     return 0;
 }
 
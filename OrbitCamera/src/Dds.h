@@ -0,0 +1,115 @@
+///////////////////////////////////////////////////////////////////////////////
+// Dds.h
+// =====
+// Block-compressed (BC1/BC3) image encoder, DDS loader and writer
+// It encodes 8-bit RGB or RGBA images including all mip levels into BC1
+// (DXT1, RGB) or BC3 (DXT5, RGBA) blocks, and reads/saves them as DDS file.
+// It is used as the compressed texture cache of the source images (TGA, BMP),
+// so the blocks are stored in the same scanline order as the source image
+// given to OpenGL (bottom to top), not the top-down order of DDS convention.
+//
+// Each 4x4 block is encoded with the bounding box of the colours, inset by
+// 1/16 of the range, and the diagonal of the box is chosen by the sign of the
+// colour covariance. The pixels are projected onto the endpoint line to find
+// the indices, 4 pixels at once with SSE2. The block rows of all levels are
+// split into the threads.
+//
+//  AUTHOR: Song Ho Ahn (song.ahn@gmail.com)
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef IMAGE_DDS_H
+#define IMAGE_DDS_H
+
+#include <string>
+#include <vector>
+#include <cstddef>
+
+namespace Image
+{
+    class Mipmap;
+
+    class Dds
+    {
+    public:
+        enum Format
+        {
+            FORMAT_NONE = 0,
+            FORMAT_BC1,                                     // DXT1, 8 bytes per block, RGB
+            FORMAT_BC3                                      // DXT5, 16 bytes per block, RGBA
+        };
+
+        // ctor/dtor
+        Dds();
+        ~Dds();
+
+        // load BC1 or BC3 blocks of all levels from a DDS file
+        bool read(const char* fileName);
+
+        // save the blocks of all levels as DDS file
+        bool save(const char* fileName) const;
+
+        // encode a single image or all levels of a mip chain
+        // The source must be RGB or RGBA; RGB is always BC1, and RGBA is BC3 if
+        // format is FORMAT_NONE.
+        bool encode(const unsigned char* data, int width, int height, int channelCount, Format format=FORMAT_NONE);
+        bool encode(const Mipmap& mipmap, Format format=FORMAT_NONE);
+
+        // getters
+        Format getFormat() const;
+        int getLevelCount() const;                          // return the number of levels including the base
+        int getWidth(int level) const;
+        int getHeight(int level) const;
+        std::size_t getDataSize(int level) const;           // return size of compressed level in bytes
+        const unsigned char* getData(int level) const;      // return the pointer to the blocks of a level
+
+        void setThreadCount(int count);                     // 0 means the number of CPU cores
+
+        void printSelf() const;                             // print itself for debug purpose
+        const char* getError() const;                       // return last error message
+
+        // return the compressed size of an image
+        static std::size_t computeSize(int width, int height, Format format);
+
+    protected:
+
+    private:
+        struct Level
+        {
+            int width;
+            int height;
+            std::size_t offset;                             // starting position in buffer
+            const unsigned char* src;                       // uncompressed source while encoding
+        };
+
+        // member functions
+        void init();                                        // clear the existing values
+        void addLevel(int width, int height);
+        void encodeLevels(int channelCount);
+        void encodeRows(int firstTask, int taskStep, int channelCount);
+
+        // member variables
+        Format format;
+        std::vector<Level> levels;
+        std::vector<unsigned char> buffer;                  // all levels in a single array
+        int threadCount;
+        std::string errorMessage;
+    };
+
+
+
+    ///////////////////////////////////////////////////////////////////////////
+    // inline functions
+    ///////////////////////////////////////////////////////////////////////////
+    inline Dds::Format Dds::getFormat() const { return format; }
+    inline int Dds::getLevelCount() const { return (int)levels.size(); }
+    inline int Dds::getWidth(int level) const { return levels[level].width; }
+    inline int Dds::getHeight(int level) const { return levels[level].height; }
+    inline std::size_t Dds::getDataSize(int level) const { return computeSize(levels[level].width, levels[level].height, format); }
+    inline const unsigned char* Dds::getData(int level) const { return &buffer[levels[level].offset]; }
+    inline void Dds::setThreadCount(int count) { threadCount = count; }
+    inline const char* Dds::getError() const { return errorMessage.c_str(); }
+}
+
+#endif // IMAGE_DDS_H
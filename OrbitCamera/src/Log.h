@@ -10,6 +10,14 @@
 // For example, Win::log(L"My number: %d\n", 123).
 // It is similar to printf() function of C standard libirary.
 //
+// Logging is asynchronous, so it never blocks the calling thread, e.g. the
+// OpenGL rendering thread. The message is formatted into a per-thread buffer,
+// then copied with its time to a fixed-size queue. The queue is lock-free for
+// multiple producers and a single consumer; a background thread writes the
+// queued messages to the file or dialog in batches. If the queue is full, the
+// message is dropped and counted, and the count is written to the log later.
+// The destructor writes all queued messages before closing the file.
+//
 // The template of the log dialog window is defined in log.rc and logResource.h
 // You must include both resource file with this source codes.
 // The dialog window cannot be closed by user once it is created. But it will be
@@ -17,7 +25,7 @@
 //
 //  AUTHOR: Song Ho Ahn (song.ahn@gmail.com)
 // CREATED: 2006-07-14
-// UPDATED: 2006-07-24
+// UPDATED: 2026-10-18
 ///////////////////////////////////////////////////////////////////////////////
 
 #ifndef WIN_LOG_H
@@ -25,12 +33,15 @@
 
 #include <string>
 #include <fstream>
+#include <thread>
+#include <atomic>
 #include <windows.h>
 
 namespace Win
 {
     enum { LOG_MODE_FILE = 0, LOG_MODE_DIALOG, LOG_MODE_BOTH }; // log output selection
     enum { LOG_MAX_STRING = 1024 };
+    enum { LOG_QUEUE_SIZE = 256 };              // max queued messages, power of 2 (512 KB)
 
     // Clients are actually use this functions to send log messages.
     // USAGE: Win::log("I am the number %d.", 1);
@@ -38,6 +49,7 @@ namespace Win
     void log(const wchar_t *format, ...);
     void log(const char *format, ...);
     extern void logMode(int mode);
+    extern void logFlush();
 
 
 
@@ -50,22 +62,47 @@ namespace Win
         static Log& getInstance();              // return reference to this class object
 
         void setMode(int mode);                 // set log target: file or dialog
-        void put(const std::wstring& str);      // print log message
+        void put(const std::wstring& str);      // queue log message
+        void put(const wchar_t* str);           // queue log message, truncated to LOG_MAX_STRING
+        void flush();                           // wait until the queued messages are written (max 1 sec)
+        long long getDroppedCount() const       { return droppedCount.load(std::memory_order_relaxed); }
 
     private:
+        // message in the queue, written by a caller and read by the writer thread
+        struct Message
+        {
+            std::atomic<unsigned int> sequence; // position of the queue when the slot is ready
+            SYSTEMTIME time;                    // when put() is called
+            int mode;                           // log mode when put() is called
+            wchar_t text[LOG_MAX_STRING];
+        };
+
         Log();                                  // hide it here to prevent instantiating this class
         Log(const Log& rhs);                    // must no body for copy ctor, so this class cannot have copy ctor
 
+        void runWriter();                       // writer thread: write the queued messages
+        int writeMessages();                    // write all ready messages, return # of messages
+        void writeMessage(const Message& msg);
         const std::wstring getTime();           // return system time as string
+        const std::wstring getTime(const SYSTEMTIME& sysTime);
         const std::wstring getDate();           // return system date as string
 
-        int logMode;                            // file, dialog or both
-        std::wofstream logFile;                 // log file handle
+        std::atomic<int> logMode;               // file, dialog or both
+        std::wofstream logFile;                 // log file handle, used by writer thread only
         HWND dialogHandle;                      // handle to dialog window
         HWND listHandle;                        // handle to listbox
+
+        Message* messages;                      // ring of LOG_QUEUE_SIZE messages
+        std::atomic<unsigned int> enqueuePos;   // next position to write, shared by callers
+        std::atomic<unsigned int> dequeuePos;   // next position to read, written by writer thread
+        std::atomic<long long> droppedCount;    // # of messages dropped by full queue
+        long long reportedDropCount;            // drops already written to the log
+        std::atomic<bool> running;              // false after the writer thread stops
+        std::atomic<bool> stopFlag;
+        HANDLE wakeEvent;                       // auto-reset event to wake the writer thread
+        std::thread writer;
     };
     ///////////////////////////////////////////////////////////////////////////
 }
 
 #endif
-
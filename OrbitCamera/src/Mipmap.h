@@ -0,0 +1,93 @@
+///////////////////////////////////////////////////////////////////////////////
+// Mipmap.h
+// ========
+// Mipmap chain generator for 8-bit grayscale, RGB and RGBA images
+// It builds all mip levels down to 1x1 with 2x2 box filter. Each level is
+// floor(size/2) of the previous level as OpenGL does, so non-power-of-two
+// images are not rescaled.
+// The image is split into bands of 64 scanlines, and each thread builds the
+// first 6 levels of its bands at once because a band does not depend on the
+// other bands. The remaining small levels are built on the calling thread.
+//
+// Filters:
+// BOX      : average 2x2 pixels in 8-bit values, SIMD
+// BOX_SRGB : average 2x2 pixels in linear space, the colour components are
+//            converted from/to sRGB with lookup tables (alpha is linear)
+//
+//  AUTHOR: Song Ho Ahn (song.ahn@gmail.com)
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef IMAGE_MIPMAP_H
+#define IMAGE_MIPMAP_H
+
+#include <vector>
+#include <cstddef>
+
+namespace Image
+{
+    class Mipmap
+    {
+    public:
+        enum Filter
+        {
+            BOX = 0,
+            BOX_SRGB
+        };
+
+        // ctor/dtor
+        Mipmap();
+        ~Mipmap();
+
+        // build the mip chain from the base image (level 0)
+        // The base image is copied, so the source can be deleted after this call.
+        bool build(const unsigned char* data, int width, int height, int channelCount, Filter filter=BOX);
+
+        // getters
+        int getLevelCount() const;                          // return the number of levels including the base
+        int getChannelCount() const;
+        int getWidth(int level) const;
+        int getHeight(int level) const;
+        std::size_t getDataSize(int level) const;           // return data size of a level in bytes
+        const unsigned char* getData(int level) const;      // return the pointer to image data of a level
+
+        void setThreadCount(int count);                     // 0 means the number of CPU cores
+
+    protected:
+
+    private:
+        struct Level
+        {
+            int width;
+            int height;
+            std::size_t offset;                             // starting position in buffer
+        };
+
+        // member functions
+        void buildBands(int firstBand, int bandStep, int lastLevel);
+        void buildRows(int level, int firstRow, int lastRow);
+
+        // member variables
+        std::vector<Level> levels;
+        std::vector<unsigned char> buffer;                  // all levels in a single array
+        int channelCount;
+        Filter filter;
+        int threadCount;
+    };
+
+
+
+    ///////////////////////////////////////////////////////////////////////////
+    // inline functions
+    ///////////////////////////////////////////////////////////////////////////
+    inline int Mipmap::getLevelCount() const { return (int)levels.size(); }
+    inline int Mipmap::getChannelCount() const { return channelCount; }
+    inline int Mipmap::getWidth(int level) const { return levels[level].width; }
+    inline int Mipmap::getHeight(int level) const { return levels[level].height; }
+    inline std::size_t Mipmap::getDataSize(int level) const { return (std::size_t)levels[level].width * levels[level].height * channelCount; }
+    inline const unsigned char* Mipmap::getData(int level) const { return &buffer[levels[level].offset]; }
+    inline void Mipmap::setThreadCount(int count) { threadCount = count; }
+}
+
+#endif // IMAGE_MIPMAP_H
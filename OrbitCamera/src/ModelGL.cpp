@@ -5,7 +5,7 @@
 //
 //  AUTHOR: Song Ho Ahn (song.ahn@gmail.com)
 // CREATED: 2016-05-29
-// UPDATED: 2017-12-13
+// UPDATED: 2026-10-18
 ///////////////////////////////////////////////////////////////////////////////
 
 #ifdef _WIN32
@@ -21,8 +21,11 @@
 
 #include <cmath>
 #include <sstream>
+#include <cstring>
+#include <map>
 #include "ModelGL.h"
 #include "glExtension.h"
+#include "Profiler.h"
 
 // constants
 const float GRID_SIZE = 10.0f;
@@ -55,6 +58,8 @@ void main()
 
 
 // blinn shading ==========================================
+// The ambient and diffuse terms are modulated by the texture of the material
+// (map_Kd) if textureUsed is true.
 const char* vsSource2 = R"(
 varying vec3 esVertex, esNormal;
 void main()
@@ -62,10 +67,13 @@ void main()
     esVertex = vec3(gl_ModelViewMatrix * gl_Vertex);
     esNormal = gl_NormalMatrix * gl_Normal;
     gl_FrontColor = gl_Color;
+    gl_TexCoord[0] = gl_MultiTexCoord0;
     gl_Position = gl_ModelViewProjectionMatrix * gl_Vertex;
 }
 )";
 const char* fsSource2 = R"(
+uniform sampler2D map0;
+uniform bool textureUsed;
 varying vec3 esVertex, esNormal;
 void main()
 {
@@ -84,6 +92,8 @@ void main()
     vec4 color =  gl_FrontMaterial.ambient * gl_FrontLightProduct[0].ambient;
     float dotNL = max(dot(normal, light), 0.0);
     color += gl_FrontMaterial.diffuse * gl_FrontLightProduct[0].diffuse * dotNL;
+    if(textureUsed)
+        color *= texture2D(map0, gl_TexCoord[0].st);
     float dotNH = max(dot(normal, halfv), 0.0);
     /*vec4 specular = (vec4(1.0) - color) * gl_FrontMaterial.specular * gl_FrontLightProduct[0].specular * pow(dotNH, gl_FrontMaterial.shininess);
     color += specular;*/
@@ -103,6 +113,7 @@ ModelGL::ModelGL() : windowWidth(0), windowHeight(0), mouseLeftDown(false),
                      gridEnabled(true), gridSize(GRID_SIZE), gridStep(GRID_STEP),
                      vboSupported(false), vboReady(false), vboModel(0), vboCam(0),
                      glslSupported(false), glslReady(false), progId1(0), progId2(0),
+                     uniformTextureUsed(-1),
                      objLoaded(false), fovEnabled(true)
 {
     bgColor.set(0, 0, 0, 0);
@@ -175,6 +186,9 @@ void ModelGL::init()
 
     initLights();
     initFont();
+
+    // GPU time of the zones needs GL_ARB_timer_query, otherwise CPU only
+    Profiler::getInstance().initGpu();
 }
 
 
@@ -206,6 +220,7 @@ void ModelGL::initLights()
 ///////////////////////////////////////////////////////////////////////////////
 void ModelGL::initFont()
 {
+    font.setTextureLoader(&textureLoader);
     font.loadFont(FONT_FILE.c_str());
     font.setColor(1, 1, 1, 1);
 }
@@ -236,6 +251,19 @@ bool ModelGL::initShaders()
 ///////////////////////////////////////////////////////////////////////////////
 void ModelGL::quit()
 {
+    textureLoader.stop();
+    textureLoader.releaseBuffers();
+    Profiler::getInstance().releaseGpu();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// write the zones of Profiler to Chrome trace JSON, no GL call
+///////////////////////////////////////////////////////////////////////////////
+bool ModelGL::saveTrace(const char* fileName)
+{
+    return Profiler::getInstance().writeTrace(fileName);
 }
 
 
@@ -272,8 +300,32 @@ void ModelGL::setViewport(int x, int y, int w, int h)
 ///////////////////////////////////////////////////////////////////////////////
 void ModelGL::draw(int screenId)
 {
+    // both screens are drawn once per frame, start the frame at screen 1
+    if(screenId == 1)
+    {
+        PROFILE_FRAME();
+        renderStats.beginFrame();
+    }
+    PROFILE_ZONE((screenId == 1) ? "draw1" : "draw2");
+
+    // CPU time to issue the GL calls of this screen, not GPU time
+    ScopedTimer drawTimer(timingStats, (screenId == 1) ? "draw1" : "draw2");
+
     preFrame();
 
+    // upload textures decoded by worker threads, once per frame
+    // both screens share the same RC, so do it for screen 1 only
+    if(screenId == 1)
+    {
+        PROFILE_GPU_ZONE("upload");
+        ScopedTimer uploadTimer(timingStats, "upload");
+        textureLoader.update();
+        renderStats.addTextureBytes(textureLoader.getFrameBytes());
+    }
+
+    // GPU time of the scene, until the end of draw()
+    PROFILE_GPU_ZONE("scene");
+
     // clear buffer
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
     //glEnable(GL_BLEND);
@@ -364,6 +416,8 @@ void ModelGL::draw(int screenId)
 ///////////////////////////////////////////////////////////////////////////////
 void ModelGL::draw2D(int screenId)
 {
+    PROFILE_ZONE("draw2D");
+
     // set orthogonal projection
     setOrthoFrustum(0, (float)windowWidth, 0, (float)windowHeight, -1, 1);
     glMatrixMode(GL_PROJECTION);
@@ -373,13 +427,31 @@ void ModelGL::draw2D(int screenId)
 
     glEnable(GL_TEXTURE_2D);
 
+    // percentiles of draw time of the previous frames at the bottom
+    std::string drawTime = "Draw: " + timingStats.formatSummary((screenId == 1) ? "draw1" : "draw2", 2);
+    drawText(5, 5, drawTime.c_str());
+
     if(screenId == 1)
     {
-        font.drawText(5, (float)windowHeight-font.getHeight(), "3rd Person View");
+        // mean GL calls per frame of the previous frames above it
+        std::string renderCounts = "GL: " + renderStats.formatSummary();
+        drawText(5, 5 + (float)font.getHeight(), renderCounts.c_str());
+
+        drawText(5, (float)windowHeight-font.getHeight(), "3rd Person View");
+
+        // show progress of texture loading
+        if(textureLoader.isBusy())
+        {
+            std::stringstream ss;
+            ss << "Loading Textures: " << textureLoader.getDecodeQueueSize() << " decoding, "
+               << textureLoader.getUploadQueueSize() << " uploading, "
+               << (textureLoader.getFrameBytes() >> 10) << " KB/frame";
+            drawText(5, (float)windowHeight-font.getHeight()*2, ss.str().c_str());
+        }
     }
     else if(screenId == 2)
     {
-        font.drawText(5, (float)windowHeight-font.getHeight(), "Point of View");
+        drawText(5, (float)windowHeight-font.getHeight(), "Point of View");
     }
 
     glDisable(GL_TEXTURE_2D);
@@ -391,6 +463,25 @@ void ModelGL::draw2D(int screenId)
 
 
 
+///////////////////////////////////////////////////////////////////////////////
+// draw text with the bitmap font, and count its GL calls
+// BitmapFont::drawText() binds the page texture and draws a quad (triangle
+// strip of 4 vertices) per character, then unbinds the texture.
+///////////////////////////////////////////////////////////////////////////////
+void ModelGL::drawText(float x, float y, const char* str)
+{
+    font.drawText(x, y, str);
+    if(!str)
+        return;
+
+    int length = (int)strlen(str);
+    for(int i = 0; i < length; ++i)
+        renderStats.addDraw(GL_TRIANGLE_STRIP, 4);
+    renderStats.addTextureBind(length + 1);
+}
+
+
+
 ///////////////////////////////////////////////////////////////////////////////
 // pre-frame
 ///////////////////////////////////////////////////////////////////////////////
@@ -588,9 +679,11 @@ void ModelGL::drawGridXZ(float size, float step)
 
     glBegin(GL_LINES);
 
+    int vertexCount = 4;            // x and z axis
     glColor4f(0.5f, 0.5f, 0.5f, 0.5f);
     for(float i=step; i <= size; i+= step)
     {
+        vertexCount += 8;
         glVertex3f(-size, 0,  i);   // lines parallel to X-axis
         glVertex3f( size, 0,  i);
         glVertex3f(-size, 0, -i);   // lines parallel to X-axis
@@ -614,6 +707,7 @@ void ModelGL::drawGridXZ(float size, float step)
     glVertex3f(0, 0,  size);
 
     glEnd();
+    renderStats.addDraw(GL_LINES, vertexCount);
 
     // enable lighting back
     glLineWidth(1.0f);
@@ -748,6 +842,9 @@ bool ModelGL::createShaderPrograms()
     glLinkProgramARB(progId2);
 
     glUseProgramObjectARB(progId2);
+    glUniform1iARB(glGetUniformLocationARB(progId2, "map0"), 0);
+    uniformTextureUsed = glGetUniformLocationARB(progId2, "textureUsed");
+    glUniform1iARB(uniformTextureUsed, 0);
 
     // check status
     int linkStatus1, linkStatus2;
@@ -866,11 +963,46 @@ bool ModelGL::loadObjs()
             vboReady = false;
     }
 
+    loadObjTextures();
+
     return objLoaded;
 }
 
 
 
+///////////////////////////////////////////////////////////////////////////////
+// request the textures of OBJ materials (map_Kd) to the texture loader
+// The groups sharing the same texture file use the same texture object.
+// Nothing is loaded if the model has no texture coords to sample them.
+///////////////////////////////////////////////////////////////////////////////
+void ModelGL::loadObjTextures()
+{
+    int count = objModel.getGroupCount();
+    texModel.assign(count, 0);
+    if(objModel.getInterleavedStride() != 32)
+        return;
+
+    TextureParams params;
+    params.minFilter = GL_LINEAR_MIPMAP_LINEAR;
+    params.mipmap = true;
+    params.compress = true;                 // BC1/BC3 with cache file, if S3TC is supported
+
+    std::map<std::string, GLuint> textures;
+    for(int i = 0; i < count; ++i)
+    {
+        const std::string& textureName = objModel.getMaterial(i).textureName;
+        if(textureName.empty())
+            continue;
+
+        std::map<std::string, GLuint>::iterator iter = textures.find(textureName);
+        if(iter == textures.end())
+            iter = textures.insert(std::make_pair(textureName, textureLoader.load(objModel.getObjDirectory() + textureName, params))).first;
+        texModel[i] = iter->second;
+    }
+}
+
+
+
 ///////////////////////////////////////////////////////////////////////////////
 // create VBOs
 ///////////////////////////////////////////////////////////////////////////////
@@ -882,6 +1014,7 @@ void ModelGL::createVertexBufferObjects()
     glGenBuffersARB(1, &vboModel);
     glBindBufferARB(GL_ARRAY_BUFFER_ARB, vboModel);
     glBufferDataARB(GL_ARRAY_BUFFER_ARB, dataSize, interleavedVertices, GL_STATIC_DRAW_ARB);
+    renderStats.addLoadBytes(dataSize);
 
     // create VBO array for indices
     iboModel.clear();
@@ -894,6 +1027,7 @@ void ModelGL::createVertexBufferObjects()
     {
         glBindBufferARB(GL_ELEMENT_ARRAY_BUFFER_ARB, iboModel[i]);
         glBufferDataARB(GL_ELEMENT_ARRAY_BUFFER_ARB, objModel.getIndexCount(i)*sizeof(int), (void*)objModel.getIndices(i), GL_STATIC_DRAW_ARB);
+        renderStats.addLoadBytes(objModel.getIndexCount(i)*sizeof(int));
     }
     glFlush();
 
@@ -903,6 +1037,7 @@ void ModelGL::createVertexBufferObjects()
     glGenBuffersARB(1, &vboCam);
     glBindBufferARB(GL_ARRAY_BUFFER_ARB, vboCam);
     glBufferDataARB(GL_ARRAY_BUFFER_ARB, dataSize, interleavedVertices, GL_STATIC_DRAW_ARB);
+    renderStats.addLoadBytes(dataSize);
 
     // create VBO for camera model indices
     iboCam.clear();
@@ -913,6 +1048,7 @@ void ModelGL::createVertexBufferObjects()
     {
         glBindBufferARB(GL_ELEMENT_ARRAY_BUFFER_ARB, iboCam[i]);
         glBufferDataARB(GL_ELEMENT_ARRAY_BUFFER_ARB, objCam.getIndexCount(i)*sizeof(int), (void*)objCam.getIndices(i), GL_STATIC_DRAW_ARB);
+        renderStats.addLoadBytes(objCam.getIndexCount(i)*sizeof(int));
     }
 }
 
@@ -944,6 +1080,7 @@ void ModelGL::drawObj()
         glMaterialf(GL_FRONT, GL_SHININESS, defaultShininess);
 
         glDrawElements(GL_TRIANGLES, (GLsizei)objModel.getIndexCount(i), GL_UNSIGNED_INT, objModel.getIndices(i));
+        renderStats.addDraw(GL_TRIANGLES, objModel.getIndexCount(i));
     }
 
     glDisableClientState(GL_VERTEX_ARRAY);  // disable vertex arrays
@@ -973,6 +1110,16 @@ void ModelGL::drawObjWithVbo()
     glNormalPointer(GL_FLOAT, stride, (void*)(sizeof(float)*3));
     glVertexPointer(3, GL_FLOAT, stride, 0);
 
+    // texture coords follow the normal if the stride has them (vnt,vnt,...)
+    // The textures are sampled by the shader only.
+    bool texCoordsUsed = glslReady && stride == 32;
+    if(texCoordsUsed)
+    {
+        glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+        glTexCoordPointer(2, GL_FLOAT, stride, (void*)(sizeof(float)*6));
+    }
+
+    GLuint boundTexId = 0;
     for(int i = 0; i < (int)iboModel.size(); ++i)
     {
         glMaterialfv(GL_FRONT, GL_AMBIENT, defaultAmbient);
@@ -980,12 +1127,34 @@ void ModelGL::drawObjWithVbo()
         glMaterialfv(GL_FRONT, GL_SPECULAR, defaultSpecular);
         glMaterialf(GL_FRONT, GL_SHININESS, defaultShininess);
 
+        // bind the texture of the material if it is uploaded, and skip the
+        // bind if the previous group uses the same texture
+        GLuint texId = 0;
+        if(texCoordsUsed && i < (int)texModel.size() && textureLoader.isReady(texModel[i]))
+            texId = texModel[i];
+        if(texId != boundTexId)
+        {
+            glBindTexture(GL_TEXTURE_2D, texId);
+            renderStats.addTextureBind();
+            glUniform1iARB(uniformTextureUsed, texId != 0);
+            boundTexId = texId;
+        }
+
         glBindBufferARB(GL_ELEMENT_ARRAY_BUFFER_ARB, iboModel[i]);
         glDrawElements(GL_TRIANGLES, objModel.getIndexCount(i), GL_UNSIGNED_INT, 0);
+        renderStats.addDraw(GL_TRIANGLES, objModel.getIndexCount(i));
+    }
+    if(boundTexId != 0)
+    {
+        glBindTexture(GL_TEXTURE_2D, 0);
+        renderStats.addTextureBind();
+        glUniform1iARB(uniformTextureUsed, 0);
     }
 
     glDisableClientState(GL_VERTEX_ARRAY);  // disable vertex arrays
     glDisableClientState(GL_NORMAL_ARRAY);
+    if(texCoordsUsed)
+        glDisableClientState(GL_TEXTURE_COORD_ARRAY);
 
     glBindBufferARB(GL_ARRAY_BUFFER_ARB, 0);
     glBindBufferARB(GL_ELEMENT_ARRAY_BUFFER_ARB, 0);
@@ -1026,6 +1195,7 @@ void ModelGL::drawCamera()
         glMaterialf(GL_FRONT, GL_SHININESS, camShininess);
 
         glDrawElements(GL_TRIANGLES, (GLsizei)objCam.getIndexCount(i), GL_UNSIGNED_INT, objCam.getIndices(i));
+        renderStats.addDraw(GL_TRIANGLES, objCam.getIndexCount(i));
     }
 
     glDisableClientState(GL_VERTEX_ARRAY);  // disable vertex arrays
@@ -1064,6 +1234,7 @@ void ModelGL::drawCameraWithVbo()
 
         glBindBufferARB(GL_ELEMENT_ARRAY_BUFFER_ARB, iboCam[i]);
         glDrawElements(GL_TRIANGLES, objCam.getIndexCount(i), GL_UNSIGNED_INT, 0);
+        renderStats.addDraw(GL_TRIANGLES, objCam.getIndexCount(i));
     }
 
     glDisableClientState(GL_VERTEX_ARRAY);  // disable vertex arrays
@@ -5,7 +5,7 @@
 //
 //  AUTHOR: Song Ho Ahn (song.ahn@gmail.com)
 // CREATED: 2016-05-29
-// UPDATED: 2016-07-21
+// UPDATED: 2026-10-18
 ///////////////////////////////////////////////////////////////////////////////
 
 #ifndef MODEL_GL_H
@@ -29,6 +29,9 @@
 #include "ObjModel.h"
 #include "BoundingBox.h"
 #include "BitmapFont.h"
+#include "TextureLoader.h"
+#include "TimingStats.h"
+#include "RenderStats.h"
 #include "OrbitCamera.h"
 #include "Vertices.h"
 
@@ -82,6 +85,16 @@ public:
 
     bool isShaderSupported();
     bool isVboSupported();
+    bool isLoadingTextures() const          { return textureLoader.isBusy(); }
+
+    // CPU time of draw() per screen and texture upload, in the last frames
+    const TimingStats& getTimingStats() const { return timingStats; }
+    bool saveTimingStats(const char* fileName) const { return timingStats.writeCsv(fileName); }
+    bool saveTrace(const char* fileName);   // CPU/GPU zones of Profiler as Chrome trace
+
+    // draw calls, triangles, buffer bytes and texture binds per frame (both screens)
+    const RenderStats& getRenderStats() const { return renderStats; }
+    bool saveRenderStats(const char* fileName) const { return renderStats.writeCsv(fileName); }
 
     // for grid
     void setGridSize(float radius);
@@ -113,11 +126,13 @@ private:
     void drawFocalPoint();
     void drawFov();
     void draw2D(int screenId);
+    void drawText(float x, float y, const char* str);   // font.drawText() with counting
     void setFrustum(float l, float r, float b, float t, float n, float f);
     void setFrustum(float fovy, float ratio, float n, float f);
     void setOrthoFrustum(float l, float r, float b, float t, float n=-1, float f=1);
     bool createShaderPrograms();
     void createVertexBufferObjects();
+    void loadObjTextures();
     void logShaders();
     void computeFovVertices(float fov);
 
@@ -162,16 +177,27 @@ private:
     GLuint vboCam;                  // vbo for camera OBJ
     std::vector<GLuint> iboModel;   // vbo for OBJ indices
     std::vector<GLuint> iboCam;     // vbo for OBJ indices
+    std::vector<GLuint> texModel;   // textures of OBJ groups, 0 if no texture
 
     // glsl extension
     bool glslSupported;
     bool glslReady;
     GLhandleARB progId1;            // shader program with color
     GLhandleARB progId2;            // shader program with color + lighting
+    GLint uniformTextureUsed;       // location of textureUsed in progId2
 
     // bitmap font
     BitmapFont font;
 
+    // textures are decoded by worker threads and uploaded per frame
+    TextureLoader textureLoader;
+
+    // rolling percentiles of draw() and texture upload
+    TimingStats timingStats;
+
+    // GL calls per frame of the draw paths
+    RenderStats renderStats;
+
     // material
     float defaultAmbient[4];
     float defaultDiffuse[4];
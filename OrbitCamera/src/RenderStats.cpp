@@ -0,0 +1,199 @@
+///////////////////////////////////////////////////////////////////////////////
+// RenderStats.cpp
+// ===============
+// Per-frame counters of the rendering work
+//
+//  AUTHOR: Song Ho Ahn (song.ahn@gmail.com)
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#ifdef _WIN32
+#include <windows.h>    // include windows.h to avoid thousands of compile errors even though this class is not depending on Windows
+#endif
+
+#ifdef __APPLE__
+#include <OpenGL/gl.h>
+#else
+#include <GL/gl.h>
+#endif
+
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include "RenderStats.h"
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// ctor
+///////////////////////////////////////////////////////////////////////////////
+RenderStats::RenderStats(int windowSize) : windowSize(windowSize), next(0), count(0), frameOpen(false), loadBytes(0)
+{
+    if(this->windowSize < 1)
+        this->windowSize = 1;
+    frames.resize(this->windowSize);
+    reset();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// close the current frame, and start counting the next frame
+// No frame is open before the first call, so nothing is kept then, and the
+// counts before it are dropped.
+///////////////////////////////////////////////////////////////////////////////
+void RenderStats::beginFrame()
+{
+    long long index = 0;
+    if(frameOpen)
+    {
+        frames[next] = current;
+        next = (next + 1) % windowSize;
+        if(count < windowSize)
+            ++count;
+        index = current.index + 1;
+    }
+
+    current = Frame();
+    current.index = index;
+    frameOpen = true;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// remove all frames, the counters of the current frame are cleared too
+///////////////////////////////////////////////////////////////////////////////
+void RenderStats::reset()
+{
+    next = count = 0;
+    current = Frame();
+    frameOpen = false;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// count a draw call and its triangles
+///////////////////////////////////////////////////////////////////////////////
+void RenderStats::addDraw(unsigned int mode, int count)
+{
+    ++current.drawCalls;
+    current.triangles += computeTriangles(mode, count);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// return the last finished frame
+///////////////////////////////////////////////////////////////////////////////
+bool RenderStats::getLast(Frame& frame) const
+{
+    if(count == 0)
+        return false;
+
+    frame = frames[(next + windowSize - 1) % windowSize];
+    return true;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// return the mean of the counters of the frames in the window
+// The index is the last frame of the window.
+///////////////////////////////////////////////////////////////////////////////
+bool RenderStats::getMean(Frame& frame) const
+{
+    if(count == 0)
+        return false;
+
+    frame = Frame();
+    for(int i = 0; i < count; ++i)
+    {
+        const Frame& f = frames[i];
+        frame.drawCalls += f.drawCalls;
+        frame.triangles += f.triangles;
+        frame.bufferBytes += f.bufferBytes;
+        frame.textureBinds += f.textureBinds;
+        frame.textureBytes += f.textureBytes;
+    }
+    frame.index = frames[(next + windowSize - 1) % windowSize].index;
+    frame.drawCalls /= count;
+    frame.triangles /= count;
+    frame.bufferBytes /= count;
+    frame.textureBinds /= count;
+    frame.textureBytes /= count;
+    return true;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// return the mean of the window as a line of text for the overlay
+///////////////////////////////////////////////////////////////////////////////
+std::string RenderStats::formatSummary() const
+{
+    Frame f;
+    if(!getMean(f))
+        return "-";
+
+    std::stringstream ss;
+    ss << "Calls: " << f.drawCalls << ", Tris: ";
+    if(f.triangles >= 10000)
+        ss << std::fixed << std::setprecision(1) << (f.triangles / 1000.0) << "K";
+    else
+        ss << f.triangles;
+    ss << ", Binds: " << f.textureBinds
+       << ", Buffer: " << ((f.bufferBytes + f.textureBytes) >> 10) << " KB";
+    if(loadBytes > 0)
+        ss << ", Load: " << (loadBytes >> 10) << " KB";
+    return ss.str();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// write the frames of the window to CSV, the oldest first
+///////////////////////////////////////////////////////////////////////////////
+bool RenderStats::writeCsv(const std::string& fileName) const
+{
+    std::ofstream file(fileName.c_str());
+    if(!file)
+        return false;
+
+    file << "frame,drawCalls,triangles,bufferBytes,textureBinds,textureBytes\n";
+    int first = (next + windowSize - count) % windowSize;
+    for(int i = 0; i < count; ++i)
+    {
+        const Frame& f = frames[(first + i) % windowSize];
+        file << f.index << "," << f.drawCalls << "," << f.triangles << "," << f.bufferBytes << ","
+             << f.textureBinds << "," << f.textureBytes << "\n";
+    }
+    file << "load,0,0," << loadBytes << ",0,0\n";
+    return (bool)file;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// return the number of triangles drawn with count vertices of the primitive
+///////////////////////////////////////////////////////////////////////////////
+int RenderStats::computeTriangles(unsigned int mode, int count)
+{
+    switch(mode)
+    {
+    case GL_TRIANGLES:
+        return count / 3;
+    case GL_TRIANGLE_STRIP:
+    case GL_TRIANGLE_FAN:
+    case GL_POLYGON:
+        return (count > 2) ? count - 2 : 0;
+    case GL_QUADS:
+        return count / 4 * 2;
+    case GL_QUAD_STRIP:
+        return (count > 3) ? (count / 2 - 1) * 2 : 0;
+    default:
+        return 0;                                   // points and lines
+    }
+}
@@ -0,0 +1,94 @@
+///////////////////////////////////////////////////////////////////////////////
+// RenderStats.h
+// =============
+// Per-frame counters of the rendering work: draw calls, triangles, bytes
+// given to glBufferData(), texture binds and bytes of texture uploads
+// The draw paths call add*() right after the GL calls they count, and
+// beginFrame() closes the current frame and keeps it in a ring of the last
+// windowSize frames; the first call only opens a frame. The overlay shows the mean of the window, so a spike of
+// a single frame (e.g. texture upload) does not hide the steady cost, and
+// writeCsv() writes every frame of the window for offline comparison.
+// The buffers created at load time, outside any frame, are counted with
+// addLoadBytes() as a one-time total, so they do not skew the first frame.
+// It only counts; no GL call. It is not thread-safe, use it on the GL thread.
+//
+// usage:
+//     RenderStats stats(300);                     // last 300 frames
+//     stats.beginFrame();                         // once per frame
+//     glDrawElements(GL_TRIANGLES, count, GL_UNSIGNED_INT, 0);
+//     stats.addDraw(GL_TRIANGLES, count);
+//     std::string line = stats.formatSummary();
+//     stats.writeCsv("render.csv");
+//
+//  AUTHOR: Song Ho Ahn (song.ahn@gmail.com)
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef RENDER_STATS_H
+#define RENDER_STATS_H
+
+#include <string>
+#include <vector>
+
+class RenderStats
+{
+public:
+    // counters of a frame
+    struct Frame
+    {
+        long long index;                            // frame number since reset()
+        long long drawCalls;                        // glDrawElements/glDrawArrays/glBegin-glEnd
+        long long triangles;                        // triangles submitted, 0 for points and lines
+        long long bufferBytes;                      // bytes given to glBufferData()
+        long long textureBinds;                     // glBindTexture() calls, including unbind
+        long long textureBytes;                     // bytes of texture images uploaded
+    };
+
+    // ctor/dtor
+    RenderStats(int windowSize=300);
+    ~RenderStats() {}
+
+    void beginFrame();                              // keep the current frame in the window, and start a new one
+    void reset();                                   // remove all frames
+
+    // count the GL calls of the current frame
+    // mode is the primitive type of the draw call, e.g. GL_TRIANGLES, and
+    // count is the number of vertices or indices
+    void addDraw(unsigned int mode, int count);
+    void addBufferData(long long bytes)             { current.bufferBytes += bytes; }
+    void addTextureBind(int count=1)                { current.textureBinds += count; }
+    void addTextureBytes(long long bytes)           { current.textureBytes += bytes; }
+    void addLoadBytes(long long bytes)              { loadBytes += bytes; }     // not in frames
+
+    // getters
+    const Frame& getCurrent() const                 { return current; }
+    bool getLast(Frame& frame) const;               // the last finished frame, false if none
+    bool getMean(Frame& frame) const;               // mean of the window, false if no frame
+    int getFrameCount() const                       { return count; }   // # of frames in the window
+    long long getLoadBytes() const                  { return loadBytes; }   // not cleared by reset()
+
+    // "Calls: 12, Tris: 3.4K, Binds: 5, Buffer: 0 KB" of the mean of the window,
+    // and ", Load: 1234 KB" if any buffer is created at load time
+    std::string formatSummary() const;
+
+    // write a row per frame of the window, the oldest first, then a "load" row
+    // of the one-time bytes in the bufferBytes column
+    bool writeCsv(const std::string& fileName) const;
+
+    static int computeTriangles(unsigned int mode, int count);
+
+protected:
+
+private:
+    // member variables
+    std::vector<Frame> frames;                      // ring of the finished frames
+    int windowSize;
+    int next;                                       // index to write the next frame
+    int count;                                      // # of frames in the ring
+    Frame current;                                  // frame being counted
+    bool frameOpen;                                 // false until the first beginFrame()
+    long long loadBytes;                            // bytes of buffers created at load time
+};
+
+#endif // RENDER_STATS_H
@@ -0,0 +1,723 @@
+///////////////////////////////////////////////////////////////////////////////
+// TextureLoader.cpp
+// =================
+// Asynchronous texture loader
+// Image files (TGA, BMP) are read and decoded by a pool of worker threads,
+// and the decoded images are queued to the OpenGL thread. update() must be
+// called on the OpenGL thread once per frame. It uploads the queued images
+// through a ring of pixel buffer objects (PBO), up to the byte budget per
+// frame, so loading textures never stalls a frame.
+// If compress is enabled, the images are encoded to BC1/BC3 and cached as DDS
+// files next to the sources.
+//
+//  AUTHOR: Song Ho Ahn (song.ahn@gmail.com)
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cstring>                      // for memcpy()
+#include <algorithm>
+#include <sys/stat.h>                   // for stat()
+#include "TextureLoader.h"
+#include "glExtension.h"
+#include "Tga.h"
+#include "Bmp.h"
+#include "Mipmap.h"
+#include "Dds.h"
+#include "Qoi.h"
+
+// constants
+static const int PBO_COUNT = 3;                             // # of PBOs in ring
+static const std::size_t DEFAULT_FRAME_BUDGET = 4 << 20;    // 4 MB per frame
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// a texture request, owned by the queue where it is
+// The image is decoded into "image", then moved to "mipmap" if mipmap is on,
+// or encoded into "dds" if compress is on. A compressed job has no "image".
+///////////////////////////////////////////////////////////////////////////////
+struct TextureLoader::Job
+{
+    GLuint id;
+    std::string fileName;
+    TextureDecoder decoder;
+    TextureParams params;
+    TextureImage image;
+    Image::Mipmap mipmap;
+    Image::Dds dds;
+    bool decoded;
+    bool compressed;                            // dds has the blocks
+    bool started;                               // upload started
+    bool done;                                  // upload completed
+    int level;                                  // uploading level, from the smallest to 0
+    int row;                                    // next scanline to upload
+    bool levelAllocated;
+
+    Job() : id(0), decoded(false), compressed(false), started(false), done(false), level(0), row(0), levelAllocated(false) {}
+
+    int getLevelCount() const                   { return !params.mipmap ? 1 : compressed ? dds.getLevelCount() : mipmap.getLevelCount(); }
+    int getWidth(int i) const                   { return compressed ? dds.getWidth(i) : params.mipmap ? mipmap.getWidth(i) : image.width; }
+    int getHeight(int i) const                  { return compressed ? dds.getHeight(i) : params.mipmap ? mipmap.getHeight(i) : image.height; }
+    const unsigned char* getData(int i) const   { return compressed ? dds.getData(i) : params.mipmap ? mipmap.getData(i) : &image.data[0]; }
+};
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// ctor/dtor
+///////////////////////////////////////////////////////////////////////////////
+TextureLoader::TextureLoader() : decodingCount(0), stopFlag(false), pboIndex(0),
+                                 pboUsed(false), buffersReady(false),
+                                 frameBudget(DEFAULT_FRAME_BUDGET), frameBytes(0), totalBytes(0)
+{
+}
+
+TextureLoader::~TextureLoader()
+{
+    stop();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// start worker threads
+///////////////////////////////////////////////////////////////////////////////
+void TextureLoader::start(int threadCount)
+{
+    if(!workers.empty())
+        return;
+
+    if(threadCount <= 0)
+        threadCount = (int)std::thread::hardware_concurrency() - 1;
+    if(threadCount < 1)
+        threadCount = 1;
+
+    stopFlag = false;
+    for(int i = 0; i < threadCount; ++i)
+        workers.push_back(std::thread(&TextureLoader::runWorker, this));
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// stop worker threads and discard the pending jobs
+// The texture objects of the discarded jobs keep the 1x1 image.
+///////////////////////////////////////////////////////////////////////////////
+void TextureLoader::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopFlag = true;
+    }
+    condition.notify_all();
+    for(std::size_t i = 0; i < workers.size(); ++i)
+        workers[i].join();
+    workers.clear();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    for(std::size_t i = 0; i < decodeQueue.size(); ++i)
+        delete decodeQueue[i];
+    for(std::size_t i = 0; i < uploadQueue.size(); ++i)
+        delete uploadQueue[i];
+    for(std::size_t i = 0; i < uploadingJobs.size(); ++i)
+        delete uploadingJobs[i];
+    decodeQueue.clear();
+    uploadQueue.clear();
+    uploadingJobs.clear();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// create a texture object and request to load an image file
+///////////////////////////////////////////////////////////////////////////////
+GLuint TextureLoader::load(const std::string& fileName, const TextureParams& params)
+{
+    Job* job = new Job();
+    job->id = createTexture(params);
+    job->fileName = fileName;
+    job->params = params;
+    if(params.compress && !glExtension::getInstance().isSupported("GL_EXT_texture_compression_s3tc"))
+        job->params.compress = false;   // upload uncompressed
+    submit(job);
+    return job->id;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// create a texture object and request to load with a custom decoder
+///////////////////////////////////////////////////////////////////////////////
+GLuint TextureLoader::load(const TextureDecoder& decoder, const TextureParams& params)
+{
+    Job* job = new Job();
+    job->id = createTexture(params);
+    job->decoder = decoder;
+    job->params = params;
+    if(params.compress && !glExtension::getInstance().isSupported("GL_EXT_texture_compression_s3tc"))
+        job->params.compress = false;
+    submit(job);
+    return job->id;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// upload the decoded images within the frame budget
+// At least one scanline is uploaded per frame, even if it exceeds the budget.
+///////////////////////////////////////////////////////////////////////////////
+void TextureLoader::update()
+{
+    frameBytes = 0;
+    if(!buffersReady)
+        initBuffers();
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        while(!uploadQueue.empty())
+        {
+            uploadingJobs.push_back(uploadQueue.front());
+            uploadQueue.pop_front();
+        }
+    }
+    if(uploadingJobs.empty())
+        return;
+
+    // scanlines of the images are not 4-byte aligned
+    GLint alignment;
+    glGetIntegerv(GL_UNPACK_ALIGNMENT, &alignment);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+    while(!uploadingJobs.empty() && frameBytes < frameBudget)
+    {
+        Job* job = uploadingJobs.front();
+        if(!job->started && !beginJob(job))
+        {
+            uploadingJobs.pop_front();
+            finishJob(job, false);
+            continue;
+        }
+
+        std::size_t bytes;
+        if(job->compressed)
+            bytes = uploadBlocks(job, frameBudget - frameBytes);
+        else
+            bytes = uploadRows(job, frameBudget - frameBytes);
+        frameBytes += bytes;
+        if(job->done)
+        {
+            uploadingJobs.pop_front();
+            finishJob(job, true);
+        }
+        else if(bytes == 0)
+        {
+            break;  // the next scanline or level does not fit in the rest of budget
+        }
+    }
+    totalBytes += frameBytes;
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, alignment);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// delete PBOs
+///////////////////////////////////////////////////////////////////////////////
+void TextureLoader::releaseBuffers()
+{
+    if(!pboIds.empty())
+        glDeleteBuffersARB((GLsizei)pboIds.size(), &pboIds[0]);
+    pboIds.clear();
+    pboUsed = false;
+    buffersReady = false;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// check the status
+///////////////////////////////////////////////////////////////////////////////
+bool TextureLoader::isReady(GLuint id) const
+{
+    std::map<GLuint, bool>::const_iterator iter = states.find(id);
+    return iter != states.end() && iter->second;
+}
+
+bool TextureLoader::isBusy() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return !decodeQueue.empty() || decodingCount > 0 || !uploadQueue.empty() || !uploadingJobs.empty();
+}
+
+int TextureLoader::getDecodeQueueSize() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return (int)decodeQueue.size() + decodingCount;
+}
+
+int TextureLoader::getUploadQueueSize() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return (int)(uploadQueue.size() + uploadingJobs.size());
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// create a texture object with 1x1 transparent black image
+///////////////////////////////////////////////////////////////////////////////
+GLuint TextureLoader::createTexture(const TextureParams& params)
+{
+    GLuint id;
+    glGenTextures(1, &id);
+    glBindTexture(GL_TEXTURE_2D, id);
+
+    // select modulate to mix texture with color for shading
+    glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, params.minFilter);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, params.magFilter);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, params.wrap);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, params.wrap);
+
+    const unsigned char pixel[4] = {0, 0, 0, 0};
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixel);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    states[id] = false;
+    return id;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// add a job to the decode queue, and start workers if not started yet
+///////////////////////////////////////////////////////////////////////////////
+void TextureLoader::submit(Job* job)
+{
+    if(workers.empty())
+        start();
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        decodeQueue.push_back(job);
+    }
+    condition.notify_one();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// worker thread: decode images, build mipmaps and compress
+///////////////////////////////////////////////////////////////////////////////
+void TextureLoader::runWorker()
+{
+    while(true)
+    {
+        Job* job;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            condition.wait(lock, [this]{ return stopFlag || !decodeQueue.empty(); });
+            if(stopFlag)
+                return;
+            job = decodeQueue.front();
+            decodeQueue.pop_front();
+            ++decodingCount;
+        }
+
+        // use the compressed cache if it is up to date
+        if(job->params.compress && !job->fileName.empty())
+            job->compressed = readCache(job->fileName, job->params.srgbMipmap, job->dds);
+        if(job->compressed)
+        {
+            job->decoded = true;
+            std::lock_guard<std::mutex> lock(mutex);
+            --decodingCount;
+            uploadQueue.push_back(job);
+            continue;
+        }
+
+        TextureImage& image = job->image;
+        bool decoded;
+        if(job->decoder)
+            decoded = job->decoder(image);
+        else
+            decoded = decodeFile(job->fileName, image);
+
+        // validate the image from the decoder
+        if(decoded)
+        {
+            decoded = image.width > 0 && image.height > 0 &&
+                      (image.channelCount == 1 || image.channelCount == 3 || image.channelCount == 4) &&
+                      image.data.size() >= (std::size_t)image.width * image.height * image.channelCount;
+        }
+
+        // the worker pool runs in parallel already, so build mipmaps in this thread only
+        // The cache always has all levels, so mipmaps are built for compression too.
+        bool compress = job->params.compress && image.channelCount >= 3;
+        if(decoded && (job->params.mipmap || compress))
+        {
+            Image::Mipmap::Filter filter = job->params.srgbMipmap ? Image::Mipmap::BOX_SRGB : Image::Mipmap::BOX;
+            job->mipmap.setThreadCount(1);
+            decoded = job->mipmap.build(&image.data[0], image.width, image.height, image.channelCount, filter);
+        }
+
+        // encode to BC1/BC3 and save the cache, the uncompressed images are not needed anymore
+        if(decoded && compress)
+        {
+            job->dds.setThreadCount(1);
+            job->compressed = job->dds.encode(job->mipmap);
+            if(job->compressed)
+            {
+                if(!job->fileName.empty())
+                    job->dds.save(getCacheName(job->fileName, job->params.srgbMipmap).c_str());
+                job->mipmap = Image::Mipmap();
+            }
+        }
+        if(decoded && (job->params.mipmap || job->compressed))
+            std::vector<unsigned char>().swap(image.data);
+        job->decoded = decoded;
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            --decodingCount;
+            uploadQueue.push_back(job);
+        }
+    }
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// read and decode TGA, BMP or QOI file by the file extension
+///////////////////////////////////////////////////////////////////////////////
+bool TextureLoader::decodeFile(const std::string& fileName, TextureImage& image)
+{
+    std::string ext;
+    std::size_t pos = fileName.find_last_of('.');
+    if(pos != std::string::npos)
+        ext = fileName.substr(pos + 1);
+    std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+
+    int width, height, bitCount;
+    const unsigned char* data;
+    Image::Tga tga;
+    Image::Bmp bmp;
+    Image::Qoi qoi;
+    if(ext == "tga")
+    {
+        if(!tga.read(fileName.c_str()))
+            return false;
+        width = tga.getWidth();
+        height = tga.getHeight();
+        bitCount = tga.getBitCount();
+        data = tga.getDataRGB();
+    }
+    else if(ext == "bmp")
+    {
+        if(!bmp.read(fileName.c_str()))
+            return false;
+        width = bmp.getWidth();
+        height = bmp.getHeight();
+        bitCount = bmp.getBitCount();
+        data = bmp.getDataRGB();
+    }
+    else if(ext == "qoi")
+    {
+        if(!qoi.read(fileName.c_str()))
+            return false;
+        width = qoi.getWidth();
+        height = qoi.getHeight();
+        bitCount = qoi.getBitCount();
+        data = qoi.getData();
+    }
+    else
+    {
+        return false;   // unknown format
+    }
+
+    if(!data)
+        return false;
+
+    image.width = width;
+    image.height = height;
+    image.channelCount = bitCount / 8;
+    image.data.assign(data, data + (std::size_t)width * height * image.channelCount);
+    return true;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// return the name of the compressed cache file of an image file
+// The sRGB mipmap has a different cache because the levels are different.
+///////////////////////////////////////////////////////////////////////////////
+std::string TextureLoader::getCacheName(const std::string& fileName, bool srgbMipmap)
+{
+    return fileName + (srgbMipmap ? ".srgb.dds" : ".dds");
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// read the compressed cache if it is newer than the source image
+// It must have all levels down to 1x1, otherwise the cache is rebuilt.
+///////////////////////////////////////////////////////////////////////////////
+bool TextureLoader::readCache(const std::string& fileName, bool srgbMipmap, Image::Dds& dds)
+{
+    std::string cacheName = getCacheName(fileName, srgbMipmap);
+    struct stat sourceInfo, cacheInfo;
+    if(stat(fileName.c_str(), &sourceInfo) != 0 || stat(cacheName.c_str(), &cacheInfo) != 0)
+        return false;
+    if(cacheInfo.st_mtime < sourceInfo.st_mtime)
+        return false;   // outdated
+
+    if(!dds.read(cacheName.c_str()))
+        return false;
+    int last = dds.getLevelCount() - 1;
+    return dds.getWidth(last) == 1 && dds.getHeight(last) == 1;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// encode an image file to BC1/BC3 with all mip levels, and save the cache
+// It is for offline processing, so all CPU cores are used.
+///////////////////////////////////////////////////////////////////////////////
+bool TextureLoader::buildCache(const std::string& fileName, bool srgbMipmap)
+{
+    TextureImage image;
+    if(!decodeFile(fileName, image) || image.channelCount < 3)
+        return false;
+
+    Image::Mipmap mipmap;
+    Image::Mipmap::Filter filter = srgbMipmap ? Image::Mipmap::BOX_SRGB : Image::Mipmap::BOX;
+    if(!mipmap.build(&image.data[0], image.width, image.height, image.channelCount, filter))
+        return false;
+
+    Image::Dds dds;
+    if(!dds.encode(mipmap))
+        return false;
+    return dds.save(getCacheName(fileName, srgbMipmap).c_str());
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// create PBO ring if supported
+///////////////////////////////////////////////////////////////////////////////
+void TextureLoader::initBuffers()
+{
+    buffersReady = true;
+    pboUsed = glExtension::getInstance().isSupported("GL_ARB_pixel_buffer_object");
+    if(pboUsed)
+    {
+        pboIds.resize(PBO_COUNT);
+        glGenBuffersARB(PBO_COUNT, &pboIds[0]);
+        pboIndex = 0;
+    }
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// prepare to upload, return false if the image cannot be uploaded
+///////////////////////////////////////////////////////////////////////////////
+bool TextureLoader::beginJob(Job* job)
+{
+    if(!job->decoded)
+        return false;
+
+    // the texture may be deleted by the owner while decoding
+    if(!glIsTexture(job->id))
+        return false;
+
+    job->started = true;
+    job->level = job->getLevelCount() - 1;  // from the smallest level
+    job->row = 0;
+    job->levelAllocated = false;
+    return true;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// upload scanlines of the job within the budget, return the uploaded bytes
+// Each chunk is copied into the next PBO in the ring, then transferred to the
+// texture by DMA, so the copy of the next chunk does not wait for it.
+///////////////////////////////////////////////////////////////////////////////
+std::size_t TextureLoader::uploadRows(Job* job, std::size_t budget)
+{
+    int channelCount = job->image.channelCount;
+    GLenum format, internalFormat;
+    switch(channelCount)
+    {
+    case 1:
+        format = job->params.grayFormat;
+        internalFormat = (format == GL_ALPHA) ? GL_ALPHA8 : GL_LUMINANCE8;
+        break;
+    case 3:
+        format = GL_RGB;
+        internalFormat = GL_RGB8;
+        break;
+    default:
+        format = GL_RGBA;
+        internalFormat = GL_RGBA8;
+        break;
+    }
+
+    glBindTexture(GL_TEXTURE_2D, job->id);
+
+    std::size_t bytes = 0;
+    bool force = (budget == frameBudget);   // nothing uploaded yet in this frame
+    while(!job->done)
+    {
+        int width = job->getWidth(job->level);
+        int height = job->getHeight(job->level);
+        std::size_t pitch = (std::size_t)width * channelCount;
+
+        // how many scanlines fit in the budget
+        std::size_t left = (bytes < budget) ? budget - bytes : 0;
+        int rows = (int)(left / pitch);
+        if(rows < 1)
+        {
+            if(bytes > 0 || !force)
+                break;
+            rows = 1;
+        }
+        if(rows > height - job->row)
+            rows = height - job->row;
+
+        // allocate the level at the first chunk
+        if(!job->levelAllocated)
+        {
+            glTexImage2D(GL_TEXTURE_2D, job->level, internalFormat, width, height, 0, format, GL_UNSIGNED_BYTE, 0);
+            job->levelAllocated = true;
+        }
+
+        const unsigned char* src = job->getData(job->level) + job->row * pitch;
+        std::size_t size = rows * pitch;
+        void* dst = 0;
+        if(pboUsed)
+        {
+            // discard the previous data (orphan) to avoid waiting for DMA
+            glBindBufferARB(GL_PIXEL_UNPACK_BUFFER_ARB, pboIds[pboIndex]);
+            glBufferDataARB(GL_PIXEL_UNPACK_BUFFER_ARB, size, 0, GL_STREAM_DRAW_ARB);
+            dst = glMapBufferARB(GL_PIXEL_UNPACK_BUFFER_ARB, GL_WRITE_ONLY_ARB);
+            if(dst)
+            {
+                memcpy(dst, src, size);
+                glUnmapBufferARB(GL_PIXEL_UNPACK_BUFFER_ARB);
+                glTexSubImage2D(GL_TEXTURE_2D, job->level, 0, job->row, width, rows, format, GL_UNSIGNED_BYTE, 0);
+            }
+            glBindBufferARB(GL_PIXEL_UNPACK_BUFFER_ARB, 0);
+            pboIndex = (pboIndex + 1) % PBO_COUNT;
+        }
+        if(!dst)
+        {
+            // no PBO or failed to map, upload from system memory
+            glTexSubImage2D(GL_TEXTURE_2D, job->level, 0, job->row, width, rows, format, GL_UNSIGNED_BYTE, src);
+        }
+
+        bytes += size;
+        job->row += rows;
+
+        // the level is done, make it the base level, so the texture is complete
+        if(job->row == height)
+        {
+            if(job->params.mipmap)
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, job->level);
+
+            if(job->level == 0)
+            {
+                job->done = true;
+            }
+            else
+            {
+                --job->level;
+                job->row = 0;
+                job->levelAllocated = false;
+            }
+        }
+    }
+
+    glBindTexture(GL_TEXTURE_2D, 0);
+    return bytes;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// upload compressed levels of the job within the budget, return the uploaded bytes
+// A level cannot be uploaded partially with glCompressedTexImage2D, so the
+// budget is checked per level. The levels are uploaded through the PBO ring
+// as uploadRows() does.
+///////////////////////////////////////////////////////////////////////////////
+std::size_t TextureLoader::uploadBlocks(Job* job, std::size_t budget)
+{
+    GLenum internalFormat = (job->dds.getFormat() == Image::Dds::FORMAT_BC1) ?
+                            GL_COMPRESSED_RGB_S3TC_DXT1_EXT : GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+
+    glBindTexture(GL_TEXTURE_2D, job->id);
+
+    std::size_t bytes = 0;
+    bool force = (budget == frameBudget);   // nothing uploaded yet in this frame
+    while(!job->done)
+    {
+        int width = job->getWidth(job->level);
+        int height = job->getHeight(job->level);
+        std::size_t size = job->dds.getDataSize(job->level);
+        std::size_t left = (bytes < budget) ? budget - bytes : 0;
+        if(size > left && (bytes > 0 || !force))
+            break;
+
+        const unsigned char* src = job->getData(job->level);
+        void* dst = 0;
+        if(pboUsed)
+        {
+            glBindBufferARB(GL_PIXEL_UNPACK_BUFFER_ARB, pboIds[pboIndex]);
+            glBufferDataARB(GL_PIXEL_UNPACK_BUFFER_ARB, size, 0, GL_STREAM_DRAW_ARB);
+            dst = glMapBufferARB(GL_PIXEL_UNPACK_BUFFER_ARB, GL_WRITE_ONLY_ARB);
+            if(dst)
+            {
+                memcpy(dst, src, size);
+                glUnmapBufferARB(GL_PIXEL_UNPACK_BUFFER_ARB);
+                glCompressedTexImage2DARB(GL_TEXTURE_2D, job->level, internalFormat, width, height, 0, (GLsizei)size, 0);
+            }
+            glBindBufferARB(GL_PIXEL_UNPACK_BUFFER_ARB, 0);
+            pboIndex = (pboIndex + 1) % PBO_COUNT;
+        }
+        if(!dst)
+        {
+            glCompressedTexImage2DARB(GL_TEXTURE_2D, job->level, internalFormat, width, height, 0, (GLsizei)size, src);
+        }
+        bytes += size;
+
+        // the level is done, make it the base level, so the texture is complete
+        if(job->params.mipmap)
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, job->level);
+        if(job->level == 0)
+            job->done = true;
+        else
+            --job->level;
+    }
+
+    glBindTexture(GL_TEXTURE_2D, 0);
+    return bytes;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// update the state of the texture and delete the job
+///////////////////////////////////////////////////////////////////////////////
+void TextureLoader::finishJob(Job* job, bool success)
+{
+    if(success)
+        states[job->id] = true;
+    else
+        states.erase(job->id);
+    delete job;
+}
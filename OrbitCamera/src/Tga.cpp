@@ -3,17 +3,20 @@
 // Targa image loader and writer
 // It reads uncompressed and RLE compressed color (24-bit and 32-bit) and 
 // grayscale image.
-// And, it saves as only uncompressed color or grayscale image.
+// And, it saves as uncompressed or RLE compressed color or grayscale image.
 //
 //  AUTHOR: Song Ho Ahn (song.ahn@gmail.com)
 // CREATED: 2006-07-17
-// UPDATED: 2014-04-05
+// UPDATED: 2026-10-18
 ///////////////////////////////////////////////////////////////////////////////
 
 #include <fstream>
 #include <iostream>
 #include <cstring>                      // for memcpy()
+#include <thread>
+#include <functional>                   // for std::ref()
 #include "Tga.h"
+#include "pixelUtils.h"
 using std::ifstream;
 using std::ofstream;
 using std::ios;
@@ -273,7 +276,7 @@ bool Tga::read(const char* fileName)
         inFile.read((char*)encData, size);
 
         // decode RLE into image data buffer
-        decodeRLE(encData, data, size, bitCount/8);
+        decodeRLE(encData, size, data, dataSize, bitCount/8);
 
         // deallocate encoded data buffer after decoding
         delete [] encData;
@@ -300,12 +303,17 @@ bool Tga::read(const char* fileName)
 // static shared functions ****************************************************
 
 ///////////////////////////////////////////////////////////////////////////////
-// save an image as an uncompressed Tga format
+// save an image as a Tga format, uncompressed or RLE compressed
 // We assume the source image is RGB order, so it must be converted BGR order.
+// The scanlines are converted (and encoded) in bands of rows, and written to
+// the file band by band, so it does not need a full-size temp image. With RLE,
+// the bands are encoded on multiple threads in parallel.
 ///////////////////////////////////////////////////////////////////////////////
-bool Tga::save(const char* fileName, int w, int h, int channelCount, const unsigned char* data)
+bool Tga::save(const char* fileName, int w, int h, int channelCount, const unsigned char* data, bool rle)
 {
     if(!fileName || !data) return false;
+    if(w <= 0 || h <= 0) return false;
+    if(channelCount != 1 && channelCount != 3 && channelCount != 4) return false;
 
     // list of entries in TGA header (18 bytes)
     char idLength;          // length of image ID filed (1 bytes)
@@ -337,19 +345,8 @@ bool Tga::save(const char* fileName, int w, int h, int channelCount, const unsig
         imageType = 3;      // grayscale
     else
         imageType = 2;      // color
-
-    // allocate temp memory
-    int dataSize = w * h * channelCount;
-    unsigned char *tmpData = new unsigned char[dataSize];
-
-    // copy image data
-    memcpy(tmpData, data, dataSize);
-
-    // flip the image upside down
-    flipImage(tmpData, width, height, channelCount);
-
-    // convert RGB to BGR order
-    swapRedBlue(tmpData, dataSize, channelCount);
+    if(rle)
+        imageType += 8;     // RLE compressed
 
     // open output file
     ofstream outFile;
@@ -370,16 +367,149 @@ bool Tga::save(const char* fileName, int w, int h, int channelCount, const unsig
     outFile.put(bitCount);
     outFile.put(descriptor);
 
-    // write image data
-    outFile.write((char*)tmpData, dataSize);
+    // use a thread per band for RLE, but not more than the number of bands
+    const int BAND_HEIGHT = 64;                 // # of scanlines per band
+    int bandCount = (h + BAND_HEIGHT - 1) / BAND_HEIGHT;
+    int threadCount = 1;
+    if(rle)
+    {
+        threadCount = (int)std::thread::hardware_concurrency();
+        if(threadCount < 1)
+            threadCount = 1;
+        if(threadCount > bandCount)
+            threadCount = bandCount;
+    }
+
+    // output buffer per thread, it is reused for next bands
+    std::vector<std::vector<unsigned char> > buffers(threadCount);
+    std::vector<std::thread> threads;
+
+    // Tga is bottom-to-top orientation, so the last scanline of the source
+    // image is the first band of the file
+    std::size_t lineSize = (std::size_t)w * channelCount;
+    for(int band = 0; band < bandCount; band += threadCount)
+    {
+        int count = bandCount - band;
+        if(count > threadCount)
+            count = threadCount;
+
+        for(int i = 0; i < count; ++i)
+        {
+            int first = (band + i) * BAND_HEIGHT;   // first scanline of the band in the file
+            int last = first + BAND_HEIGHT;
+            if(last > h)
+                last = h;
+
+            std::vector<unsigned char>* buffer = &buffers[i];
+            const unsigned char* src = data + (std::size_t)(h - 1 - first) * lineSize;
+            if(count == 1)
+                encodeBand(src, w, last - first, channelCount, rle, *buffer);
+            else
+                threads.push_back(std::thread(encodeBand, src, w, last - first, channelCount, rle, std::ref(*buffer)));
+        }
+
+        // write the encoded bands in order
+        for(std::size_t i = 0; i < threads.size(); ++i)
+            threads[i].join();
+        threads.clear();
+
+        for(int i = 0; i < count; ++i)
+            outFile.write((char*)&buffers[i][0], buffers[i].size());
+    }
 
     // close the opened file
+    bool result = outFile.good();
     outFile.close();
 
-    // deallocate tmp buffer
-    delete [] tmpData;
+    return result;
+}
 
-    return true;
+
+
+///////////////////////////////////////////////////////////////////////////////
+// convert scanlines from RGB to BGR order, and encode them with TGA RLE
+// "src" points to the first (bottom) scanline of the band, and next scanlines
+// are above of it in the source image (top-to-bottom orientation).
+// The encoded data is stored in "buffer", which is resized to fit the data.
+// Packets do not cross scanlines as TGA 2.0 recommends, so each band can be
+// encoded independently.
+///////////////////////////////////////////////////////////////////////////////
+void Tga::encodeBand(const unsigned char* src, int width, int lineCount, int channelCount, bool rle,
+                     std::vector<unsigned char>& buffer)
+{
+    std::size_t lineSize = (std::size_t)width * channelCount;
+
+    // worst case of RLE is 1 header byte for every 128 pixels
+    std::size_t maxLineSize = lineSize + (width + 127) / 128;
+    buffer.resize(maxLineSize * lineCount + lineSize);  // extra scanline for RGB->BGR conversion
+
+    unsigned char* line = &buffer[maxLineSize * lineCount];  // BGR scanline at the end of buffer
+    unsigned char* out = &buffer[0];
+    for(int i = 0; i < lineCount; ++i)
+    {
+        memcpy(line, src - i * lineSize, lineSize);
+        swapRedBlue(line, (int)lineSize, channelCount);
+
+        if(rle)
+        {
+            out += encodeRLE(line, width, channelCount, out);
+        }
+        else
+        {
+            memcpy(out, line, lineSize);
+            out += lineSize;
+        }
+    }
+    buffer.resize(out - &buffer[0]);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// encode a scanline with TGA RLE
+// A run-length packet is used for 2 or more same pixels, and the other pixels
+// are grouped into raw packets. Both packets hold 128 pixels at max.
+// It returns the number of encoded bytes.
+///////////////////////////////////////////////////////////////////////////////
+std::size_t Tga::encodeRLE(const unsigned char* data, int pixelCount, int channelCount, unsigned char* outData)
+{
+    unsigned char* out = outData;
+    int i = 0;
+    while(i < pixelCount)
+    {
+        // count the same pixels from current position
+        const unsigned char* pixel = data + i * channelCount;
+        int runCount = 1;
+        while(i + runCount < pixelCount && runCount < 128 &&
+              memcmp(pixel, pixel + runCount * channelCount, channelCount) == 0)
+            ++runCount;
+
+        if(runCount > 1)
+        {
+            // run-length packet: header + 1 pixel
+            *out++ = (unsigned char)(0x80 | (runCount - 1));
+            memcpy(out, pixel, channelCount);
+            out += channelCount;
+            i += runCount;
+        }
+        else
+        {
+            // raw packet: collect pixels until 2 same pixels appear
+            int rawCount = 1;
+            while(i + rawCount < pixelCount && rawCount < 128)
+            {
+                const unsigned char* next = pixel + rawCount * channelCount;
+                if(i + rawCount + 1 < pixelCount && memcmp(next, next + channelCount, channelCount) == 0)
+                    break;
+                ++rawCount;
+            }
+            *out++ = (unsigned char)(rawCount - 1);
+            memcpy(out, pixel, rawCount * channelCount);
+            out += rawCount * channelCount;
+            i += rawCount;
+        }
+    }
+    return out - outData;
 }
 
 
@@ -418,36 +548,59 @@ bool Tga::save(const char* fileName, int w, int h, int channelCount, const unsig
 // ====================  =================
 // 01 A1 A2 A3 B1 B2 B3  A1 A2 A3 B1 B2 B3
 ///////////////////////////////////////////////////////////////////////////////
-bool Tga::decodeRLE(const unsigned char *encData, unsigned char *outData, std::size_t encDataSize, int channelCount)
+bool Tga::decodeRLE(const unsigned char *encData, std::size_t encDataSize, unsigned char *outData, std::size_t dataSize, int channelCount)
 {
     // check NULL pointer
     if(!encData || !outData)
         return false;
 
-    const unsigned char* endPointer = encData + encDataSize - 1;
+    const unsigned char* endPointer = encData + encDataSize;
+    unsigned char* outEnd = outData + dataSize;
 
     unsigned char header;                   // RLE encode header (1-byte)
-    int repeatCount;
+    std::size_t repeatCount;
+    std::size_t size;
+
+    // a pattern of the repeating colour, it is copied 48 bytes at once
+    // 48 is the multiple of 1, 3, 4 and 16 (SSE register)
+    const std::size_t PATTERN_SIZE = 48;
+    unsigned char pattern[PATTERN_SIZE];
 
-    while(encData < endPointer)
+    while(encData < endPointer && outData < outEnd)
     {
         // get header
-        header = *encData;
+        header = *encData++;                // move the pointer from header to data
+
+        // get # of pixels from low 7 bits
+        // NOTE: 7-bit can be 127 at max, but the # of pixels counts from 1, not 0.
+        // Therefore, the possible counts are from 1 to 128.
+        repeatCount = (header & 0x7f) + 1;
+        size = repeatCount * channelCount;
+        if(size > (std::size_t)(outEnd - outData))
+            size = outEnd - outData;        // do not write over the end of image
 
         // run-length packet mode if bit-7 is 1
         if(header & 0x80)                   // 80h = 10000000b
         {
-            // get # of colors to repeat from low 7 bits
-            // NOTE: 7-bit can be 127 at max, but the # of repeats counts from 1, not 0.
-            // Therefore, the possible repeat counts are from 0 to 128.
-            repeatCount = (int)header - 0x80 + 1;
-            ++encData;                      // move the pointer from header to data
+            if(encData + channelCount > endPointer)
+                return false;               // truncated data
 
-            for(int i = 0; i < repeatCount; ++i)
+            if(channelCount == 1)
+            {
+                memset(outData, *encData, size);
+            }
+            else
             {
-                memcpy(outData, encData, channelCount);
-                outData += channelCount;   // next
+                // fill pattern with the colour, then copy it with wide stores
+                for(std::size_t i = 0; i < PATTERN_SIZE; i += channelCount)
+                    memcpy(pattern + i, encData, channelCount);
+
+                std::size_t i = 0;
+                for(; i + PATTERN_SIZE <= size; i += PATTERN_SIZE)
+                    memcpy(outData + i, pattern, PATTERN_SIZE);
+                memcpy(outData + i, pattern, size - i);
             }
+            outData += size;
 
             // move to next header
             encData += channelCount;
@@ -456,17 +609,13 @@ bool Tga::decodeRLE(const unsigned char *encData, unsigned char *outData, std::s
         // raw packet mode if bit-7 is 0
         else
         {
-            // get the # of raw pixels
-            // Again, the # of values are 1 more than actual value, because it always starts 1, not 0.
-            repeatCount = header + 1;
-            ++encData;                      // move from header to data
+            if(size > (std::size_t)(endPointer - encData))
+                return false;               // truncated data
 
-            for(int i = 0; i < repeatCount; ++i)
-            {
-                memcpy(outData, encData, channelCount);
-                outData += channelCount;   // next
-                encData += channelCount;   // next
-            }
+            // copy all raw pixels at once
+            memcpy(outData, encData, size);
+            outData += size;
+            encData += repeatCount * channelCount;
         }
     }
 
@@ -478,50 +627,20 @@ bool Tga::decodeRLE(const unsigned char *encData, unsigned char *outData, std::s
 ///////////////////////////////////////////////////////////////////////////////
 // Tga is bottom-to-top orientation. Flip the image vertically, so the image
 // can be rendered from top to bottom orientation
+// It uses the SIMD kernel in pixelUtils, swapping scanlines in place.
 ///////////////////////////////////////////////////////////////////////////////
 void Tga::flipImage(unsigned char *data, int width, int height, int channelCount)
 {
-    if(!data) return;
-
-    int i;
-    int lineSize = width * channelCount;        // the number of bytes per scanline
-    unsigned char *line1 = data;                // the first scanline
-    unsigned char *line2 = data + ((height-1)*lineSize); // the last scanline
-    unsigned char tmp;
-
-    // swap line #1 and line #2
-    while(line1 < line2)
-    {
-        for(i=0; i < lineSize; ++i)
-        {
-            tmp = *line2;
-            *line2++ = *line1;
-            *line1++ = tmp;
-        }
-
-        // one scanline is done, move the pointer to scanline #2 1-line up
-        line2 -= (lineSize * 2);
-    }
+    Pixel::flipImage(data, width, height, channelCount);
 }
 
 
 
 ///////////////////////////////////////////////////////////////////////////////
 // swap the position of the 1st and 3rd color components (RGB <-> BGR)
+// It uses the SIMD kernel in pixelUtils, grayscale image is not changed.
 ///////////////////////////////////////////////////////////////////////////////
 void Tga::swapRedBlue(unsigned char *data, int dataSize, int channelCount)
 {
-    if(!data) return;
-    if(dataSize % channelCount) return;     // must be divisible by the number of channels
-
-    unsigned char tmp;
-    int i;
-
-    // swap the position of red and blue components
-    for(i=0; i < dataSize; i+=channelCount)
-    {
-        tmp = data[i];
-        data[i] = data[i+2];
-        data[i+2] = tmp;
-    }
+    Pixel::swapRedBlue(data, dataSize, channelCount);
 }
@@ -3,17 +3,18 @@
 // Targa image loader and writer
 // It reads uncompressed and RLE compressed color (24-bit and 32-bit) and 
 // grayscale image.
-// And, it saves as only uncompressed color or grayscale image.
+// And, it saves as uncompressed or RLE compressed color or grayscale image.
 //
 //  AUTHOR: Song Ho Ahn (song.ahn@gmail.com)
 // CREATED: 2006-07-17
-// UPDATED: 2013-01-23
+// UPDATED: 2026-10-18
 ///////////////////////////////////////////////////////////////////////////////
 
 #ifndef IMAGE_TGA_H
 #define IMAGE_TGA_H
 
 #include <string>
+#include <vector>
 
 namespace Image
 {
@@ -32,7 +33,8 @@ namespace Image
 
         // save an image as TGA format
         // It assumes the color order of input image is RGB, so it will convert to BGR order before save
-        static bool save(const char* fileName, int width, int height, int channelCount, const unsigned char* data);
+        // If rle is true, the image is RLE compressed on multiple threads
+        static bool save(const char* fileName, int width, int height, int channelCount, const unsigned char* data, bool rle=false);
 
         // getters
         int getWidth() const;                       // return width of image in pixel
@@ -54,7 +56,9 @@ namespace Image
         void init();                                // clear the existing values
 
         // shared functions (only 1 copy of the function, even if there are multiple instances of this class)
-        static bool decodeRLE(const unsigned char *encData, unsigned char *data, std::size_t encSize, int channelCount); // decode TGA RLE to uncompressed
+        static bool decodeRLE(const unsigned char *encData, std::size_t encSize, unsigned char *data, std::size_t dataSize, int channelCount); // decode TGA RLE to uncompressed
+        static std::size_t encodeRLE(const unsigned char *data, int pixelCount, int channelCount, unsigned char *encData); // encode a scanline to TGA RLE
+        static void encodeBand(const unsigned char *src, int width, int lineCount, int channelCount, bool rle, std::vector<unsigned char>& buffer);
         static void flipImage(unsigned char *data, int width, int height, int channelCount);    // flip the vertical orientation
         static void swapRedBlue(unsigned char *data, int dataSize, int channelCount);           // swap the position of red and blue components
 
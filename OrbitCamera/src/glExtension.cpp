@@ -6,7 +6,7 @@
 //
 //  AUTHOR: Song Ho Ahn (song.ahn@gmail.com)
 // CREATED: 2013-03-05
-// UPDATED: 2017-11-07
+// UPDATED: 2026-10-18
 ///////////////////////////////////////////////////////////////////////////////
 
 #include <iostream>
@@ -103,6 +103,20 @@ PFNGLWAITSYNCPROC           pglWaitSync = 0;
 PFNGLGETINTEGER64VPROC      pglGetInteger64v = 0;
 PFNGLGETSYNCIVPROC          pglGetSynciv = 0;
 
+// GL_ARB_timer_query
+PFNGLGENQUERIESPROC             pglGenQueries = 0;
+PFNGLDELETEQUERIESPROC          pglDeleteQueries = 0;
+PFNGLBEGINQUERYPROC             pglBeginQuery = 0;
+PFNGLENDQUERYPROC               pglEndQuery = 0;
+PFNGLGETQUERYOBJECTIVPROC       pglGetQueryObjectiv = 0;
+PFNGLQUERYCOUNTERPROC           pglQueryCounter = 0;          // GL_TIMESTAMP
+PFNGLGETQUERYOBJECTUI64VPROC    pglGetQueryObjectui64v = 0;   // 64-bit result in ns
+
+// GL_ARB_texture_compression
+PFNGLCOMPRESSEDTEXIMAGE2DARBPROC    pglCompressedTexImage2DARB = 0;
+PFNGLCOMPRESSEDTEXSUBIMAGE2DARBPROC pglCompressedTexSubImage2DARB = 0;
+PFNGLGETCOMPRESSEDTEXIMAGEARBPROC   pglGetCompressedTexImageARB = 0;
+
 // GL_ARB_vertex_shader and GL_ARB_fragment_shader extensions
 PFNGLBINDATTRIBLOCATIONARBPROC  pglBindAttribLocationARB = 0;       // bind vertex attrib var with index
 PFNGLGETACTIVEATTRIBARBPROC     pglGetActiveAttribARB = 0;          // get attrib value
@@ -422,6 +436,22 @@ void glExtension::getFunctionPointers()
             glGetInteger64v     = (PFNGLGETINTEGER64VPROC)wglGetProcAddress("glGetInteger64v");
             glGetSynciv         = (PFNGLGETSYNCIVPROC)wglGetProcAddress("glGetSynciv");
         }
+        else if(extensions[i] == "GL_ARB_timer_query")
+        {
+            glGenQueries            = (PFNGLGENQUERIESPROC)wglGetProcAddress("glGenQueries");
+            glDeleteQueries         = (PFNGLDELETEQUERIESPROC)wglGetProcAddress("glDeleteQueries");
+            glBeginQuery            = (PFNGLBEGINQUERYPROC)wglGetProcAddress("glBeginQuery");
+            glEndQuery              = (PFNGLENDQUERYPROC)wglGetProcAddress("glEndQuery");
+            glGetQueryObjectiv      = (PFNGLGETQUERYOBJECTIVPROC)wglGetProcAddress("glGetQueryObjectiv");
+            glQueryCounter          = (PFNGLQUERYCOUNTERPROC)wglGetProcAddress("glQueryCounter");
+            glGetQueryObjectui64v   = (PFNGLGETQUERYOBJECTUI64VPROC)wglGetProcAddress("glGetQueryObjectui64v");
+        }
+        else if(extensions[i] == "GL_ARB_texture_compression")
+        {
+            glCompressedTexImage2DARB       = (PFNGLCOMPRESSEDTEXIMAGE2DARBPROC)wglGetProcAddress("glCompressedTexImage2DARB");
+            glCompressedTexSubImage2DARB    = (PFNGLCOMPRESSEDTEXSUBIMAGE2DARBPROC)wglGetProcAddress("glCompressedTexSubImage2DARB");
+            glGetCompressedTexImageARB      = (PFNGLGETCOMPRESSEDTEXIMAGEARBPROC)wglGetProcAddress("glGetCompressedTexImageARB");
+        }
         else if(extensions[i] == "GL_ARB_vertex_shader") // also GL_ARB_fragment_shader
         {
             glBindAttribLocationARB = (PFNGLBINDATTRIBLOCATIONARBPROC)wglGetProcAddress("glBindAttribLocationARB");
@@ -6,7 +6,7 @@
 //
 //  AUTHOR: Song Ho Ahn (song.ahn@gmail.com)
 // CREATED: 2013-03-05
-// UPDATED: 2017-11-07
+// UPDATED: 2026-10-18
 ///////////////////////////////////////////////////////////////////////////////
 
 #ifndef GL_EXTENSION_H
@@ -219,6 +219,30 @@ extern PFNGLGETSYNCIVPROC       pglGetSynciv;
 #define glGetInteger64v         pglGetInteger64v
 #define glGetSynciv             pglGetSynciv
 
+// GL_ARB_timer_query (v3.3 core), query objects are v1.5 core
+extern PFNGLGENQUERIESPROC          pglGenQueries;
+extern PFNGLDELETEQUERIESPROC       pglDeleteQueries;
+extern PFNGLBEGINQUERYPROC          pglBeginQuery;
+extern PFNGLENDQUERYPROC            pglEndQuery;
+extern PFNGLGETQUERYOBJECTIVPROC    pglGetQueryObjectiv;
+extern PFNGLQUERYCOUNTERPROC        pglQueryCounter;
+extern PFNGLGETQUERYOBJECTUI64VPROC pglGetQueryObjectui64v;
+#define glGenQueries                pglGenQueries
+#define glDeleteQueries             pglDeleteQueries
+#define glBeginQuery                pglBeginQuery
+#define glEndQuery                  pglEndQuery
+#define glGetQueryObjectiv          pglGetQueryObjectiv
+#define glQueryCounter              pglQueryCounter
+#define glGetQueryObjectui64v       pglGetQueryObjectui64v
+
+// GL_ARB_texture_compression
+extern PFNGLCOMPRESSEDTEXIMAGE2DARBPROC     pglCompressedTexImage2DARB;
+extern PFNGLCOMPRESSEDTEXSUBIMAGE2DARBPROC  pglCompressedTexSubImage2DARB;
+extern PFNGLGETCOMPRESSEDTEXIMAGEARBPROC    pglGetCompressedTexImageARB;
+#define glCompressedTexImage2DARB           pglCompressedTexImage2DARB
+#define glCompressedTexSubImage2DARB        pglCompressedTexSubImage2DARB
+#define glGetCompressedTexImageARB          pglGetCompressedTexImageARB
+
 // GL_ARB_vertex_shader and GL_ARB_fragment_shader extensions
 extern PFNGLBINDATTRIBLOCATIONARBPROC   pglBindAttribLocationARB;   // bind vertex attrib var with index
 extern PFNGLGETACTIVEATTRIBARBPROC      pglGetActiveAttribARB;      // get attrib value
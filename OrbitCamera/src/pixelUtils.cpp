@@ -0,0 +1,753 @@
+///////////////////////////////////////////////////////////////////////////////
+// pixelUtils.cpp
+// ==============
+// SIMD pixel kernels shared by image codecs (Tga, Bmp) and other samples
+// The fastest kernel for the running CPU (AVX2, SSSE3, SSE2 or plain C++) is
+// selected at run-time with CPUID, so the same binary runs on any x86 CPU.
+// On non-x86 platforms, only the plain C++ kernels are compiled.
+//
+//  AUTHOR: Song Ho Ahn (song.ahn@gmail.com)
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cstring>                      // for memcpy(), memcmp()
+#include "pixelUtils.h"
+
+#ifdef PIXEL_X86
+#if defined(_MSC_VER)
+#include <intrin.h>                     // for __cpuid(), _xgetbv()
+#else
+#include <cpuid.h>                      // for __cpuid_count()
+#endif
+#include <immintrin.h>
+#endif
+
+
+
+namespace Pixel
+{
+///////////////////////////////////////////////////////////////////////////////
+// CPU feature detection
+///////////////////////////////////////////////////////////////////////////////
+#ifdef PIXEL_X86
+static void cpuid(int leaf, int sub, unsigned int regs[4])
+{
+#if defined(_MSC_VER)
+    int r[4];
+    __cpuidex(r, leaf, sub);
+    regs[0] = r[0]; regs[1] = r[1]; regs[2] = r[2]; regs[3] = r[3];
+#else
+    __cpuid_count(leaf, sub, regs[0], regs[1], regs[2], regs[3]);
+#endif
+}
+
+// read XCR0 to check OS saves YMM registers on context switch
+static unsigned long long xgetbv0()
+{
+#if defined(_MSC_VER)
+    return _xgetbv(0);
+#else
+    unsigned int eax, edx;
+    __asm__ __volatile__("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return ((unsigned long long)edx << 32) | eax;
+#endif
+}
+#endif
+
+static SimdLevel detectSimdLevel()
+{
+    SimdLevel level = SIMD_NONE;
+#ifdef PIXEL_X86
+    unsigned int regs[4];
+    cpuid(0, 0, regs);
+    unsigned int maxLeaf = regs[0];
+
+    cpuid(1, 0, regs);
+    bool sse2  = (regs[3] & (1u << 26)) != 0;   // EDX bit 26
+    bool ssse3 = (regs[2] & (1u << 9)) != 0;    // ECX bit 9
+    bool osxsave = (regs[2] & (1u << 27)) != 0; // ECX bit 27
+    bool avx   = (regs[2] & (1u << 28)) != 0;   // ECX bit 28
+
+    if(sse2)
+        level = SIMD_SSE2;
+    if(sse2 && ssse3)
+        level = SIMD_SSSE3;
+
+    // AVX2 needs both CPU (leaf 7) and OS support (XMM and YMM states enabled)
+    if(level == SIMD_SSSE3 && avx && osxsave && maxLeaf >= 7)
+    {
+        if((xgetbv0() & 0x6) == 0x6)
+        {
+            cpuid(7, 0, regs);
+            if(regs[1] & (1u << 5))             // EBX bit 5
+                level = SIMD_AVX2;
+        }
+    }
+#endif
+    return level;
+}
+
+SimdLevel getMaxSimdLevel()
+{
+    static const SimdLevel maxLevel = detectSimdLevel();   // detect only once
+    return maxLevel;
+}
+
+static int currentLevel = -1;           // -1 means not selected yet
+
+SimdLevel getSimdLevel()
+{
+    if(currentLevel < 0)
+        currentLevel = getMaxSimdLevel();
+    return (SimdLevel)currentLevel;
+}
+
+void setSimdLevel(SimdLevel level)
+{
+    SimdLevel maxLevel = getMaxSimdLevel();
+    currentLevel = (level > maxLevel) ? maxLevel : level;
+}
+
+const char* getSimdLevelName(SimdLevel level)
+{
+    switch(level)
+    {
+    case SIMD_SSE2:  return "SSE2";
+    case SIMD_SSSE3: return "SSSE3";
+    case SIMD_AVX2:  return "AVX2";
+    default:         return "None";
+    }
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// plain C++ kernels
+///////////////////////////////////////////////////////////////////////////////
+static void swapRedBlue3(unsigned char* data, std::size_t count)
+{
+    unsigned char tmp;
+    for(std::size_t i = 0; i < count; ++i, data += 3)
+    {
+        tmp = data[0];
+        data[0] = data[2];
+        data[2] = tmp;
+    }
+}
+
+static void swapRedBlue4(unsigned char* data, std::size_t count)
+{
+    // swap as 32-bit words; byte 0 <-> byte 2 in little-endian
+    unsigned int p;
+    for(std::size_t i = 0; i < count; ++i, data += 4)
+    {
+        memcpy(&p, data, 4);
+        p = (p & 0xff00ff00) | ((p >> 16) & 0xff) | ((p & 0xff) << 16);
+        memcpy(data, &p, 4);
+    }
+}
+
+static void swapLines(unsigned char* line1, unsigned char* line2, std::size_t size)
+{
+    unsigned long long a, b;
+    std::size_t i = 0;
+    for(; i + 8 <= size; i += 8)
+    {
+        memcpy(&a, line1 + i, 8);
+        memcpy(&b, line2 + i, 8);
+        memcpy(line1 + i, &b, 8);
+        memcpy(line2 + i, &a, 8);
+    }
+    unsigned char tmp;
+    for(; i < size; ++i)
+    {
+        tmp = line1[i];
+        line1[i] = line2[i];
+        line2[i] = tmp;
+    }
+}
+
+static void fillPixels4(unsigned char* dst, std::size_t count, unsigned int value)
+{
+    for(std::size_t i = 0; i < count; ++i, dst += 4)
+        memcpy(dst, &value, 4);
+}
+
+// shift must be in [-255, 255]
+// a lookup table replaces the add and 2 compares per component
+static void addBrightness4(const unsigned char* src, unsigned char* dst, std::size_t count, int shift)
+{
+    if(count == 0) return;
+
+    unsigned char table[256];
+    for(int i = 0; i < 256; ++i)
+    {
+        int value = i + shift;
+        table[i] = (unsigned char)(value < 0 ? 0 : (value > 255 ? 255 : value));
+    }
+    for(std::size_t i = 0; i < count; ++i, src += 4, dst += 4)
+    {
+        dst[0] = table[src[0]];
+        dst[1] = table[src[1]];
+        dst[2] = table[src[2]];
+        dst[3] = src[3];
+    }
+}
+
+
+
+#ifdef PIXEL_X86
+///////////////////////////////////////////////////////////////////////////////
+// SSE2 kernels
+///////////////////////////////////////////////////////////////////////////////
+PIXEL_TARGET("sse2")
+static std::size_t swapRedBlue4SSE2(unsigned char* data, std::size_t count)
+{
+    // no byte shuffle in SSE2, use the same shift/mask trick as plain C++
+    const __m128i maskAG = _mm_set1_epi32((int)0xff00ff00);
+    const __m128i maskB  = _mm_set1_epi32(0x000000ff);
+    std::size_t i = 0;
+    for(; i + 4 <= count; i += 4, data += 16)
+    {
+        __m128i p = _mm_loadu_si128((const __m128i*)data);
+        __m128i ag = _mm_and_si128(p, maskAG);
+        __m128i r = _mm_and_si128(_mm_srli_epi32(p, 16), maskB);
+        __m128i b = _mm_slli_epi32(_mm_and_si128(p, maskB), 16);
+        _mm_storeu_si128((__m128i*)data, _mm_or_si128(ag, _mm_or_si128(r, b)));
+    }
+    return i;                           // # of processed pixels
+}
+
+PIXEL_TARGET("sse2")
+static std::size_t swapLinesSSE2(unsigned char* line1, unsigned char* line2, std::size_t size)
+{
+    std::size_t i = 0;
+    for(; i + 32 <= size; i += 32)
+    {
+        __m128i a0 = _mm_loadu_si128((const __m128i*)(line1 + i));
+        __m128i a1 = _mm_loadu_si128((const __m128i*)(line1 + i + 16));
+        __m128i b0 = _mm_loadu_si128((const __m128i*)(line2 + i));
+        __m128i b1 = _mm_loadu_si128((const __m128i*)(line2 + i + 16));
+        _mm_storeu_si128((__m128i*)(line1 + i), b0);
+        _mm_storeu_si128((__m128i*)(line1 + i + 16), b1);
+        _mm_storeu_si128((__m128i*)(line2 + i), a0);
+        _mm_storeu_si128((__m128i*)(line2 + i + 16), a1);
+    }
+    return i;                           // # of processed bytes
+}
+
+// saturating add/subtract of 8-bit values, 0 for alpha keeps it unchanged
+PIXEL_TARGET("sse2")
+static std::size_t addBrightness4SSE2(const unsigned char* src, unsigned char* dst, std::size_t count, int shift)
+{
+    int amount = (shift < 0) ? -shift : shift;
+    const __m128i value = _mm_set1_epi32(amount * 0x010101);
+    std::size_t i = 0;
+    if(shift >= 0)
+    {
+        for(; i + 4 <= count; i += 4, src += 16, dst += 16)
+        {
+            __m128i p = _mm_loadu_si128((const __m128i*)src);
+            _mm_storeu_si128((__m128i*)dst, _mm_adds_epu8(p, value));
+        }
+    }
+    else
+    {
+        for(; i + 4 <= count; i += 4, src += 16, dst += 16)
+        {
+            __m128i p = _mm_loadu_si128((const __m128i*)src);
+            _mm_storeu_si128((__m128i*)dst, _mm_subs_epu8(p, value));
+        }
+    }
+    return i;                           // # of processed pixels
+}
+
+// store a cache line (64 bytes) per iteration, dst must be 16-byte aligned
+// for the streaming stores
+PIXEL_TARGET("sse2")
+static std::size_t fillPixels4SSE2(unsigned char* dst, std::size_t count, unsigned int value, bool nonTemporal)
+{
+    const __m128i p = _mm_set1_epi32((int)value);
+    std::size_t i = 0;
+    if(nonTemporal)
+    {
+        for(; i + 16 <= count; i += 16, dst += 64)
+        {
+            _mm_stream_si128((__m128i*)dst, p);
+            _mm_stream_si128((__m128i*)(dst + 16), p);
+            _mm_stream_si128((__m128i*)(dst + 32), p);
+            _mm_stream_si128((__m128i*)(dst + 48), p);
+        }
+    }
+    else
+    {
+        for(; i + 16 <= count; i += 16, dst += 64)
+        {
+            _mm_storeu_si128((__m128i*)dst, p);
+            _mm_storeu_si128((__m128i*)(dst + 16), p);
+            _mm_storeu_si128((__m128i*)(dst + 32), p);
+            _mm_storeu_si128((__m128i*)(dst + 48), p);
+        }
+    }
+    return i;                           // # of processed pixels
+}
+
+PIXEL_TARGET("sse2")
+static std::size_t copyStreamSSE2(unsigned char* dst, const unsigned char* src, std::size_t size)
+{
+    std::size_t i = 0;
+    for(; i + 64 <= size; i += 64)
+    {
+        __m128i a0 = _mm_loadu_si128((const __m128i*)(src + i));
+        __m128i a1 = _mm_loadu_si128((const __m128i*)(src + i + 16));
+        __m128i a2 = _mm_loadu_si128((const __m128i*)(src + i + 32));
+        __m128i a3 = _mm_loadu_si128((const __m128i*)(src + i + 48));
+        _mm_stream_si128((__m128i*)(dst + i), a0);
+        _mm_stream_si128((__m128i*)(dst + i + 16), a1);
+        _mm_stream_si128((__m128i*)(dst + i + 32), a2);
+        _mm_stream_si128((__m128i*)(dst + i + 48), a3);
+    }
+    return i;                           // # of processed bytes
+}
+
+// stop at the first different block, the caller compares the rest
+PIXEL_TARGET("sse2")
+static std::size_t isEqualSSE2(const unsigned char* data1, const unsigned char* data2, std::size_t size)
+{
+    std::size_t i = 0;
+    for(; i + 32 <= size; i += 32)
+    {
+        __m128i e0 = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(data1 + i)),
+                                    _mm_loadu_si128((const __m128i*)(data2 + i)));
+        __m128i e1 = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(data1 + i + 16)),
+                                    _mm_loadu_si128((const __m128i*)(data2 + i + 16)));
+        if(_mm_movemask_epi8(_mm_and_si128(e0, e1)) != 0xffff)
+            break;
+    }
+    return i;                           // # of equal bytes
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// SSSE3 kernels
+///////////////////////////////////////////////////////////////////////////////
+// 16 RGB pixels (48 bytes) are loaded into 3 registers, and each output
+// register is merged from 2 or 3 shuffled inputs; -1 clears the byte
+#define PIXEL_SWAP3_MASKS \
+    const __m128i m00 = _mm_setr_epi8( 2, 1, 0, 5, 4, 3, 8, 7, 6,11,10, 9,14,13,12,-1); \
+    const __m128i m01 = _mm_setr_epi8(-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1, 1); \
+    const __m128i m10 = _mm_setr_epi8(-1,15,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1); \
+    const __m128i m11 = _mm_setr_epi8( 0,-1, 4, 3, 2, 7, 6, 5,10, 9, 8,13,12,11,-1,15); \
+    const __m128i m12 = _mm_setr_epi8(-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1, 0,-1); \
+    const __m128i m21 = _mm_setr_epi8(14,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1); \
+    const __m128i m22 = _mm_setr_epi8(-1, 3, 2, 1, 6, 5, 4, 9, 8, 7,12,11,10,15,14,13)
+
+PIXEL_TARGET("ssse3")
+static std::size_t swapRedBlue3SSSE3(unsigned char* data, std::size_t count)
+{
+    PIXEL_SWAP3_MASKS;
+    std::size_t i = 0;
+    for(; i + 16 <= count; i += 16, data += 48)
+    {
+        __m128i a = _mm_loadu_si128((const __m128i*)data);
+        __m128i b = _mm_loadu_si128((const __m128i*)(data + 16));
+        __m128i c = _mm_loadu_si128((const __m128i*)(data + 32));
+        __m128i o0 = _mm_or_si128(_mm_shuffle_epi8(a, m00), _mm_shuffle_epi8(b, m01));
+        __m128i o1 = _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(a, m10), _mm_shuffle_epi8(b, m11)),
+                                  _mm_shuffle_epi8(c, m12));
+        __m128i o2 = _mm_or_si128(_mm_shuffle_epi8(b, m21), _mm_shuffle_epi8(c, m22));
+        _mm_storeu_si128((__m128i*)data, o0);
+        _mm_storeu_si128((__m128i*)(data + 16), o1);
+        _mm_storeu_si128((__m128i*)(data + 32), o2);
+    }
+    return i;                           // # of processed pixels
+}
+
+PIXEL_TARGET("ssse3")
+static std::size_t swapRedBlue4SSSE3(unsigned char* data, std::size_t count)
+{
+    const __m128i mask = _mm_setr_epi8(2,1,0,3, 6,5,4,7, 10,9,8,11, 14,13,12,15);
+    std::size_t i = 0;
+    for(; i + 4 <= count; i += 4, data += 16)
+    {
+        __m128i p = _mm_loadu_si128((const __m128i*)data);
+        _mm_storeu_si128((__m128i*)data, _mm_shuffle_epi8(p, mask));
+    }
+    return i;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// AVX2 kernels
+///////////////////////////////////////////////////////////////////////////////
+PIXEL_TARGET("avx2")
+static std::size_t swapRedBlue3AVX2(unsigned char* data, std::size_t count)
+{
+    // vpshufb works within 128-bit lanes, so 96 bytes are regrouped into 2
+    // independent 48-byte blocks, one per lane, then the SSSE3 masks are used
+    PIXEL_SWAP3_MASKS;
+    const __m256i n00 = _mm256_broadcastsi128_si256(m00);
+    const __m256i n01 = _mm256_broadcastsi128_si256(m01);
+    const __m256i n10 = _mm256_broadcastsi128_si256(m10);
+    const __m256i n11 = _mm256_broadcastsi128_si256(m11);
+    const __m256i n12 = _mm256_broadcastsi128_si256(m12);
+    const __m256i n21 = _mm256_broadcastsi128_si256(m21);
+    const __m256i n22 = _mm256_broadcastsi128_si256(m22);
+    std::size_t i = 0;
+    for(; i + 32 <= count; i += 32, data += 96)
+    {
+        __m256i p0 = _mm256_loadu_si256((const __m256i*)data);          // 0-15 | 16-31
+        __m256i p1 = _mm256_loadu_si256((const __m256i*)(data + 32));   // 32-47 | 48-63
+        __m256i p2 = _mm256_loadu_si256((const __m256i*)(data + 64));   // 64-79 | 80-95
+        __m256i a = _mm256_permute2x128_si256(p0, p1, 0x30);            // 0-15 | 48-63
+        __m256i b = _mm256_permute2x128_si256(p0, p2, 0x21);            // 16-31 | 64-79
+        __m256i c = _mm256_permute2x128_si256(p1, p2, 0x30);            // 32-47 | 80-95
+        __m256i o0 = _mm256_or_si256(_mm256_shuffle_epi8(a, n00), _mm256_shuffle_epi8(b, n01));
+        __m256i o1 = _mm256_or_si256(_mm256_or_si256(_mm256_shuffle_epi8(a, n10), _mm256_shuffle_epi8(b, n11)),
+                                     _mm256_shuffle_epi8(c, n12));
+        __m256i o2 = _mm256_or_si256(_mm256_shuffle_epi8(b, n21), _mm256_shuffle_epi8(c, n22));
+        _mm256_storeu_si256((__m256i*)data, _mm256_permute2x128_si256(o0, o1, 0x20));
+        _mm256_storeu_si256((__m256i*)(data + 32), _mm256_permute2x128_si256(o2, o0, 0x30));
+        _mm256_storeu_si256((__m256i*)(data + 64), _mm256_permute2x128_si256(o1, o2, 0x31));
+    }
+    return i;
+}
+
+PIXEL_TARGET("avx2")
+static std::size_t swapRedBlue4AVX2(unsigned char* data, std::size_t count)
+{
+    const __m256i mask = _mm256_setr_epi8(2,1,0,3, 6,5,4,7, 10,9,8,11, 14,13,12,15,
+                                          2,1,0,3, 6,5,4,7, 10,9,8,11, 14,13,12,15);
+    std::size_t i = 0;
+    for(; i + 16 <= count; i += 16, data += 64)
+    {
+        __m256i p0 = _mm256_loadu_si256((const __m256i*)data);
+        __m256i p1 = _mm256_loadu_si256((const __m256i*)(data + 32));
+        _mm256_storeu_si256((__m256i*)data, _mm256_shuffle_epi8(p0, mask));
+        _mm256_storeu_si256((__m256i*)(data + 32), _mm256_shuffle_epi8(p1, mask));
+    }
+    for(; i + 8 <= count; i += 8, data += 32)
+    {
+        __m256i p = _mm256_loadu_si256((const __m256i*)data);
+        _mm256_storeu_si256((__m256i*)data, _mm256_shuffle_epi8(p, mask));
+    }
+    return i;
+}
+
+PIXEL_TARGET("avx2")
+static std::size_t swapLinesAVX2(unsigned char* line1, unsigned char* line2, std::size_t size)
+{
+    std::size_t i = 0;
+    for(; i + 64 <= size; i += 64)
+    {
+        __m256i a0 = _mm256_loadu_si256((const __m256i*)(line1 + i));
+        __m256i a1 = _mm256_loadu_si256((const __m256i*)(line1 + i + 32));
+        __m256i b0 = _mm256_loadu_si256((const __m256i*)(line2 + i));
+        __m256i b1 = _mm256_loadu_si256((const __m256i*)(line2 + i + 32));
+        _mm256_storeu_si256((__m256i*)(line1 + i), b0);
+        _mm256_storeu_si256((__m256i*)(line1 + i + 32), b1);
+        _mm256_storeu_si256((__m256i*)(line2 + i), a0);
+        _mm256_storeu_si256((__m256i*)(line2 + i + 32), a1);
+    }
+    return i;
+}
+
+PIXEL_TARGET("avx2")
+static std::size_t addBrightness4AVX2(const unsigned char* src, unsigned char* dst, std::size_t count, int shift)
+{
+    // 2 registers (16 pixels) per iteration to hide the latency of loads
+    int amount = (shift < 0) ? -shift : shift;
+    const __m256i value = _mm256_set1_epi32(amount * 0x010101);
+    std::size_t i = 0;
+    if(shift >= 0)
+    {
+        for(; i + 16 <= count; i += 16, src += 64, dst += 64)
+        {
+            __m256i p0 = _mm256_loadu_si256((const __m256i*)src);
+            __m256i p1 = _mm256_loadu_si256((const __m256i*)(src + 32));
+            _mm256_storeu_si256((__m256i*)dst, _mm256_adds_epu8(p0, value));
+            _mm256_storeu_si256((__m256i*)(dst + 32), _mm256_adds_epu8(p1, value));
+        }
+    }
+    else
+    {
+        for(; i + 16 <= count; i += 16, src += 64, dst += 64)
+        {
+            __m256i p0 = _mm256_loadu_si256((const __m256i*)src);
+            __m256i p1 = _mm256_loadu_si256((const __m256i*)(src + 32));
+            _mm256_storeu_si256((__m256i*)dst, _mm256_subs_epu8(p0, value));
+            _mm256_storeu_si256((__m256i*)(dst + 32), _mm256_subs_epu8(p1, value));
+        }
+    }
+    return i;
+}
+
+PIXEL_TARGET("avx2")
+static std::size_t isEqualAVX2(const unsigned char* data1, const unsigned char* data2, std::size_t size)
+{
+    std::size_t i = 0;
+    for(; i + 64 <= size; i += 64)
+    {
+        __m256i e0 = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(data1 + i)),
+                                       _mm256_loadu_si256((const __m256i*)(data2 + i)));
+        __m256i e1 = _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i*)(data1 + i + 32)),
+                                       _mm256_loadu_si256((const __m256i*)(data2 + i + 32)));
+        if(_mm256_movemask_epi8(_mm256_and_si256(e0, e1)) != -1)
+            break;
+    }
+    return i;                           // # of equal bytes
+}
+
+// dst must be 32-byte aligned for the streaming stores
+PIXEL_TARGET("avx2")
+static std::size_t fillPixels4AVX2(unsigned char* dst, std::size_t count, unsigned int value, bool nonTemporal)
+{
+    const __m256i p = _mm256_set1_epi32((int)value);
+    std::size_t i = 0;
+    if(nonTemporal)
+    {
+        for(; i + 16 <= count; i += 16, dst += 64)
+        {
+            _mm256_stream_si256((__m256i*)dst, p);
+            _mm256_stream_si256((__m256i*)(dst + 32), p);
+        }
+    }
+    else
+    {
+        for(; i + 16 <= count; i += 16, dst += 64)
+        {
+            _mm256_storeu_si256((__m256i*)dst, p);
+            _mm256_storeu_si256((__m256i*)(dst + 32), p);
+        }
+    }
+    return i;                           // # of processed pixels
+}
+
+PIXEL_TARGET("avx2")
+static std::size_t copyStreamAVX2(unsigned char* dst, const unsigned char* src, std::size_t size)
+{
+    std::size_t i = 0;
+    for(; i + 64 <= size; i += 64)
+    {
+        __m256i a0 = _mm256_loadu_si256((const __m256i*)(src + i));
+        __m256i a1 = _mm256_loadu_si256((const __m256i*)(src + i + 32));
+        _mm256_stream_si256((__m256i*)(dst + i), a0);
+        _mm256_stream_si256((__m256i*)(dst + i + 32), a1);
+    }
+    return i;                           // # of processed bytes
+}
+#endif // PIXEL_X86
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// swap the position of the 1st and 3rd colour components (RGB <-> BGR)
+// SIMD kernels process the bulk of pixels, and the remaining pixels at the
+// end are processed by plain C++ kernel.
+///////////////////////////////////////////////////////////////////////////////
+void swapRedBlue(unsigned char* data, std::size_t dataSize, int channelCount)
+{
+    if(!data) return;
+    if(channelCount != 3 && channelCount != 4) return;
+    if(dataSize % channelCount) return;     // must be divisible by the number of channels
+
+    std::size_t count = dataSize / channelCount;
+    std::size_t done = 0;
+    SimdLevel level = getSimdLevel();
+
+    if(channelCount == 3)
+    {
+#ifdef PIXEL_X86
+        if(level >= SIMD_AVX2)
+            done = swapRedBlue3AVX2(data, count);
+        if(level >= SIMD_SSSE3)
+            done += swapRedBlue3SSSE3(data + done * 3, count - done);
+#endif
+        swapRedBlue3(data + done * 3, count - done);
+    }
+    else
+    {
+#ifdef PIXEL_X86
+        if(level >= SIMD_AVX2)
+            done = swapRedBlue4AVX2(data, count);
+        else if(level >= SIMD_SSSE3)
+            done = swapRedBlue4SSSE3(data, count);
+        else if(level >= SIMD_SSE2)
+            done = swapRedBlue4SSE2(data, count);
+#endif
+        swapRedBlue4(data + done * 4, count - done);
+    }
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// flip the image vertically in place
+// It swaps the first and last scanlines with wide loads/stores directly, so
+// it does not need a temp scanline buffer. The scanlines are processed in
+// blocks that fit in L1 cache with very wide images.
+///////////////////////////////////////////////////////////////////////////////
+void flipImage(unsigned char* data, int width, int height, int channelCount)
+{
+    if(!data) return;
+    if(width <= 0 || height <= 1 || channelCount <= 0) return;
+
+    const std::size_t BLOCK_SIZE = 16384;       // 2 blocks (top and bottom) in 32KB L1
+    std::size_t lineSize = (std::size_t)width * channelCount;
+    unsigned char* line1 = data;                                // the first scanline
+    unsigned char* line2 = data + (std::size_t)(height - 1) * lineSize; // the last scanline
+    SimdLevel level = getSimdLevel();
+
+    while(line1 < line2)
+    {
+        for(std::size_t offset = 0; offset < lineSize; offset += BLOCK_SIZE)
+        {
+            std::size_t size = lineSize - offset;
+            if(size > BLOCK_SIZE)
+                size = BLOCK_SIZE;
+
+            unsigned char* p1 = line1 + offset;
+            unsigned char* p2 = line2 + offset;
+            std::size_t done = 0;
+#ifdef PIXEL_X86
+            if(level >= SIMD_AVX2)
+                done = swapLinesAVX2(p1, p2, size);
+            if(level >= SIMD_SSE2)
+                done += swapLinesSSE2(p1 + done, p2 + done, size - done);
+#endif
+            swapLines(p1 + done, p2 + done, size - done);
+        }
+
+        // move to the next pair of scanlines
+        line1 += lineSize;
+        line2 -= lineSize;
+    }
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// change the brightness of BGRA/RGBA pixels with saturation
+// The SIMD kernels add the shift to 16 or 32 bytes at once with unsigned
+// saturation, instead of comparing each component with 255.
+///////////////////////////////////////////////////////////////////////////////
+void addBrightness(const unsigned char* src, unsigned char* dst, std::size_t pixelCount, int shift)
+{
+    if(!src || !dst) return;
+
+    if(shift > 255) shift = 255;
+    if(shift < -255) shift = -255;
+
+    std::size_t done = 0;
+#ifdef PIXEL_X86
+    SimdLevel level = getSimdLevel();
+    if(level >= SIMD_AVX2)
+        done = addBrightness4AVX2(src, dst, pixelCount, shift);
+    if(level >= SIMD_SSE2)
+        done += addBrightness4SSE2(src + done * 4, dst + done * 4, pixelCount - done, shift);
+#endif
+    addBrightness4(src + done * 4, dst + done * 4, pixelCount - done, shift);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// compare 2 memory blocks
+// The SIMD kernels return the size of the equal blocks, and memcmp() checks
+// the rest, so a different block is found by memcmp() in a few bytes.
+///////////////////////////////////////////////////////////////////////////////
+bool isEqual(const unsigned char* data1, const unsigned char* data2, std::size_t size)
+{
+    if(!data1 || !data2) return false;
+
+    std::size_t done = 0;
+#ifdef PIXEL_X86
+    SimdLevel level = getSimdLevel();
+    if(level >= SIMD_AVX2)
+        done = isEqualAVX2(data1, data2, size);
+    else if(level >= SIMD_SSE2)
+        done = isEqualSSE2(data1, data2, size);
+#endif
+    return memcmp(data1 + done, data2 + done, size - done) == 0;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// fill 4-byte pixels with a value
+// The pixels before the aligned address are filled by plain C++, then the
+// SIMD kernel fills the aligned block, and the plain C++ fills the rest.
+// The streaming stores need a fence before the other threads or GPU use the
+// buffer.
+///////////////////////////////////////////////////////////////////////////////
+void fillPixels(unsigned char* dst, std::size_t pixelCount, unsigned int value, bool nonTemporal)
+{
+    if(!dst) return;
+
+    std::size_t done = 0;
+#ifdef PIXEL_X86
+    SimdLevel level = getSimdLevel();
+    if(level >= SIMD_SSE2)
+    {
+        // align dst for the streaming stores, 4-byte aligned dst is required
+        std::size_t alignment = (level >= SIMD_AVX2) ? 32 : 16;
+        std::size_t misalign = (std::size_t)dst & (alignment - 1);
+        if(misalign & 3)
+            nonTemporal = false;
+        if(nonTemporal && misalign)
+        {
+            std::size_t head = (alignment - misalign) / 4;
+            done = (head < pixelCount) ? head : pixelCount;
+            fillPixels4(dst, done, value);
+        }
+
+        if(level >= SIMD_AVX2)
+            done += fillPixels4AVX2(dst + done * 4, pixelCount - done, value, nonTemporal);
+        else
+            done += fillPixels4SSE2(dst + done * 4, pixelCount - done, value, nonTemporal);
+        if(nonTemporal)
+            _mm_sfence();
+    }
+#endif
+    fillPixels4(dst + done * 4, pixelCount - done, value);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// copy memory, with streaming stores if nonTemporal is true
+// The source is read with normal loads. Only the destination bypasses cache.
+///////////////////////////////////////////////////////////////////////////////
+void copyPixels(unsigned char* dst, const unsigned char* src, std::size_t size, bool nonTemporal)
+{
+    if(!dst || !src) return;
+
+    std::size_t done = 0;
+#ifdef PIXEL_X86
+    SimdLevel level = getSimdLevel();
+    if(nonTemporal && level >= SIMD_SSE2)
+    {
+        std::size_t alignment = (level >= SIMD_AVX2) ? 32 : 16;
+        std::size_t misalign = (std::size_t)dst & (alignment - 1);
+        if(misalign)
+        {
+            done = alignment - misalign;
+            if(done > size)
+                done = size;
+            memcpy(dst, src, done);
+        }
+
+        if(level >= SIMD_AVX2)
+            done += copyStreamAVX2(dst + done, src + done, size - done);
+        else
+            done += copyStreamSSE2(dst + done, src + done, size - done);
+        _mm_sfence();
+    }
+#endif
+    memcpy(dst + done, src + done, size - done);    // memcpy() is fast enough for cached stores
+}
+
+} // namespace Pixel
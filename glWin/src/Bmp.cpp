@@ -3,6 +3,8 @@
 // BMP image loader
 // It reads only 8/24/32-bit uncompressed and 8-bit RLE compression format.
 //
+// 2026-10-18: Use memset()/memcpy() for runs in decodeRLE8(), fixed buffer size for RLE.
+// 2026-10-18: Use SIMD kernels in pixelUtils for flipImage() and swapRedBlue()
 // 2019-07-20: Fixed clearing memory in getColorCount()
 // 2018-08-10: Fixed dealloc memory in save()
 // 2016-11-09: Fixed errors when height < 0 in read()/save().
@@ -14,7 +16,7 @@
 //
 //  AUTHOR: Song Ho Ahn (song.ahn@gmail.com)
 // CREATED: 2006-05-08
-// UPDATED: 2019-07-20
+// UPDATED: 2026-10-18
 ///////////////////////////////////////////////////////////////////////////////
 
 #include <fstream>
@@ -22,6 +24,7 @@
 #include <cstring>                      // for memcpy()
 #include <cstdlib>                      // for abs()
 #include "Bmp.h"
+#include "pixelUtils.h"
 //using std::ifstream;
 //using std::ofstream;
 //using std::ios;
@@ -265,7 +268,8 @@ bool Bmp::read(const char* fileName)
 
     // allocate data arrays
     // add extra bytes for paddings if width is not divisible by 4
-    data = new unsigned char [dataSizeWithPaddings];
+    // RLE data is smaller than decoded data, so use the larger size
+    data = new unsigned char [(dataSizeWithPaddings > dataSize) ? dataSizeWithPaddings : dataSize];
     dataRGB = new unsigned char [dataSize];
 
 /*@@ we don't use palette for 8-bit indexed grayscale mode. Instead, we use the index value as the intensity of the pixel.
@@ -311,7 +315,7 @@ bool Bmp::read(const char* fileName)
         inFile.read((char*)encData, size);
 
         // decode RLE into image data buffer
-        decodeRLE8(encData, data);
+        decodeRLE8(encData, size, data, dataSize);
 
         // deallocate encoded data buffer after decoding
         delete [] encData;
@@ -530,9 +534,10 @@ bool Bmp::save(const char* fileName, int w, int h, int channelCount, const unsig
 ///////////////////////////////////////////////////////////////////////////////
 // decode 8-bit RLE data into uncompressed data
 // This routine needs 2 pointers: the pointer to the encoded input data and
-// the pointer to the decoded output data. The length of input array is not
-// necessary because the last 2 bytes of input data must be 00 and 01, which
-// tells the end of data. So it can stop decoding process.
+// the pointer to the decoded output data. The last 2 bytes of input data must
+// be 00 and 01, which tells the end of data. So it can stop decoding process.
+// The sizes of both arrays are also given, so a broken file cannot make it
+// read or write over the end of arrays.
 //
 // BMP uses 2-value RLE scheme: the first value contains a count of the number
 // of pixels in the run, and the second value contains the value of the pixel
@@ -562,18 +567,19 @@ bool Bmp::save(const char* fileName, int w, int h, int channelCount, const unsig
 // example, 00 02 03 04 means move the cursor 3 pixels right, and 4 pixels
 // upward. (Note that BMP is bottom-to-top orientation.)
 ///////////////////////////////////////////////////////////////////////////////
-bool Bmp::decodeRLE8(const unsigned char *encData, unsigned char *outData)
+bool Bmp::decodeRLE8(const unsigned char *encData, std::size_t encSize, unsigned char *outData, std::size_t dataSize)
 {
     // check NULL pointer
     if(!encData || !outData)
         return false;
 
+    const unsigned char* encEnd = encData + encSize;
+    unsigned char* outEnd = outData + dataSize;
     unsigned char first, second;
-    int i;
-    bool stop = false;
+    std::size_t count;
 
     // start decoding, stop when it reaches at the end of decoded data
-    while(!stop)
+    while(encData + 2 <= encEnd)
     {
         // grab 2 bytes at the current position
         first = *encData++;
@@ -581,21 +587,33 @@ bool Bmp::decodeRLE8(const unsigned char *encData, unsigned char *outData)
 
         if(first)                   // encoded run mode
         {
-            for(i=0; i < first; ++i)
-                *outData++ = second;
+            // fill the run at once, but do not write over the end of image
+            count = first;
+            if(count > (std::size_t)(outEnd - outData))
+                count = outEnd - outData;
+            memset(outData, second, count);
+            outData += count;
         }
         else
         {
             if(second == 1)         // reached the end of bitmap
-                stop = true;        // must stop decoding
+                break;              // must stop decoding
 
             else if(second == 2)    // delta mark
                 encData += 2;       // do nothing, but move the cursor 2 more bytes
 
-            else                    // unencoded run mode (second >= 3)
+            else if(second >= 3)    // unencoded run mode (second >= 3)
             {
-                for(i=0; i < second; ++i)
-                    *outData++ = *encData++;
+                count = second;
+                if(count > (std::size_t)(encEnd - encData))
+                    return false;   // truncated data
+                if(count > (std::size_t)(outEnd - outData))
+                    count = outEnd - outData;
+
+                // copy all unencoded pixels at once
+                memcpy(outData, encData, count);
+                outData += count;
+                encData += second;
 
                 if(second % 2)      // if it is odd number, then there is a padding 0. ignore it
                     encData++;
@@ -611,56 +629,23 @@ bool Bmp::decodeRLE8(const unsigned char *encData, unsigned char *outData)
 ///////////////////////////////////////////////////////////////////////////////
 // BMP is bottom-to-top orientation. Flip the image vertically, so the image
 // can be rendered from top to bottom orientation
+// It uses the SIMD kernel in pixelUtils, swapping scanlines in place.
 ///////////////////////////////////////////////////////////////////////////////
 void Bmp::flipImage(unsigned char *data, int width, int height, int channelCount)
 {
-    if(!data) return;
-
-    int lineSize = width * channelCount;
-    unsigned char* tmp = new unsigned char [lineSize];
-    int half = height / 2;
-
-    int line1 = 0;                          // first line
-    int line2 = (height - 1) * lineSize;    // last line
-
-    // scan only half of height
-    for(int i = 0; i < half; ++i)
-    {
-        // copy line by line
-        memcpy(tmp, &data[line1], lineSize);
-        memcpy(&data[line1], &data[line2], lineSize);
-        memcpy(&data[line2], tmp, lineSize);
-
-        // move to next line
-        line1 += lineSize;
-        line2 -= lineSize;
-    }
-
-    // deallocate temp arrays
-    delete [] tmp;
+    Pixel::flipImage(data, width, height, channelCount);
 }
 
 
 
 ///////////////////////////////////////////////////////////////////////////////
 // swap the position of the 1st and 3rd color components (RGB <-> BGR)
+// It uses the SIMD kernel in pixelUtils.
 ///////////////////////////////////////////////////////////////////////////////
 void Bmp::swapRedBlue(unsigned char *data, int dataSize, int channelCount)
 {
-    if(!data) return;
     if(channelCount < 3) return;            // must be 3 or 4
-    if(dataSize % channelCount) return;     // must be divisible by the number of channels
-
-    unsigned char tmp;
-    int i;
-
-    // swap the position of red and blue components
-    for(i=0; i < dataSize; i+=channelCount)
-    {
-        tmp = data[i];
-        data[i] = data[i+2];
-        data[i+2] = tmp;
-    }
+    Pixel::swapRedBlue(data, dataSize, channelCount);
 }
 
 
@@ -3,6 +3,8 @@
 // BMP image loader
 // It reads only 8/24/32-bit uncompressed and 8-bit RLE compression format.
 //
+// 2026-10-18: Use memset()/memcpy() for runs in decodeRLE8(), fixed buffer size for RLE.
+// 2026-10-18: Use SIMD kernels in pixelUtils for flipImage() and swapRedBlue()
 // 2019-07-20: Fixed clearing memory in getColorCount()
 // 2018-08-10: Fixed dealloc memory in save()
 // 2016-11-09: Fixed errors when height < 0 in read()/save().
@@ -14,7 +16,7 @@
 //
 //  AUTHOR: Song Ho Ahn (song.ahn@gmail.com)
 // CREATED: 2006-05-08
-// UPDATED: 2019-07-20
+// UPDATED: 2026-10-18
 ///////////////////////////////////////////////////////////////////////////////
 
 #ifndef IMAGE_BMP_H
@@ -60,7 +62,7 @@ namespace Image
         void init();                                // clear the existing values
 
         // shared functions (only 1 copy of the function, even if there are multiple instances of this class)
-        static bool decodeRLE8(const unsigned char *encData, unsigned char *data);              // decode BMP 8-bit RLE to uncompressed
+        static bool decodeRLE8(const unsigned char *encData, std::size_t encSize, unsigned char *data, std::size_t dataSize); // decode BMP 8-bit RLE to uncompressed
         static void flipImage(unsigned char *data, int width, int height, int channelCount);    // flip the vertical orientation
         static void swapRedBlue(unsigned char *data, int dataSize, int channelCount);           // swap the position of red and blue components
         static int  getColorCount(const unsigned char *data, int dataSize);                     // get the number of colors used in 8-bit grayscale image
@@ -10,12 +10,14 @@
 //
 //  AUTHOR: Song Ho Ahn (song.ahn@gamil.com)
 // CREATED: 2006-07-09
-// UPDATED: 2020-01-27
+// UPDATED: 2026-10-18
 ///////////////////////////////////////////////////////////////////////////////
 
+#include <cstring>                      // for memcpy()
 #include "ControllerGL.h"
 #include "resource.h"
 #include "Log.h"
+#include "pixelUtils.h"
 using namespace Win;
 
 
@@ -99,46 +101,12 @@ void ControllerGL::runThread()
     model->init();
     Win::log(L"Initialized OpenGL states.");
 
-    // load bmp and create texture
-    HBITMAP hBitmap = (HBITMAP)LoadImage(::GetModuleHandle(0), MAKEINTRESOURCE(IDB_BITMAP_EARTH),
-                                         IMAGE_BITMAP, 0, 0, LR_DEFAULTCOLOR);
-    if(hBitmap)
-    {
-        // get bitmap info
-        BITMAPINFO bitmap;
-        bitmap.bmiHeader.biSize = sizeof(BITMAPINFOHEADER);
-        ::GetDIBits(view->getDC(), hBitmap, 0, 0, 0, &bitmap, DIB_RGB_COLORS);
-        int width = bitmap.bmiHeader.biWidth;
-        int height = bitmap.bmiHeader.biHeight;         // negative means top-to-bottom orientation
-        int bitCount = bitmap.bmiHeader.biBitCount;     // bits per pixel
-        int byteCount = bitmap.bmiHeader.biSizeImage;   // # of bytes of bitmap
-
-        // get bitmap data as BGR
-        unsigned char* buffer = new unsigned char[byteCount];
-        int result = ::GetDIBits(view->getDC(), hBitmap, 0, height, buffer, &bitmap, DIB_RGB_COLORS);
-        if(result > 0)
-        {
-            // convert BGR to RGB
-            swapRedBlue(buffer, byteCount, bitCount >> 3);
-            // flip vertically
-            flipImage(buffer, width, height, bitCount >> 3);
-            Win::log(L"Loaded a bitmap: %d x %d, %d bits", width, height, bitCount);
-
-            // create texture
-            model->createTexture(width, height, bitCount, buffer);
-            Win::log(L"Created OpenGL texture object.");
-        }
-        else
-        {
-            Win::log(L"[ERROR] Failed to get bitmap data.");
-        }
-
-        delete [] buffer;
-    }
-    else
-    {
-        Win::log(L"[ERROR] Failed to load earth.bmp.");
-    }
+    // load bmp and create texture on a worker thread
+    // the texture is uploaded by ModelGL::draw() when it is decoded
+    // The mipmaps of the colour image are filtered in linear space.
+    model->setMipmapSrgb(true);
+    model->loadTexture(decodeEarthBitmap);
+    Win::log(L"Requested to load earth.bmp.");
 
     // cofigure projection matrix
     RECT rect;
@@ -154,8 +122,19 @@ void ControllerGL::runThread()
         std::this_thread::sleep_for(std::chrono::milliseconds(1));  // yield to other processes or threads
         model->draw();
         view->swapBuffers();
+
+        // report texture uploads
+        const TextureLoader& loader = model->getTextureLoader();
+        if(loader.getFrameBytes() > 0)
+        {
+            Win::log(L"Uploaded texture: %d KB/frame, %d decoding, %d uploading.",
+                     (int)(loader.getFrameBytes() >> 10), loader.getDecodeQueueSize(), loader.getUploadQueueSize());
+        }
     }
 
+    // stop texture loader and delete GL objects
+    model->quit();
+
     // close OpenGL Rendering Context (RC)
     view->closeContext(handle);
     ::wglMakeCurrent(0, 0);             // unset RC
@@ -315,55 +294,57 @@ LRESULT ControllerGL::size(int w, int h, WPARAM wParam)
 
 
 ///////////////////////////////////////////////////////////////////////////////
-// convert BGR to RGB or vice versa
+// decode the earth bitmap in resource, called by a worker thread of
+// TextureLoader, so it uses the screen DC instead of the DC of OpenGL window
 ///////////////////////////////////////////////////////////////////////////////
-void ControllerGL::swapRedBlue(unsigned char* data, int dataSize, int channelCount)
+bool ControllerGL::decodeEarthBitmap(TextureImage& image)
 {
-    if(!data) return;
-    if(channelCount < 3) return;            // must be 3 or 4
-    if(dataSize % channelCount) return;     // must be divisible by the number of channels
-
-    unsigned char tmp;
-    int i;
-
-    // swap the position of red and blue components
-    for(i=0; i < dataSize; i+=channelCount)
+    HBITMAP hBitmap = (HBITMAP)::LoadImage(::GetModuleHandle(0), MAKEINTRESOURCE(IDB_BITMAP_EARTH),
+                                           IMAGE_BITMAP, 0, 0, LR_DEFAULTCOLOR);
+    if(!hBitmap)
     {
-        tmp = data[i];
-        data[i] = data[i+2];
-        data[i+2] = tmp;
+        Win::log(L"[ERROR] Failed to load earth.bmp.");
+        return false;
     }
-}
-
-
-
-///////////////////////////////////////////////////////////////////////////////
-// flip bitmap vertically
-///////////////////////////////////////////////////////////////////////////////
-void ControllerGL::flipImage(unsigned char* data, int width, int height, int channelCount)
-{
-    if(!data) return;
 
-    int lineSize = width * channelCount;
-    unsigned char* tmp = new unsigned char [lineSize];
-    int half = height / 2;
-
-    int line1 = 0;                          // first line
-    int line2 = (height - 1) * lineSize;    // last line
-
-    // scan only half of height
-    for(int i = 0; i < half; ++i)
+    // get bitmap info
+    HDC hdc = ::GetDC(0);
+    BITMAPINFO bitmap;
+    memset(&bitmap, 0, sizeof(bitmap));
+    bitmap.bmiHeader.biSize = sizeof(BITMAPINFOHEADER);
+    ::GetDIBits(hdc, hBitmap, 0, 0, 0, &bitmap, DIB_RGB_COLORS);
+    int width = bitmap.bmiHeader.biWidth;
+    int height = bitmap.bmiHeader.biHeight;         // negative means top-to-bottom orientation
+    int bitCount = bitmap.bmiHeader.biBitCount;     // bits per pixel
+    int byteCount = bitmap.bmiHeader.biSizeImage;   // # of bytes of bitmap
+
+    // get bitmap data as BGR
+    std::vector<unsigned char> buffer(byteCount);
+    int result = ::GetDIBits(hdc, hBitmap, 0, height, &buffer[0], &bitmap, DIB_RGB_COLORS);
+    ::ReleaseDC(0, hdc);
+    ::DeleteObject(hBitmap);
+    if(result <= 0)
     {
-        // copy line by line
-        memcpy(tmp, &data[line1], lineSize);
-        memcpy(&data[line1], &data[line2], lineSize);
-        memcpy(&data[line2], tmp, lineSize);
-
-        // move to next line
-        line1 += lineSize;
-        line2 -= lineSize;
+        Win::log(L"[ERROR] Failed to get bitmap data.");
+        return false;
     }
 
-    // deallocate temp arrays
-    delete [] tmp;
+    // remove 4-byte padding of each scanline
+    int channelCount = bitCount >> 3;
+    int lineSize = width * channelCount;
+    int pitch = ((width * bitCount + 31) / 32) * 4;
+    image.width = width;
+    image.height = height;
+    image.channelCount = channelCount;
+    image.data.resize((std::size_t)lineSize * height);
+    for(int i = 0; i < height; ++i)
+        memcpy(&image.data[(std::size_t)i * lineSize], &buffer[(std::size_t)i * pitch], lineSize);
+
+    // convert BGR to RGB and flip vertically
+    if(channelCount >= 3)
+        Pixel::swapRedBlue(&image.data[0], image.data.size(), channelCount);
+    Pixel::flipImage(&image.data[0], width, height, channelCount);
+    Win::log(L"Loaded a bitmap: %d x %d, %d bits", width, height, bitCount);
+
+    return true;
 }
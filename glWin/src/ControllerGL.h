@@ -10,7 +10,7 @@
 //
 //  AUTHOR: Song Ho Ahn (song.ahn@gamil.com)
 // CREATED: 2006-07-09
-// UPDATED: 2020-01-27
+// UPDATED: 2026-10-18
 ///////////////////////////////////////////////////////////////////////////////
 
 #ifndef WIN_CONTROLLER_GL_H
@@ -48,8 +48,7 @@ namespace Win
 
     private:
         void runThread();                               // thread for OpenGL rendering
-        void swapRedBlue(unsigned char* data, int dataSize, int channelCount);
-        void flipImage(unsigned char* data, int width, int height, int channelCount);
+        static bool decodeEarthBitmap(TextureImage& image);  // for TextureLoader worker
 
         ModelGL* model;                                 //
         ViewGL* view;                                   //
@@ -0,0 +1,654 @@
+///////////////////////////////////////////////////////////////////////////////
+// Dds.cpp
+// =======
+// Block-compressed (BC1/BC3) image encoder, DDS loader and writer
+// It encodes 8-bit RGB or RGBA images including all mip levels into BC1
+// (DXT1, RGB) or BC3 (DXT5, RGBA) blocks, and reads/saves them as DDS file.
+//
+//  AUTHOR: Song Ho Ahn (song.ahn@gmail.com)
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#include <fstream>
+#include <iostream>
+#include <cstring>                      // for memcpy()
+#include <thread>
+#include "Dds.h"
+#include "Mipmap.h"
+#include "pixelUtils.h"
+
+#ifdef PIXEL_X86
+#include <immintrin.h>
+#endif
+
+using std::ifstream;
+using std::ofstream;
+using std::ios;
+using std::cout;
+using std::endl;
+using namespace Image;
+
+// constants
+static const int HEADER_SIZE = 128;                 // "DDS " + DDS_HEADER
+static const int MIN_THREAD_BLOCKS = 64 * 64;       // smaller image is encoded by a single thread
+static const unsigned int DDSD_CAPS = 0x1;
+static const unsigned int DDSD_HEIGHT = 0x2;
+static const unsigned int DDSD_WIDTH = 0x4;
+static const unsigned int DDSD_PIXELFORMAT = 0x1000;
+static const unsigned int DDSD_MIPMAPCOUNT = 0x20000;
+static const unsigned int DDSD_LINEARSIZE = 0x80000;
+static const unsigned int DDPF_FOURCC = 0x4;
+static const unsigned int DDSCAPS_COMPLEX = 0x8;
+static const unsigned int DDSCAPS_TEXTURE = 0x1000;
+static const unsigned int DDSCAPS_MIPMAP = 0x400000;
+static const unsigned int FOURCC_DXT1 = 0x31545844; // "DXT1"
+static const unsigned int FOURCC_DXT5 = 0x35545844; // "DXT5"
+
+// BC1 index of the k-th colour from colour0 to colour1
+static const unsigned int COLOR_CODES[4] = {0, 2, 3, 1};
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// little-endian 32-bit read/write
+///////////////////////////////////////////////////////////////////////////////
+static unsigned int getUint32(const unsigned char* p)
+{
+    return (unsigned int)p[0] | ((unsigned int)p[1] << 8) | ((unsigned int)p[2] << 16) | ((unsigned int)p[3] << 24);
+}
+
+static void putUint32(unsigned char* p, unsigned int value)
+{
+    p[0] = (unsigned char)value;
+    p[1] = (unsigned char)(value >> 8);
+    p[2] = (unsigned char)(value >> 16);
+    p[3] = (unsigned char)(value >> 24);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// copy a 4x4 block into 16 RGBA pixels
+// The pixels outside of the image are clamped to the edge.
+///////////////////////////////////////////////////////////////////////////////
+static void fetchBlock(const unsigned char* src, int width, int height, int channelCount,
+                       int bx, int by, unsigned char* rgba)
+{
+    int x0 = bx * 4;
+    int y0 = by * 4;
+    bool inside = (x0 + 4 <= width) && (y0 + 4 <= height);
+    for(int y = 0; y < 4; ++y)
+    {
+        int sy = (y0 + y < height) ? y0 + y : height - 1;
+        const unsigned char* row = src + (std::size_t)sy * width * channelCount;
+        unsigned char* dst = rgba + y * 16;
+        if(inside && channelCount == 4)
+        {
+            memcpy(dst, row + x0 * 4, 16);
+            continue;
+        }
+        for(int x = 0; x < 4; ++x, dst += 4)
+        {
+            int sx = (x0 + x < width) ? x0 + x : width - 1;
+            const unsigned char* p = row + sx * channelCount;
+            dst[0] = p[0];
+            dst[1] = p[1];
+            dst[2] = p[2];
+            dst[3] = (channelCount == 4) ? p[3] : 255;
+        }
+    }
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// plain C++ kernels
+///////////////////////////////////////////////////////////////////////////////
+static void findColorRange(const unsigned char* rgba, unsigned char* minColor, unsigned char* maxColor)
+{
+    minColor[0] = minColor[1] = minColor[2] = 255;
+    maxColor[0] = maxColor[1] = maxColor[2] = 0;
+    for(int i = 0; i < 16; ++i)
+    {
+        const unsigned char* p = rgba + i * 4;
+        for(int j = 0; j < 3; ++j)
+        {
+            if(p[j] < minColor[j]) minColor[j] = p[j];
+            if(p[j] > maxColor[j]) maxColor[j] = p[j];
+        }
+    }
+}
+
+// project the pixels onto the line from color0 to color1, and quantize to 4 steps
+static unsigned int findColorIndices(const unsigned char* rgba, const int* color0, const int* dir, float scale)
+{
+    unsigned int indices = 0;
+    for(int i = 0; i < 16; ++i)
+    {
+        const unsigned char* p = rgba + i * 4;
+        int t = (p[0] - color0[0]) * dir[0] + (p[1] - color0[1]) * dir[1] + (p[2] - color0[2]) * dir[2];
+        float f = t * scale + 0.5f;
+        f = (f < 0) ? 0 : (f > 3) ? 3 : f;
+        indices |= COLOR_CODES[(int)f] << (i * 2);
+    }
+    return indices;
+}
+
+
+
+#ifdef PIXEL_X86
+///////////////////////////////////////////////////////////////////////////////
+// SSE2 kernels
+// A register holds 4 RGBA pixels, so a block is 4 registers.
+///////////////////////////////////////////////////////////////////////////////
+PIXEL_TARGET("sse2")
+static void findColorRangeSSE2(const unsigned char* rgba, unsigned char* minColor, unsigned char* maxColor)
+{
+    __m128i a = _mm_loadu_si128((const __m128i*)rgba);
+    __m128i b = _mm_loadu_si128((const __m128i*)(rgba + 16));
+    __m128i c = _mm_loadu_si128((const __m128i*)(rgba + 32));
+    __m128i d = _mm_loadu_si128((const __m128i*)(rgba + 48));
+    __m128i lo = _mm_min_epu8(_mm_min_epu8(a, b), _mm_min_epu8(c, d));
+    __m128i hi = _mm_max_epu8(_mm_max_epu8(a, b), _mm_max_epu8(c, d));
+
+    // reduce 4 pixels to 1
+    lo = _mm_min_epu8(lo, _mm_shuffle_epi32(lo, _MM_SHUFFLE(1, 0, 3, 2)));
+    lo = _mm_min_epu8(lo, _mm_shuffle_epi32(lo, _MM_SHUFFLE(2, 3, 0, 1)));
+    hi = _mm_max_epu8(hi, _mm_shuffle_epi32(hi, _MM_SHUFFLE(1, 0, 3, 2)));
+    hi = _mm_max_epu8(hi, _mm_shuffle_epi32(hi, _MM_SHUFFLE(2, 3, 0, 1)));
+
+    unsigned int minValue = (unsigned int)_mm_cvtsi128_si32(lo);
+    unsigned int maxValue = (unsigned int)_mm_cvtsi128_si32(hi);
+    for(int j = 0; j < 3; ++j)
+    {
+        minColor[j] = (unsigned char)(minValue >> (j * 8));
+        maxColor[j] = (unsigned char)(maxValue >> (j * 8));
+    }
+}
+
+// pmaddwd multiplies 16-bit RGBA with the direction (alpha is 0), then the
+// partial sums (RG, BA) of each pixel are added
+PIXEL_TARGET("sse2")
+static unsigned int findColorIndicesSSE2(const unsigned char* rgba, const int* color0, const int* dir, float scale)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i origin = _mm_setr_epi16((short)color0[0], (short)color0[1], (short)color0[2], 0,
+                                          (short)color0[0], (short)color0[1], (short)color0[2], 0);
+    const __m128i axis = _mm_setr_epi16((short)dir[0], (short)dir[1], (short)dir[2], 0,
+                                        (short)dir[0], (short)dir[1], (short)dir[2], 0);
+    const __m128 scales = _mm_set1_ps(scale);
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 three = _mm_set1_ps(3.0f);
+
+    int steps[16];
+    for(int i = 0; i < 16; i += 4)
+    {
+        __m128i p = _mm_loadu_si128((const __m128i*)(rgba + i * 4));
+        __m128i p01 = _mm_madd_epi16(_mm_sub_epi16(_mm_unpacklo_epi8(p, zero), origin), axis);
+        __m128i p23 = _mm_madd_epi16(_mm_sub_epi16(_mm_unpackhi_epi8(p, zero), origin), axis);
+        __m128 rg = _mm_shuffle_ps(_mm_castsi128_ps(p01), _mm_castsi128_ps(p23), _MM_SHUFFLE(2, 0, 2, 0));
+        __m128 ba = _mm_shuffle_ps(_mm_castsi128_ps(p01), _mm_castsi128_ps(p23), _MM_SHUFFLE(3, 1, 3, 1));
+        __m128i t = _mm_add_epi32(_mm_castps_si128(rg), _mm_castps_si128(ba));
+
+        __m128 f = _mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(t), scales), half);
+        f = _mm_min_ps(_mm_max_ps(f, _mm_setzero_ps()), three);
+        _mm_storeu_si128((__m128i*)(steps + i), _mm_cvttps_epi32(f));
+    }
+
+    unsigned int indices = 0;
+    for(int i = 0; i < 16; ++i)
+        indices |= COLOR_CODES[steps[i]] << (i * 2);
+    return indices;
+}
+#endif
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// convert 8-bit RGB to RGB565, and vice versa
+///////////////////////////////////////////////////////////////////////////////
+static unsigned short packColor(const unsigned char* color)
+{
+    int r = (color[0] * 31 + 127) / 255;
+    int g = (color[1] * 63 + 127) / 255;
+    int b = (color[2] * 31 + 127) / 255;
+    return (unsigned short)((r << 11) | (g << 5) | b);
+}
+
+static void unpackColor(unsigned short c, int* color)
+{
+    int r = (c >> 11) & 31;
+    int g = (c >> 5) & 63;
+    int b = c & 31;
+    color[0] = (r << 3) | (r >> 2);
+    color[1] = (g << 2) | (g >> 4);
+    color[2] = (b << 3) | (b >> 2);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// encode the colours of 16 RGBA pixels to a 8-byte BC1 block
+// It is always 4-colour mode (color0 > color1), so it is valid for BC3 too.
+///////////////////////////////////////////////////////////////////////////////
+static void encodeColorBlock(const unsigned char* rgba, bool simd, unsigned char* dst)
+{
+    unsigned char minColor[3], maxColor[3];
+#ifdef PIXEL_X86
+    if(simd)
+        findColorRangeSSE2(rgba, minColor, maxColor);
+    else
+#endif
+        findColorRange(rgba, minColor, maxColor);
+
+    // inset the bounding box by 1/16 of the range to reduce the error of the extremes
+    int center[3];
+    for(int j = 0; j < 3; ++j)
+    {
+        int inset = (maxColor[j] - minColor[j]) >> 4;
+        minColor[j] = (unsigned char)(minColor[j] + inset);
+        maxColor[j] = (unsigned char)(maxColor[j] - inset);
+        center[j] = (minColor[j] + maxColor[j] + 1) >> 1;
+    }
+
+    // choose the diagonal of the box; flip red and blue if they are negatively correlated to green
+    int covRG = 0, covBG = 0;
+    for(int i = 0; i < 16; ++i)
+    {
+        const unsigned char* p = rgba + i * 4;
+        int g = p[1] - center[1];
+        covRG += (p[0] - center[0]) * g;
+        covBG += (p[2] - center[2]) * g;
+    }
+    if(covRG < 0)
+    {
+        unsigned char tmp = minColor[0]; minColor[0] = maxColor[0]; maxColor[0] = tmp;
+    }
+    if(covBG < 0)
+    {
+        unsigned char tmp = minColor[2]; minColor[2] = maxColor[2]; maxColor[2] = tmp;
+    }
+
+    unsigned short c0 = packColor(maxColor);
+    unsigned short c1 = packColor(minColor);
+    unsigned int indices = 0;
+    if(c0 < c1)
+    {
+        unsigned short tmp = c0; c0 = c1; c1 = tmp;
+    }
+    if(c0 != c1)
+    {
+        // find indices with the quantized endpoints
+        int color0[3], color1[3], dir[3];
+        unpackColor(c0, color0);
+        unpackColor(c1, color1);
+        for(int j = 0; j < 3; ++j)
+            dir[j] = color1[j] - color0[j];
+        float scale = 3.0f / (dir[0] * dir[0] + dir[1] * dir[1] + dir[2] * dir[2]);
+#ifdef PIXEL_X86
+        if(simd)
+            indices = findColorIndicesSSE2(rgba, color0, dir, scale);
+        else
+#endif
+            indices = findColorIndices(rgba, color0, dir, scale);
+    }
+
+    dst[0] = (unsigned char)c0;
+    dst[1] = (unsigned char)(c0 >> 8);
+    dst[2] = (unsigned char)c1;
+    dst[3] = (unsigned char)(c1 >> 8);
+    putUint32(dst + 4, indices);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// encode the alpha of 16 RGBA pixels to a 8-byte BC3 alpha block
+// It uses 8-alpha mode (alpha0 > alpha1) with 3-bit indices.
+///////////////////////////////////////////////////////////////////////////////
+static void encodeAlphaBlock(const unsigned char* rgba, unsigned char* dst)
+{
+    int minAlpha = 255, maxAlpha = 0;
+    for(int i = 0; i < 16; ++i)
+    {
+        int a = rgba[i * 4 + 3];
+        if(a < minAlpha) minAlpha = a;
+        if(a > maxAlpha) maxAlpha = a;
+    }
+
+    unsigned long long indices = 0;
+    int range = maxAlpha - minAlpha;
+    if(range > 0)
+    {
+        for(int i = 0; i < 16; ++i)
+        {
+            // k-th step from alpha0 (max) to alpha1 (min), 0 and 7 are the endpoints
+            int k = ((maxAlpha - rgba[i * 4 + 3]) * 14 + range) / (range * 2);
+            unsigned long long code = (k == 0) ? 0 : (k == 7) ? 1 : k + 1;
+            indices |= code << (i * 3);
+        }
+    }
+
+    dst[0] = (unsigned char)maxAlpha;
+    dst[1] = (unsigned char)minAlpha;
+    for(int i = 0; i < 6; ++i)
+        dst[i + 2] = (unsigned char)(indices >> (i * 8));
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// ctor/dtor
+///////////////////////////////////////////////////////////////////////////////
+Dds::Dds() : format(FORMAT_NONE), threadCount(0)
+{
+    init();
+}
+
+Dds::~Dds()
+{
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// clear out the exsiting values
+///////////////////////////////////////////////////////////////////////////////
+void Dds::init()
+{
+    format = FORMAT_NONE;
+    levels.clear();
+    buffer.clear();
+    errorMessage = "No error.";
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// print itself for debug
+///////////////////////////////////////////////////////////////////////////////
+void Dds::printSelf() const
+{
+    cout << "===== Dds =====\n"
+         << "Format: " << (format == FORMAT_BC1 ? "BC1 (DXT1)" : format == FORMAT_BC3 ? "BC3 (DXT5)" : "None") << "\n"
+         << "Width: " << (levels.empty() ? 0 : levels[0].width) << " pixels\n"
+         << "Height: " << (levels.empty() ? 0 : levels[0].height) << " pixels\n"
+         << "Levels: " << levels.size() << "\n"
+         << "Data Size: " << buffer.size() << " bytes\n"
+         << endl;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// return the compressed size of an image, 4x4 pixels per block
+///////////////////////////////////////////////////////////////////////////////
+std::size_t Dds::computeSize(int width, int height, Format format)
+{
+    std::size_t blockSize = (format == FORMAT_BC3) ? 16 : 8;
+    return (std::size_t)((width + 3) / 4) * ((height + 3) / 4) * blockSize;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// append a level at the end of buffer
+///////////////////////////////////////////////////////////////////////////////
+void Dds::addLevel(int width, int height)
+{
+    Level level;
+    level.width = width;
+    level.height = height;
+    level.offset = buffer.size();
+    level.src = 0;
+    levels.push_back(level);
+    buffer.resize(buffer.size() + computeSize(width, height, format));
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// read a DDS file with BC1 or BC3 blocks
+///////////////////////////////////////////////////////////////////////////////
+bool Dds::read(const char* fileName)
+{
+    this->init();   // clear out all values
+
+    // check NULL pointer
+    if(!fileName)
+    {
+        errorMessage = "File name is not defined (NULL pointer).";
+        return false;
+    }
+
+    // open a DDS file as binary mode
+    ifstream inFile;
+    inFile.open(fileName, ios::binary);         // binary mode
+    if(!inFile.good())
+    {
+        errorMessage = "Failed to open a DDS file to read.";
+        return false;            // exit if failed
+    }
+
+    // read the magic number and header
+    unsigned char header[HEADER_SIZE];
+    inFile.read((char*)header, HEADER_SIZE);
+    if(!inFile || memcmp(header, "DDS ", 4) != 0 || getUint32(header + 4) != 124)
+    {
+        errorMessage = "Not a DDS file.";
+        return false;
+    }
+
+    unsigned int flags = getUint32(header + 8);
+    int height = (int)getUint32(header + 12);
+    int width = (int)getUint32(header + 16);
+    int levelCount = (flags & DDSD_MIPMAPCOUNT) ? (int)getUint32(header + 28) : 1;
+    unsigned int pixelFlags = getUint32(header + 80);
+    unsigned int fourCC = getUint32(header + 84);
+
+    if(!(pixelFlags & DDPF_FOURCC) || (fourCC != FOURCC_DXT1 && fourCC != FOURCC_DXT5))
+    {
+        errorMessage = "Unsupported format, only DXT1 and DXT5.";
+        return false;
+    }
+    if(width <= 0 || height <= 0 || width > 65536 || height > 65536)
+    {
+        errorMessage = "Invalid image size.";
+        return false;
+    }
+    if(levelCount < 1)
+        levelCount = 1;
+
+    // add the levels down to the given count or 1x1
+    format = (fourCC == FOURCC_DXT1) ? FORMAT_BC1 : FORMAT_BC3;
+    for(int i = 0; i < levelCount; ++i)
+    {
+        addLevel(width, height);
+        if(width == 1 && height == 1)
+            break;
+        width = (width > 1) ? width / 2 : 1;
+        height = (height > 1) ? height / 2 : 1;
+    }
+
+    inFile.read((char*)&buffer[0], buffer.size());
+    if(!inFile)
+    {
+        errorMessage = "Failed to read the blocks.";
+        this->init();
+        return false;
+    }
+    return true;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// save the blocks of all levels as DDS file
+///////////////////////////////////////////////////////////////////////////////
+bool Dds::save(const char* fileName) const
+{
+    if(!fileName || levels.empty())
+        return false;
+
+    unsigned char header[HEADER_SIZE];
+    memset(header, 0, HEADER_SIZE);
+    memcpy(header, "DDS ", 4);
+    putUint32(header + 4, 124);                                 // size of DDS_HEADER
+    putUint32(header + 8, DDSD_CAPS | DDSD_HEIGHT | DDSD_WIDTH | DDSD_PIXELFORMAT | DDSD_MIPMAPCOUNT | DDSD_LINEARSIZE);
+    putUint32(header + 12, levels[0].height);
+    putUint32(header + 16, levels[0].width);
+    putUint32(header + 20, (unsigned int)getDataSize(0));      // linear size of the base level
+    putUint32(header + 28, (unsigned int)levels.size());
+    putUint32(header + 76, 32);                                 // size of DDS_PIXELFORMAT
+    putUint32(header + 80, DDPF_FOURCC);
+    putUint32(header + 84, (format == FORMAT_BC1) ? FOURCC_DXT1 : FOURCC_DXT5);
+    unsigned int caps = DDSCAPS_TEXTURE;
+    if(levels.size() > 1)
+        caps |= DDSCAPS_COMPLEX | DDSCAPS_MIPMAP;
+    putUint32(header + 108, caps);
+
+    ofstream outFile;
+    outFile.open(fileName, ios::binary);
+    if(!outFile.good()) return false;   // exit if failed
+
+    outFile.write((const char*)header, HEADER_SIZE);
+    outFile.write((const char*)&buffer[0], buffer.size());
+    outFile.close();
+    return outFile.good();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// encode a single image
+///////////////////////////////////////////////////////////////////////////////
+bool Dds::encode(const unsigned char* data, int width, int height, int channelCount, Format format)
+{
+    this->init();
+
+    if(!data || width <= 0 || height <= 0 || (channelCount != 3 && channelCount != 4))
+    {
+        errorMessage = "Invalid image, only RGB and RGBA are supported.";
+        return false;
+    }
+
+    this->format = (channelCount == 3) ? FORMAT_BC1 : (format == FORMAT_NONE) ? FORMAT_BC3 : format;
+    addLevel(width, height);
+    levels[0].src = data;
+    encodeLevels(channelCount);
+    return true;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// encode all levels of a mip chain
+///////////////////////////////////////////////////////////////////////////////
+bool Dds::encode(const Mipmap& mipmap, Format format)
+{
+    this->init();
+
+    int channelCount = mipmap.getChannelCount();
+    if(mipmap.getLevelCount() == 0 || (channelCount != 3 && channelCount != 4))
+    {
+        errorMessage = "Invalid image, only RGB and RGBA are supported.";
+        return false;
+    }
+
+    this->format = (channelCount == 3) ? FORMAT_BC1 : (format == FORMAT_NONE) ? FORMAT_BC3 : format;
+    for(int i = 0; i < mipmap.getLevelCount(); ++i)
+    {
+        addLevel(mipmap.getWidth(i), mipmap.getHeight(i));
+        levels[i].src = mipmap.getData(i);
+    }
+    encodeLevels(channelCount);
+    return true;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// encode the block rows of all levels on multiple threads
+// A task is a row of blocks, and the tasks are interleaved to the threads,
+// so each thread gets the similar amount of the large and small levels.
+///////////////////////////////////////////////////////////////////////////////
+void Dds::encodeLevels(int channelCount)
+{
+    int taskCount = 0;
+    std::size_t blockCount = 0;
+    for(std::size_t i = 0; i < levels.size(); ++i)
+    {
+        taskCount += (levels[i].height + 3) / 4;
+        blockCount += (std::size_t)((levels[i].width + 3) / 4) * ((levels[i].height + 3) / 4);
+    }
+
+    // decide the number of threads
+    int count = threadCount;
+    if(count <= 0)
+        count = (int)std::thread::hardware_concurrency();
+    if(count > taskCount)
+        count = taskCount;
+    if(count < 1 || blockCount < (std::size_t)MIN_THREAD_BLOCKS)
+        count = 1;
+
+    // detect SIMD level before starting threads, so they only read it
+    Pixel::getSimdLevel();
+    std::vector<std::thread> threads;
+    for(int i = 1; i < count; ++i)
+        threads.push_back(std::thread(&Dds::encodeRows, this, i, count, channelCount));
+    encodeRows(0, count, channelCount);
+    for(std::size_t i = 0; i < threads.size(); ++i)
+        threads[i].join();
+
+    // the sources are not valid after this call
+    for(std::size_t i = 0; i < levels.size(); ++i)
+        levels[i].src = 0;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// encode every (taskStep)th block row from firstTask
+///////////////////////////////////////////////////////////////////////////////
+void Dds::encodeRows(int firstTask, int taskStep, int channelCount)
+{
+#ifdef PIXEL_X86
+    bool simd = Pixel::getSimdLevel() >= Pixel::SIMD_SSE2;
+#else
+    bool simd = false;
+#endif
+    std::size_t blockSize = (format == FORMAT_BC3) ? 16 : 8;
+    unsigned char rgba[64];
+
+    int task = 0;       // first task of the level
+    for(std::size_t i = 0; i < levels.size(); ++i)
+    {
+        const Level& level = levels[i];
+        int blockWidth = (level.width + 3) / 4;
+        int blockHeight = (level.height + 3) / 4;
+
+        // the first row of this thread in the level
+        int by = firstTask - task;
+        if(by < 0)
+            by += ((-by + taskStep - 1) / taskStep) * taskStep;
+        for(; by < blockHeight; by += taskStep)
+        {
+            unsigned char* dst = &buffer[level.offset + (std::size_t)by * blockWidth * blockSize];
+            for(int bx = 0; bx < blockWidth; ++bx, dst += blockSize)
+            {
+                fetchBlock(level.src, level.width, level.height, channelCount, bx, by, rgba);
+                if(format == FORMAT_BC3)
+                {
+                    encodeAlphaBlock(rgba, dst);
+                    encodeColorBlock(rgba, simd, dst + 8);
+                }
+                else
+                {
+                    encodeColorBlock(rgba, simd, dst);
+                }
+            }
+        }
+        task += blockHeight;
+    }
+}
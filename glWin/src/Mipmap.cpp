@@ -0,0 +1,365 @@
+///////////////////////////////////////////////////////////////////////////////
+// Mipmap.cpp
+// ==========
+// Mipmap chain generator for 8-bit grayscale, RGB and RGBA images
+// It builds all mip levels down to 1x1 with 2x2 box filter. Each level is
+// floor(size/2) of the previous level as OpenGL does, so non-power-of-two
+// images are not rescaled.
+// The image is split into bands of 64 scanlines, and each thread builds the
+// first 6 levels of its bands at once because a band does not depend on the
+// other bands. The remaining small levels are built on the calling thread.
+//
+//  AUTHOR: Song Ho Ahn (song.ahn@gmail.com)
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cstring>                      // for memcpy()
+#include <cmath>
+#include <thread>
+#include "Mipmap.h"
+#include "pixelUtils.h"
+
+#ifdef PIXEL_X86
+#include <immintrin.h>
+#endif
+
+using namespace Image;
+
+// constants
+static const int BAND_LEVELS = 6;                   // # of levels built per band
+static const int BAND_HEIGHT = 1 << BAND_LEVELS;    // 64 scanlines per band
+static const int MIN_THREAD_PIXELS = 256 * 256;     // smaller image is built by a single thread
+static const int LINEAR_LUT_SIZE = 4096;            // resolution of linear to sRGB table
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// sRGB lookup tables, initialized once at the first use
+///////////////////////////////////////////////////////////////////////////////
+struct SrgbTable
+{
+    float toLinear[256];                            // sRGB byte to linear [0, 1]
+    unsigned char toSrgb[LINEAR_LUT_SIZE];          // linear [0, 1] to sRGB byte
+
+    SrgbTable()
+    {
+        for(int i = 0; i < 256; ++i)
+        {
+            float c = i / 255.0f;
+            toLinear[i] = (c <= 0.04045f) ? c / 12.92f : powf((c + 0.055f) / 1.055f, 2.4f);
+        }
+        for(int i = 0; i < LINEAR_LUT_SIZE; ++i)
+        {
+            float c = i / (float)(LINEAR_LUT_SIZE - 1);
+            c = (c <= 0.0031308f) ? c * 12.92f : 1.055f * powf(c, 1 / 2.4f) - 0.055f;
+            toSrgb[i] = (unsigned char)(c * 255 + 0.5f);
+        }
+    }
+};
+
+static const SrgbTable& getSrgbTable()
+{
+    static const SrgbTable table;                   // thread-safe init in C++11
+    return table;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// plain C++ kernels
+// The box filter is done in 2 steps; add 2 scanlines vertically into 16-bit
+// sums first, then add 2 adjacent pixels of the sums horizontally.
+///////////////////////////////////////////////////////////////////////////////
+static void sumRows(const unsigned char* row1, const unsigned char* row2, std::size_t size, unsigned short* sums)
+{
+    for(std::size_t i = 0; i < size; ++i)
+        sums[i] = (unsigned short)(row1[i] + row2[i]);
+}
+
+// srcWidth must be 2 * dstWidth or greater, except srcWidth == 1
+static void sumColumns(const unsigned short* sums, int srcWidth, int dstWidth, int channelCount, unsigned char* dst)
+{
+    int next = (srcWidth > 1) ? channelCount : 0;   // 1-pixel width uses itself twice
+    if(channelCount == 3 && next)
+    {
+        // unrolled for RGB, the most common case without SIMD
+        for(int x = 0; x < dstWidth; ++x, sums += 6, dst += 3)
+        {
+            dst[0] = (unsigned char)((sums[0] + sums[3] + 2) >> 2);
+            dst[1] = (unsigned char)((sums[1] + sums[4] + 2) >> 2);
+            dst[2] = (unsigned char)((sums[2] + sums[5] + 2) >> 2);
+        }
+        return;
+    }
+    for(int x = 0; x < dstWidth; ++x)
+    {
+        const unsigned short* s = sums + x * 2 * channelCount;
+        for(int i = 0; i < channelCount; ++i)
+            *dst++ = (unsigned char)((s[i] + s[i + next] + 2) >> 2);
+    }
+}
+
+// gamma-correct version; the colour components are averaged in linear space
+// Grayscale is regarded as sRGB, and the alpha of RGBA is averaged as is.
+static void filterRowSrgb(const unsigned char* row1, const unsigned char* row2, int srcWidth, int dstWidth,
+                          int channelCount, unsigned char* dst)
+{
+    const SrgbTable& table = getSrgbTable();
+    const float scale = (LINEAR_LUT_SIZE - 1) * 0.25f;
+    int colourCount = (channelCount == 4) ? 3 : channelCount;
+    int next = (srcWidth > 1) ? channelCount : 0;
+    for(int x = 0; x < dstWidth; ++x)
+    {
+        const unsigned char* p1 = row1 + x * 2 * channelCount;
+        const unsigned char* p2 = row2 + x * 2 * channelCount;
+        int i;
+        for(i = 0; i < colourCount; ++i)
+        {
+            float sum = table.toLinear[p1[i]] + table.toLinear[p1[i + next]] +
+                        table.toLinear[p2[i]] + table.toLinear[p2[i + next]];
+            *dst++ = table.toSrgb[(int)(sum * scale + 0.5f)];
+        }
+        for(; i < channelCount; ++i)
+            *dst++ = (unsigned char)((p1[i] + p1[i + next] + p2[i] + p2[i + next] + 2) >> 2);
+    }
+}
+
+
+
+#ifdef PIXEL_X86
+///////////////////////////////////////////////////////////////////////////////
+// SSE2 kernels
+// They return the number of elements processed, and the rest is done by the
+// plain C++ kernels.
+///////////////////////////////////////////////////////////////////////////////
+PIXEL_TARGET("sse2")
+static std::size_t sumRowsSSE2(const unsigned char* row1, const unsigned char* row2, std::size_t size, unsigned short* sums)
+{
+    const __m128i zero = _mm_setzero_si128();
+    std::size_t count = size & ~(std::size_t)15;
+    for(std::size_t i = 0; i < count; i += 16)
+    {
+        __m128i a = _mm_loadu_si128((const __m128i*)(row1 + i));
+        __m128i b = _mm_loadu_si128((const __m128i*)(row2 + i));
+        __m128i lo = _mm_add_epi16(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero));
+        __m128i hi = _mm_add_epi16(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero));
+        _mm_storeu_si128((__m128i*)(sums + i), lo);
+        _mm_storeu_si128((__m128i*)(sums + i + 8), hi);
+    }
+    return count;
+}
+
+// RGBA: 8 pixels of sums (4 registers) to 4 output pixels
+// 2 pixels are in a register, so 64-bit halves are added each other
+PIXEL_TARGET("sse2")
+static int sumColumns4SSE2(const unsigned short* sums, int dstWidth, unsigned char* dst)
+{
+    const __m128i two = _mm_set1_epi16(2);
+    int count = dstWidth & ~3;
+    for(int x = 0; x < count; x += 4)
+    {
+        const unsigned short* s = sums + x * 8;
+        __m128i a = _mm_loadu_si128((const __m128i*)s);
+        __m128i b = _mm_loadu_si128((const __m128i*)(s + 8));
+        __m128i c = _mm_loadu_si128((const __m128i*)(s + 16));
+        __m128i d = _mm_loadu_si128((const __m128i*)(s + 24));
+        __m128i p01 = _mm_add_epi16(_mm_unpacklo_epi64(a, b), _mm_unpackhi_epi64(a, b));
+        __m128i p23 = _mm_add_epi16(_mm_unpacklo_epi64(c, d), _mm_unpackhi_epi64(c, d));
+        p01 = _mm_srli_epi16(_mm_add_epi16(p01, two), 2);
+        p23 = _mm_srli_epi16(_mm_add_epi16(p23, two), 2);
+        _mm_storeu_si128((__m128i*)(dst + x * 4), _mm_packus_epi16(p01, p23));
+    }
+    return count;
+}
+
+// grayscale: 32 pixels of sums to 16 output pixels
+// pmaddwd with 1s adds adjacent 16-bit values into 32-bit
+PIXEL_TARGET("sse2")
+static int sumColumns1SSE2(const unsigned short* sums, int dstWidth, unsigned char* dst)
+{
+    const __m128i one = _mm_set1_epi16(1);
+    const __m128i two = _mm_set1_epi32(2);
+    int count = dstWidth & ~15;
+    for(int x = 0; x < count; x += 16)
+    {
+        const unsigned short* s = sums + x * 2;
+        __m128i a = _mm_madd_epi16(_mm_loadu_si128((const __m128i*)s), one);
+        __m128i b = _mm_madd_epi16(_mm_loadu_si128((const __m128i*)(s + 8)), one);
+        __m128i c = _mm_madd_epi16(_mm_loadu_si128((const __m128i*)(s + 16)), one);
+        __m128i d = _mm_madd_epi16(_mm_loadu_si128((const __m128i*)(s + 24)), one);
+        a = _mm_srli_epi32(_mm_add_epi32(a, two), 2);
+        b = _mm_srli_epi32(_mm_add_epi32(b, two), 2);
+        c = _mm_srli_epi32(_mm_add_epi32(c, two), 2);
+        d = _mm_srli_epi32(_mm_add_epi32(d, two), 2);
+        __m128i ab = _mm_packs_epi32(a, b);
+        __m128i cd = _mm_packs_epi32(c, d);
+        _mm_storeu_si128((__m128i*)(dst + x), _mm_packus_epi16(ab, cd));
+    }
+    return count;
+}
+#endif
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// 2x2 box filter for a scanline of the next level
+// RGB uses SIMD for the vertical step only; 3-byte pixels do not fit in the
+// 16-byte registers for the horizontal step.
+///////////////////////////////////////////////////////////////////////////////
+static void filterRowBox(const unsigned char* row1, const unsigned char* row2, int srcWidth, int dstWidth,
+                         int channelCount, unsigned short* sums, unsigned char* dst)
+{
+    std::size_t size = (std::size_t)srcWidth * channelCount;
+    std::size_t i = 0;
+#ifdef PIXEL_X86
+    bool simd = Pixel::getSimdLevel() >= Pixel::SIMD_SSE2;
+    if(simd)
+        i = sumRowsSSE2(row1, row2, size, sums);
+#endif
+    sumRows(row1 + i, row2 + i, size - i, sums + i);
+
+    int x = 0;
+#ifdef PIXEL_X86
+    if(simd && srcWidth > 1)
+    {
+        if(channelCount == 4)
+            x = sumColumns4SSE2(sums, dstWidth, dst);
+        else if(channelCount == 1)
+            x = sumColumns1SSE2(sums, dstWidth, dst);
+    }
+#endif
+    sumColumns(sums + x * 2 * channelCount, srcWidth - x * 2, dstWidth - x, channelCount, dst + x * channelCount);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// ctor/dtor
+///////////////////////////////////////////////////////////////////////////////
+Mipmap::Mipmap() : channelCount(0), filter(BOX), threadCount(0)
+{
+}
+
+Mipmap::~Mipmap()
+{
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// build the mip chain from the base image
+// The base image must be tightly packed without row padding.
+///////////////////////////////////////////////////////////////////////////////
+bool Mipmap::build(const unsigned char* data, int width, int height, int channelCount, Filter filter)
+{
+    levels.clear();
+    buffer.clear();
+    this->channelCount = 0;
+
+    if(!data || width <= 0 || height <= 0)
+        return false;
+    if(channelCount != 1 && channelCount != 3 && channelCount != 4)
+        return false;
+
+    this->channelCount = channelCount;
+    this->filter = filter;
+
+    // compute dimension and position of all levels
+    Level level;
+    level.width = width;
+    level.height = height;
+    level.offset = 0;
+    while(true)
+    {
+        levels.push_back(level);
+        if(level.width == 1 && level.height == 1)
+            break;
+        level.offset += (std::size_t)level.width * level.height * channelCount;
+        level.width = (level.width > 1) ? level.width / 2 : 1;
+        level.height = (level.height > 1) ? level.height / 2 : 1;
+    }
+    buffer.resize(level.offset + channelCount);     // last level is 1x1
+    memcpy(&buffer[0], data, (std::size_t)width * height * channelCount);
+
+    int lastBandLevel = (int)levels.size() - 1;
+    if(lastBandLevel > BAND_LEVELS)
+        lastBandLevel = BAND_LEVELS;
+
+    // decide the number of threads
+    int bandCount = (height + BAND_HEIGHT - 1) / BAND_HEIGHT;
+    int count = threadCount;
+    if(count <= 0)
+        count = (int)std::thread::hardware_concurrency();
+    if(count > bandCount)
+        count = bandCount;
+    if(count < 1 || (long long)width * height < MIN_THREAD_PIXELS)
+        count = 1;
+
+    // build the first levels in bands, the calling thread takes the 1st share
+    // detect SIMD level before starting threads, so they only read it
+    Pixel::getSimdLevel();
+    std::vector<std::thread> threads;
+    for(int i = 1; i < count; ++i)
+        threads.push_back(std::thread(&Mipmap::buildBands, this, i, count, lastBandLevel));
+    buildBands(0, count, lastBandLevel);
+    for(std::size_t i = 0; i < threads.size(); ++i)
+        threads[i].join();
+
+    // build the remaining small levels
+    for(int i = lastBandLevel + 1; i < (int)levels.size(); ++i)
+        buildRows(i, 0, levels[i].height);
+
+    return true;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// build level 1 to lastLevel of every (bandStep)th band from firstBand
+// A band starts at a multiple of 64 scanlines, so its scanlines at level n
+// are made from the same band of level n-1 only.
+///////////////////////////////////////////////////////////////////////////////
+void Mipmap::buildBands(int firstBand, int bandStep, int lastLevel)
+{
+    int height = levels[0].height;
+    for(int y1 = firstBand * BAND_HEIGHT; y1 < height; y1 += bandStep * BAND_HEIGHT)
+    {
+        int y2 = y1 + BAND_HEIGHT;
+        for(int i = 1; i <= lastLevel; ++i)
+        {
+            int firstRow = y1 >> i;
+            int lastRow = (y2 >= height) ? levels[i].height : (y2 >> i);
+            if(firstRow < lastRow)
+                buildRows(i, firstRow, lastRow);
+        }
+    }
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// build the scanlines [firstRow, lastRow) of a level from the previous level
+///////////////////////////////////////////////////////////////////////////////
+void Mipmap::buildRows(int level, int firstRow, int lastRow)
+{
+    const Level& src = levels[level - 1];
+    const Level& dst = levels[level];
+    std::size_t srcPitch = (std::size_t)src.width * channelCount;
+    std::size_t dstPitch = (std::size_t)dst.width * channelCount;
+    std::vector<unsigned short> sums(srcPitch);
+
+    for(int y = firstRow; y < lastRow; ++y)
+    {
+        int y1 = y * 2;
+        int y2 = (y1 + 1 < src.height) ? y1 + 1 : y1;  // 1-pixel height uses itself twice
+        const unsigned char* row1 = &buffer[src.offset + y1 * srcPitch];
+        const unsigned char* row2 = &buffer[src.offset + y2 * srcPitch];
+        unsigned char* out = &buffer[dst.offset + y * dstPitch];
+
+        if(filter == BOX_SRGB)
+            filterRowSrgb(row1, row2, src.width, dst.width, channelCount, out);
+        else
+            filterRowBox(row1, row2, src.width, dst.width, channelCount, &sums[0], out);
+    }
+}
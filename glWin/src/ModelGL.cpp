@@ -5,11 +5,10 @@
 //
 //  AUTHOR: Song Ho Ahn (song.ahn@gmail.com)
 // CREATED: 2006-07-10
-// UPDATED: 2017-11-11
+// UPDATED: 2026-10-18
 ///////////////////////////////////////////////////////////////////////////////
 
 #include "ModelGL.h"
-#include "Bmp.h"
 #include "Log.h"
 
 
@@ -21,7 +20,8 @@ ModelGL::ModelGL() : windowWidth(0), windowHeight(0), animateFlag(false),
                      mouseLeftDown(false), mouseRightDown(false),
                      mouseX(0), mouseY(0), cameraAngleX(0), cameraAngleY(0),
                      cameraDistance(5), textureId(0), bgFlag(0),
-                     windowResized(false), frameBuffer(0), bufferSize(0)
+                     windowResized(false), frameBuffer(0), bufferSize(0),
+                     mipmapSrgb(false)
 {
     bgColor[0] = bgColor[1] = bgColor[2] = bgColor[3] = 0;
 
@@ -166,6 +166,9 @@ void ModelGL::draw()
 {
     static float angle = 0;
 
+    // upload textures decoded by worker threads within the frame budget
+    textureLoader.update();
+
     // clear buffer
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
 
@@ -246,67 +249,12 @@ void ModelGL::draw()
 
 
 ///////////////////////////////////////////////////////////////////////////////
-// create texture object from bitmap
+// clean up OpenGL objects, call on the rendering thread before closing RC
 ///////////////////////////////////////////////////////////////////////////////
-void ModelGL::createTexture(int width, int height, int bitCount, const GLvoid* data)
+void ModelGL::quit()
 {
-    GLenum format, internalFormat;
-    switch(bitCount)
-    {
-        case 8:
-            format = GL_LUMINANCE;
-            internalFormat = GL_LUMINANCE8;
-            break;
-        case 24:
-            format = GL_RGB;
-            internalFormat = GL_RGB8;
-            break;
-        case 32:
-            format = GL_RGBA;
-            internalFormat = GL_RGBA8;
-            break;
-    }
-
-    // gen texture object
-    glGenTextures(1, &textureId);
-
-    // set active texture and configure it
-    glBindTexture(GL_TEXTURE_2D, textureId);
-
-    // select modulate to mix texture with color for shading
-    glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
-
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-    // if wrap is true, the texture wraps over at the edges (repeat)
-    //       ... false, the texture ends at the edges (clamp)
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-    //glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    //glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-
-    glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, width, height, 0, format, GL_UNSIGNED_BYTE, data);
-
-    // generate texture mipmaps
-    int channelCount = bitCount >> 3;
-    switch(channelCount)
-    {
-    case 1:
-        gluBuild2DMipmaps(GL_TEXTURE_2D, channelCount, width, height, GL_LUMINANCE, GL_UNSIGNED_BYTE, data);
-        break;
-    case 3:
-        gluBuild2DMipmaps(GL_TEXTURE_2D, channelCount, width, height, GL_RGB, GL_UNSIGNED_BYTE, data);
-        break;
-    case 4:
-        gluBuild2DMipmaps(GL_TEXTURE_2D, channelCount, width, height, GL_RGBA, GL_UNSIGNED_BYTE, data);
-        break;
-    }
-    //glGenerateMipmap(GL_TEXTURE_2D);
-    //Win::log(L"textureID: %ld, %x, %x", textureId, glGetError(), format);
-
-    // unbind
-    glBindTexture(GL_TEXTURE_2D, 0);
+    textureLoader.stop();
+    textureLoader.releaseBuffers();
 }
 
 
@@ -316,51 +264,33 @@ void ModelGL::createTexture(int width, int height, int bitCount, const GLvoid* d
 ///////////////////////////////////////////////////////////////////////////////
 unsigned int ModelGL::loadTextureBmp(const char* fileName)
 {
-    int chans, x, y;
-    void* buf;
-    Image::Bmp bmp;
-
-    bmp.read(fileName);
-    x = bmp.getWidth();
-    y = bmp.getHeight();
-    chans = bmp.getBitCount() / 8;
-    buf = (void*)bmp.getDataRGB();
-
-    // gen texture ID
-    GLuint texture;
-    glGenTextures(1, &texture);
-
-    // set active texture and configure it
-    glBindTexture(GL_TEXTURE_2D, texture);
-
-    // select modulate to mix texture with color for shading
-    glTexEnvi(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
-
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-    // if wrap is true, the texture wraps over at the edges (repeat)
-    //       ... false, the texture ends at the edges (clamp)
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-    //glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    //glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-
-    // build our texture mipmaps
-    switch(chans)
-    {
-    case 1:
-        gluBuild2DMipmaps(GL_TEXTURE_2D, chans, x, y, GL_LUMINANCE, GL_UNSIGNED_BYTE, buf);
-        break;
-    case 3:
-        gluBuild2DMipmaps(GL_TEXTURE_2D, chans, x, y, GL_RGB, GL_UNSIGNED_BYTE, buf);
-        break;
-    case 4:
-        gluBuild2DMipmaps(GL_TEXTURE_2D, chans, x, y, GL_RGBA, GL_UNSIGNED_BYTE, buf);
-        break;
-    }
+    // the file is read and decoded by a worker thread, and the texture object
+    // is returned immediately with 1x1 image until the upload is done
+    TextureParams params;
+    params.minFilter = GL_LINEAR_MIPMAP_LINEAR;
+    params.magFilter = GL_LINEAR;
+    params.wrap = GL_REPEAT;
+    params.mipmap = true;
+    params.srgbMipmap = mipmapSrgb;
+    params.compress = true;                 // BC1/BC3 with cache file, if S3TC is supported
+    return textureLoader.load(fileName, params);
+}
 
-    return texture;
+
+
+///////////////////////////////////////////////////////////////////////////////
+// load texture with a custom decoder running on a worker thread
+///////////////////////////////////////////////////////////////////////////////
+void ModelGL::loadTexture(const TextureDecoder& decoder)
+{
+    TextureParams params;
+    params.minFilter = GL_LINEAR_MIPMAP_LINEAR;
+    params.magFilter = GL_LINEAR;
+    params.wrap = GL_REPEAT;
+    params.mipmap = true;
+    params.srgbMipmap = mipmapSrgb;
+    params.compress = true;                 // no cache file for the decoder
+    textureId = textureLoader.load(decoder, params);
 }
 
 
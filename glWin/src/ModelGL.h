@@ -5,7 +5,7 @@
 //
 //  AUTHOR: Song Ho Ahn (song.ahn@gmail.com)
 // CREATED: 2006-07-10
-// UPDATED: 2017-11-11
+// UPDATED: 2026-10-18
 ///////////////////////////////////////////////////////////////////////////////
 
 #ifndef MODEL_GL_H
@@ -18,6 +18,7 @@
 #include <GL/glu.h>
 
 #include "Sphere.h"
+#include "TextureLoader.h"
 
 
 class ModelGL
@@ -27,7 +28,8 @@ public:
     ~ModelGL();
 
     void init();                                    // initialize OpenGL states
-    void createTexture(int width, int height, int bitCount, const void* data);
+    void quit();                                    // clean up OpenGL objects
+    void loadTexture(const TextureDecoder& decoder);    // decode on a worker thread and upload by draw()
     void setCamera(float posX, float posY, float posZ, float targetX, float targetY, float targetZ);
     void setViewport(int width, int height);
     void resizeWindow(int width, int height);
@@ -38,6 +40,8 @@ public:
     void setMousePosition(int x, int y) { mouseX = x; mouseY = y; };
     void setDrawMode(int mode);
     void animate(bool flag) { animateFlag = flag; };
+    void setMipmapSrgb(bool flag) { mipmapSrgb = flag; };   // filter mipmaps in linear space
+    const TextureLoader& getTextureLoader() const { return textureLoader; };
 
     void rotateCamera(int x, int y);
     void zoomCamera(int dist);
@@ -76,5 +80,7 @@ private:
     bool windowResized;
     unsigned char* frameBuffer;                     // framebuffer to store RGBA color
     int bufferSize;                                 // framebuffer size in bytes
+    bool mipmapSrgb;                                // gamma-correct mipmap filter
+    TextureLoader textureLoader;                    // decode textures on worker threads
 };
 #endif
@@ -0,0 +1,477 @@
+///////////////////////////////////////////////////////////////////////////////
+// Qoi.cpp
+// =======
+// QOI (Quite OK Image) lossless image encoder, decoder and writer
+// The format is from the QOI specification 1.0 (qoiformat.org).
+//
+//  AUTHOR: Song Ho Ahn (song.ahn@gmail.com)
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#include <fstream>
+#include <iostream>
+#include <cstring>                      // for memcpy()
+#include <thread>
+#include <functional>                   // for std::ref()
+#include "Qoi.h"
+
+using std::ifstream;
+using std::ofstream;
+using std::ios;
+using std::cout;
+using std::endl;
+using namespace Image;
+
+// constants
+static const int HEADER_SIZE = 14;                  // "qoif", width, height, channels, colorspace
+static const int END_SIZE = 8;                      // 7 x 0x00 and 0x01
+static const unsigned char END_MARKER[END_SIZE] = {0, 0, 0, 0, 0, 0, 0, 1};
+static const unsigned int PIXELS_MAX = 400000000;   // limit of decoder, same as the reference
+static const unsigned char OP_INDEX = 0x00;         // 00xxxxxx
+static const unsigned char OP_DIFF = 0x40;          // 01xxxxxx
+static const unsigned char OP_LUMA = 0x80;          // 10xxxxxx
+static const unsigned char OP_RUN = 0xc0;           // 11xxxxxx
+static const unsigned char OP_RGB = 0xfe;
+static const unsigned char OP_RGBA = 0xff;
+static const unsigned char OP_MASK = 0xc0;
+static const int RUN_MAX = 62;
+static const int SCAN_PIXELS = 4096;                // max pixels to scan back for the index of a slice
+static const int MIN_THREAD_PIXELS = 256 * 256;     // smaller image is encoded by a single thread
+static const int MIN_SLICE_ROWS = 16;
+
+// pixel is packed to 32-bit, R in the lowest byte
+static const unsigned int INITIAL_PIXEL = 0xff000000;   // r=0, g=0, b=0, a=255
+
+static inline unsigned int makePixel(unsigned int r, unsigned int g, unsigned int b, unsigned int a)
+{
+    return r | (g << 8) | (b << 16) | (a << 24);
+}
+
+static inline int getHash(unsigned int pixel)
+{
+    return ((pixel & 0xff) * 3 + ((pixel >> 8) & 0xff) * 5 + ((pixel >> 16) & 0xff) * 7 + (pixel >> 24) * 11) & 63;
+}
+
+// read a pixel of RGB(A) or BGR(A) order
+static inline unsigned int fetchPixel(const unsigned char* p, int channelCount, int r, int b)
+{
+    return makePixel(p[r], p[1], p[b], (channelCount == 4) ? p[3] : 255);
+}
+
+static inline void putUint32(unsigned char* p, unsigned int value)
+{
+    p[0] = (unsigned char)(value >> 24);            // big endian
+    p[1] = (unsigned char)(value >> 16);
+    p[2] = (unsigned char)(value >> 8);
+    p[3] = (unsigned char)value;
+}
+
+static inline unsigned int getUint32(const unsigned char* p)
+{
+    return ((unsigned int)p[0] << 24) | ((unsigned int)p[1] << 16) | ((unsigned int)p[2] << 8) | p[3];
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// default constructor
+///////////////////////////////////////////////////////////////////////////////
+Qoi::Qoi() : width(0), height(0), bitCount(0), errorMessage("No error.")
+{
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// clear out the exsiting values
+///////////////////////////////////////////////////////////////////////////////
+void Qoi::init()
+{
+    width = height = bitCount = 0;
+    data.clear();
+    errorMessage = "No error.";
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// print itself for debug
+///////////////////////////////////////////////////////////////////////////////
+void Qoi::printSelf() const
+{
+    cout << "===== Qoi =====\n"
+         << "Width: " << width << " pixels\n"
+         << "Height: " << height << " pixels\n"
+         << "Bit Count: " << bitCount << " bits\n"
+         << "Data Size: " << data.size() << " bytes\n"
+         << endl;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// read a QOI file and decode it
+///////////////////////////////////////////////////////////////////////////////
+bool Qoi::read(const char* fileName)
+{
+    this->init();   // clear out all values
+
+    // check NULL pointer
+    if(!fileName)
+    {
+        errorMessage = "File name is not defined (NULL pointer).";
+        return false;
+    }
+
+    // open a QOI file as binary mode
+    ifstream inFile;
+    inFile.open(fileName, ios::binary);
+    if(!inFile.good())
+    {
+        errorMessage = "Failed to open a QOI file to read.";
+        return false;
+    }
+
+    // read the whole file
+    inFile.seekg(0, ios::end);
+    std::size_t fileSize = (std::size_t)inFile.tellg();
+    inFile.seekg(0, ios::beg);
+    std::vector<unsigned char> encData(fileSize);
+    if(fileSize > 0)
+        inFile.read((char*)&encData[0], fileSize);
+    inFile.close();
+    if(fileSize == 0 || !inFile)
+    {
+        errorMessage = "Failed to read a QOI file.";
+        return false;
+    }
+
+    return decode(&encData[0], fileSize);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// decode a QOI stream
+// If the chunks end before all pixels, the last pixel is repeated like the
+// reference decoder.
+///////////////////////////////////////////////////////////////////////////////
+bool Qoi::decode(const unsigned char* encData, std::size_t encSize)
+{
+    this->init();
+
+    if(!encData || encSize < (std::size_t)(HEADER_SIZE + END_SIZE) || memcmp(encData, "qoif", 4) != 0)
+    {
+        errorMessage = "Not a QOI image.";
+        return false;
+    }
+
+    unsigned int w = getUint32(encData + 4);
+    unsigned int h = getUint32(encData + 8);
+    int channelCount = encData[12];
+    if(w == 0 || h == 0 || h >= PIXELS_MAX / w || (channelCount != 3 && channelCount != 4))
+    {
+        errorMessage = "Invalid QOI header.";
+        return false;
+    }
+
+    width = (int)w;
+    height = (int)h;
+    bitCount = channelCount * 8;
+    data.resize((std::size_t)w * h * channelCount);
+
+    unsigned int index[64];
+    memset(index, 0, sizeof(index));
+    unsigned int pixel = INITIAL_PIXEL;
+    unsigned char r = 0, g = 0, b = 0, a = 255;
+    int run = 0;
+
+    // the chunks end before the end marker, so a chunk of 5 bytes can be read
+    // without checking the size
+    std::size_t pos = HEADER_SIZE;
+    std::size_t chunkEnd = encSize - END_SIZE;
+    unsigned char* out = &data[0];
+    unsigned char* outEnd = out + data.size();
+    for(; out < outEnd; out += channelCount)
+    {
+        if(run > 0)
+        {
+            --run;
+        }
+        else if(pos < chunkEnd)
+        {
+            unsigned char b1 = encData[pos++];
+            if(b1 == OP_RGB)
+            {
+                r = encData[pos];
+                g = encData[pos + 1];
+                b = encData[pos + 2];
+                pos += 3;
+            }
+            else if(b1 == OP_RGBA)
+            {
+                r = encData[pos];
+                g = encData[pos + 1];
+                b = encData[pos + 2];
+                a = encData[pos + 3];
+                pos += 4;
+            }
+            else if((b1 & OP_MASK) == OP_INDEX)
+            {
+                pixel = index[b1];
+                r = (unsigned char)pixel;
+                g = (unsigned char)(pixel >> 8);
+                b = (unsigned char)(pixel >> 16);
+                a = (unsigned char)(pixel >> 24);
+            }
+            else if((b1 & OP_MASK) == OP_DIFF)
+            {
+                r += ((b1 >> 4) & 0x03) - 2;
+                g += ((b1 >> 2) & 0x03) - 2;
+                b += (b1 & 0x03) - 2;
+            }
+            else if((b1 & OP_MASK) == OP_LUMA)
+            {
+                unsigned char b2 = encData[pos++];
+                int vg = (b1 & 0x3f) - 32;
+                r += vg - 8 + ((b2 >> 4) & 0x0f);
+                g += vg;
+                b += vg - 8 + (b2 & 0x0f);
+            }
+            else // OP_RUN
+            {
+                run = b1 & 0x3f;
+            }
+
+            pixel = makePixel(r, g, b, a);
+            index[getHash(pixel)] = pixel;
+        }
+
+        out[0] = r;
+        out[1] = g;
+        out[2] = b;
+        if(channelCount == 4)
+            out[3] = a;
+    }
+    return true;
+}
+
+
+
+// static shared functions ****************************************************
+
+///////////////////////////////////////////////////////////////////////////////
+// save an image as a QOI file
+// The source image is RGB(A) order and top-to-bottom, same as Tga::save().
+///////////////////////////////////////////////////////////////////////////////
+bool Qoi::save(const char* fileName, int width, int height, int channelCount, const unsigned char* data, int threadCount)
+{
+    if(!fileName || !data) return false;
+
+    std::vector<unsigned char> buffer;
+    if(encode(data, width, height, channelCount, false, false, threadCount, buffer) == 0)
+        return false;
+
+    // open output file
+    ofstream outFile;
+    outFile.open(fileName, ios::binary);
+    if(!outFile.good()) return false;   // exit if failed
+
+    outFile.write((const char*)&buffer[0], buffer.size());
+    outFile.close();
+    return outFile.good();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// encode an image to QOI stream
+// The scanlines are split into a slice per thread, and the encoded slices are
+// concatenated between the header and the end marker.
+///////////////////////////////////////////////////////////////////////////////
+std::size_t Qoi::encode(const unsigned char* data, int width, int height, int channelCount,
+                        bool bgr, bool flip, int threadCount, std::vector<unsigned char>& buffer)
+{
+    buffer.clear();
+    if(!data || width <= 0 || height <= 0 || (channelCount != 3 && channelCount != 4))
+        return 0;
+
+    // decide the number of threads
+    int count = threadCount;
+    if(count <= 0)
+        count = (int)std::thread::hardware_concurrency();
+    if(count > height / MIN_SLICE_ROWS)
+        count = height / MIN_SLICE_ROWS;
+    if(count < 1 || (std::size_t)width * height < (std::size_t)MIN_THREAD_PIXELS)
+        count = 1;
+
+    std::vector<std::vector<unsigned char> > slices(count);
+    std::vector<std::thread> threads;
+    for(int i = 1; i < count; ++i)
+    {
+        int firstRow = (int)((long long)height * i / count);
+        int lastRow = (int)((long long)height * (i + 1) / count);
+        threads.push_back(std::thread(encodeSlice, data, width, height, channelCount, bgr, flip,
+                                      firstRow, lastRow, std::ref(slices[i])));
+    }
+    encodeSlice(data, width, height, channelCount, bgr, flip, 0, height / count, slices[0]);
+    for(std::size_t i = 0; i < threads.size(); ++i)
+        threads[i].join();
+
+    // header + slices + end marker
+    std::size_t size = HEADER_SIZE + END_SIZE;
+    for(int i = 0; i < count; ++i)
+        size += slices[i].size();
+    buffer.resize(size);
+
+    unsigned char* out = &buffer[0];
+    memcpy(out, "qoif", 4);
+    putUint32(out + 4, (unsigned int)width);
+    putUint32(out + 8, (unsigned int)height);
+    out[12] = (unsigned char)channelCount;
+    out[13] = 0;                                    // sRGB with linear alpha
+    out += HEADER_SIZE;
+    for(int i = 0; i < count; ++i)
+    {
+        if(!slices[i].empty())
+            memcpy(out, &slices[i][0], slices[i].size());
+        out += slices[i].size();
+    }
+    memcpy(out, END_MARKER, END_SIZE);
+    return size;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// encode the scanlines [firstRow, lastRow) of the output (top-to-bottom)
+// A slice after the first starts with the state of decoder at its first
+// pixel. The previous pixel is the last pixel of the previous scanline, and
+// the index has the last colour of each hash among the previous pixels. The
+// index entries not found within SCAN_PIXELS are filled with a colour of a
+// different hash, so they never match. The opaque black may not be in the
+// index of decoder if it is only in the initial run, so it is also unknown.
+///////////////////////////////////////////////////////////////////////////////
+void Qoi::encodeSlice(const unsigned char* data, int width, int height, int channelCount, bool bgr, bool flip,
+                      int firstRow, int lastRow, std::vector<unsigned char>& buffer)
+{
+    int r = bgr ? 2 : 0;                            // offset of red
+    int b = bgr ? 0 : 2;                            // offset of blue
+    std::size_t pitch = (std::size_t)width * channelCount;
+
+    unsigned int index[64];
+    unsigned int prev = INITIAL_PIXEL;
+    if(firstRow == 0)
+    {
+        memset(index, 0, sizeof(index));
+    }
+    else
+    {
+        bool found[64];
+        for(int i = 0; i < 64; ++i)
+        {
+            index[i] = (i == 0) ? makePixel(1, 0, 0, 0) : 0;    // hash 3 or 0, not i
+            found[i] = false;
+        }
+
+        // scan back from the last pixel of the previous scanline
+        int foundCount = 0;
+        int scanCount = 0;
+        for(int row = firstRow - 1; row >= 0 && foundCount < 64 && scanCount < SCAN_PIXELS; --row)
+        {
+            const unsigned char* line = data + (flip ? height - 1 - row : row) * pitch;
+            for(int x = width - 1; x >= 0 && foundCount < 64 && scanCount < SCAN_PIXELS; --x, ++scanCount)
+            {
+                unsigned int pixel = fetchPixel(line + x * channelCount, channelCount, r, b);
+                if(row == firstRow - 1 && x == width - 1)
+                    prev = pixel;
+
+                int hash = getHash(pixel);
+                if(found[hash])
+                    continue;
+                found[hash] = true;
+                ++foundCount;
+                if(pixel != INITIAL_PIXEL)
+                    index[hash] = pixel;
+            }
+        }
+    }
+
+    // worst case is OP_RGB or OP_RGBA for all pixels
+    buffer.resize((std::size_t)width * (lastRow - firstRow) * (channelCount + 1));
+    unsigned char* out = &buffer[0];
+    int run = 0;
+    for(int row = firstRow; row < lastRow; ++row)
+    {
+        const unsigned char* p = data + (flip ? height - 1 - row : row) * pitch;
+        for(int x = 0; x < width; ++x, p += channelCount)
+        {
+            unsigned int pixel = fetchPixel(p, channelCount, r, b);
+            if(pixel == prev)
+            {
+                if(++run == RUN_MAX)
+                {
+                    *out++ = OP_RUN | (RUN_MAX - 1);
+                    run = 0;
+                }
+                continue;
+            }
+
+            if(run > 0)
+            {
+                *out++ = OP_RUN | (unsigned char)(run - 1);
+                run = 0;
+            }
+
+            int hash = getHash(pixel);
+            if(index[hash] == pixel)
+            {
+                *out++ = OP_INDEX | (unsigned char)hash;
+            }
+            else
+            {
+                index[hash] = pixel;
+                if((pixel >> 24) == (prev >> 24))
+                {
+                    // differences with wraparound
+                    signed char vr = (signed char)((pixel & 0xff) - (prev & 0xff));
+                    signed char vg = (signed char)(((pixel >> 8) & 0xff) - ((prev >> 8) & 0xff));
+                    signed char vb = (signed char)(((pixel >> 16) & 0xff) - ((prev >> 16) & 0xff));
+                    signed char vgr = vr - vg;
+                    signed char vgb = vb - vg;
+                    if(vr > -3 && vr < 2 && vg > -3 && vg < 2 && vb > -3 && vb < 2)
+                    {
+                        *out++ = OP_DIFF | (unsigned char)((vr + 2) << 4 | (vg + 2) << 2 | (vb + 2));
+                    }
+                    else if(vgr > -9 && vgr < 8 && vg > -33 && vg < 32 && vgb > -9 && vgb < 8)
+                    {
+                        *out++ = OP_LUMA | (unsigned char)(vg + 32);
+                        *out++ = (unsigned char)((vgr + 8) << 4 | (vgb + 8));
+                    }
+                    else
+                    {
+                        *out++ = OP_RGB;
+                        *out++ = (unsigned char)pixel;
+                        *out++ = (unsigned char)(pixel >> 8);
+                        *out++ = (unsigned char)(pixel >> 16);
+                    }
+                }
+                else
+                {
+                    *out++ = OP_RGBA;
+                    *out++ = (unsigned char)pixel;
+                    *out++ = (unsigned char)(pixel >> 8);
+                    *out++ = (unsigned char)(pixel >> 16);
+                    *out++ = (unsigned char)(pixel >> 24);
+                }
+            }
+            prev = pixel;
+        }
+    }
+
+    // the run is closed at the end of slice, the next slice starts a new run
+    if(run > 0)
+        *out++ = OP_RUN | (unsigned char)(run - 1);
+    buffer.resize(out - &buffer[0]);
+}
@@ -0,0 +1,176 @@
+///////////////////////////////////////////////////////////////////////////////
+// TextureLoader.h
+// ===============
+// Asynchronous texture loader
+// Image files (TGA, BMP, QOI) are read and decoded by a pool of worker threads,
+// and the decoded images are queued to the OpenGL thread. update() must be
+// called on the OpenGL thread once per frame. It uploads the queued images
+// through a ring of pixel buffer objects (PBO), up to the byte budget per
+// frame, so loading textures never stalls a frame.
+//
+// load() creates the texture object immediately with a 1x1 transparent black
+// image, so the texture ID can be used for rendering right away. If mipmap is
+// enabled, the mip levels are built by the worker thread too, and uploaded
+// from the smallest level with GL_TEXTURE_BASE_LEVEL, so the texture is always
+// complete and gets sharper while loading. Without mipmap, a texture larger
+// than the frame budget is undefined until its upload is completed.
+//
+// If compress is enabled, RGB and RGBA images are encoded to BC1/BC3 blocks
+// with all mip levels by the worker thread, and saved as a cache file next to
+// the source image (<file>.dds). The next load reads the cache instead of the
+// source if it is newer than the source. The compressed levels are uploaded
+// with glCompressedTexImage2D, a whole level at a time. If S3TC is not
+// supported, the images are uploaded uncompressed as before.
+//
+// If PBO is not supported, the images are uploaded from system memory with
+// the same budget.
+//
+//  AUTHOR: Song Ho Ahn (song.ahn@gmail.com)
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TEXTURE_LOADER_H
+#define TEXTURE_LOADER_H
+
+#ifdef _WIN32
+#include <windows.h>    // include windows.h to avoid thousands of compile errors even though this class is not depending on Windows
+#endif
+
+#ifdef __APPLE__
+#include <OpenGL/gl.h>
+#else
+#include <GL/gl.h>
+#endif
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <map>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <cstddef>
+
+namespace Image
+{
+    class Dds;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// decoded image to upload, tightly packed 8-bit grayscale, RGB or RGBA
+///////////////////////////////////////////////////////////////////////////////
+struct TextureImage
+{
+    int width;
+    int height;
+    int channelCount;                               // 1, 3 or 4
+    std::vector<unsigned char> data;
+
+    TextureImage() : width(0), height(0), channelCount(0) {}
+};
+
+// custom decode function running on a worker thread, return false if failed
+typedef std::function<bool(TextureImage&)> TextureDecoder;
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// texture parameters
+///////////////////////////////////////////////////////////////////////////////
+struct TextureParams
+{
+    GLint minFilter;
+    GLint magFilter;
+    GLint wrap;                                     // for both S and T
+    GLenum grayFormat;                              // GL_LUMINANCE or GL_ALPHA for 8-bit images
+    bool mipmap;                                    // build mipmaps on worker thread
+    bool srgbMipmap;                                // gamma-correct mipmap filter
+    bool compress;                                  // BC1/BC3 compression with cache file, RGB(A) only
+
+    TextureParams() : minFilter(GL_LINEAR), magFilter(GL_LINEAR), wrap(GL_REPEAT),
+                      grayFormat(GL_LUMINANCE), mipmap(false), srgbMipmap(false), compress(false) {}
+};
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+class TextureLoader
+{
+public:
+    TextureLoader();
+    ~TextureLoader();                               // stop worker threads
+
+    // start/stop worker threads, 0 means the number of CPU cores - 1
+    void start(int threadCount=0);
+    void stop();                                    // discard pending jobs
+
+    // create a texture object and request to load the image
+    // These must be called on the OpenGL thread. The decoder is called on a worker thread.
+    GLuint load(const std::string& fileName, const TextureParams& params=TextureParams());
+    GLuint load(const TextureDecoder& decoder, const TextureParams& params=TextureParams());
+
+    // upload decoded images within the budget, call on the OpenGL thread once per frame
+    void update();
+
+    // delete PBOs, call on the OpenGL thread before the context is destroyed
+    void releaseBuffers();
+
+    bool isReady(GLuint id) const;                  // true if the image of the texture is fully uploaded
+    bool isBusy() const;                            // true if any texture is not uploaded yet
+
+    void setFrameBudget(std::size_t bytes)          { frameBudget = bytes; }
+    std::size_t getFrameBudget() const              { return frameBudget; }
+
+    // stats
+    int getDecodeQueueSize() const;                 // # of images waiting for decode or decoding
+    int getUploadQueueSize() const;                 // # of decoded images waiting for upload or uploading
+    std::size_t getFrameBytes() const               { return frameBytes; }  // bytes uploaded by the last update()
+    std::size_t getTotalBytes() const               { return totalBytes; }
+    bool isPboUsed() const                          { return pboUsed; }
+
+    // encode an image file to the compressed cache file offline, on all CPU cores
+    static bool buildCache(const std::string& fileName, bool srgbMipmap=false);
+    static std::string getCacheName(const std::string& fileName, bool srgbMipmap=false);
+
+protected:
+
+private:
+    struct Job;
+
+    // member functions
+    GLuint createTexture(const TextureParams& params);
+    void submit(Job* job);
+    void runWorker();
+    static bool decodeFile(const std::string& fileName, TextureImage& image);
+    static bool readCache(const std::string& fileName, bool srgbMipmap, Image::Dds& dds);
+    void initBuffers();
+    bool beginJob(Job* job);
+    std::size_t uploadRows(Job* job, std::size_t budget);
+    std::size_t uploadBlocks(Job* job, std::size_t budget);
+    void finishJob(Job* job, bool success);
+
+    // member variables
+    std::vector<std::thread> workers;
+    mutable std::mutex mutex;                       // for decodeQueue, uploadQueue and counts
+    std::condition_variable condition;
+    std::deque<Job*> decodeQueue;
+    std::deque<Job*> uploadQueue;                   // decoded by workers
+    std::deque<Job*> uploadingJobs;                 // owned by OpenGL thread
+    int decodingCount;
+    bool stopFlag;
+
+    std::map<GLuint, bool> states;                  // texture ID, ready or not (OpenGL thread only)
+    std::vector<GLuint> pboIds;                     // PBO ring
+    int pboIndex;
+    bool pboUsed;
+    bool buffersReady;
+    std::size_t frameBudget;                        // max bytes uploaded per frame
+    std::size_t frameBytes;
+    std::size_t totalBytes;
+};
+
+#endif // TEXTURE_LOADER_H
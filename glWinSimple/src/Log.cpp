@@ -10,6 +10,9 @@
 // For example, Win::log(L"My number: %d\n", 123).
 // It is similar to printf() function of C standard libirary.
 //
+// The messages are queued without lock and written by a background thread,
+// so Win::log() never blocks the caller. See Log.h for details.
+//
 // The template of the log dialog window is defined in log.rc and logResource.h
 // You must include both resource file with this source codes.
 // The dialog window cannot be closed by user once it is created. But it will be
@@ -17,20 +20,21 @@
 //
 //  AUTHOR: Song Ho Ahn (song.ahn@gmail.com)
 // CREATED: 2006-07-14
-// UPDATED: 2008-05-07
+// UPDATED: 2026-10-18
 ///////////////////////////////////////////////////////////////////////////////
 
 #include <cstdarg>
 #include <cwchar>
+#include <cstdlib>
 #include <sstream>
 #include <iomanip>
 #include "Log.h"
 #include "logResource.h"                            // for log dialog resource
-#include "wcharUtil.h"
 using namespace Win;
 
 
 const char* LOG_FILE = "log.txt";
+const DWORD LOG_FLUSH_TIMEOUT = 1000;               // max ms to wait in flush()
 
 BOOL CALLBACK logDialogProc(HWND hwnd, UINT message, WPARAM wParam, LPARAM lParam);
 
@@ -39,18 +43,30 @@ BOOL CALLBACK logDialogProc(HWND hwnd, UINT message, WPARAM wParam, LPARAM lPara
 ///////////////////////////////////////////////////////////////////////////////
 // constructor
 ///////////////////////////////////////////////////////////////////////////////
-Log::Log() : logMode(LOG_MODE_FILE), dialogHandle(0), listHandle(0)
+Log::Log() : logMode(LOG_MODE_FILE), dialogHandle(0), listHandle(0),
+             messages(0), enqueuePos(0), dequeuePos(0), droppedCount(0), reportedDropCount(0),
+             running(false), stopFlag(false), wakeEvent(0)
 {
+    // the slot i is free to write at the position i
+    messages = new Message[LOG_QUEUE_SIZE];
+    for(int i = 0; i < LOG_QUEUE_SIZE; ++i)
+        messages[i].sequence.store(i, std::memory_order_relaxed);
+
     // open log file
     logFile.open(LOG_FILE, std::ios::out);
-    if(logFile.fail())
-        return;
+    if(!logFile.fail())
+    {
+        // first put starting date and time
+        logFile << L"===== Log started at "
+                << getDate() << L", "
+                << getTime() << L". =====\n\n"
+                << std::flush;
+    }
 
-    // first put starting date and time
-    logFile << L"===== Log started at "
-            << getDate() << L", "
-            << getTime() << L". =====\n\n"
-            << std::flush;
+    // start the writer thread, the file is used by the writer thread only after this
+    wakeEvent = ::CreateEvent(0, FALSE, FALSE, 0);  // auto-reset
+    running.store(true);
+    writer = std::thread(&Log::runWriter, this);
 }
 
 
@@ -60,10 +76,22 @@ Log::Log() : logMode(LOG_MODE_FILE), dialogHandle(0), listHandle(0)
 ///////////////////////////////////////////////////////////////////////////////
 Log::~Log()
 {
+    // stop the writer thread after it writes all queued messages
+    stopFlag.store(true);
+    ::SetEvent(wakeEvent);
+    if(writer.joinable())
+        writer.join();
+    running.store(false);
+    writeMessages();                                // queued while the writer was stopping
+
     // close opened file
     logFile << L"\n\n===== END OF LOG =====\n";
     logFile.close();
 
+    ::CloseHandle(wakeEvent);
+    delete [] messages;
+    messages = 0;
+
     // destroy dilalog
     if(dialogHandle)
     {
@@ -87,13 +115,149 @@ Log& Log::getInstance()
 
 ///////////////////////////////////////////////////////////////////////////////
 // add message to log
+// It claims a free slot of the queue with CAS, copies the message and marks
+// the slot ready, then wakes the writer thread. It never waits; if the queue
+// is full, the message is dropped and counted.
 ///////////////////////////////////////////////////////////////////////////////
+void Log::put(const wchar_t* str)
+{
+    if(!running.load(std::memory_order_relaxed))
+    {
+        droppedCount.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    // the slot is free if its sequence is the same as the position
+    unsigned int pos = enqueuePos.load(std::memory_order_relaxed);
+    Message* msg;
+    while(true)
+    {
+        msg = &messages[pos & (LOG_QUEUE_SIZE - 1)];
+        int diff = (int)(msg->sequence.load(std::memory_order_acquire) - pos);
+        if(diff == 0)
+        {
+            // pos is updated to the current value if failed
+            if(enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                break;
+        }
+        else if(diff < 0)
+        {
+            // not read by the writer yet, the queue is full
+            droppedCount.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        else
+        {
+            // taken by another thread, try the next position
+            pos = enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    ::GetLocalTime(&msg->time);
+    msg->mode = logMode.load(std::memory_order_acquire);
+    int i = 0;
+    for(; i < LOG_MAX_STRING - 1 && str[i]; ++i)
+        msg->text[i] = str[i];
+    msg->text[i] = L'\0';
+
+    // publish the message to the writer thread
+    msg->sequence.store(pos + 1, std::memory_order_release);
+    ::SetEvent(wakeEvent);
+}
+
+
+
 void Log::put(const std::wstring& message)
 {
-    if(logMode != LOG_MODE_FILE)
+    put(message.c_str());
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// wait until the messages queued before this call are written
+// It gives up after LOG_FLUSH_TIMEOUT, e.g., the writer is stopped.
+///////////////////////////////////////////////////////////////////////////////
+void Log::flush()
+{
+    unsigned int pos = enqueuePos.load(std::memory_order_acquire);
+    ::SetEvent(wakeEvent);
+
+    ULONGLONG endTime = ::GetTickCount64() + LOG_FLUSH_TIMEOUT;
+    while((int)(dequeuePos.load(std::memory_order_acquire) - pos) < 0 && ::GetTickCount64() < endTime)
+        ::Sleep(1);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// writer thread: write the queued messages whenever it is woken up
+// The messages queued while writing are written in the same batch.
+///////////////////////////////////////////////////////////////////////////////
+void Log::runWriter()
+{
+    while(true)
+    {
+        ::WaitForSingleObject(wakeEvent, INFINITE);
+        bool stopped = stopFlag.load();
+        writeMessages();
+        if(stopped)
+            return;
+    }
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// write the ready messages in order, and the number of the dropped messages
+// The file is flushed once per batch, not per message.
+///////////////////////////////////////////////////////////////////////////////
+int Log::writeMessages()
+{
+    int count = 0;
+    unsigned int pos = dequeuePos.load(std::memory_order_relaxed);
+    while(true)
+    {
+        Message& msg = messages[pos & (LOG_QUEUE_SIZE - 1)];
+        if(msg.sequence.load(std::memory_order_acquire) != pos + 1)
+            break;                                  // empty, or being copied by a caller
+
+        writeMessage(msg);
+
+        // free the slot for the next round of the ring
+        msg.sequence.store(pos + LOG_QUEUE_SIZE, std::memory_order_release);
+        ++pos;
+        ++count;
+    }
+
+    long long dropped = droppedCount.load(std::memory_order_relaxed);
+    if(dropped != reportedDropCount)
+    {
+        logFile << getTime() << L"  "
+                << L"[Log] " << (dropped - reportedDropCount)
+                << L" message(s) dropped, the queue is full.\n";
+        reportedDropCount = dropped;
+        ++count;
+    }
+
+    if(count > 0)
+        logFile << std::flush;
+    dequeuePos.store(pos, std::memory_order_release);
+    return count;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// write a message to the file and/or dialog, called by the writer thread
+///////////////////////////////////////////////////////////////////////////////
+void Log::writeMessage(const Message& msg)
+{
+    // skip the dialog while stopping, the UI thread may be waiting for the writer
+    if(msg.mode != LOG_MODE_FILE && listHandle && !stopFlag.load(std::memory_order_relaxed))
     {
         std::wstring str;
-        str = getTime() + L": " + message;
+        str = getTime(msg.time) + L": " + msg.text;
         //long index = ::SendMessage(listHandle, LB_ADDSTRING, 0, (LPARAM)str.c_str());
         //::SendMessage(listHandle, LB_SETTOPINDEX, index, 0);  // set focus to current line
 
@@ -104,13 +268,12 @@ void Log::put(const std::wstring& message)
             ::SendMessageTimeout(listHandle, LB_SETTOPINDEX, index, 0, SMTO_NORMAL, 500, 0);  // set focus to current line
     }
 
-    if(logMode != LOG_MODE_DIALOG)
+    if(msg.mode != LOG_MODE_DIALOG)
     {
         // put time first and append message
-        logFile << getTime() << L"  "
-                << message
-                << L"\n"
-                << std::flush;
+        logFile << getTime(msg.time) << L"  "
+                << msg.text
+                << L"\n";
     }
 }
 
@@ -142,10 +305,16 @@ const std::wstring Log::getDate()
 ///////////////////////////////////////////////////////////////////////////////
 const std::wstring Log::getTime()
 {
-    std::wstringstream wss;
-
     SYSTEMTIME sysTime;
     ::GetLocalTime(&sysTime);
+    return getTime(sysTime);
+}
+
+
+
+const std::wstring Log::getTime(const SYSTEMTIME& sysTime)
+{
+    std::wstringstream wss;
 
     wss << std::setfill(L'0');
     wss << sysTime.wHour << L":" << std::setw(2)
@@ -164,16 +333,11 @@ void Log::setMode(int mode)
 {
     if(mode > LOG_MODE_BOTH) return;                // invalid mode number
 
+    // queued with the current mode, so it goes to the file
     if(logMode == LOG_MODE_FILE && mode == LOG_MODE_DIALOG)
-    {
-        logFile << getTime() << L"  "
-                << L"Redirect log to dialog box.\n"
-                << std::flush;
-    }
-
-    logMode = mode;
+        put(L"Redirect log to dialog box.");
 
-    if(logMode != LOG_MODE_FILE)                    // to dialog
+    if(mode != LOG_MODE_FILE)                       // to dialog
     {
         if(!dialogHandle)
         {
@@ -211,22 +375,28 @@ void Log::setMode(int mode)
         if(dialogHandle)
             ::ShowWindow(dialogHandle, SW_MINIMIZE);
     }
+
+    // the messages queued after this go to the new target, the dialog is ready
+    logMode.store(mode, std::memory_order_release);
 }
 
 
 
 ///////////////////////////////////////////////////////////////////////////////
 // C-style printf fuction
+// The message is formatted into the preallocated buffer of the calling thread,
+// then copied to the queue.
 ///////////////////////////////////////////////////////////////////////////////
 void Win::log(const wchar_t *format, ...)
 {
-    wchar_t buffer[LOG_MAX_STRING];
+    static thread_local wchar_t buffer[LOG_MAX_STRING];
 
     // do the formating
     va_list valist;
     va_start(valist, format);
     _vsnwprintf(buffer, LOG_MAX_STRING, format, valist);
     va_end(valist);
+    buffer[LOG_MAX_STRING-1] = L'\0';               // not terminated if truncated
 
     Log::getInstance().put(buffer);
 }
@@ -235,15 +405,22 @@ void Win::log(const wchar_t *format, ...)
 
 void Win::log(const char *format, ...)
 {
-    char buffer[LOG_MAX_STRING];
+    static thread_local char buffer[LOG_MAX_STRING];
+    static thread_local wchar_t wideBuffer[LOG_MAX_STRING];
 
     // do the formating
     va_list valist;
     va_start(valist, format);
     _vsnprintf(buffer, LOG_MAX_STRING, format, valist);
     va_end(valist);
+    buffer[LOG_MAX_STRING-1] = '\0';
 
-    Log::getInstance().put(toWchar(buffer));
+    // convert here, toWchar() shares a circular buffer between threads
+    if(mbstowcs(wideBuffer, buffer, LOG_MAX_STRING) == (size_t)-1)
+        wideBuffer[0] = L'\0';                      // invalid multi-byte char
+    wideBuffer[LOG_MAX_STRING-1] = L'\0';
+
+    Log::getInstance().put(wideBuffer);
 }
 
 
@@ -265,6 +442,16 @@ void Win::logMode(int mode)
 
 
 
+///////////////////////////////////////////////////////////////////////////////
+// wait until the queued messages are written, e.g., before a crash-prone call
+///////////////////////////////////////////////////////////////////////////////
+void Win::logFlush()
+{
+    Log::getInstance().flush();
+}
+
+
+
 ///////////////////////////////////////////////////////////////////////////////
 // process log dialog messages
 ///////////////////////////////////////////////////////////////////////////////
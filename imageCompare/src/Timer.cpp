@@ -0,0 +1,139 @@
+//////////////////////////////////////////////////////////////////////////////
+// Timer.cpp
+// =========
+// High Resolution Timer.
+// This timer is able to measure the elapsed time with 1 nano-second resolution
+// in both Windows, Linux and Unix system
+//
+//  AUTHOR: Song Ho Ahn (song.ahn@gmail.com)
+// CREATED: 2003-01-13
+// UPDATED: 2026-10-18
+//
+// Copyright (c) 2003 Song Ho Ahn
+//////////////////////////////////////////////////////////////////////////////
+
+#include "Timer.h"
+#include <stdlib.h>
+
+///////////////////////////////////////////////////////////////////////////////
+// constructor
+///////////////////////////////////////////////////////////////////////////////
+Timer::Timer()
+{
+    stopped = 0;
+    startTimeInNanoSec = getNanoTime();
+    endTimeInNanoSec = startTimeInNanoSec;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// distructor
+///////////////////////////////////////////////////////////////////////////////
+Timer::~Timer()
+{
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// start timer.
+// startTimeInNanoSec will be set at this point.
+///////////////////////////////////////////////////////////////////////////////
+void Timer::start()
+{
+    stopped = 0; // reset stop flag
+    startTimeInNanoSec = getNanoTime();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// stop the timer.
+// endTimeInNanoSec will be set at this point.
+///////////////////////////////////////////////////////////////////////////////
+void Timer::stop()
+{
+    stopped = 1; // set timer stopped flag
+    endTimeInNanoSec = getNanoTime();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// read the monotonic clock in nano-second
+// The counter of QueryPerformanceCounter() is split to seconds and remainder
+// before multiplying by 10^9, so it does not overflow 64-bit.
+///////////////////////////////////////////////////////////////////////////////
+long long Timer::getNanoTime()
+{
+#if defined(WIN32) || defined(_WIN32)
+    static LARGE_INTEGER frequency = {};
+    if(frequency.QuadPart == 0)
+        QueryPerformanceFrequency(&frequency);  // fixed at boot, never 0 since WinXP
+
+    LARGE_INTEGER count;
+    QueryPerformanceCounter(&count);
+    long long sec = count.QuadPart / frequency.QuadPart;
+    long long rem = count.QuadPart % frequency.QuadPart;
+    return sec * 1000000000LL + rem * 1000000000LL / frequency.QuadPart;
+#else
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+#endif
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// compute elapsed time in nano-second resolution.
+// other getElapsedTime will call this first, then convert to correspond resolution.
+///////////////////////////////////////////////////////////////////////////////
+long long Timer::getElapsedTimeInNanoSec()
+{
+    if(!stopped)
+        endTimeInNanoSec = getNanoTime();
+
+    return endTimeInNanoSec - startTimeInNanoSec;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// divide elapsedTimeInNanoSec by 1000
+///////////////////////////////////////////////////////////////////////////////
+double Timer::getElapsedTimeInMicroSec()
+{
+    return this->getElapsedTimeInNanoSec() * 0.001;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// divide elapsedTimeInNanoSec by 1000000
+///////////////////////////////////////////////////////////////////////////////
+double Timer::getElapsedTimeInMilliSec()
+{
+    return this->getElapsedTimeInNanoSec() * 0.000001;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// divide elapsedTimeInNanoSec by 1000000000
+///////////////////////////////////////////////////////////////////////////////
+double Timer::getElapsedTimeInSec()
+{
+    return this->getElapsedTimeInNanoSec() * 0.000000001;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// same as getElapsedTimeInSec()
+///////////////////////////////////////////////////////////////////////////////
+double Timer::getElapsedTime()
+{
+    return this->getElapsedTimeInSec();
+}
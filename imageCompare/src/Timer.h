@@ -0,0 +1,55 @@
+//////////////////////////////////////////////////////////////////////////////
+// Timer.h
+// =======
+// High Resolution Timer.
+// This timer is able to measure the elapsed time with 1 nano-second resolution
+// in both Windows, Linux and Unix system. It uses the monotonic clock
+// (QueryPerformanceCounter() or clock_gettime(CLOCK_MONOTONIC)), so the time
+// never goes backward when the system clock is adjusted.
+// The ticks are kept as 64-bit integers in nano-second, and converted to double
+// only by getElapsedTime*(), so no precision is lost for a long uptime.
+//
+//  AUTHOR: Song Ho Ahn (song.ahn@gmail.com)
+// CREATED: 2003-01-13
+// UPDATED: 2026-10-18
+//
+// Copyright (c) 2003 Song Ho Ahn
+//////////////////////////////////////////////////////////////////////////////
+
+#ifndef TIMER_H_DEF
+#define TIMER_H_DEF
+
+#if defined(WIN32) || defined(_WIN32)   // Windows system specific
+#include <windows.h>
+#else          // Unix based system specific
+#include <time.h>
+#endif
+
+
+class Timer
+{
+public:
+    Timer();                                    // default constructor
+    ~Timer();                                   // default destructor
+
+    void   start();                             // start timer
+    void   stop();                              // stop the timer
+    double getElapsedTime();                    // get elapsed time in second
+    double getElapsedTimeInSec();               // get elapsed time in second (same as getElapsedTime)
+    double getElapsedTimeInMilliSec();          // get elapsed time in milli-second
+    double getElapsedTimeInMicroSec();          // get elapsed time in micro-second
+    long long getElapsedTimeInNanoSec();        // get elapsed time in nano-second
+
+    static long long getNanoTime();             // current time of the monotonic clock in nano-second
+
+
+protected:
+
+
+private:
+    long long startTimeInNanoSec;               // starting time in nano-second
+    long long endTimeInNanoSec;                 // ending time in nano-second
+    int    stopped;                             // stop flag
+};
+
+#endif // TIMER_H_DEF
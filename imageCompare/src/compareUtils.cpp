@@ -0,0 +1,592 @@
+///////////////////////////////////////////////////////////////////////////////
+// compareUtils.cpp
+// ================
+// Image comparison for regression tests of rendered frames
+//
+//  AUTHOR: Song Ho Ahn (song.ahn@gmail.com)
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cmath>                        // for log10()
+#include <cstdlib>                      // for abs()
+#include <vector>
+#include "compareUtils.h"
+#include "pixelUtils.h"                 // SIMD level and PIXEL_TARGET
+#include "ThreadPool.h"
+
+#ifdef PIXEL_X86
+#include <immintrin.h>
+#endif
+
+
+
+namespace Compare
+{
+// constants
+static const int BLOCK_SIZE = 4;                    // SSIM window is 2x2 blocks
+static const double SSIM_C1 = (0.01 * 255) * (0.01 * 255);
+static const double SSIM_C2 = (0.03 * 255) * (0.03 * 255);
+static const int FLUSH_COUNT = 65536;               // 32-bit sums of squares do not overflow (65536 * 255^2 < 2^32)
+static const int HEATMAP_BASE = 96;                 // the smallest error is dark red, not black
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// plain C++ kernels
+///////////////////////////////////////////////////////////////////////////////
+static void addErrors1(const unsigned char* src1, const unsigned char* src2, std::size_t pixelCount,
+                       int channelCount, ErrorSums& sums)
+{
+    for(std::size_t i = 0; i < pixelCount; ++i)
+    {
+        for(int c = 0; c < channelCount; ++c)
+        {
+            int error = abs((int)*src1++ - (int)*src2++);
+            sums.squares[c] += error * error;
+            if(error > sums.maxErrors[c])
+                sums.maxErrors[c] = error;
+        }
+    }
+}
+
+static void computeBlockSums1(const unsigned char* luma1, const unsigned char* luma2, int width,
+                              int firstBlock, int lastBlock, BlockSums* blocks)
+{
+    for(int i = firstBlock; i < lastBlock; ++i)
+    {
+        BlockSums sums = {0, 0, 0, 0, 0};
+        for(int y = 0; y < BLOCK_SIZE; ++y)
+        {
+            const unsigned char* p1 = luma1 + y * width + i * BLOCK_SIZE;
+            const unsigned char* p2 = luma2 + y * width + i * BLOCK_SIZE;
+            for(int x = 0; x < BLOCK_SIZE; ++x)
+            {
+                sums.sum1 += p1[x];
+                sums.sum2 += p2[x];
+                sums.squares1 += p1[x] * p1[x];
+                sums.squares2 += p2[x] * p2[x];
+                sums.products += p1[x] * p2[x];
+            }
+        }
+        blocks[i] = sums;
+    }
+}
+
+// lane i of a vector of N vectors is channel (i % channelCount)
+static void addLaneErrors(const unsigned char* maxs, const unsigned long long* squares, int laneCount,
+                          int channelCount, ErrorSums& sums)
+{
+    for(int i = 0; i < laneCount; ++i)
+    {
+        int c = i % channelCount;
+        sums.squares[c] += squares[i];
+        if(maxs[i] > sums.maxErrors[c])
+            sums.maxErrors[c] = maxs[i];
+    }
+}
+
+
+
+#ifdef PIXEL_X86
+///////////////////////////////////////////////////////////////////////////////
+// SSE2 kernels
+///////////////////////////////////////////////////////////////////////////////
+// N vectors of 16 bytes have whole pixels (N=3 for RGB), so each lane always
+// has the same channel; max errors per byte lane, and squares in 32-bit lanes
+template<int N>
+PIXEL_TARGET("sse2")
+static std::size_t addErrorsSSE2(const unsigned char* src1, const unsigned char* src2, std::size_t size,
+                                 int channelCount, ErrorSums& sums)
+{
+    const __m128i zero = _mm_setzero_si128();
+    __m128i maxs[N];
+    __m128i squares[N][4];
+    unsigned long long laneSquares[N * 16] = {0};
+    for(int v = 0; v < N; ++v)
+    {
+        maxs[v] = zero;
+        for(int k = 0; k < 4; ++k)
+            squares[v][k] = zero;
+    }
+
+    std::size_t i = 0;
+    int count = 0;
+    for(; i + N * 16 <= size; i += N * 16)
+    {
+        for(int v = 0; v < N; ++v)
+        {
+            __m128i a = _mm_loadu_si128((const __m128i*)(src1 + i + v * 16));
+            __m128i b = _mm_loadu_si128((const __m128i*)(src2 + i + v * 16));
+            __m128i d = _mm_or_si128(_mm_subs_epu8(a, b), _mm_subs_epu8(b, a));    // |a - b|
+            maxs[v] = _mm_max_epu8(maxs[v], d);
+
+            __m128i lo = _mm_unpacklo_epi8(d, zero);
+            __m128i hi = _mm_unpackhi_epi8(d, zero);
+            lo = _mm_mullo_epi16(lo, lo);
+            hi = _mm_mullo_epi16(hi, hi);
+            squares[v][0] = _mm_add_epi32(squares[v][0], _mm_unpacklo_epi16(lo, zero));
+            squares[v][1] = _mm_add_epi32(squares[v][1], _mm_unpackhi_epi16(lo, zero));
+            squares[v][2] = _mm_add_epi32(squares[v][2], _mm_unpacklo_epi16(hi, zero));
+            squares[v][3] = _mm_add_epi32(squares[v][3], _mm_unpackhi_epi16(hi, zero));
+        }
+
+        // move 32-bit sums to 64-bit before overflow
+        if(++count == FLUSH_COUNT || i + N * 32 > size)
+        {
+            unsigned int values[4];
+            for(int v = 0; v < N; ++v)
+            {
+                for(int k = 0; k < 4; ++k)
+                {
+                    _mm_storeu_si128((__m128i*)values, squares[v][k]);
+                    for(int j = 0; j < 4; ++j)
+                        laneSquares[v * 16 + k * 4 + j] += values[j];
+                    squares[v][k] = zero;
+                }
+            }
+            count = 0;
+        }
+    }
+
+    unsigned char laneMaxs[N * 16];
+    for(int v = 0; v < N; ++v)
+        _mm_storeu_si128((__m128i*)(laneMaxs + v * 16), maxs[v]);
+    addLaneErrors(laneMaxs, laneSquares, N * 16, channelCount, sums);
+    return i;                           // # of processed bytes, whole pixels
+}
+
+// sums of 2 blocks (8 pixels) per row; madd adds pairs, then the pairs of a
+// block are added with the swapped pairs
+PIXEL_TARGET("sse2")
+static int computeBlockSumsSSE2(const unsigned char* luma1, const unsigned char* luma2, int width,
+                                int firstBlock, int lastBlock, BlockSums* blocks)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i ones = _mm_set1_epi16(1);
+    int i = firstBlock;
+    for(; i + 2 <= lastBlock; i += 2)
+    {
+        __m128i sum1 = zero, sum2 = zero, squares1 = zero, squares2 = zero, products = zero;
+        for(int y = 0; y < BLOCK_SIZE; ++y)
+        {
+            __m128i x = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)(luma1 + y * width + i * BLOCK_SIZE)), zero);
+            __m128i z = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)(luma2 + y * width + i * BLOCK_SIZE)), zero);
+            sum1 = _mm_add_epi32(sum1, _mm_madd_epi16(x, ones));
+            sum2 = _mm_add_epi32(sum2, _mm_madd_epi16(z, ones));
+            squares1 = _mm_add_epi32(squares1, _mm_madd_epi16(x, x));
+            squares2 = _mm_add_epi32(squares2, _mm_madd_epi16(z, z));
+            products = _mm_add_epi32(products, _mm_madd_epi16(x, z));
+        }
+
+        // lane 0 and 2 have the sums of block 0 and 1
+        int values[5][4];
+        __m128i* v = (__m128i*)values;
+        _mm_storeu_si128(v,     _mm_add_epi32(sum1, _mm_shuffle_epi32(sum1, _MM_SHUFFLE(2, 3, 0, 1))));
+        _mm_storeu_si128(v + 1, _mm_add_epi32(sum2, _mm_shuffle_epi32(sum2, _MM_SHUFFLE(2, 3, 0, 1))));
+        _mm_storeu_si128(v + 2, _mm_add_epi32(squares1, _mm_shuffle_epi32(squares1, _MM_SHUFFLE(2, 3, 0, 1))));
+        _mm_storeu_si128(v + 3, _mm_add_epi32(squares2, _mm_shuffle_epi32(squares2, _MM_SHUFFLE(2, 3, 0, 1))));
+        _mm_storeu_si128(v + 4, _mm_add_epi32(products, _mm_shuffle_epi32(products, _MM_SHUFFLE(2, 3, 0, 1))));
+        for(int k = 0; k < 2; ++k)
+        {
+            BlockSums& b = blocks[i + k];
+            b.sum1 = values[0][k * 2];
+            b.sum2 = values[1][k * 2];
+            b.squares1 = values[2][k * 2];
+            b.squares2 = values[3][k * 2];
+            b.products = values[4][k * 2];
+        }
+    }
+    return i;                           // next block
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// AVX2 kernels
+///////////////////////////////////////////////////////////////////////////////
+// same as SSE2 with 32-byte vectors; the bytes are widened in order with
+// vpmovzx, so lane i of the k-th 8 lanes is byte (k * 8 + i)
+template<int N>
+PIXEL_TARGET("avx2")
+static std::size_t addErrorsAVX2(const unsigned char* src1, const unsigned char* src2, std::size_t size,
+                                 int channelCount, ErrorSums& sums)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i maxs[N];
+    __m256i squares[N][4];
+    unsigned long long laneSquares[N * 32] = {0};
+    for(int v = 0; v < N; ++v)
+    {
+        maxs[v] = zero;
+        for(int k = 0; k < 4; ++k)
+            squares[v][k] = zero;
+    }
+
+    std::size_t i = 0;
+    int count = 0;
+    for(; i + N * 32 <= size; i += N * 32)
+    {
+        for(int v = 0; v < N; ++v)
+        {
+            __m256i a = _mm256_loadu_si256((const __m256i*)(src1 + i + v * 32));
+            __m256i b = _mm256_loadu_si256((const __m256i*)(src2 + i + v * 32));
+            __m256i d = _mm256_or_si256(_mm256_subs_epu8(a, b), _mm256_subs_epu8(b, a));
+            maxs[v] = _mm256_max_epu8(maxs[v], d);
+
+            __m256i lo = _mm256_cvtepu8_epi16(_mm256_castsi256_si128(d));
+            __m256i hi = _mm256_cvtepu8_epi16(_mm256_extracti128_si256(d, 1));
+            lo = _mm256_mullo_epi16(lo, lo);
+            hi = _mm256_mullo_epi16(hi, hi);
+            squares[v][0] = _mm256_add_epi32(squares[v][0], _mm256_cvtepu16_epi32(_mm256_castsi256_si128(lo)));
+            squares[v][1] = _mm256_add_epi32(squares[v][1], _mm256_cvtepu16_epi32(_mm256_extracti128_si256(lo, 1)));
+            squares[v][2] = _mm256_add_epi32(squares[v][2], _mm256_cvtepu16_epi32(_mm256_castsi256_si128(hi)));
+            squares[v][3] = _mm256_add_epi32(squares[v][3], _mm256_cvtepu16_epi32(_mm256_extracti128_si256(hi, 1)));
+        }
+
+        if(++count == FLUSH_COUNT || i + N * 64 > size)
+        {
+            unsigned int values[8];
+            for(int v = 0; v < N; ++v)
+            {
+                for(int k = 0; k < 4; ++k)
+                {
+                    _mm256_storeu_si256((__m256i*)values, squares[v][k]);
+                    for(int j = 0; j < 8; ++j)
+                        laneSquares[v * 32 + k * 8 + j] += values[j];
+                    squares[v][k] = zero;
+                }
+            }
+            count = 0;
+        }
+    }
+
+    unsigned char laneMaxs[N * 32];
+    for(int v = 0; v < N; ++v)
+        _mm256_storeu_si256((__m256i*)(laneMaxs + v * 32), maxs[v]);
+    addLaneErrors(laneMaxs, laneSquares, N * 32, channelCount, sums);
+    _mm256_zeroupper();
+    return i;
+}
+
+// 4 blocks (16 pixels) per row; the shuffle is per 128-bit lane, so lane 0,
+// 2, 4 and 6 have the sums of block 0 to 3
+PIXEL_TARGET("avx2")
+static int computeBlockSumsAVX2(const unsigned char* luma1, const unsigned char* luma2, int width,
+                                int firstBlock, int lastBlock, BlockSums* blocks)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i ones = _mm256_set1_epi16(1);
+    int i = firstBlock;
+    for(; i + 4 <= lastBlock; i += 4)
+    {
+        __m256i sum1 = zero, sum2 = zero, squares1 = zero, squares2 = zero, products = zero;
+        for(int y = 0; y < BLOCK_SIZE; ++y)
+        {
+            __m256i x = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*)(luma1 + y * width + i * BLOCK_SIZE)));
+            __m256i z = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*)(luma2 + y * width + i * BLOCK_SIZE)));
+            sum1 = _mm256_add_epi32(sum1, _mm256_madd_epi16(x, ones));
+            sum2 = _mm256_add_epi32(sum2, _mm256_madd_epi16(z, ones));
+            squares1 = _mm256_add_epi32(squares1, _mm256_madd_epi16(x, x));
+            squares2 = _mm256_add_epi32(squares2, _mm256_madd_epi16(z, z));
+            products = _mm256_add_epi32(products, _mm256_madd_epi16(x, z));
+        }
+
+        int values[5][8];
+        __m256i* v = (__m256i*)values;
+        _mm256_storeu_si256(v,     _mm256_add_epi32(sum1, _mm256_shuffle_epi32(sum1, _MM_SHUFFLE(2, 3, 0, 1))));
+        _mm256_storeu_si256(v + 1, _mm256_add_epi32(sum2, _mm256_shuffle_epi32(sum2, _MM_SHUFFLE(2, 3, 0, 1))));
+        _mm256_storeu_si256(v + 2, _mm256_add_epi32(squares1, _mm256_shuffle_epi32(squares1, _MM_SHUFFLE(2, 3, 0, 1))));
+        _mm256_storeu_si256(v + 3, _mm256_add_epi32(squares2, _mm256_shuffle_epi32(squares2, _MM_SHUFFLE(2, 3, 0, 1))));
+        _mm256_storeu_si256(v + 4, _mm256_add_epi32(products, _mm256_shuffle_epi32(products, _MM_SHUFFLE(2, 3, 0, 1))));
+        for(int k = 0; k < 4; ++k)
+        {
+            BlockSums& b = blocks[i + k];
+            b.sum1 = values[0][k * 2];
+            b.sum2 = values[1][k * 2];
+            b.squares1 = values[2][k * 2];
+            b.squares2 = values[3][k * 2];
+            b.products = values[4][k * 2];
+        }
+    }
+    _mm256_zeroupper();
+    return i;
+}
+#endif // PIXEL_X86
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// reset the sums before addErrors()
+///////////////////////////////////////////////////////////////////////////////
+void clearErrors(ErrorSums& sums)
+{
+    for(int i = 0; i < CHANNEL_MAX; ++i)
+    {
+        sums.squares[i] = 0;
+        sums.maxErrors[i] = 0;
+    }
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// add the squared errors and the max errors of each channel
+// The sums are not cleared, so the errors of multiple bands can be added.
+///////////////////////////////////////////////////////////////////////////////
+void addErrors(const unsigned char* src1, const unsigned char* src2, std::size_t pixelCount,
+               int channelCount, ErrorSums& sums)
+{
+    if(!src1 || !src2 || channelCount < 1 || channelCount > CHANNEL_MAX) return;
+
+    std::size_t size = pixelCount * channelCount;
+    std::size_t done = 0;
+#ifdef PIXEL_X86
+    Pixel::SimdLevel level = Pixel::getSimdLevel();
+    bool rgb = (channelCount == 3);
+    if(level >= Pixel::SIMD_AVX2)
+        done = rgb ? addErrorsAVX2<3>(src1, src2, size, channelCount, sums) : addErrorsAVX2<1>(src1, src2, size, channelCount, sums);
+    else if(level >= Pixel::SIMD_SSE2)
+        done = rgb ? addErrorsSSE2<3>(src1, src2, size, channelCount, sums) : addErrorsSSE2<1>(src1, src2, size, channelCount, sums);
+#endif
+    addErrors1(src1 + done, src2 + done, (size - done) / channelCount, channelCount, sums);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// PSNR = 10 * log10(255^2 / MSE)
+///////////////////////////////////////////////////////////////////////////////
+double computePsnr(double mse)
+{
+    if(mse <= 0)
+        return PSNR_INFINITE;
+    return 10.0 * log10(255.0 * 255.0 / mse);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Y = (77 * R + 150 * G + 29 * B) / 256
+///////////////////////////////////////////////////////////////////////////////
+void convertToLuma(const unsigned char* src, std::size_t pixelCount, int channelCount, unsigned char* dst)
+{
+    if(!src || !dst) return;
+
+    if(channelCount < 3)
+    {
+        for(std::size_t i = 0; i < pixelCount; ++i, src += channelCount)
+            dst[i] = src[0];
+        return;
+    }
+
+    for(std::size_t i = 0; i < pixelCount; ++i, src += channelCount)
+        dst[i] = (unsigned char)((77 * src[0] + 150 * src[1] + 29 * src[2] + 128) >> 8);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// compute the sums of all 4x4 blocks in the block rows [firstRow, lastRow)
+// The columns at the right of the last block are ignored.
+///////////////////////////////////////////////////////////////////////////////
+void computeBlockSums(const unsigned char* luma1, const unsigned char* luma2, int width,
+                      int firstRow, int lastRow, BlockSums* blocks)
+{
+    if(!luma1 || !luma2 || !blocks) return;
+
+    int blockCount = width / BLOCK_SIZE;
+    for(int row = firstRow; row < lastRow; ++row)
+    {
+        std::size_t offset = (std::size_t)row * BLOCK_SIZE * width;
+        BlockSums* rowBlocks = blocks + (std::size_t)row * blockCount;
+        int done = 0;
+#ifdef PIXEL_X86
+        Pixel::SimdLevel level = Pixel::getSimdLevel();
+        if(level >= Pixel::SIMD_AVX2)
+            done = computeBlockSumsAVX2(luma1 + offset, luma2 + offset, width, 0, blockCount, rowBlocks);
+        else if(level >= Pixel::SIMD_SSE2)
+            done = computeBlockSumsSSE2(luma1 + offset, luma2 + offset, width, 0, blockCount, rowBlocks);
+#endif
+        computeBlockSums1(luma1 + offset, luma2 + offset, width, done, blockCount, rowBlocks);
+    }
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// SSIM = (2 * mu1 * mu2 + C1) * (2 * cov + C2) /
+//        ((mu1^2 + mu2^2 + C1) * (var1 + var2 + C2))
+///////////////////////////////////////////////////////////////////////////////
+double computeSsim(double sum1, double sum2, double squares1, double squares2, double products, double count)
+{
+    double mu1 = sum1 / count;
+    double mu2 = sum2 / count;
+    double var1 = squares1 / count - mu1 * mu1;
+    double var2 = squares2 / count - mu2 * mu2;
+    double cov = products / count - mu1 * mu2;
+    return ((2 * mu1 * mu2 + SSIM_C1) * (2 * cov + SSIM_C2)) /
+           ((mu1 * mu1 + mu2 * mu2 + SSIM_C1) * (var1 + var2 + SSIM_C2));
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// draw the max absolute error of each pixel with black-red-yellow-white colours
+///////////////////////////////////////////////////////////////////////////////
+void drawHeatmap(const unsigned char* src1, const unsigned char* src2, std::size_t pixelCount,
+                 int channelCount, int scale, unsigned char* dst)
+{
+    if(!src1 || !src2 || !dst) return;
+
+    for(std::size_t i = 0; i < pixelCount; ++i, src1 += channelCount, src2 += channelCount, dst += 3)
+    {
+        int error = 0;
+        for(int c = 0; c < channelCount; ++c)
+        {
+            int e = abs((int)src1[c] - (int)src2[c]);
+            if(e > error)
+                error = e;
+        }
+
+        if(error == 0)
+        {
+            // dark gray of the image for reference
+            unsigned char gray;
+            convertToLuma(src1, 1, channelCount, &gray);
+            dst[0] = dst[1] = dst[2] = gray >> 2;
+        }
+        else
+        {
+            int level = HEATMAP_BASE + error * scale * 3;
+            if(level > 765) level = 765;
+            dst[0] = (unsigned char)(level > 255 ? 255 : level);
+            dst[1] = (unsigned char)(level > 510 ? 255 : level > 255 ? level - 255 : 0);
+            dst[2] = (unsigned char)(level > 510 ? level - 510 : 0);
+        }
+    }
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// compare 2 images in 3 passes with all threads
+// 1. errors, luma and heatmap of each band of scanlines
+// 2. sums of 4x4 blocks of luma for SSIM
+// 3. SSIM of 8x8 windows (2x2 blocks) at every 4 pixels
+// The sums of each band are added in order, so the results do not depend on
+// the number of threads.
+///////////////////////////////////////////////////////////////////////////////
+Result compareImages(const unsigned char* image1, const unsigned char* image2, int width, int height,
+                     int channelCount, ThreadPool& threadPool, unsigned char* heatmap, int heatmapScale)
+{
+    Result result = {};
+    result.channelCount = channelCount;
+    if(!image1 || !image2 || width <= 0 || height <= 0 || channelCount < 1 || channelCount > CHANNEL_MAX)
+        return result;
+
+    std::size_t pixelCount = (std::size_t)width * height;
+    std::size_t rowSize = (std::size_t)width * channelCount;
+    std::vector<unsigned char> luma1(pixelCount);
+    std::vector<unsigned char> luma2(pixelCount);
+
+    // pass 1: both images are read once
+    int bandRows = ThreadPool::computeBandRows(rowSize * 2);
+    int bandCount = (height + bandRows - 1) / bandRows;
+    std::vector<ErrorSums> bandErrors(bandCount);
+    threadPool.run(height, bandRows, [&](int firstRow, int lastRow)
+    {
+        std::size_t offset = firstRow * rowSize;
+        std::size_t count = (std::size_t)(lastRow - firstRow) * width;
+        ErrorSums& sums = bandErrors[firstRow / bandRows];
+        clearErrors(sums);
+        addErrors(image1 + offset, image2 + offset, count, channelCount, sums);
+        convertToLuma(image1 + offset, count, channelCount, &luma1[(std::size_t)firstRow * width]);
+        convertToLuma(image2 + offset, count, channelCount, &luma2[(std::size_t)firstRow * width]);
+        if(heatmap)
+            drawHeatmap(image1 + offset, image2 + offset, count, channelCount, heatmapScale,
+                        heatmap + (std::size_t)firstRow * width * 3);
+    });
+
+    ErrorSums sums;
+    clearErrors(sums);
+    for(int i = 0; i < bandCount; ++i)
+    {
+        for(int c = 0; c < channelCount; ++c)
+        {
+            sums.squares[c] += bandErrors[i].squares[c];
+            if(bandErrors[i].maxErrors[c] > sums.maxErrors[c])
+                sums.maxErrors[c] = bandErrors[i].maxErrors[c];
+        }
+    }
+
+    double totalSquares = 0;
+    for(int c = 0; c < channelCount; ++c)
+    {
+        result.maxErrors[c] = sums.maxErrors[c];
+        result.psnrs[c] = computePsnr((double)sums.squares[c] / pixelCount);
+        if(sums.maxErrors[c] > result.maxError)
+            result.maxError = sums.maxErrors[c];
+        totalSquares += (double)sums.squares[c];
+    }
+    result.psnr = computePsnr(totalSquares / (pixelCount * channelCount));
+
+    // an image smaller than a window is a single window
+    int blockWidth = width / BLOCK_SIZE;
+    int blockHeight = height / BLOCK_SIZE;
+    if(blockWidth < 2 || blockHeight < 2)
+    {
+        double s1 = 0, s2 = 0, s11 = 0, s22 = 0, s12 = 0;
+        for(std::size_t i = 0; i < pixelCount; ++i)
+        {
+            s1 += luma1[i];
+            s2 += luma2[i];
+            s11 += luma1[i] * luma1[i];
+            s22 += luma2[i] * luma2[i];
+            s12 += luma1[i] * luma2[i];
+        }
+        result.ssim = computeSsim(s1, s2, s11, s22, s12, (double)pixelCount);
+        return result;
+    }
+
+    // pass 2: a block row is 4 scanlines of both luma images
+    std::vector<BlockSums> blocks((std::size_t)blockWidth * blockHeight);
+    int blockRows = ThreadPool::computeBandRows((std::size_t)width * BLOCK_SIZE * 2);
+    threadPool.run(blockHeight, blockRows, [&](int firstRow, int lastRow)
+    {
+        computeBlockSums(&luma1[0], &luma2[0], width, firstRow, lastRow, &blocks[0]);
+    });
+
+    // pass 3: a window row reads 2 block rows
+    int windowWidth = blockWidth - 1;
+    int windowHeight = blockHeight - 1;
+    int windowRows = ThreadPool::computeBandRows((std::size_t)blockWidth * sizeof(BlockSums) * 2);
+    std::vector<double> bandSsims((windowHeight + windowRows - 1) / windowRows);
+    threadPool.run(windowHeight, windowRows, [&](int firstRow, int lastRow)
+    {
+        double sum = 0;
+        for(int y = firstRow; y < lastRow; ++y)
+        {
+            const BlockSums* b0 = &blocks[(std::size_t)y * blockWidth];
+            const BlockSums* b1 = b0 + blockWidth;
+            for(int x = 0; x < windowWidth; ++x)
+            {
+                sum += computeSsim(b0[x].sum1 + b0[x + 1].sum1 + b1[x].sum1 + b1[x + 1].sum1,
+                                   b0[x].sum2 + b0[x + 1].sum2 + b1[x].sum2 + b1[x + 1].sum2,
+                                   b0[x].squares1 + b0[x + 1].squares1 + b1[x].squares1 + b1[x + 1].squares1,
+                                   b0[x].squares2 + b0[x + 1].squares2 + b1[x].squares2 + b1[x + 1].squares2,
+                                   b0[x].products + b0[x + 1].products + b1[x].products + b1[x + 1].products,
+                                   BLOCK_SIZE * BLOCK_SIZE * 4);
+            }
+        }
+        bandSsims[firstRow / windowRows] = sum;
+    });
+
+    double ssimSum = 0;
+    for(std::size_t i = 0; i < bandSsims.size(); ++i)
+        ssimSum += bandSsims[i];
+    result.ssim = ssimSum / ((double)windowWidth * windowHeight);
+    return result;
+}
+
+} // namespace Compare
@@ -0,0 +1,90 @@
+///////////////////////////////////////////////////////////////////////////////
+// compareUtils.h
+// ==============
+// Image comparison for regression tests of rendered frames
+// compareImages() computes the max error and PSNR of each channel, and the
+// mean SSIM of luma, of 2 images of the same size and format (8-bit gray, RGB
+// or RGBA). It can also draw a heatmap of the differences.
+//
+// The kernels use the SIMD level of pixelUtils (Pixel::getSimdLevel()), and
+// the images are processed in bands of scanlines by all threads of the pool.
+// SSIM uses 8x8 windows at every 4 pixels; the sums of each 4x4 block are
+// computed once with SIMD, and a window adds up its 2x2 blocks. Integer sums
+// make the results the same at all SIMD levels and thread counts.
+//
+//  AUTHOR: Song Ho Ahn (song.ahn@gmail.com)
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef COMPARE_UTILS_H
+#define COMPARE_UTILS_H
+
+#include <cstddef>
+
+class ThreadPool;
+
+namespace Compare
+{
+    const int CHANNEL_MAX = 4;
+    const double PSNR_INFINITE = 1.0e9;         // PSNR of identical images
+
+    // sums of the differences, accumulated by addErrors()
+    struct ErrorSums
+    {
+        unsigned long long squares[CHANNEL_MAX];    // sum of squared errors per channel
+        int maxErrors[CHANNEL_MAX];                 // max absolute error per channel
+    };
+
+    // sums of the luma values of a 4x4 block for SSIM
+    struct BlockSums
+    {
+        int sum1, sum2;                             // sum of x, y
+        int squares1, squares2;                     // sum of x^2, y^2
+        int products;                               // sum of x*y
+    };
+
+    // result of compareImages()
+    struct Result
+    {
+        int channelCount;
+        int maxErrors[CHANNEL_MAX];                 // per channel
+        double psnrs[CHANNEL_MAX];                  // dB per channel
+        int maxError;                               // max of all channels
+        double psnr;                                // dB of all channels
+        double ssim;                                // mean SSIM of luma, 1 if identical
+    };
+
+    void clearErrors(ErrorSums& sums);
+
+    // add the errors of count bytes (pixelCount * channelCount)
+    void addErrors(const unsigned char* src1, const unsigned char* src2, std::size_t pixelCount,
+                   int channelCount, ErrorSums& sums);
+
+    // PSNR in dB of 8-bit values from the mean squared error
+    double computePsnr(double mse);
+
+    // 8-bit luma of RGB(A) with BT.601 weights, gray is copied as is
+    void convertToLuma(const unsigned char* src, std::size_t pixelCount, int channelCount, unsigned char* dst);
+
+    // sums of the 4x4 blocks of the block rows [firstRow, lastRow) of 2 luma
+    // images, blocks has (width / 4) * (height / 4) elements
+    void computeBlockSums(const unsigned char* luma1, const unsigned char* luma2, int width,
+                          int firstRow, int lastRow, BlockSums* blocks);
+
+    // SSIM of the sums of 1 window
+    double computeSsim(double sum1, double sum2, double squares1, double squares2, double products, double count);
+
+    // heatmap of the max absolute error of each pixel, scaled by scale
+    // The same pixels are the dark gray of image1, and the different pixels are
+    // red, yellow to white. dst is RGB, 3 bytes per pixel.
+    void drawHeatmap(const unsigned char* src1, const unsigned char* src2, std::size_t pixelCount,
+                     int channelCount, int scale, unsigned char* dst);
+
+    // compare 2 images with all threads of the pool
+    // heatmap is RGB image (width * height * 3 bytes), or NULL to skip it.
+    Result compareImages(const unsigned char* image1, const unsigned char* image2, int width, int height,
+                         int channelCount, ThreadPool& threadPool, unsigned char* heatmap=0, int heatmapScale=8);
+}
+
+#endif // COMPARE_UTILS_H
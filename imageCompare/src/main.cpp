@@ -0,0 +1,453 @@
+///////////////////////////////////////////////////////////////////////////////
+// main.cpp
+// ========
+// Command-line tool to compare rendered frames with golden images
+// It loads 2 images (TGA, BMP or QOI) with the image codecs of the samples,
+// and prints the max error and PSNR of each channel, and SSIM of luma. The
+// exit code is 1 if a threshold is exceeded, so it can be used in regression
+// test scripts, e.g.,
+//     imageCompare --max-error 2 --min-ssim 0.995 golden.tga frame.tga
+// Without thresholds, the images must be identical.
+//
+// With --list FILE, each line of the file has a pair of images (and an
+// optional heatmap file), so thousands of images are compared in a process
+// with the same worker threads. Each line prints the result of a pair.
+//
+// exit codes:
+//     0   all images are within the thresholds
+//     1   an image exceeds a threshold
+//     2   invalid options, failed to load, or different sizes
+//
+//  AUTHOR: Song Ho Ahn (song.ahn@gmail.com)
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <algorithm>
+#include "compareUtils.h"
+#include "pixelUtils.h"                 // SIMD level
+#include "ThreadPool.h"
+#include "Timer.h"
+#include "Tga.h"
+#include "Bmp.h"
+#include "Qoi.h"
+
+
+
+// decoded image, RGB(A) order and top-to-bottom
+struct ImageData
+{
+    int width;
+    int height;
+    int channelCount;
+    std::vector<unsigned char> data;
+};
+
+// command-line options
+struct Options
+{
+    std::string fileName1;
+    std::string fileName2;
+    std::string heatmapFile;
+    std::string listFile;
+    int heatmapScale;
+    int maxError;                       // -1 is off
+    double minPsnr;                     // 0 is off
+    double minSsim;                     // 0 is off
+    int threadCount;                    // 0 is all CPU cores
+    std::string simd;
+    bool quiet;                         // print the failed pairs only
+};
+
+// result of a pair of images
+enum Status
+{
+    STATUS_PASS = 0,
+    STATUS_FAIL,
+    STATUS_ERROR
+};
+
+bool parseOptions(int argc, char** argv, Options& options);
+void printUsage(const char* name);
+bool loadImage(const std::string& fileName, ImageData& image);
+Status comparePair(const std::string& fileName1, const std::string& fileName2,
+                   const std::string& heatmapFile, const Options& options, bool verbose);
+int compareList(const Options& options);
+std::string formatPsnr(double psnr);
+
+// constants
+const int HEATMAP_SCALE = 8;            // default error scale of heatmap
+const char* CHANNEL_NAMES[] = {"R", "G", "B", "A"};
+const char* GRAY_NAMES[] = {"Y", "A"};
+const char* STATUS_NAMES[] = {"PASS", "FAIL", "ERROR"};
+
+// global variables
+ThreadPool threadPool;                  // all CPU cores by default
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+int main(int argc, char** argv)
+{
+    Options options;
+    options.heatmapScale = HEATMAP_SCALE;
+    options.maxError = -1;
+    options.minPsnr = 0;
+    options.minSsim = 0;
+    options.threadCount = 0;
+    options.quiet = false;
+    if(!parseOptions(argc, argv, options))
+    {
+        printUsage(argv[0]);
+        return STATUS_ERROR;
+    }
+
+    if(options.threadCount > 0)
+        threadPool.setThreadCount(options.threadCount);
+
+    if(options.simd == "none")
+        Pixel::setSimdLevel(Pixel::SIMD_NONE);
+    else if(options.simd == "sse2")
+        Pixel::setSimdLevel(Pixel::SIMD_SSE2);
+    else if(options.simd == "ssse3")
+        Pixel::setSimdLevel(Pixel::SIMD_SSSE3);
+    else if(options.simd == "avx2")
+        Pixel::setSimdLevel(Pixel::SIMD_AVX2);
+
+    if(!options.listFile.empty())
+        return compareList(options);
+
+    return comparePair(options.fileName1, options.fileName2, options.heatmapFile, options, !options.quiet);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// parse "--name value" or "--name=value" options and 2 image files
+///////////////////////////////////////////////////////////////////////////////
+bool parseOptions(int argc, char** argv, Options& options)
+{
+    std::vector<std::string> files;
+    for(int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if(arg.compare(0, 2, "--") != 0)
+        {
+            files.push_back(arg);
+            continue;
+        }
+
+        // split "--name=value"
+        std::string value;
+        bool hasValue = false;
+        std::size_t pos = arg.find('=');
+        if(pos != std::string::npos)
+        {
+            value = arg.substr(pos + 1);
+            arg = arg.substr(0, pos);
+            hasValue = true;
+        }
+
+        if(arg == "--quiet")
+        {
+            options.quiet = true;
+            continue;
+        }
+        else if(arg == "--help")
+        {
+            return false;
+        }
+
+        // the other options need a value
+        if(!hasValue)
+        {
+            if(i + 1 >= argc)
+            {
+                std::cout << "[ERROR] " << arg << " needs a value." << std::endl;
+                return false;
+            }
+            value = argv[++i];
+        }
+
+        char* end = 0;
+        double number = std::strtod(value.c_str(), &end);
+        bool isNumber = !value.empty() && *end == '\0';
+
+        if(arg == "--heatmap")
+            options.heatmapFile = value;
+        else if(arg == "--list")
+            options.listFile = value;
+        else if(arg == "--simd" && (value == "none" || value == "sse2" || value == "ssse3" || value == "avx2"))
+            options.simd = value;
+        else if(arg == "--scale" && isNumber && number >= 1)
+            options.heatmapScale = (int)number;
+        else if(arg == "--max-error" && isNumber && number >= 0 && number <= 255)
+            options.maxError = (int)number;
+        else if(arg == "--min-psnr" && isNumber && number >= 0)
+            options.minPsnr = number;
+        else if(arg == "--min-ssim" && isNumber && number >= 0 && number <= 1)
+            options.minSsim = number;
+        else if(arg == "--threads" && isNumber && number >= 0)
+            options.threadCount = (int)number;
+        else
+        {
+            std::cout << "[ERROR] Invalid option: " << arg << " " << value << std::endl;
+            return false;
+        }
+    }
+
+    if(options.listFile.empty())
+    {
+        if(files.size() != 2)
+        {
+            std::cout << "[ERROR] 2 image files are required." << std::endl;
+            return false;
+        }
+        options.fileName1 = files[0];
+        options.fileName2 = files[1];
+    }
+    else if(!files.empty() || !options.heatmapFile.empty())
+    {
+        std::cout << "[ERROR] Image files are in the list file with --list." << std::endl;
+        return false;
+    }
+    return true;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// print the options with the default values
+///////////////////////////////////////////////////////////////////////////////
+void printUsage(const char* name)
+{
+    std::cout << "Usage: " << name << " [options] image1 image2\n"
+              << "       " << name << " [options] --list FILE\n"
+              << "  --max-error N       fail if the error of a channel > N (off)\n"
+              << "  --min-psnr DB       fail if PSNR of all channels < DB (off)\n"
+              << "  --min-ssim V        fail if SSIM < V, 0 ~ 1 (off)\n"
+              << "  --heatmap FILE      write the differences to TGA file\n"
+              << "  --scale N           error scale of heatmap (" << HEATMAP_SCALE << ")\n"
+              << "  --list FILE         compare the pairs of each line: image1 image2 [heatmap]\n"
+              << "  --threads N         # of threads, 0 is all CPU cores (0)\n"
+              << "  --simd NAME         none, sse2, ssse3 or avx2 (" << Pixel::getSimdLevelName(Pixel::getMaxSimdLevel()) << ")\n"
+              << "  --quiet             print the failed images only\n"
+              << "Without thresholds, the images must be identical.\n"
+              << std::flush;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// read and decode TGA, BMP or QOI file by the file extension
+///////////////////////////////////////////////////////////////////////////////
+bool loadImage(const std::string& fileName, ImageData& image)
+{
+    std::string ext;
+    std::size_t pos = fileName.find_last_of('.');
+    if(pos != std::string::npos)
+        ext = fileName.substr(pos + 1);
+    std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+
+    int width, height, bitCount;
+    const unsigned char* data;
+    const char* error;
+    Image::Tga tga;
+    Image::Bmp bmp;
+    Image::Qoi qoi;
+    if(ext == "tga")
+    {
+        tga.read(fileName.c_str());
+        width = tga.getWidth();
+        height = tga.getHeight();
+        bitCount = tga.getBitCount();
+        data = tga.getDataRGB();
+        error = tga.getError();
+    }
+    else if(ext == "bmp")
+    {
+        bmp.read(fileName.c_str());
+        width = bmp.getWidth();
+        height = bmp.getHeight();
+        bitCount = bmp.getBitCount();
+        data = bmp.getDataRGB();
+        error = bmp.getError();
+    }
+    else if(ext == "qoi")
+    {
+        qoi.read(fileName.c_str());
+        width = qoi.getWidth();
+        height = qoi.getHeight();
+        bitCount = qoi.getBitCount();
+        data = qoi.getData();
+        error = qoi.getError();
+    }
+    else
+    {
+        std::cout << "[ERROR] Unknown image format: " << fileName << " (.tga, .bmp or .qoi)" << std::endl;
+        return false;
+    }
+
+    if(!data)
+    {
+        std::cout << "[ERROR] Failed to load " << fileName << ": " << error << std::endl;
+        return false;
+    }
+
+    image.width = width;
+    image.height = height;
+    image.channelCount = bitCount / 8;
+    image.data.assign(data, data + (std::size_t)width * height * image.channelCount);
+    return true;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// compare 2 image files, and write the heatmap if heatmapFile is not empty
+// verbose prints the errors of each channel, otherwise a line per pair.
+///////////////////////////////////////////////////////////////////////////////
+Status comparePair(const std::string& fileName1, const std::string& fileName2,
+                   const std::string& heatmapFile, const Options& options, bool verbose)
+{
+    Timer timer;
+    timer.start();
+
+    ImageData image1, image2;
+    if(!loadImage(fileName1, image1) || !loadImage(fileName2, image2))
+        return STATUS_ERROR;
+
+    if(image1.width != image2.width || image1.height != image2.height || image1.channelCount != image2.channelCount)
+    {
+        std::cout << "[ERROR] Different image formats: " << fileName1 << " (" << image1.width << "x" << image1.height
+                  << ", " << image1.channelCount * 8 << " bits), " << fileName2 << " (" << image2.width << "x"
+                  << image2.height << ", " << image2.channelCount * 8 << " bits)" << std::endl;
+        return STATUS_ERROR;
+    }
+
+    std::vector<unsigned char> heatmap;
+    if(!heatmapFile.empty())
+        heatmap.resize((std::size_t)image1.width * image1.height * 3);
+
+    Compare::Result result = Compare::compareImages(&image1.data[0], &image2.data[0], image1.width, image1.height,
+                                                    image1.channelCount, threadPool,
+                                                    heatmap.empty() ? 0 : &heatmap[0], options.heatmapScale);
+
+    // without thresholds, any difference fails
+    bool failed = false;
+    if(options.maxError >= 0 && result.maxError > options.maxError)
+        failed = true;
+    if(options.minPsnr > 0 && result.psnr < options.minPsnr)
+        failed = true;
+    if(options.minSsim > 0 && result.ssim < options.minSsim)
+        failed = true;
+    if(options.maxError < 0 && options.minPsnr <= 0 && options.minSsim <= 0 && result.maxError > 0)
+        failed = true;
+    Status status = failed ? STATUS_FAIL : STATUS_PASS;
+
+    if(!heatmap.empty() && !Image::Tga::save(heatmapFile.c_str(), image1.width, image1.height, 3, &heatmap[0]))
+    {
+        std::cout << "[ERROR] Failed to write " << heatmapFile << std::endl;
+        return STATUS_ERROR;
+    }
+    timer.stop();
+
+    const char** names = (image1.channelCount < 3) ? GRAY_NAMES : CHANNEL_NAMES;
+    if(verbose)
+    {
+        std::cout << "Image 1: " << fileName1 << " (" << image1.width << "x" << image1.height << ", "
+                  << image1.channelCount * 8 << " bits)\n"
+                  << "Image 2: " << fileName2 << "\n"
+                  << "Channel  Max Error  PSNR (dB)\n";
+        for(int c = 0; c < result.channelCount; ++c)
+            std::cout << std::left << std::setw(7) << names[c] << std::right << std::setw(11) << result.maxErrors[c]
+                      << std::setw(11) << formatPsnr(result.psnrs[c]) << "\n";
+        std::cout << std::left << std::setw(7) << "All" << std::right << std::setw(11) << result.maxError
+                  << std::setw(11) << formatPsnr(result.psnr) << "\n"
+                  << "SSIM: " << std::fixed << std::setprecision(6) << result.ssim << "\n"
+                  << "Time: " << std::setprecision(3) << timer.getElapsedTimeInMilliSec() << " ms ("
+                  << Pixel::getSimdLevelName(Pixel::getSimdLevel()) << ", " << threadPool.getThreadCount() << " threads)\n";
+        if(!heatmapFile.empty())
+            std::cout << "Heatmap: " << heatmapFile << "\n";
+        std::cout << "Result: " << STATUS_NAMES[status] << std::endl;
+    }
+    else if(status != STATUS_PASS || !options.quiet)
+    {
+        std::cout << STATUS_NAMES[status] << " " << fileName1 << " " << fileName2 << ": max error ";
+        for(int c = 0; c < result.channelCount; ++c)
+            std::cout << (c > 0 ? "," : "") << result.maxErrors[c];
+        std::cout << ", PSNR " << formatPsnr(result.psnr) << " dB, SSIM " << std::fixed << std::setprecision(6)
+                  << result.ssim << std::endl;
+    }
+    std::cout << std::resetiosflags(std::ios_base::fixed | std::ios_base::floatfield);
+    return status;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// compare the pairs of images in the list file
+// A line is "image1 image2 [heatmap]", and empty lines and lines starting with
+// '#' are skipped. It returns the worst status of all pairs.
+///////////////////////////////////////////////////////////////////////////////
+int compareList(const Options& options)
+{
+    std::ifstream inFile(options.listFile.c_str());
+    if(!inFile)
+    {
+        std::cout << "[ERROR] Failed to open " << options.listFile << std::endl;
+        return STATUS_ERROR;
+    }
+
+    Timer timer;
+    timer.start();
+
+    int counts[3] = {0, 0, 0};          // per status
+    std::string line;
+    while(std::getline(inFile, line))
+    {
+        std::istringstream ss(line);
+        std::string fileName1, fileName2, heatmapFile;
+        ss >> fileName1 >> fileName2 >> heatmapFile;
+        if(fileName1.empty() || fileName1[0] == '#')
+            continue;
+
+        Status status = STATUS_ERROR;
+        if(fileName2.empty())
+            std::cout << "[ERROR] No second image: " << line << std::endl;
+        else
+            status = comparePair(fileName1, fileName2, heatmapFile, options, false);
+        ++counts[status];
+    }
+    timer.stop();
+
+    std::cout << counts[0] + counts[1] + counts[2] << " pairs: " << counts[STATUS_PASS] << " passed, "
+              << counts[STATUS_FAIL] << " failed, " << counts[STATUS_ERROR] << " errors ("
+              << std::fixed << std::setprecision(3) << timer.getElapsedTime() << " sec)" << std::endl;
+
+    if(counts[STATUS_ERROR] > 0)
+        return STATUS_ERROR;
+    return (counts[STATUS_FAIL] > 0) ? STATUS_FAIL : STATUS_PASS;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// PSNR with 2 decimals, or "inf" for identical images
+///////////////////////////////////////////////////////////////////////////////
+std::string formatPsnr(double psnr)
+{
+    if(psnr >= Compare::PSNR_INFINITE)
+        return "inf";
+
+    std::ostringstream ss;
+    ss << std::fixed << std::setprecision(2) << psnr;
+    return ss.str();
+}
@@ -0,0 +1,83 @@
+///////////////////////////////////////////////////////////////////////////////
+// FrameQueue.cpp
+// ==============
+// Bounded lock-free queue of frame buffer indices between 2 threads
+//
+//  AUTHOR: Song Ho Ahn (song.ahn@gmail.com)
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#include "FrameQueue.h"
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// ctor
+///////////////////////////////////////////////////////////////////////////////
+FrameQueue::FrameQueue() : mask(0), capacity(0), head(0), tail(0)
+{
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// allocate the slots of the next power of 2, so the indices wrap around
+// 2^32 without a gap
+///////////////////////////////////////////////////////////////////////////////
+void FrameQueue::init(int capacity)
+{
+    this->capacity = (capacity > 0) ? capacity : 1;
+
+    unsigned int slotCount = 1;
+    while(slotCount < (unsigned int)this->capacity)
+        slotCount <<= 1;
+    values.assign(slotCount, 0);
+    mask = slotCount - 1;
+
+    head.store(0);
+    tail.store(0);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// add a value at the tail, return false if the queue is full
+// The release store makes the value visible before the new tail.
+///////////////////////////////////////////////////////////////////////////////
+bool FrameQueue::push(int value)
+{
+    unsigned int t = tail.load(std::memory_order_relaxed);
+    if(t - head.load(std::memory_order_acquire) >= (unsigned int)capacity)
+        return false;
+
+    values[t & mask] = value;
+    tail.store(t + 1, std::memory_order_release);
+    return true;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// remove a value from the head, return false if the queue is empty
+///////////////////////////////////////////////////////////////////////////////
+bool FrameQueue::pop(int& value)
+{
+    unsigned int h = head.load(std::memory_order_relaxed);
+    if(h == tail.load(std::memory_order_acquire))
+        return false;
+
+    value = values[h & mask];
+    head.store(h + 1, std::memory_order_release);
+    return true;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// return the number of values, it may be changed by the other thread
+///////////////////////////////////////////////////////////////////////////////
+int FrameQueue::getSize() const
+{
+    return (int)(tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire));
+}
@@ -0,0 +1,52 @@
+///////////////////////////////////////////////////////////////////////////////
+// FrameQueue.h
+// ============
+// Bounded lock-free queue of frame buffer indices between 2 threads
+// Only one thread calls push() and only one other thread calls pop(), so the
+// head and tail are updated by atomics without lock. push() returns false if
+// the queue is full, and pop() returns false if the queue is empty, so the
+// caller decides to wait or to give up.
+//
+//  AUTHOR: Song Ho Ahn (song.ahn@gmail.com)
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef FRAME_QUEUE_H
+#define FRAME_QUEUE_H
+
+#include <vector>
+#include <atomic>
+
+class FrameQueue
+{
+public:
+    // ctor/dtor
+    FrameQueue();
+    ~FrameQueue() {}
+
+    // set the max number of values and clear the queue, not thread-safe
+    void init(int capacity);
+
+    bool push(int value);                       // producer thread only
+    bool pop(int& value);                       // consumer thread only
+
+    // getters
+    int getCapacity() const                     { return capacity; }
+    int getSize() const;                        // # of values in the queue
+    bool isEmpty() const                        { return getSize() == 0; }
+
+protected:
+
+private:
+    // member variables
+    std::vector<int> values;                    // slots of power of 2
+    unsigned int mask;                          // # of slots - 1
+    int capacity;
+
+    // head and tail are on separate cache lines, written by different threads
+    alignas(64) std::atomic<unsigned int> head; // next value to pop, written by consumer
+    alignas(64) std::atomic<unsigned int> tail; // next slot to push, written by producer
+};
+
+#endif // FRAME_QUEUE_H
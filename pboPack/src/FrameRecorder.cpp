@@ -0,0 +1,381 @@
+///////////////////////////////////////////////////////////////////////////////
+// FrameRecorder.cpp
+// =================
+// Background recorder of the read-back frames (BGRA or RGBA, bottom-up rows)
+//
+//  AUTHOR: Song Ho Ahn (song.ahn@gmail.com)
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cstring>
+#include <cstdio>
+#include <chrono>
+#include "FrameRecorder.h"
+#include "Qoi.h"                        // lossless image encoder
+
+// constants
+static const int PIXEL_SIZE = 4;                // bytes per pixel, BGRA or RGBA
+static const int FRAME_RATE = 30;               // frame rate in Y4M header
+static const int WRITER_SLEEP_MS = 1;           // writer sleep if no frame
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// ctor
+///////////////////////////////////////////////////////////////////////////////
+FrameRecorder::FrameRecorder() : format(FORMAT_UNKNOWN), policy(POLICY_DROP), matrix(Yuv::BT601),
+                                 width(0), height(0), bgra(true), opened(false), stopFlag(false), addedCount(0),
+                                 droppedCount(0), writtenCount(0)
+{
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// dtor
+///////////////////////////////////////////////////////////////////////////////
+FrameRecorder::~FrameRecorder()
+{
+    close();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// allocate the pool of buffers, open the file, then start the writer thread
+// All buffers are in the free queue at first.
+///////////////////////////////////////////////////////////////////////////////
+bool FrameRecorder::open(const std::string& fileName, int width, int height, bool bgra,
+                         int bufferCount, Policy policy, Yuv::Matrix matrix)
+{
+    close();
+
+    this->fileName = fileName;
+    this->width = width;
+    this->height = height;
+    this->bgra = bgra;
+    this->policy = policy;
+    this->matrix = matrix;
+    addedCount = droppedCount = 0;
+    writtenCount.store(0);
+    errorMessage.clear();
+
+    format = getFormat(fileName);
+    if(format == FORMAT_UNKNOWN)
+    {
+        errorMessage = "Unknown capture format: " + fileName + " (.raw, .y4m, .tga or .qoi)";
+        return false;
+    }
+    if(width <= 0 || height <= 0)
+    {
+        errorMessage = "Invalid capture size";
+        return false;
+    }
+
+    // TGA and QOI open a file per frame
+    if(format != FORMAT_TGA && format != FORMAT_QOI)
+    {
+        file.open(fileName.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+        if(!file)
+        {
+            errorMessage = "Failed to open " + fileName;
+            return false;
+        }
+    }
+
+    // "C420jpeg" may be read as full range, so the range is tagged explicitly
+    if(format == FORMAT_Y4M)
+    {
+        file << "YUV4MPEG2 W" << width << " H" << height << " F" << FRAME_RATE
+             << ":1 Ip A1:1 C420 XCOLORRANGE=LIMITED\n";
+    }
+
+    if(bufferCount < 1)
+        bufferCount = 1;
+    std::size_t frameSize = (std::size_t)width * height * PIXEL_SIZE;
+    buffers.assign(bufferCount, std::vector<unsigned char>(frameSize));
+    freeQueue.init(bufferCount);
+    readyQueue.init(bufferCount);
+    for(int i = 0; i < bufferCount; ++i)
+        freeQueue.push(i);
+
+    stopFlag.store(false);
+    writer = std::thread(&FrameRecorder::runWriter, this);
+    opened = true;
+    return true;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// stop the writer after all queued frames are written, then release buffers
+///////////////////////////////////////////////////////////////////////////////
+void FrameRecorder::close()
+{
+    if(!opened)
+        return;
+
+    stopFlag.store(true);
+    if(writer.joinable())
+        writer.join();
+
+    if(file.is_open())
+        file.close();
+    buffers.clear();
+    rowBuffer.clear();
+    yuvBuffer.clear();
+    qoiBuffer.clear();
+    opened = false;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// copy a frame into a free buffer, and queue it to the writer
+// POLICY_BLOCK yields the render thread until the writer returns a buffer.
+///////////////////////////////////////////////////////////////////////////////
+bool FrameRecorder::addFrame(const unsigned char* src)
+{
+    if(!opened || !src)
+        return false;
+
+    int index;
+    while(!freeQueue.pop(index))
+    {
+        if(policy == POLICY_DROP)
+        {
+            ++droppedCount;
+            return false;
+        }
+        std::this_thread::yield();
+    }
+
+    memcpy(&buffers[index][0], src, buffers[index].size());
+    readyQueue.push(index);                     // never full, same capacity as the pool
+    ++addedCount;
+    return true;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// return the output format from the file extension
+///////////////////////////////////////////////////////////////////////////////
+FrameRecorder::Format FrameRecorder::getFormat(const std::string& fileName)
+{
+    std::size_t pos = fileName.rfind('.');
+    if(pos == std::string::npos)
+        return FORMAT_UNKNOWN;
+
+    std::string ext = fileName.substr(pos);
+    if(ext == ".raw")
+        return FORMAT_RAW;
+    else if(ext == ".y4m")
+        return FORMAT_Y4M;
+    else if(ext == ".tga")
+        return FORMAT_TGA;
+    else if(ext == ".qoi")
+        return FORMAT_QOI;
+    else
+        return FORMAT_UNKNOWN;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// return the name of policy for the options and reports
+///////////////////////////////////////////////////////////////////////////////
+const char* FrameRecorder::getPolicyName(Policy policy)
+{
+    return (policy == POLICY_BLOCK) ? "block" : "drop";
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// writer thread: write the queued frames until close() is called and the
+// queue is empty
+// After a write error, the frames are returned to the pool without writing,
+// so the render thread is never blocked by a failed writer.
+///////////////////////////////////////////////////////////////////////////////
+void FrameRecorder::runWriter()
+{
+    bool failed = false;
+    while(true)
+    {
+        int index;
+        if(!readyQueue.pop(index))
+        {
+            if(stopFlag.load())
+                break;
+            std::this_thread::sleep_for(std::chrono::milliseconds(WRITER_SLEEP_MS));
+            continue;
+        }
+
+        if(!failed)
+        {
+            if(writeFrame(&buffers[index][0]))
+                writtenCount.fetch_add(1);
+            else
+                failed = true;
+        }
+        freeQueue.push(index);
+    }
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// write a frame in the format of the file
+///////////////////////////////////////////////////////////////////////////////
+bool FrameRecorder::writeFrame(const unsigned char* frame)
+{
+    if(format == FORMAT_RAW)
+        return writeRaw(frame);
+    else if(format == FORMAT_Y4M)
+        return writeY4m(frame);
+    else if(format == FORMAT_TGA)
+        return writeTga(frame);
+    else
+        return writeQoi(frame);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// write the scanlines from top to bottom as is
+///////////////////////////////////////////////////////////////////////////////
+bool FrameRecorder::writeRaw(const unsigned char* frame)
+{
+    std::size_t pitch = (std::size_t)width * PIXEL_SIZE;
+    for(int i = height - 1; i >= 0; --i)
+        file.write((const char*)frame + i * pitch, pitch);
+
+    if(!file)
+    {
+        errorMessage = "Failed to write " + fileName;
+        return false;
+    }
+    return true;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// write a frame of Y4M, "FRAME" and the Y, U and V planes
+///////////////////////////////////////////////////////////////////////////////
+bool FrameRecorder::writeY4m(const unsigned char* frame)
+{
+    yuvBuffer.resize(Yuv::getFrameSize(width, height));
+    Yuv::convertToYuv420(frame, width, height, bgra, true, matrix, &yuvBuffer[0],
+                         0, Yuv::getChromaHeight(height));
+    file << "FRAME\n";
+    file.write((const char*)&yuvBuffer[0], yuvBuffer.size());
+
+    if(!file)
+    {
+        errorMessage = "Failed to write " + fileName;
+        return false;
+    }
+    return true;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// write a frame to a numbered TGA file, uncompressed 32-bit BGRA
+// TGA stores the scanlines from bottom to top, same as glReadPixels().
+///////////////////////////////////////////////////////////////////////////////
+bool FrameRecorder::writeTga(const unsigned char* frame)
+{
+    std::string name = getSequenceName(".tga");
+
+    std::ofstream tga(name.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+    if(!tga)
+    {
+        errorMessage = "Failed to open " + name;
+        return false;
+    }
+
+    unsigned char header[18] = {0};
+    header[2] = 2;                              // uncompressed true-color
+    header[12] = (unsigned char)(width & 0xff);
+    header[13] = (unsigned char)(width >> 8);
+    header[14] = (unsigned char)(height & 0xff);
+    header[15] = (unsigned char)(height >> 8);
+    header[16] = 32;                            // bits per pixel
+    header[17] = 8;                             // 8-bit alpha, bottom-left origin
+    tga.write((const char*)header, sizeof(header));
+
+    std::size_t pitch = (std::size_t)width * PIXEL_SIZE;
+    if(bgra)
+    {
+        tga.write((const char*)frame, pitch * height);
+    }
+    else
+    {
+        // swap R and B of RGBA
+        rowBuffer.resize(pitch);
+        for(int i = 0; i < height; ++i)
+        {
+            const unsigned char* src = frame + i * pitch;
+            for(std::size_t j = 0; j < pitch; j += PIXEL_SIZE)
+            {
+                rowBuffer[j]     = src[j + 2];
+                rowBuffer[j + 1] = src[j + 1];
+                rowBuffer[j + 2] = src[j];
+                rowBuffer[j + 3] = src[j + 3];
+            }
+            tga.write((const char*)&rowBuffer[0], pitch);
+        }
+    }
+
+    if(!tga)
+    {
+        errorMessage = "Failed to write " + name;
+        return false;
+    }
+    return true;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// write a frame to a numbered QOI file
+// The frame is encoded as is (BGRA/RGBA, bottom-up) with all CPU cores, and
+// the file has RGBA in top-down rows.
+///////////////////////////////////////////////////////////////////////////////
+bool FrameRecorder::writeQoi(const unsigned char* frame)
+{
+    std::string name = getSequenceName(".qoi");
+    Image::Qoi::encode(frame, width, height, PIXEL_SIZE, bgra, true, 0, qoiBuffer);
+
+    std::ofstream qoi(name.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+    if(!qoi)
+    {
+        errorMessage = "Failed to open " + name;
+        return false;
+    }
+
+    qoi.write((const char*)&qoiBuffer[0], qoiBuffer.size());
+    if(!qoi)
+    {
+        errorMessage = "Failed to write " + name;
+        return false;
+    }
+    return true;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// return the file name of the next frame in an image sequence
+// "out.tga" -> "out_00012.tga"
+///////////////////////////////////////////////////////////////////////////////
+std::string FrameRecorder::getSequenceName(const char* ext) const
+{
+    char number[16];
+    snprintf(number, sizeof(number), "_%05d", writtenCount.load());
+    return fileName.substr(0, fileName.rfind('.')) + number + ext;
+}
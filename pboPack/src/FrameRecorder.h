@@ -0,0 +1,130 @@
+///////////////////////////////////////////////////////////////////////////////
+// FrameRecorder.h
+// ===============
+// Background recorder of the read-back frames (BGRA or RGBA, bottom-up rows)
+// addFrame() copies a frame, e.g., the mapped PBO, into a free buffer of the
+// pool, and passes the buffer index to the writer thread with a lock-free
+// queue. The writer thread converts and writes the frame to the file, then
+// returns the buffer to the pool. So the render thread pays only a memcpy per
+// frame.
+//
+// If all buffers are in use (the writer is slower than rendering), the policy
+// decides; POLICY_DROP skips the frame and counts it, POLICY_BLOCK waits until
+// the writer returns a buffer.
+//
+// The output format is chosen by the file extension:
+//     .raw    frames of 4-byte pixels in top-down rows, e.g.,
+//             ffplay -f rawvideo -pixel_format bgra -video_size WxH out.raw
+//     .y4m    YUV4MPEG2 of 4:2:0 BT.601 or BT.709 (limited range), converted by
+//             yuvUtils. The header has "C420" (centred chroma of 2x2 pixels)
+//             and "XCOLORRANGE=LIMITED"; Y4M has no tag of the matrix, e.g.,
+//             ffplay -vf setparams=colorspace=bt709 out.y4m
+//     .tga    image sequence, "out.tga" writes out_00000.tga, out_00001.tga...
+//     .qoi    lossless compressed image sequence, encoded by Qoi from the
+//             BGRA/RGBA frame without conversion, on multiple threads
+//
+//  AUTHOR: Song Ho Ahn (song.ahn@gmail.com)
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef FRAME_RECORDER_H
+#define FRAME_RECORDER_H
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <thread>
+#include <atomic>
+#include "FrameQueue.h"
+#include "yuvUtils.h"
+
+class FrameRecorder
+{
+public:
+    // what to do if no buffer is free
+    enum Policy
+    {
+        POLICY_DROP = 0,                        // skip the frame
+        POLICY_BLOCK                            // wait for the writer
+    };
+
+    enum Format
+    {
+        FORMAT_RAW = 0,
+        FORMAT_Y4M,
+        FORMAT_TGA,
+        FORMAT_QOI,
+        FORMAT_UNKNOWN
+    };
+
+    // ctor/dtor
+    FrameRecorder();
+    ~FrameRecorder();                           // close() if open
+
+    // open the file and start the writer thread, bgra is false for RGBA
+    // matrix is the colour matrix of Y4M, and not used by the other formats.
+    bool open(const std::string& fileName, int width, int height, bool bgra,
+              int bufferCount, Policy policy, Yuv::Matrix matrix);
+
+    // write the remaining frames, then stop the writer thread
+    void close();
+
+    // copy a frame of width * height * 4 bytes, called on the render thread
+    // It returns false if the frame is dropped.
+    bool addFrame(const unsigned char* src);
+
+    // getters
+    bool isOpen() const                         { return opened; }
+    int getAddedCount() const                   { return addedCount; }
+    int getWrittenCount() const                 { return writtenCount.load(); }
+    int getDroppedCount() const                 { return droppedCount; }
+    const std::string& getFileName() const      { return fileName; }
+    Yuv::Matrix getMatrix() const               { return matrix; }
+    const std::string& getError() const         { return errorMessage; }   // after open() or close()
+
+    static Format getFormat(const std::string& fileName);
+    static const char* getPolicyName(Policy policy);
+
+protected:
+
+private:
+    // member functions
+    void runWriter();
+    bool writeFrame(const unsigned char* frame);
+    bool writeRaw(const unsigned char* frame);
+    bool writeY4m(const unsigned char* frame);
+    bool writeTga(const unsigned char* frame);
+    bool writeQoi(const unsigned char* frame);
+    std::string getSequenceName(const char* ext) const;  // "out_00012.tga"
+
+    // member variables
+    std::string fileName;
+    std::ofstream file;                         // RAW and Y4M, TGA/QOI open a file per frame
+    Format format;
+    Policy policy;
+    Yuv::Matrix matrix;
+    int width;
+    int height;
+    bool bgra;
+    bool opened;
+
+    std::vector<std::vector<unsigned char> > buffers;   // pool of frames
+    FrameQueue freeQueue;                       // writer -> render thread
+    FrameQueue readyQueue;                      // render -> writer thread
+    std::thread writer;
+    std::atomic<bool> stopFlag;
+
+    // render thread only
+    int addedCount;
+    int droppedCount;
+
+    // writer thread only, until close()
+    std::atomic<int> writtenCount;
+    std::vector<unsigned char> rowBuffer;       // converted scanline
+    std::vector<unsigned char> yuvBuffer;       // Y, U and V planes
+    std::vector<unsigned char> qoiBuffer;       // encoded QOI image
+    std::string errorMessage;
+};
+
+#endif // FRAME_RECORDER_H
@@ -0,0 +1,244 @@
+///////////////////////////////////////////////////////////////////////////////
+// KernelBench.cpp
+// ===============
+// Correctness check and throughput of the CPU kernels at all SIMD levels, for
+// the --bench-kernels mode of the PBO samples
+//
+//  AUTHOR: Song Ho Ahn (song.ahn@gmail.com)
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <algorithm>
+#include <random>
+#include <cstdlib>
+#include <cstring>
+#include "KernelBench.h"
+#include "TimingStats.h"
+#include "Timer.h"
+#include "pixelUtils.h"
+
+// constants
+static const int MIN_CALL_COUNT = 5;                // calls to measure at least
+static const int MAX_CALL_COUNT = 1000;
+static const long long MIN_MEASURE_TIME = 100000000;    // 100 ms in nano-second
+static const unsigned int RANDOM_SEED = 2026;
+static const unsigned char DST_PATTERN = 0xcd;      // initial bytes of dst
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// ctor
+///////////////////////////////////////////////////////////////////////////////
+KernelBench::KernelBench()
+{
+    // the odd size checks the tails of SIMD loops
+    Size sizes[] = {{511, 383}, {512, 512}, {1024, 1024}, {1920, 1080}, {3840, 2160}};
+    defaultSizes.assign(sizes, sizes + sizeof(sizes) / sizeof(sizes[0]));
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// add a kernel to check and measure
+///////////////////////////////////////////////////////////////////////////////
+void KernelBench::addKernel(const std::string& name, double srcPixelSize, double dstPixelSize, bool inPlace,
+                            const Function& function, const std::vector<Size>& sizes)
+{
+    Kernel kernel;
+    kernel.name = name;
+    kernel.srcPixelSize = srcPixelSize;
+    kernel.dstPixelSize = dstPixelSize;
+    kernel.inPlace = inPlace;
+    kernel.function = function;
+    kernel.tolerance = 0;
+    kernel.sizes = sizes.empty() ? defaultSizes : sizes;
+    kernels.push_back(kernel);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// set the reference function of the last added kernel
+///////////////////////////////////////////////////////////////////////////////
+void KernelBench::setReference(const Function& function, int tolerance)
+{
+    if(kernels.empty())
+        return;
+
+    kernels.back().reference = function;
+    kernels.back().tolerance = tolerance;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// add the kernels of pixelUtils
+// The brightness is shifted up and down, so both sides are saturated. The
+// in-place kernels are measured up to 8K (7680x4320) too.
+///////////////////////////////////////////////////////////////////////////////
+void KernelBench::addPixelKernels()
+{
+    addKernel("addBrightness +40", 4, 4, false, [](const unsigned char* src, unsigned char* dst, int w, int h)
+    {
+        Pixel::addBrightness(src, dst, (std::size_t)w * h, 40);
+    });
+    addKernel("addBrightness -40", 4, 4, false, [](const unsigned char* src, unsigned char* dst, int w, int h)
+    {
+        Pixel::addBrightness(src, dst, (std::size_t)w * h, -40);
+    });
+
+    std::vector<Size> sizes = defaultSizes;
+    Size size8k = {7680, 4320};
+    sizes.push_back(size8k);
+    addKernel("swapRedBlue", 4, 4, true, [](const unsigned char*, unsigned char* dst, int w, int h)
+    {
+        Pixel::swapRedBlue(dst, (std::size_t)w * h * 4, 4);
+    }, sizes);
+    addKernel("flipImage", 4, 4, true, [](const unsigned char*, unsigned char* dst, int w, int h)
+    {
+        Pixel::flipImage(dst, w, h, 4);
+    }, sizes);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// run all kernels and print a row per size and SIMD level
+///////////////////////////////////////////////////////////////////////////////
+bool KernelBench::run()
+{
+    Pixel::SimdLevel savedLevel = Pixel::getSimdLevel();
+    std::cout << "Max SIMD: " << Pixel::getSimdLevelName(Pixel::getMaxSimdLevel()) << "\n"
+              << std::left << std::setw(20) << "kernel" << std::setw(12) << "size"
+              << std::setw(8) << "SIMD" << std::right << std::setw(10) << "GB/s" << "  check" << std::endl;
+
+    bool passed = true;
+    for(std::size_t i = 0; i < kernels.size(); ++i)
+    {
+        for(std::size_t j = 0; j < kernels[i].sizes.size(); ++j)
+        {
+            if(!runKernel(kernels[i], kernels[i].sizes[j]))
+                passed = false;
+        }
+    }
+
+    Pixel::setSimdLevel(savedLevel);
+    std::cout << (passed ? "All kernels passed." : "[ERROR] Some kernels failed.") << std::endl;
+    return passed;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// check and measure a kernel at all SIMD levels for an image size
+// The output of SIMD_NONE is the expected output of the other levels.
+///////////////////////////////////////////////////////////////////////////////
+bool KernelBench::runKernel(const Kernel& kernel, const Size& size)
+{
+    std::size_t dataSize = (std::size_t)size.width * size.height * 4;
+    std::vector<unsigned char> src(dataSize);
+    std::mt19937 random(RANDOM_SEED);
+    for(std::size_t i = 0; i < dataSize; ++i)
+        src[i] = (unsigned char)(random() >> 24);
+
+    std::vector<unsigned char> dst(dataSize);
+    std::vector<unsigned char> expected;
+    std::vector<unsigned char> reference;
+    if(kernel.reference)
+    {
+        reference.assign(dataSize, DST_PATTERN);
+        kernel.reference(&src[0], &reference[0], size.width, size.height);
+    }
+
+    std::ostringstream oss;
+    oss << size.width << "x" << size.height;
+    std::string sizeName = oss.str();
+
+    bool passed = true;
+    int maxLevel = Pixel::getMaxSimdLevel();
+    for(int level = Pixel::SIMD_NONE; level <= maxLevel; ++level)
+    {
+        Pixel::setSimdLevel((Pixel::SimdLevel)level);
+
+        // check the output of a call
+        if(kernel.inPlace)
+            dst = src;
+        else
+            dst.assign(dataSize, DST_PATTERN);
+        kernel.function(&src[0], &dst[0], size.width, size.height);
+
+        std::string check = "ok";
+        if(level == Pixel::SIMD_NONE)
+        {
+            expected = dst;
+        }
+        else if(dst != expected)
+        {
+            std::size_t count = 0;
+            for(std::size_t i = 0; i < dataSize; ++i)
+                count += (dst[i] != expected[i]);
+            std::ostringstream message;
+            message << "FAILED: " << count << " bytes differ from " << Pixel::getSimdLevelName(Pixel::SIMD_NONE);
+            check = message.str();
+            passed = false;
+        }
+
+        if(kernel.reference && check == "ok")
+        {
+            int maxDiff = 0;
+            for(std::size_t i = 0; i < dataSize; ++i)
+                maxDiff = (std::max)(maxDiff, std::abs(dst[i] - reference[i]));
+            std::ostringstream message;
+            if(maxDiff <= kernel.tolerance)
+            {
+                message << "ok, max diff from reference " << maxDiff;
+            }
+            else
+            {
+                message << "FAILED: max diff from reference " << maxDiff << " > " << kernel.tolerance;
+                passed = false;
+            }
+            check = message.str();
+        }
+
+        double speed = measure(kernel, size, src, dst);
+        std::cout << std::left << std::setw(20) << kernel.name << std::setw(12) << sizeName
+                  << std::setw(8) << Pixel::getSimdLevelName((Pixel::SimdLevel)level)
+                  << std::right << std::fixed << std::setprecision(2) << std::setw(10) << speed
+                  << "  " << check << std::endl;
+    }
+    std::cout.unsetf(std::ios::floatfield);
+    return passed;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// call the function repeatedly for at least MIN_MEASURE_TIME, and return GB/s
+// of the median time
+///////////////////////////////////////////////////////////////////////////////
+double KernelBench::measure(const Kernel& kernel, const Size& size,
+                            const std::vector<unsigned char>& src, std::vector<unsigned char>& dst)
+{
+    std::vector<double> times;
+    long long startTime = Timer::getNanoTime();
+    long long time = startTime;
+    while((int)times.size() < MIN_CALL_COUNT ||
+          (time - startTime < MIN_MEASURE_TIME && (int)times.size() < MAX_CALL_COUNT))
+    {
+        kernel.function(&src[0], &dst[0], size.width, size.height);
+        long long endTime = Timer::getNanoTime();
+        times.push_back((double)(endTime - time));
+        time = endTime;
+    }
+
+    double pixelCount = (double)size.width * size.height;
+    double bytes = (kernel.srcPixelSize + kernel.dstPixelSize) * pixelCount;
+    std::sort(times.begin(), times.end());
+    double nanoSec = TimingStats::computePercentile(times, 50);
+    return (nanoSec > 0) ? bytes / nanoSec : 0;     // bytes per ns = GB/s
+}
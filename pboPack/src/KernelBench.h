@@ -0,0 +1,91 @@
+///////////////////////////////////////////////////////////////////////////////
+// KernelBench.h
+// =============
+// Correctness check and throughput of the CPU kernels at all SIMD levels, for
+// the --bench-kernels mode of the PBO samples
+// Each kernel runs on the same random image at every level from SIMD_NONE to
+// Pixel::getMaxSimdLevel(), and the output of each level must be the same as
+// the output of SIMD_NONE. If a reference function is given, the outputs are
+// also compared with the reference, within the tolerance.
+// The speed is the median of repeated calls, in GB/s of the bytes read and
+// written by the kernel.
+//
+// usage:
+//     KernelBench bench;
+//     bench.addPixelKernels();         // kernels of pixelUtils
+//     bench.addKernel("name", 4, 4, false, function);
+//     bool passed = bench.run();       // print a row per size and level
+//
+//  AUTHOR: Song Ho Ahn (song.ahn@gmail.com)
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef KERNEL_BENCH_H
+#define KERNEL_BENCH_H
+
+#include <string>
+#include <vector>
+#include <functional>
+
+class KernelBench
+{
+public:
+    struct Size
+    {
+        int width;
+        int height;
+    };
+
+    // process an image of width x height, src has 4-byte pixels of random
+    // values, and dst has the same size as src (dstPixelSize must be <= 4)
+    // For in-place kernels, dst is a copy of src and src must not be used.
+    typedef std::function<void(const unsigned char* src, unsigned char* dst, int width, int height)> Function;
+
+    // ctor/dtor
+    KernelBench();
+    ~KernelBench() {}
+
+    // add a kernel, the bytes read and written per pixel are for GB/s
+    // The default sizes are from 512x512 to 3840x2160, with an odd size to
+    // check the tails of the SIMD loops.
+    void addKernel(const std::string& name, double srcPixelSize, double dstPixelSize, bool inPlace,
+                   const Function& function, const std::vector<Size>& sizes=std::vector<Size>());
+
+    // compare the outputs of the last added kernel with the reference function
+    // too, the difference of each byte must be at most tolerance
+    void setReference(const Function& function, int tolerance);
+
+    // add the kernels of pixelUtils: addBrightness, swapRedBlue and flipImage
+    void addPixelKernels();
+
+    // run all kernels at all SIMD levels, print the results to stdout, and
+    // return false if any output is different
+    bool run();
+
+protected:
+
+private:
+    struct Kernel
+    {
+        std::string name;
+        double srcPixelSize;                        // bytes read per pixel
+        double dstPixelSize;                        // bytes written per pixel
+        bool inPlace;
+        Function function;
+        Function reference;
+        int tolerance;
+        std::vector<Size> sizes;
+    };
+
+    // member functions
+    bool runKernel(const Kernel& kernel, const Size& size);
+    double measure(const Kernel& kernel, const Size& size,
+                   const std::vector<unsigned char>& src, std::vector<unsigned char>& dst);
+
+    // member variables
+    std::vector<Kernel> kernels;
+    std::vector<Size> defaultSizes;
+};
+
+#endif // KERNEL_BENCH_H
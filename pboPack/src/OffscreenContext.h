@@ -0,0 +1,58 @@
+///////////////////////////////////////////////////////////////////////////////
+// OffscreenContext.h
+// ==================
+// OpenGL context without window for the headless benchmark mode
+// It creates an EGL context (surfaceless or 1x1 pbuffer), and a framebuffer
+// object with RGBA8 colour and 24-bit depth renderbuffers to render into.
+// Read/draw the framebuffer with GL_COLOR_ATTACHMENT0 instead of GL_FRONT
+// and GL_BACK. It runs on a GPU-less machine with the Mesa software
+// rasterizer (llvmpipe), e.g., EGL_PLATFORM=surfaceless.
+//
+// It is available on Linux only. On the other systems, create() returns false.
+//
+//  AUTHOR: Song Ho Ahn (song.ahn@gmail.com)
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef OFFSCREEN_CONTEXT_H
+#define OFFSCREEN_CONTEXT_H
+
+#include <string>
+#include "glExtension.h"
+
+class OffscreenContext
+{
+public:
+    // ctor/dtor
+    OffscreenContext();
+    ~OffscreenContext();                        // destroy the context
+
+    // create the context and the framebuffer of the size, then make it current
+    bool create(int width, int height);
+    void destroy();
+
+    // getters
+    GLuint getFboId() const                     { return fboId; }
+    int getWidth() const                        { return width; }
+    int getHeight() const                       { return height; }
+    const std::string& getError() const         { return errorMessage; }
+
+protected:
+
+private:
+    // member functions
+    bool createFramebuffer();
+
+    // member variables
+    void* display;                              // EGLDisplay
+    void* surface;                              // EGLSurface, null if surfaceless
+    void* context;                              // EGLContext
+    GLuint fboId;
+    GLuint rboIds[2];                           // colour and depth
+    int width;
+    int height;
+    std::string errorMessage;
+};
+
+#endif // OFFSCREEN_CONTEXT_H
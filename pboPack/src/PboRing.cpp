@@ -0,0 +1,267 @@
+///////////////////////////////////////////////////////////////////////////////
+// PboRing.cpp
+// ===========
+// Ring of pixel buffer objects (PBO) with fence sync objects
+//
+//  AUTHOR: Song Ho Ahn (song.ahn@gmail.com)
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#include "PboRing.h"
+#include "Timer.h"
+
+// constants
+static const GLuint64 WAIT_TIMEOUT = 100000000;     // 100 ms in nanoseconds, per glClientWaitSync()
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// ctor/dtor
+///////////////////////////////////////////////////////////////////////////////
+PboRing::PboRing() : target(GL_PIXEL_PACK_BUFFER), head(0), fenceCount(0), latency(0),
+                     stallTime(0), syncUsed(false)
+{
+}
+
+PboRing::~PboRing()
+{
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// create PBOs, and delete the previous ones
+///////////////////////////////////////////////////////////////////////////////
+bool PboRing::init(GLenum target, int count, GLsizeiptr size, GLenum usage)
+{
+    release();
+    if(count < 1 || size <= 0)
+        return false;
+
+    this->target = target;
+    syncUsed = glExtension::getInstance().isSupported("GL_ARB_sync");
+
+    std::vector<GLuint> ids(count);
+    glGenBuffers(count, &ids[0]);
+    slots.resize(count);
+    for(int i = 0; i < count; ++i)
+    {
+        slots[i].id = ids[i];
+        slots[i].sync = 0;
+        slots[i].pending = false;
+        slots[i].serial = 0;
+
+        // reserve memory space only with NULL pointer
+        glBindBuffer(target, ids[i]);
+        glBufferData(target, size, 0, usage);
+    }
+    glBindBuffer(target, 0);
+
+    head = 0;
+    fenceCount = 0;
+    latency = 0;
+    stallTime = 0;
+    return true;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// delete PBOs and fences
+///////////////////////////////////////////////////////////////////////////////
+void PboRing::release()
+{
+    for(std::size_t i = 0; i < slots.size(); ++i)
+    {
+        clearFence(slots[i]);
+        glDeleteBuffers(1, &slots[i].id);
+    }
+    slots.clear();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// take the next PBO, and wait for its fence if the GPU is still using it
+// For packing, the unused result of the PBO is discarded.
+///////////////////////////////////////////////////////////////////////////////
+int PboRing::acquire()
+{
+    if(slots.empty())
+        return -1;
+
+    int index = head;
+    head = (head + 1) % (int)slots.size();
+
+    Slot& slot = slots[index];
+    if(slot.sync && !isSignaled(slot))
+        wait(slot);
+    clearFence(slot);
+    slot.pending = false;
+
+    glBindBuffer(target, slot.id);
+    return index;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// insert a fence after the GL command reading/writing the PBO
+///////////////////////////////////////////////////////////////////////////////
+void PboRing::fence(int index)
+{
+    Slot& slot = slots[index];
+    clearFence(slot);
+    if(syncUsed)
+        slot.sync = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    slot.pending = true;
+    slot.serial = ++fenceCount;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// find the newest PBO finished by GPU, without waiting
+// The pending PBOs are checked from the newest. Without sync objects, a PBO
+// is regarded as finished after count-1 more fences, so a ring of 2 behaves
+// as the classic 2 PBOs (index/nextIndex).
+///////////////////////////////////////////////////////////////////////////////
+int PboRing::getLatestReady()
+{
+    int count = (int)slots.size();
+    int found = -1;
+    for(int i = 1; i <= count; ++i)
+    {
+        int index = (head - i + count) % count;     // from the newest
+        Slot& slot = slots[index];
+        if(!slot.pending)
+            continue;
+
+        if(found < 0)
+        {
+            if(syncUsed ? isSignaled(slot) : (fenceCount - slot.serial >= count - 1))
+            {
+                found = index;
+                latency = fenceCount - slot.serial;
+            }
+        }
+        if(found >= 0)
+        {
+            // free the found and older ones; the older results are skipped
+            clearFence(slot);
+            slot.pending = false;
+        }
+    }
+    return found;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// wait for the oldest pending PBO, so all results are used in order
+// Without sync objects, glMapBuffer() waits for the GPU instead.
+///////////////////////////////////////////////////////////////////////////////
+int PboRing::waitOldest()
+{
+    int found = -1;
+    for(std::size_t i = 0; i < slots.size(); ++i)
+    {
+        if(slots[i].pending && (found < 0 || slots[i].serial < slots[found].serial))
+            found = (int)i;
+    }
+    if(found < 0)
+        return -1;
+
+    Slot& slot = slots[found];
+    if(slot.sync && !isSignaled(slot))
+        wait(slot);
+    latency = fenceCount - slot.serial;
+    clearFence(slot);
+    slot.pending = false;
+    return found;
+}
+
+int PboRing::getPendingCount() const
+{
+    int count = 0;
+    for(std::size_t i = 0; i < slots.size(); ++i)
+    {
+        if(slots[i].pending)
+            ++count;
+    }
+    return count;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// bind/map
+///////////////////////////////////////////////////////////////////////////////
+void PboRing::bind(int index)
+{
+    glBindBuffer(target, slots[index].id);
+}
+
+void PboRing::unbind()
+{
+    glBindBuffer(target, 0);
+}
+
+void* PboRing::map(int index, GLenum access)
+{
+    glBindBuffer(target, slots[index].id);
+    return glMapBuffer(target, access);
+}
+
+void PboRing::unmap()
+{
+    glUnmapBuffer(target);
+    glBindBuffer(target, 0);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// check the fence without waiting
+///////////////////////////////////////////////////////////////////////////////
+bool PboRing::isSignaled(Slot& slot)
+{
+    if(!slot.sync)
+        return true;
+
+    // flush, so the fence is signalled eventually even if nothing else flushes
+    GLenum result = glClientWaitSync(slot.sync, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+    return result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// block until the fence is signalled, and add the waiting time to stallTime
+///////////////////////////////////////////////////////////////////////////////
+void PboRing::wait(Slot& slot)
+{
+    Timer timer;
+    timer.start();
+    GLenum result;
+    do
+    {
+        result = glClientWaitSync(slot.sync, GL_SYNC_FLUSH_COMMANDS_BIT, WAIT_TIMEOUT);
+    }
+    while(result == GL_TIMEOUT_EXPIRED);
+    timer.stop();
+    stallTime += timer.getElapsedTimeInMilliSec();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// delete the fence of a PBO
+///////////////////////////////////////////////////////////////////////////////
+void PboRing::clearFence(Slot& slot)
+{
+    if(slot.sync)
+        glDeleteSync(slot.sync);
+    slot.sync = 0;
+}
@@ -0,0 +1,95 @@
+///////////////////////////////////////////////////////////////////////////////
+// Qoi.h
+// =====
+// QOI (Quite OK Image) lossless image encoder, decoder and writer
+// It encodes 8-bit RGB or RGBA images with the QOI operations (run, index of
+// recent colours, small difference and luma difference), so it is several
+// times smaller than uncompressed TGA/BMP and fast enough to save every frame.
+// The input can be BGR(A) order and bottom-to-top, e.g., a mapped PBO of
+// glReadPixels(GL_BGRA), so it does not need a converted copy of the image.
+//
+// Large images are split into slices of scanlines and encoded on multiple
+// threads. Each slice starts with the decoder state at its first pixel; the
+// previous pixel, and the colours of the index found by scanning back the
+// previous pixels (the unknown entries are never referenced). So the slices
+// are simply concatenated, and the output is a standard QOI stream.
+//
+//  AUTHOR: Song Ho Ahn (song.ahn@gmail.com)
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef IMAGE_QOI_H
+#define IMAGE_QOI_H
+
+#include <string>
+#include <vector>
+#include <cstddef>
+
+namespace Image
+{
+    class Qoi
+    {
+    public:
+        // ctor/dtor
+        Qoi();
+        ~Qoi() {}
+
+        // load and decode a QOI file
+        bool read(const char* fileName);
+
+        // decode QOI data in memory, the image is RGB or RGBA by the header
+        bool decode(const unsigned char* encData, std::size_t encSize);
+
+        // save an image as QOI format
+        // The input is RGB(A) order and top-to-bottom like Tga::save().
+        // threadCount 0 means the number of CPU cores.
+        static bool save(const char* fileName, int width, int height, int channelCount, const unsigned char* data, int threadCount=0);
+
+        // encode an image to QOI in memory, and return the encoded size
+        // bgr is true for BGR(A) order, and flip is true for bottom-to-top
+        // scanlines. The buffer is resized to fit the encoded data.
+        static std::size_t encode(const unsigned char* data, int width, int height, int channelCount,
+                                  bool bgr, bool flip, int threadCount, std::vector<unsigned char>& buffer);
+
+        // getters
+        int getWidth() const;                       // return width of image in pixel
+        int getHeight() const;                      // return height of image in pixel
+        int getBitCount() const;                    // return the number of bits per pixel (24 or 32)
+        std::size_t getDataSize() const;            // return data size in bytes
+        const unsigned char* getData() const;       // return image data as RGB/RGBA order, top-to-bottom
+
+        void printSelf() const;                     // print itself for debug purpose
+        const char* getError() const;               // return last error message
+
+    protected:
+
+    private:
+        // member functions
+        void init();                                // clear the existing values
+
+        static void encodeSlice(const unsigned char* data, int width, int height, int channelCount, bool bgr, bool flip,
+                                int firstRow, int lastRow, std::vector<unsigned char>& buffer);
+
+        // member variables
+        int width;
+        int height;
+        int bitCount;
+        std::vector<unsigned char> data;            // RGB or RGBA order
+        std::string errorMessage;
+    };
+
+
+
+    ///////////////////////////////////////////////////////////////////////////
+    // inline functions
+    ///////////////////////////////////////////////////////////////////////////
+    inline int Qoi::getWidth() const { return width; }
+    inline int Qoi::getHeight() const { return height; }
+    inline int Qoi::getBitCount() const { return bitCount; }
+    inline std::size_t Qoi::getDataSize() const { return data.size(); }
+    inline const unsigned char* Qoi::getData() const { return data.empty() ? 0 : &data[0]; }
+    inline const char* Qoi::getError() const { return errorMessage.c_str(); }
+}
+
+#endif // IMAGE_QOI_H
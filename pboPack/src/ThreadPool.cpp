@@ -0,0 +1,195 @@
+///////////////////////////////////////////////////////////////////////////////
+// ThreadPool.cpp
+// ==============
+// Persistent worker threads to process an image in bands of scanlines
+//
+//  AUTHOR: Song Ho Ahn (song.ahn@gmail.com)
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#include "ThreadPool.h"
+
+// constants
+static const std::size_t BAND_SIZE = 64 * 1024;     // bytes per band, fits in L2 with the output
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// ctor/dtor
+///////////////////////////////////////////////////////////////////////////////
+ThreadPool::ThreadPool(int threadCount) : generation(0), activeCount(0), stopFlag(false),
+                                          function(0), rowCount(0), bandRows(1), nextBand(0), bandCount(0)
+{
+    setThreadCount(threadCount);
+}
+
+ThreadPool::~ThreadPool()
+{
+    stopWorkers();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// return the number of CPU cores
+///////////////////////////////////////////////////////////////////////////////
+int ThreadPool::getMaxThreadCount()
+{
+    int count = (int)std::thread::hardware_concurrency();
+    return (count > 0) ? count : 1;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// restart the workers with the new number of threads
+// The calling thread is the first thread, so count-1 workers are created.
+///////////////////////////////////////////////////////////////////////////////
+void ThreadPool::setThreadCount(int count)
+{
+    if(count <= 0)
+        count = getMaxThreadCount();
+    if(count == getThreadCount())
+        return;
+
+    stopWorkers();
+    startWorkers(count - 1);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// return the number of rows per band
+// A band is about 64KB, but at least 1 row.
+///////////////////////////////////////////////////////////////////////////////
+int ThreadPool::computeBandRows(std::size_t rowSize)
+{
+    if(rowSize == 0)
+        return 1;
+    std::size_t rows = BAND_SIZE / rowSize;
+    return (rows > 0) ? (int)rows : 1;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// process all rows in bands on all threads, and return when all are done
+///////////////////////////////////////////////////////////////////////////////
+void ThreadPool::run(int rowCount, int bandRows, const BandFunction& func)
+{
+    if(rowCount <= 0)
+        return;
+    if(bandRows < 1)
+        bandRows = 1;
+
+    // no worker, or a single band, run on this thread
+    int bandCount = (rowCount + bandRows - 1) / bandRows;
+    if(workers.empty() || bandCount == 1)
+    {
+        for(int row = 0; row < rowCount; row += bandRows)
+            func(row, (row + bandRows < rowCount) ? row + bandRows : rowCount);
+        return;
+    }
+
+    // publish the job and wake up the workers
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        this->function = &func;
+        this->rowCount = rowCount;
+        this->bandRows = bandRows;
+        this->bandCount = bandCount;
+        this->nextBand = 0;
+        activeCount = (int)workers.size();
+        ++generation;
+    }
+    startCondition.notify_all();
+
+    // the calling thread works too
+    processBands();
+
+    // wait for the workers to finish their last bands
+    std::unique_lock<std::mutex> lock(mutex);
+    doneCondition.wait(lock, [this]{ return activeCount == 0; });
+    function = 0;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// take the next bands until no band is left
+///////////////////////////////////////////////////////////////////////////////
+void ThreadPool::processBands()
+{
+    while(true)
+    {
+        int band;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if(nextBand >= bandCount)
+                return;
+            band = nextBand++;
+        }
+
+        int firstRow = band * bandRows;
+        int lastRow = firstRow + bandRows;
+        if(lastRow > rowCount)
+            lastRow = rowCount;
+        (*function)(firstRow, lastRow);
+    }
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// worker thread: sleep until the next run(), then process bands
+// lastGeneration is the generation at creation, so it does not process the
+// previous run() again.
+///////////////////////////////////////////////////////////////////////////////
+void ThreadPool::runWorker(unsigned int lastGeneration)
+{
+    while(true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            startCondition.wait(lock, [&]{ return stopFlag || generation != lastGeneration; });
+            if(stopFlag)
+                return;
+            lastGeneration = generation;
+        }
+
+        processBands();
+
+        bool last;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            last = (--activeCount == 0);
+        }
+        if(last)
+            doneCondition.notify_one();
+    }
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// create/destroy worker threads
+///////////////////////////////////////////////////////////////////////////////
+void ThreadPool::startWorkers(int count)
+{
+    stopFlag = false;
+    for(int i = 0; i < count; ++i)
+        workers.push_back(std::thread(&ThreadPool::runWorker, this, generation));
+}
+
+void ThreadPool::stopWorkers()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopFlag = true;
+    }
+    startCondition.notify_all();
+    for(std::size_t i = 0; i < workers.size(); ++i)
+        workers[i].join();
+    workers.clear();
+}
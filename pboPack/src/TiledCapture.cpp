@@ -0,0 +1,278 @@
+///////////////////////////////////////////////////////////////////////////////
+// TiledCapture.cpp
+// ================
+// High-resolution screenshot larger than the window, rendered tile by tile
+//
+//  AUTHOR: Song Ho Ahn (song.ahn@gmail.com)
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#include <fstream>
+#include <cstring>
+#include <algorithm>
+#include "TiledCapture.h"
+
+// constants
+static const int CHANNEL_COUNT = 4;         // BGRA
+static const int TGA_MAX_SIZE = 65535;      // 16-bit width/height of TGA header
+static const int STRIP_COUNT = 2;           // the reads in flight span 2 strips
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// ctor
+///////////////////////////////////////////////////////////////////////////////
+TiledCapture::TiledCapture() : fboId(0), tileWidth(0), tileHeight(0), tileCount(0), stallTime(0)
+{
+    rboIds[0] = rboIds[1] = 0;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// create FBO with colour and depth renderbuffers of the tile size, and PBOs
+///////////////////////////////////////////////////////////////////////////////
+bool TiledCapture::init(int tileWidth, int tileHeight, int pboCount)
+{
+    release();
+    if(tileWidth <= 0 || tileHeight <= 0 || pboCount <= 0)
+    {
+        errorMessage = "Invalid tile size or PBO count.";
+        return false;
+    }
+
+    GLint maxSize = 0;
+    glGetIntegerv(GL_MAX_RENDERBUFFER_SIZE, &maxSize);
+    if(tileWidth > maxSize || tileHeight > maxSize)
+    {
+        errorMessage = "Tile is larger than the max renderbuffer size.";
+        return false;
+    }
+
+    this->tileWidth = tileWidth;
+    this->tileHeight = tileHeight;
+
+    GLint prevFboId = 0;
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &prevFboId);
+
+    glGenRenderbuffers(2, rboIds);
+    glBindRenderbuffer(GL_RENDERBUFFER, rboIds[0]);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, tileWidth, tileHeight);
+    glBindRenderbuffer(GL_RENDERBUFFER, rboIds[1]);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, tileWidth, tileHeight);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    glGenFramebuffers(1, &fboId);
+    glBindFramebuffer(GL_FRAMEBUFFER, fboId);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, rboIds[0]);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, rboIds[1]);
+    GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    glBindFramebuffer(GL_FRAMEBUFFER, prevFboId);
+    if(status != GL_FRAMEBUFFER_COMPLETE)
+    {
+        errorMessage = "Framebuffer object is not complete.";
+        release();
+        return false;
+    }
+
+    pboRing.init(GL_PIXEL_PACK_BUFFER, pboCount, (GLsizeiptr)tileWidth * tileHeight * CHANNEL_COUNT, GL_STREAM_READ);
+    tiles.resize(pboCount);
+    return true;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// delete FBO, renderbuffers and PBOs
+///////////////////////////////////////////////////////////////////////////////
+void TiledCapture::release()
+{
+    pboRing.release();
+    if(fboId)
+        glDeleteFramebuffers(1, &fboId);
+    if(rboIds[0])
+        glDeleteRenderbuffers(2, rboIds);
+    fboId = 0;
+    rboIds[0] = rboIds[1] = 0;
+    strips.clear();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// render all tiles from bottom to top, and write the strips to TGA
+// A tile is copied only when a PBO is needed for the next tile, so the ring
+// keeps pboCount reads in flight while the next tiles are rendered. A strip
+// is written to the file as soon as all of its tiles are copied.
+///////////////////////////////////////////////////////////////////////////////
+bool TiledCapture::save(const char* fileName, int width, int height, const double frustum[6], const DrawFunction& draw)
+{
+    errorMessage.clear();
+    if(!fboId)
+    {
+        errorMessage = "TiledCapture is not initialized.";
+        return false;
+    }
+    if(width <= 0 || height <= 0 || width > TGA_MAX_SIZE || height > TGA_MAX_SIZE)
+    {
+        errorMessage = "Invalid image size for TGA.";
+        return false;
+    }
+
+    std::ofstream file(fileName, std::ios::out | std::ios::binary | std::ios::trunc);
+    if(!file.is_open())
+    {
+        errorMessage = std::string("Failed to open a file: ") + fileName;
+        return false;
+    }
+
+    // 32-bit uncompressed true-colour, origin at lower-left like glReadPixels()
+    unsigned char header[18] = {0};
+    header[2] = 2;
+    header[12] = (unsigned char)(width & 0xff);
+    header[13] = (unsigned char)(width >> 8);
+    header[14] = (unsigned char)(height & 0xff);
+    header[15] = (unsigned char)(height >> 8);
+    header[16] = 32;
+    header[17] = 8;                             // 8 alpha bits
+    file.write((const char*)header, sizeof(header));
+
+    // save the states changed here
+    GLint prevFboId = 0;
+    GLint viewport[4];
+    GLint readBuffer, drawBuffer;
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &prevFboId);
+    glGetIntegerv(GL_VIEWPORT, viewport);
+    glGetIntegerv(GL_READ_BUFFER, &readBuffer);
+    glGetIntegerv(GL_DRAW_BUFFER, &drawBuffer);
+    glMatrixMode(GL_PROJECTION);
+    glPushMatrix();
+    glMatrixMode(GL_MODELVIEW);
+    glPushMatrix();
+
+    glBindFramebuffer(GL_FRAMEBUFFER, fboId);
+    glReadBuffer(GL_COLOR_ATTACHMENT0);
+    glDrawBuffer(GL_COLOR_ATTACHMENT0);
+
+    int tilesPerRow = (width + tileWidth - 1) / tileWidth;
+    int stripCount = (height + tileHeight - 1) / tileHeight;
+    strips.resize(STRIP_COUNT);
+    for(int i = 0; i < STRIP_COUNT; ++i)
+        strips[i].resize((std::size_t)width * tileHeight * CHANNEL_COUNT);
+    int copiedCounts[STRIP_COUNT] = {0, 0};
+    int writtenCount = 0;                       // # of strips written to file
+    tileCount = 0;
+    pboRing.resetStallTime();
+
+    // copy the oldest tile, then write its strip if it is the last tile
+    auto copyOldest = [&]()
+    {
+        int index = pboRing.waitOldest();
+        copyTile(index, width);
+        const Tile& tile = tiles[index];
+        int slot = tile.strip % STRIP_COUNT;
+        if(++copiedCounts[slot] == tilesPerRow)
+        {
+            file.write((const char*)&strips[slot][0], (std::streamsize)width * tile.height * CHANNEL_COUNT);
+            copiedCounts[slot] = 0;
+            ++writtenCount;
+        }
+    };
+
+    for(int s = 0; s < stripCount; ++s)
+    {
+        // the strip buffer is reused after the strip 2 before is written
+        while(writtenCount < s - STRIP_COUNT + 1)
+            copyOldest();
+
+        int y = s * tileHeight;
+        int h = std::min(tileHeight, height - y);
+        for(int x = 0; x < width; x += tileWidth)
+        {
+            int w = std::min(tileWidth, width - x);
+            if(pboRing.getPendingCount() == pboRing.getCount())
+                copyOldest();
+
+            double f[6];
+            computeTileFrustum(frustum, width, height, x, y, w, h, f);
+            glViewport(0, 0, w, h);
+            glMatrixMode(GL_PROJECTION);
+            glLoadIdentity();
+            glFrustum(f[0], f[1], f[2], f[3], f[4], f[5]);
+            glMatrixMode(GL_MODELVIEW);
+            glLoadIdentity();
+            draw();
+
+            // read the tile asynchronously, and render the next tile
+            int index = pboRing.acquire();
+            glReadPixels(0, 0, w, h, GL_BGRA, GL_UNSIGNED_BYTE, 0);
+            pboRing.fence(index);
+            pboRing.unbind();
+            tiles[index].x = x;
+            tiles[index].width = w;
+            tiles[index].height = h;
+            tiles[index].strip = s;
+            ++tileCount;
+        }
+    }
+    while(pboRing.getPendingCount() > 0)
+        copyOldest();
+    stallTime = pboRing.getStallTime();
+
+    // restore the states
+    glBindFramebuffer(GL_FRAMEBUFFER, prevFboId);
+    glReadBuffer(readBuffer);
+    glDrawBuffer(drawBuffer);
+    glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+    glMatrixMode(GL_PROJECTION);
+    glPopMatrix();
+    glMatrixMode(GL_MODELVIEW);
+    glPopMatrix();
+
+    file.close();
+    if(!file.good())
+    {
+        errorMessage = std::string("Failed to write a file: ") + fileName;
+        return false;
+    }
+    return true;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// split the near plane of the whole frustum at the pixel boundaries
+///////////////////////////////////////////////////////////////////////////////
+void TiledCapture::computeTileFrustum(const double frustum[6], int width, int height,
+                                      int x, int y, int w, int h, double tileFrustum[6])
+{
+    double left = frustum[0], right = frustum[1];
+    double bottom = frustum[2], top = frustum[3];
+    tileFrustum[0] = left + (right - left) * x / width;
+    tileFrustum[1] = left + (right - left) * (x + w) / width;
+    tileFrustum[2] = bottom + (top - bottom) * y / height;
+    tileFrustum[3] = bottom + (top - bottom) * (y + h) / height;
+    tileFrustum[4] = frustum[4];
+    tileFrustum[5] = frustum[5];
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// copy the read tile in a PBO to its strip buffer
+///////////////////////////////////////////////////////////////////////////////
+void TiledCapture::copyTile(int index, int imageWidth)
+{
+    const Tile& tile = tiles[index];
+    const unsigned char* src = (const unsigned char*)pboRing.map(index, GL_READ_ONLY);
+    if(src)
+    {
+        unsigned char* dst = &strips[tile.strip % STRIP_COUNT][(std::size_t)tile.x * CHANNEL_COUNT];
+        std::size_t srcPitch = (std::size_t)tile.width * CHANNEL_COUNT;
+        std::size_t dstPitch = (std::size_t)imageWidth * CHANNEL_COUNT;
+        for(int i = 0; i < tile.height; ++i)
+            memcpy(dst + i * dstPitch, src + i * srcPitch, srcPitch);
+    }
+    pboRing.unmap();
+}
@@ -0,0 +1,95 @@
+///////////////////////////////////////////////////////////////////////////////
+// TiledCapture.h
+// ==============
+// High-resolution screenshot larger than the window, rendered tile by tile
+// The image is split into tiles of the FBO size, and each tile is rendered
+// with a sub-frustum of the whole view frustum, like glFrustum() with the
+// left/right/bottom/top of the tile on the near plane. So the tiles are
+// stitched without seams, and the image can be much larger than the maximum
+// viewport or renderbuffer size, e.g., 16384 x 16384.
+//
+// The tiles are read back to a ring of PBOs; the next tiles are rendered
+// while the previous reads are in flight, and a tile is copied to the strip
+// buffer (a row of tiles) when its fence is signalled. Each finished strip is
+// appended to a bottom-up TGA file, so only 2 strips are in memory, e.g.,
+// 2 x 64 MB for 16384 x 16384 with 1024 x 1024 tiles, instead of 1 GB.
+//
+// usage:
+//     TiledCapture capture;
+//     capture.init(1024, 1024, 3);                // tile size and PBO count
+//     capture.save("big.tga", 16384, 16384, frustum, drawScene);
+//     capture.release();
+//
+//  AUTHOR: Song Ho Ahn (song.ahn@gmail.com)
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TILED_CAPTURE_H
+#define TILED_CAPTURE_H
+
+#include <string>
+#include <vector>
+#include <functional>
+#include "glExtension.h"
+#include "PboRing.h"
+
+class TiledCapture
+{
+public:
+    // draw the scene, the projection matrix and viewport are set already
+    typedef std::function<void()> DrawFunction;
+
+    // ctor/dtor
+    TiledCapture();
+    ~TiledCapture() {}                          // GL objects must be deleted by release()
+
+    // create FBO of the tile size and the PBO ring, GL context must be current
+    bool init(int tileWidth, int tileHeight, int pboCount);
+    void release();
+
+    // render the image of width x height in tiles, and save as 32-bit TGA
+    // frustum is left, right, bottom, top, near, far of the whole image,
+    // the same as glFrustum(). The FBO, viewport and matrices are restored.
+    bool save(const char* fileName, int width, int height, const double frustum[6], const DrawFunction& draw);
+
+    // sub-frustum of the pixels [x, x+w) x [y, y+h) of the image
+    static void computeTileFrustum(const double frustum[6], int width, int height,
+                                   int x, int y, int w, int h, double tileFrustum[6]);
+
+    // getters
+    int getTileWidth() const                    { return tileWidth; }
+    int getTileHeight() const                   { return tileHeight; }
+    int getTileCount() const                    { return tileCount; }   // tiles of the last save()
+    double getStallTime() const                 { return stallTime; }   // ms waited for the reads
+    const std::string& getError() const         { return errorMessage; }
+
+protected:
+
+private:
+    // tile in flight
+    struct Tile
+    {
+        int x;                                  // position in the image
+        int width;
+        int height;
+        int strip;                              // row of tiles from the bottom
+    };
+
+    // member functions
+    void copyTile(int index, int imageWidth);
+
+    // member variables
+    GLuint fboId;
+    GLuint rboIds[2];                           // colour and depth
+    int tileWidth;
+    int tileHeight;
+    PboRing pboRing;
+    std::vector<Tile> tiles;                    // tile of each PBO
+    std::vector<std::vector<unsigned char> > strips;    // BGRA of rows of tiles
+    int tileCount;
+    double stallTime;
+    std::string errorMessage;
+};
+
+#endif // TILED_CAPTURE_H
@@ -18,7 +18,9 @@
 // GL_ARB_pixel_buffer_objects, GL_ARB_vertex_buffer_object
 // GL_ARB_shader_objects, GL_ARB_vertex_program, GL_ARB_fragment_program, GL_ARB_vertex_shader, GL_ARB_fragment_shader
 // GL_ARB_sync
+// GL_ARB_timer_query
 // GL_ARB_vertex_array_object
+// GL_ARB_buffer_storage, GL_ARB_map_buffer_range
 // WGL_ARB_extensions_string
 // WGL_ARB_pixel_format
 // WGL_ARB_create_context
@@ -26,7 +28,7 @@
 //
 //  AUTHOR: Song Ho Ahn (song.ahn@gmail.com)
 // CREATED: 2013-03-05
-// UPDATED: 2018-08-09
+// UPDATED: 2026-10-18
 ///////////////////////////////////////////////////////////////////////////////
 
 #ifndef GL_EXTENSION_H
@@ -349,6 +351,22 @@ extern PFNGLGETSYNCIVPROC       pglGetSynciv;
 #define glGetInteger64v         pglGetInteger64v
 #define glGetSynciv             pglGetSynciv
 
+// GL_ARB_timer_query (v3.3 core), query objects are v1.5 core
+extern PFNGLGENQUERIESPROC          pglGenQueries;
+extern PFNGLDELETEQUERIESPROC       pglDeleteQueries;
+extern PFNGLBEGINQUERYPROC          pglBeginQuery;
+extern PFNGLENDQUERYPROC            pglEndQuery;
+extern PFNGLGETQUERYOBJECTIVPROC    pglGetQueryObjectiv;
+extern PFNGLQUERYCOUNTERPROC        pglQueryCounter;
+extern PFNGLGETQUERYOBJECTUI64VPROC pglGetQueryObjectui64v;
+#define glGenQueries                pglGenQueries
+#define glDeleteQueries             pglDeleteQueries
+#define glBeginQuery                pglBeginQuery
+#define glEndQuery                  pglEndQuery
+#define glGetQueryObjectiv          pglGetQueryObjectiv
+#define glQueryCounter              pglQueryCounter
+#define glGetQueryObjectui64v       pglGetQueryObjectui64v
+
 // GL_ARB_vertex_array_object
 extern PFNGLGENVERTEXARRAYSPROC     pglGenVertexArrays;     // VAO name generation procedure
 extern PFNGLDELETEVERTEXARRAYSPROC  pglDeleteVertexArrays;  // VAO deletion procedure
@@ -812,6 +830,16 @@ extern PFNGLGETQUERYBUFFEROBJECTUI64VPROC                pglGetQueryBufferObject
 #define glGetQueryBufferObjecti64v                       pglGetQueryBufferObjecti64v
 #define glGetQueryBufferObjectui64v                      pglGetQueryBufferObjectui64v
 
+// GL_ARB_buffer_storage (v4.4 core)
+extern PFNGLBUFFERSTORAGEPROC           pglBufferStorage;           // immutable storage for persistent mapping
+#define glBufferStorage                 pglBufferStorage
+
+// GL_ARB_map_buffer_range (v3.0 core)
+extern PFNGLMAPBUFFERRANGEPROC          pglMapBufferRange;          // map a range of buffer
+extern PFNGLFLUSHMAPPEDBUFFERRANGEPROC  pglFlushMappedBufferRange;  // flush a range of mapped buffer
+#define glMapBufferRange                pglMapBufferRange
+#define glFlushMappedBufferRange        pglFlushMappedBufferRange
+
 
 
 // WGL_ARB_extensions_string
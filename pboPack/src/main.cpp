@@ -3,10 +3,26 @@
 // ========
 // testing Pixel Buffer Object for packing (read-back) pixel data from
 // framebuffer to a PBO using GL_ARB_pixel_buffer_object extension
+// With --headless, it renders to an offscreen FBO without window, and writes
+// the timings of each frame to a CSV/JSON report, e.g.,
+//     pboPack --headless --width 1024 --height 1024 --pbo 3 --report out.json
+// With --bench-kernels, the CPU kernels (and the YUV converters) are checked
+// and measured at all SIMD levels without GL, then it exits with 1 if any
+// output is different.
+// With --capture, the read-back frames are recorded by a writer thread (after
+// the warmup frames in headless mode), e.g.,
+//     pboPack --headless --frames 100 --capture out.y4m --capture-policy block
+// With --yuv bt601|bt709 (or Y key), each read-back frame is also converted
+// to YUV 4:2:0 by all threads, to measure the cost of feeding a video encoder.
+// With --screenshot NAME (or I key), the last frame is saved as TGA, TGA RLE,
+// BMP and QOI, and the sizes and speeds of the image writers are compared.
+// With --hires FILE (or H key), the scene is rendered in tiles with
+// sub-frustums to an image much larger than the window, e.g.,
+//     pboPack --headless --frames 1 --hires big.tga --hires-size 16384x16384
 //
 //  AUTHOR: Song Ho Ahn (song.ahn@gmail.com)
 // CREATED: 2007-11-30
-// UPDATED: 2018-09-04
+// UPDATED: 2026-10-18
 ///////////////////////////////////////////////////////////////////////////////
 
 #ifdef __APPLE__
@@ -19,9 +35,28 @@
 #include <sstream>
 #include <iomanip>
 #include <cstdlib>
+#include <cmath>
+#include <algorithm>
 #include <cstring>
+#include <vector>
+#include <fstream>
 #include "glExtension.h"                            // extension helper
 #include "Timer.h"
+#include "TimingStats.h"                            // rolling percentiles of timings
+#include "Profiler.h"                               // CPU/GPU zones and Chrome trace
+#include "ThreadPool.h"                             // worker threads for pixel processing
+#include "PboRing.h"                                // PBOs with fence sync
+#include "pixelUtils.h"                             // SIMD pixel kernels
+#include "FrameRecorder.h"                          // background frame capture
+#include "yuvUtils.h"                               // BGRA/RGBA to YUV 4:2:0
+#include "formatUtils.h"                            // pixel format conversion for PBO
+#include "Tga.h"
+#include "Bmp.h"
+#include "Qoi.h"                                    // lossless image encoder
+#include "TiledCapture.h"                           // high-resolution image in tiles
+#include "Benchmark.h"                              // command-line options and report
+#include "KernelBench.h"                            // SIMD kernel check and throughput
+#include "OffscreenContext.h"                       // context without window
 
 
 
@@ -39,6 +74,7 @@ void exitCB();
 
 void initGL();
 int  initGLUT(int argc, char **argv);
+bool initOptions();
 bool initSharedMem();
 void clearSharedMem();
 void initLights();
@@ -48,24 +84,64 @@ void drawString3D(const char *str, float pos[3], float color[4], void *font);
 void showInfo();
 void showTransferRate();
 void printTransferRate();
+void recordProcessTime();
+void printProcessTimes();
+int  runBenchmark();
+int  runKernelBench();
 void draw();
 void add(unsigned char* src, int width, int height, int shift, unsigned char* dst);
+void unpackFrame(const unsigned char* src, unsigned char* dst);
+bool startCapture(const std::string& fileName);
+void stopCapture();
+void captureFrame(const unsigned char* src);
+void convertToYuv(const unsigned char* src);
+void saveScreenshot(const std::string& name);
+bool saveHighRes(const std::string& fileName);
+void drawScene();
 void toOrtho();
 void toPerspective();
+void writeTimingStats();
+void writeTrace();
 
 
 // constants
-const int SCREEN_WIDTH = 512;
+const int SCREEN_WIDTH = 512;       // default image size, --width/--height
 const int SCREEN_HEIGHT = 512;
 const float CAMERA_DISTANCE = 5.0f;
 const int CHANNEL_COUNT = 4;
-const int DATA_SIZE = SCREEN_WIDTH * SCREEN_HEIGHT * CHANNEL_COUNT;
-const GLenum PIXEL_FORMAT = GL_BGRA;
-const int PBO_COUNT = 2;
+const int PBO_COUNT = 3;            // default depth of PBO ring
+const int PBO_MAX_COUNT = 8;
+const int CAPTURE_BUFFER_COUNT = 8; // # of frames queued to the writer thread
+const char* CAPTURE_FILE = "capture.y4m";   // default file of C key
+const char* SCREENSHOT_NAME = "screenshot"; // default name of I key
+const char* HIRES_FILE = "highres.tga";     // default file of H key
+const char* HIRES_SIZE = "4096x4096";       // default size of high-resolution image
+const int TILE_SIZE = 1024;                 // default tile size of high-resolution image
+const float FOV_Y = 60.0f;                  // perspective projection
+const float NEAR_PLANE = 0.1f;
+const float FAR_PLANE = 1000.0f;
+const int STATS_WINDOW = 300;               // # of last frames of the percentiles
+
+// GL format and type of each Format::Type (bgra, rgba, rgb565, rgba4444, red)
+const GLenum TRANSFER_FORMATS[] = {GL_BGRA, GL_RGBA, GL_RGB, GL_RGBA, GL_RED};
+const GLenum TRANSFER_TYPES[] = {GL_UNSIGNED_BYTE, GL_UNSIGNED_BYTE, GL_UNSIGNED_SHORT_5_6_5,
+                                 GL_UNSIGNED_SHORT_4_4_4_4, GL_UNSIGNED_BYTE};
 
 // global variables
 void *font = GLUT_BITMAP_8_BY_13;
-GLuint pboIds[PBO_COUNT];           // IDs of PBOs
+int screenWidth = SCREEN_WIDTH;     // size of each half of the window
+int screenHeight = SCREEN_HEIGHT;
+int dataSize;                       // bytes of an image
+GLenum pixelFormat = GL_BGRA;       // GL_BGRA or GL_RGBA, --format
+Format::Type memoryType = Format::BGRA8;     // format of colorBuffer
+Format::Type transferType = Format::BGRA8;   // format of glReadPixels() and PBO, --transfer
+int transferSize;                   // bytes of an image in PBO
+GLubyte* transferBuffer = 0;        // read-back image without PBO, 0 if the same format
+GLenum readBufferMode = GL_FRONT;   // GL_COLOR_ATTACHMENT0 in headless mode
+GLenum drawBufferMode = GL_BACK;
+Benchmark benchmark;                // command-line options and headless report
+OffscreenContext offscreen;         // GL context for headless mode
+PboRing pboRing;                    // ring of PBOs for read-back
 bool mouseLeftDown;
 bool mouseRightDown;
 float mouseX, mouseY;
@@ -75,9 +151,20 @@ float cameraDistance;
 bool pboSupported;
 bool pboUsed;
 int drawMode = 0;
-Timer timer, t1;
-float readTime, processTime;
+Timer timer;
+float readTime, processTime, stallTime;     // last frame, for the benchmark report
+TimingStats timingStats(STATS_WINDOW);      // percentiles of the last frames
+ThreadPool threadPool;              // persistent workers, all CPU cores by default
+std::vector<double> processTimeSums;    // sum of process time per thread count
+std::vector<int> processTimeCounts;     // # of frames per thread count
 GLubyte* colorBuffer = 0;
+FrameRecorder recorder;             // writes the read-back frames on its own thread
+FrameRecorder::Policy capturePolicy = FrameRecorder::POLICY_DROP;
+float captureTime;                  // memcpy time to the recorder, part of processTime
+int yuvMode = 0;                    // 0: off, 1: BT.601, 2: BT.709
+const char* YUV_MODE_NAMES[] = {"off", "bt601", "bt709"};
+std::vector<unsigned char> yuvBuffer;   // I420 frame converted from the read-back frame
+float convertTime;                  // YUV conversion time, part of processTime
 
 
 
@@ -161,18 +248,52 @@ void draw()
 ///////////////////////////////////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
+    // parse command-line options, the defaults are the constants
+    benchmark.setWidth(SCREEN_WIDTH);
+    benchmark.setHeight(SCREEN_HEIGHT);
+    benchmark.setFormat("bgra");
+    benchmark.setTransfer("format");                // the same as --format
+    benchmark.setPboMode(PBO_COUNT);
+    benchmark.setCapturePolicy("drop");
+    benchmark.setYuvMode("off");
+    benchmark.setHiresSize(HIRES_SIZE);
+    benchmark.setTileSize(TILE_SIZE);
+    if(!benchmark.parse(argc, argv) || !initOptions())
+    {
+        benchmark.printUsage(argv[0]);
+        return 1;
+    }
+
+    // check and measure the CPU kernels, no GL is needed
+    if(benchmark.isKernelBench())
+        return runKernelBench();
+
     initSharedMem();
 
     // register exit callback
     atexit(exitCB);
 
-    // init GLUT and GL
-    initGLUT(argc, argv);
+    // init GLUT and GL, or offscreen framebuffer without window
+    if(benchmark.isHeadless())
+    {
+        // render the both sides (2 x width) to FBO
+        if(!offscreen.create(screenWidth * 2, screenHeight))
+        {
+            std::cout << "[ERROR] " << offscreen.getError() << std::endl;
+            return 1;
+        }
+        readBufferMode = drawBufferMode = GL_COLOR_ATTACHMENT0;
+    }
+    else
+    {
+        initGLUT(argc, argv);
+    }
     initGL();
 
     // get OpenGL extensions
     glExtension& ext = glExtension::getInstance();
-    pboSupported = pboUsed = ext.isSupported("GL_ARB_pixel_buffer_object");
+    pboSupported = ext.isSupported("GL_ARB_pixel_buffer_object");
+    pboUsed = pboSupported && benchmark.getPboMode() > 0;
     if(pboSupported)
     {
         std::cout << "Video card supports GL_ARB_pixel_buffer_object." << std::endl;
@@ -182,6 +303,15 @@ int main(int argc, char **argv)
         std::cout << "[ERROR] Video card does not supports GL_ARB_pixel_buffer_object." << std::endl;
     }
 
+    // profile the zones only if --trace is given, GPU time needs GL_ARB_timer_query
+    Profiler& profiler = Profiler::getInstance();
+    profiler.setEnabled(!benchmark.getTraceFile().empty());
+    if(profiler.isEnabled())
+        std::cout << "Profiler: GPU timer query " << (profiler.initGpu() ? "on" : "off") << std::endl;
+
+    // select the pixel kernels for this CPU
+    std::cout << "SIMD: " << Pixel::getSimdLevelName(Pixel::getSimdLevel()) << std::endl;
+
 #ifdef _WIN32
     // check EXT_swap_control is supported
     if(ext.isSupported("WGL_EXT_swap_control"))
@@ -194,17 +324,23 @@ int main(int argc, char **argv)
 
     if(pboSupported)
     {
-        // create 2 pixel buffer objects, you need to delete them when program exits.
-        // glBufferData() with NULL pointer reserves only memory space.
-        glGenBuffers(PBO_COUNT, pboIds);
-        glBindBuffer(GL_PIXEL_PACK_BUFFER, pboIds[0]);
-        glBufferData(GL_PIXEL_PACK_BUFFER, DATA_SIZE, 0, GL_STREAM_READ);
-        glBindBuffer(GL_PIXEL_PACK_BUFFER, pboIds[1]);
-        glBufferData(GL_PIXEL_PACK_BUFFER, DATA_SIZE, 0, GL_STREAM_READ);
-
-        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        // create a ring of pixel buffer objects, you need to delete them when program exits.
+        // A fence is inserted after glReadPixels() if GL_ARB_sync is supported.
+        int count = (benchmark.getPboMode() > 0) ? benchmark.getPboMode() : PBO_COUNT;
+        pboRing.init(GL_PIXEL_PACK_BUFFER, count, transferSize, GL_STREAM_READ);
+        std::cout << "PBO ring: " << pboRing.getCount() << " PBOs, fence sync "
+                  << (pboRing.isSyncUsed() ? "on" : "off") << std::endl;
     }
 
+    // run the given frames without window, then exit
+    // It starts recording after the warmup frames.
+    if(benchmark.isHeadless())
+        return runBenchmark();
+
+    // start recording before the first frame
+    if(!benchmark.getCaptureFile().empty() && !startCapture(benchmark.getCaptureFile()))
+        return 1;
+
     // start timer, the elapsed time will be used for updateVertices()
     timer.start();
 
@@ -229,7 +365,7 @@ int initGLUT(int argc, char **argv)
 
     glutInitDisplayMode(GLUT_RGB | GLUT_DOUBLE | GLUT_ALPHA); // display mode
 
-    glutInitWindowSize(SCREEN_WIDTH*2, SCREEN_HEIGHT);    // window size
+    glutInitWindowSize(screenWidth*2, screenHeight);    // window size
 
     glutInitWindowPosition(100, 100);           // window location
 
@@ -260,6 +396,8 @@ void initGL()
 {
     glShadeModel(GL_SMOOTH);                    // shading mathod: GL_SMOOTH or GL_FLAT
     glPixelStorei(GL_UNPACK_ALIGNMENT, 4);      // 4-byte pixel alignment
+    if(Format::getPixelSize(transferType) < 4)
+        glPixelStorei(GL_PACK_ALIGNMENT, 1);    // rows of 2-byte pixels are not padded
 
     // enable /disable features
     glHint(GL_PERSPECTIVE_CORRECTION_HINT, GL_NICEST);
@@ -338,6 +476,79 @@ void drawString3D(const char *str, float pos[3], float color[4], void *font)
 
 
 
+///////////////////////////////////////////////////////////////////////////////
+// apply the command-line options to global variables
+///////////////////////////////////////////////////////////////////////////////
+bool initOptions()
+{
+    screenWidth = benchmark.getWidth();
+    screenHeight = benchmark.getHeight();
+    dataSize = screenWidth * screenHeight * CHANNEL_COUNT;
+
+    if(benchmark.getFormat() == "bgra")
+        pixelFormat = GL_BGRA;
+    else if(benchmark.getFormat() == "rgba")
+        pixelFormat = GL_RGBA;
+    else
+    {
+        std::cout << "[ERROR] Unsupported pixel format: " << benchmark.getFormat() << " (bgra or rgba)" << std::endl;
+        return false;
+    }
+    memoryType = (pixelFormat == GL_BGRA) ? Format::BGRA8 : Format::RGBA8;
+
+    // read back in the smaller format, then unpack it while processing
+    std::string transfer = benchmark.getTransfer();
+    if(transfer == "format")
+        transfer = benchmark.getFormat();
+    if(!Format::parseType(transfer.c_str(), transferType) || !Format::isConvertible(transferType, memoryType))
+    {
+        std::cout << "[ERROR] Unsupported transfer format: " << transfer << " (bgra, rgba, rgb565 or rgba4444)" << std::endl;
+        return false;
+    }
+    transferSize = screenWidth * screenHeight * Format::getPixelSize(transferType);
+
+    if(benchmark.getPboMode() > PBO_MAX_COUNT)
+    {
+        std::cout << "[ERROR] PBO count must be 0 ~ " << PBO_MAX_COUNT << std::endl;
+        return false;
+    }
+
+    // 0 keeps all CPU cores
+    if(benchmark.getThreadCount() > 0)
+        threadPool.setThreadCount(benchmark.getThreadCount());
+
+    for(yuvMode = 0; yuvMode < 3; ++yuvMode)
+    {
+        if(benchmark.getYuvMode() == YUV_MODE_NAMES[yuvMode])
+            break;
+    }
+    if(yuvMode == 3)
+    {
+        std::cout << "[ERROR] Unsupported YUV mode: " << benchmark.getYuvMode() << " (off, bt601 or bt709)" << std::endl;
+        return false;
+    }
+
+    if(benchmark.getCapturePolicy() == "drop")
+        capturePolicy = FrameRecorder::POLICY_DROP;
+    else if(benchmark.getCapturePolicy() == "block")
+        capturePolicy = FrameRecorder::POLICY_BLOCK;
+    else
+    {
+        std::cout << "[ERROR] Unsupported capture policy: " << benchmark.getCapturePolicy() << " (drop or block)" << std::endl;
+        return false;
+    }
+
+    if(!benchmark.getCaptureFile().empty() &&
+       FrameRecorder::getFormat(benchmark.getCaptureFile()) == FrameRecorder::FORMAT_UNKNOWN)
+    {
+        std::cout << "[ERROR] Unsupported capture file: " << benchmark.getCaptureFile() << " (.raw, .y4m, .tga or .qoi)" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+
+
 ///////////////////////////////////////////////////////////////////////////////
 // initialize global variables
 ///////////////////////////////////////////////////////////////////////////////
@@ -352,8 +563,10 @@ bool initSharedMem()
     drawMode = 0; // 0:fill, 1:wireframe, 2:point
 
     // allocate buffers to store frames
-    colorBuffer = new GLubyte[DATA_SIZE];
-    memset(colorBuffer, 255, DATA_SIZE);
+    colorBuffer = new GLubyte[dataSize];
+    memset(colorBuffer, 255, dataSize);
+    if(transferType != memoryType)
+        transferBuffer = new GLubyte[transferSize];
 
     return true;
 }
@@ -368,12 +581,17 @@ void clearSharedMem()
     // deallocate frame buffer
     delete [] colorBuffer;
     colorBuffer = 0;
+    delete [] transferBuffer;
+    transferBuffer = 0;
 
     // clean up PBOs
     if(pboSupported)
     {
-        glDeleteBuffers(PBO_COUNT, pboIds);
+        pboRing.release();
     }
+
+    // delete GPU timer queries
+    Profiler::getInstance().releaseGpu();
 }
 
 
@@ -425,7 +643,7 @@ void showInfo()
     glMatrixMode(GL_PROJECTION);     // switch to projection matrix
     glPushMatrix();                  // save current projection matrix
     glLoadIdentity();                // reset projection matrix
-    gluOrtho2D(0, SCREEN_WIDTH, 0, SCREEN_HEIGHT);  // set to orthogonal projection
+    gluOrtho2D(0, screenWidth, 0, screenHeight);  // set to orthogonal projection
 
     const int FONT_HEIGHT = 14;
     float color[4] = {1, 1, 1, 1};
@@ -433,23 +651,61 @@ void showInfo()
     std::stringstream ss;
     ss << "PBO: ";
     if(pboUsed)
-        ss << "on" << std::ends;
+        ss << pboRing.getCount() << " PBOs (latency: " << pboRing.getLatency() << " frames)";
     else
-        ss << "off" << std::ends;
+        ss << "off";
+    ss << ", Transfer: " << Format::getTypeName(transferType) << std::ends;
 
-    drawString(ss.str().c_str(), 1, SCREEN_HEIGHT-FONT_HEIGHT, color, font);
+    drawString(ss.str().c_str(), 1, screenHeight-FONT_HEIGHT, color, font);
     ss.str(""); // clear buffer
 
-    ss << "Read Time: " << readTime << " ms" << std::ends;
-    drawString(ss.str().c_str(), 1, SCREEN_HEIGHT-(2*FONT_HEIGHT), color, font);
+    ss << "Read Time: " << timingStats.formatSummary("read") << std::ends;
+    drawString(ss.str().c_str(), 1, screenHeight-(2*FONT_HEIGHT), color, font);
     ss.str("");
 
     ss << std::fixed << std::setprecision(3);
-    ss << "Process Time: " << processTime << " ms" << std::ends;
-    drawString(ss.str().c_str(), 1, SCREEN_HEIGHT-(3*FONT_HEIGHT), color, font);
+    ss << "Process Time: " << timingStats.formatSummary("process") << " (" << Pixel::getSimdLevelName(Pixel::getSimdLevel())
+       << ", " << threadPool.getThreadCount() << " threads)" << std::ends;
+    drawString(ss.str().c_str(), 1, screenHeight-(3*FONT_HEIGHT), color, font);
+    ss.str("");
+
+    ss << "Stall Time: " << timingStats.formatSummary("stall") << std::ends;
+    drawString(ss.str().c_str(), 1, screenHeight-(4*FONT_HEIGHT), color, font);
+    ss.str("");
+
+    ss << "Capture: ";
+    if(recorder.isOpen())
+        ss << recorder.getAddedCount() << " frames, " << recorder.getDroppedCount() << " dropped ("
+           << captureTime << " ms)" << std::ends;
+    else
+        ss << "off" << std::ends;
+    drawString(ss.str().c_str(), 1, screenHeight-(5*FONT_HEIGHT), color, font);
+    ss.str("");
+
+    ss << "YUV 4:2:0: " << YUV_MODE_NAMES[yuvMode];
+    if(yuvMode > 0)
+        ss << " (" << convertTime << " ms)";
+    ss << std::ends;
+    drawString(ss.str().c_str(), 1, screenHeight-(6*FONT_HEIGHT), color, font);
+    ss.str("");
+
+    ss << "Press C to toggle capture, Y to change YUV, I/H to save image/hi-res." << std::ends;
+    drawString(ss.str().c_str(), 1, 1 + 4 * FONT_HEIGHT, color, font);
     ss.str("");
 
     ss << "Press SPACE to toggle PBO." << std::ends;
+    drawString(ss.str().c_str(), 1, 1 + 3 * FONT_HEIGHT, color, font);
+    ss.str("");
+
+    ss << "Press +/- to change PBO count." << std::ends;
+    drawString(ss.str().c_str(), 1, 1 + 2 * FONT_HEIGHT, color, font);
+    ss.str("");
+
+    ss << "Press T to change threads." << std::ends;
+    drawString(ss.str().c_str(), 1, 1 + FONT_HEIGHT, color, font);
+    ss.str("");
+
+    ss << "Press S to toggle SIMD." << std::ends;
     drawString(ss.str().c_str(), 1, 1, color, font);
 
     // unset floating format
@@ -481,7 +737,7 @@ void showTransferRate()
     {
         ss.str("");
         ss << std::fixed << std::setprecision(1);
-        ss << "Transfer Rate: " << (count / elapsedTime) * (SCREEN_WIDTH * SCREEN_HEIGHT) / (1024 * 1024) << " Mp" << std::ends; // update fps string
+        ss << "Transfer Rate: " << (count / elapsedTime) * (screenWidth * screenHeight) / (1024 * 1024) << " Mp" << std::ends; // update fps string
         ss << std::resetiosflags(std::ios_base::fixed | std::ios_base::floatfield);
         count = 0;                      // reset counter
         timer.start();                  // restart timer
@@ -495,7 +751,7 @@ void showTransferRate()
     glMatrixMode(GL_PROJECTION);        // switch to projection matrix
     glPushMatrix();                     // save current projection matrix
     glLoadIdentity();                   // reset projection matrix
-    gluOrtho2D(0, SCREEN_WIDTH, 0, SCREEN_HEIGHT); // set to orthogonal projection
+    gluOrtho2D(0, screenWidth, 0, screenHeight); // set to orthogonal projection
 
     float color[4] = {1, 1, 0, 1};
     drawString(ss.str().c_str(), 200, 286, color, font);
@@ -530,7 +786,11 @@ void printTransferRate()
     else
     {
         std::cout << std::fixed << std::setprecision(1);
-        std::cout << "Transfer Rate: " << (count / elapsedTime) * (SCREEN_WIDTH * SCREEN_HEIGHT) * INV_MEGA << " Mpixels/s. (" << count / elapsedTime << " FPS)\n";
+        std::cout << "Transfer Rate: " << (count / elapsedTime) * (screenWidth * screenHeight) * INV_MEGA << " Mpixels/s, "
+                  << (count / elapsedTime) * transferSize * INV_MEGA << " MB/s (" << Format::getTypeName(transferType) << "). ("
+                  << count / elapsedTime << " FPS), "
+                  << "Process Time: " << timingStats.formatSummary("process") << " (" << threadPool.getThreadCount() << " threads), "
+                  << "Stall Time: " << timingStats.formatSummary("stall") << " (" << pboRing.getCount() << " PBOs, latency " << pboRing.getLatency() << ")\n";
         std::cout << std::resetiosflags(std::ios_base::fixed | std::ios_base::floatfield);
         count = 0;                      // reset counter
         timer.start();                  // restart timer
@@ -538,56 +798,554 @@ void printTransferRate()
 }
 
 
+
+///////////////////////////////////////////////////////////////////////////////
+// accumulate the process time of the current thread count
+///////////////////////////////////////////////////////////////////////////////
+void recordProcessTime()
+{
+    int threadCount = threadPool.getThreadCount();
+    if((int)processTimeSums.size() <= threadCount)
+    {
+        processTimeSums.resize(threadCount + 1, 0.0);
+        processTimeCounts.resize(threadCount + 1, 0);
+    }
+    processTimeSums[threadCount] += processTime;
+    ++processTimeCounts[threadCount];
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// check the CPU kernels at all SIMD levels against the plain C++ kernels, and
+// print the throughput, return 1 if any output is different
+///////////////////////////////////////////////////////////////////////////////
+int runKernelBench()
+{
+    KernelBench bench;
+    bench.addPixelKernels();
+
+    // YUV 4:2:0 of bottom-up BGRA, the same as read-back frames
+    // The fixed-point kernels are also compared with the floating-point
+    // reference, which differs by at most 1.
+    Yuv::Matrix matrices[] = {Yuv::BT601, Yuv::BT709};
+    for(int i = 0; i < 2; ++i)
+    {
+        Yuv::Matrix matrix = matrices[i];
+        bench.addKernel(std::string("yuv420 ") + Yuv::getMatrixName(matrix), 4, 1.5, false,
+                        [matrix](const unsigned char* src, unsigned char* dst, int w, int h)
+        {
+            Yuv::convertToYuv420(src, w, h, true, true, matrix, dst, 0, Yuv::getChromaHeight(h));
+        });
+        bench.setReference([matrix](const unsigned char* src, unsigned char* dst, int w, int h)
+        {
+            Yuv::convertToYuv420Reference(src, w, h, true, true, matrix, dst);
+        }, 1);
+    }
+
+    // pixel formats of formatUtils, with both byte orders
+    // The 16-bit and float sources are the random bytes too, so NaN, infinity
+    // and out-of-range floats are clamped as well. The sRGB kernels have 8
+    // bytes per pixel on one side, so they convert half of the pixels.
+    for(int i = 0; i < 2; ++i)
+    {
+        bool bgra = (i == 0);
+        std::string order = bgra ? " bgra" : " rgba";
+        bench.addKernel("packRgb565" + order, 4, 2, false, [bgra](const unsigned char* src, unsigned char* dst, int w, int h)
+        {
+            Format::packRgb565(src, bgra, (unsigned short*)dst, (std::size_t)w * h);
+        });
+        bench.addKernel("packRgba4444" + order, 4, 2, false, [bgra](const unsigned char* src, unsigned char* dst, int w, int h)
+        {
+            Format::packRgba4444(src, bgra, (unsigned short*)dst, (std::size_t)w * h);
+        });
+        bench.addKernel("unpackRgb565" + order, 2, 4, false, [bgra](const unsigned char* src, unsigned char* dst, int w, int h)
+        {
+            Format::unpackRgb565((const unsigned short*)src, bgra, dst, (std::size_t)w * h);
+        });
+        bench.addKernel("unpackRgba4444" + order, 2, 4, false, [bgra](const unsigned char* src, unsigned char* dst, int w, int h)
+        {
+            Format::unpackRgba4444((const unsigned short*)src, bgra, dst, (std::size_t)w * h);
+        });
+    }
+    bench.addKernel("swapRedBlue copy", 4, 4, false, [](const unsigned char* src, unsigned char* dst, int w, int h)
+    {
+        Format::swapRedBlue(src, dst, (std::size_t)w * h);
+    });
+    for(int channel = 0; channel < 4; ++channel)
+    {
+        bench.addKernel(std::string("extractChannel ") + (char)('0' + channel), 4, 1, false,
+                        [channel](const unsigned char* src, unsigned char* dst, int w, int h)
+        {
+            Format::extractChannel(src, channel, dst, (std::size_t)w * h);
+        });
+    }
+    bench.addKernel("floatToUnorm16", 4, 2, false, [](const unsigned char* src, unsigned char* dst, int w, int h)
+    {
+        Format::floatToUnorm16((const float*)src, (unsigned short*)dst, (std::size_t)w * h);
+    });
+    bench.addKernel("floatToUnorm8", 4, 1, false, [](const unsigned char* src, unsigned char* dst, int w, int h)
+    {
+        Format::floatToUnorm8((const float*)src, dst, (std::size_t)w * h);
+    });
+    bench.addKernel("srgbToLinear", 2, 4, false, [](const unsigned char* src, unsigned char* dst, int w, int h)
+    {
+        Format::srgbToLinear(src, (unsigned short*)dst, (std::size_t)w * h / 2);
+    });
+    bench.addKernel("linearToSrgb", 4, 2, false, [](const unsigned char* src, unsigned char* dst, int w, int h)
+    {
+        Format::linearToSrgb((const unsigned short*)src, dst, (std::size_t)w * h / 2);
+    });
+
+    return bench.run() ? 0 : 1;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// render the frames to the offscreen framebuffer without window, and write
+// the timings of each frame to the report
+///////////////////////////////////////////////////////////////////////////////
+int runBenchmark()
+{
+    benchmark.setName("pboPack");
+    benchmark.addParameter("width", screenWidth);
+    benchmark.addParameter("height", screenHeight);
+    benchmark.addParameter("format", benchmark.getFormat());
+    benchmark.addParameter("transfer", Format::getTypeName(transferType));
+    benchmark.addParameter("readMB", transferSize / (1024.0 * 1024));
+    benchmark.addParameter("pbo", pboUsed ? pboRing.getCount() : 0);
+    benchmark.addParameter("sync", pboRing.isSyncUsed() ? "on" : "off");
+    benchmark.addParameter("simd", Pixel::getSimdLevelName(Pixel::getSimdLevel()));
+    benchmark.addParameter("threads", threadPool.getThreadCount());
+    benchmark.addParameter("renderer", (const char*)glGetString(GL_RENDERER));
+    benchmark.addParameter("capture", benchmark.getCaptureFile().empty() ? "off" : benchmark.getCaptureFile());
+    benchmark.addParameter("policy", FrameRecorder::getPolicyName(capturePolicy));
+    benchmark.addParameter("yuv", YUV_MODE_NAMES[yuvMode]);
+    benchmark.setColumns({"frameTime", "readTime", "processTime", "stallTime", "captureTime", "convertTime"});
+
+    Timer frameTimer, totalTimer;
+    int warmupCount = benchmark.getWarmupCount();
+    int frameCount = warmupCount + benchmark.getFrameCount();
+    for(int i = 0; i < frameCount; ++i)
+    {
+        // record the measured frames only, so captured is the same as frames
+        if(i == warmupCount)
+        {
+            if(!benchmark.getCaptureFile().empty() && !startCapture(benchmark.getCaptureFile()))
+                return 1;
+            totalTimer.start();
+        }
+
+        frameTimer.start();
+        displayCB();
+        frameTimer.stop();
+
+        if(i >= warmupCount)
+            benchmark.addFrame({frameTimer.getElapsedTimeInMilliSec(), readTime, processTime, stallTime, captureTime, convertTime});
+    }
+    glFinish();
+    totalTimer.stop();
+    benchmark.setTotalTime(totalTimer.getElapsedTime());
+
+    // wait for the writer to finish the queued frames
+    if(recorder.isOpen())
+    {
+        benchmark.addParameter("captured", recorder.getAddedCount());
+        benchmark.addParameter("dropped", recorder.getDroppedCount());
+        stopCapture();
+    }
+
+    if(!benchmark.getScreenshotName().empty())
+        saveScreenshot(benchmark.getScreenshotName());
+    if(!benchmark.getHiresFile().empty() && !saveHighRes(benchmark.getHiresFile()))
+        return 1;
+
+    benchmark.printSummary();
+    if(!benchmark.getReportFile().empty())
+    {
+        if(!benchmark.writeReport(benchmark.getReportFile()))
+            return 1;
+        std::cout << "Report: " << benchmark.getReportFile() << std::endl;
+    }
+    return 0;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// print the average process time and speedup per thread count
+///////////////////////////////////////////////////////////////////////////////
+void printProcessTimes()
+{
+    double baseTime = 0;
+    if(processTimeCounts.size() > 1 && processTimeCounts[1] > 0)
+        baseTime = processTimeSums[1] / processTimeCounts[1];
+
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "Threads  Process Time (ms)  Speedup  Frames\n";
+    for(std::size_t i = 1; i < processTimeCounts.size(); ++i)
+    {
+        if(processTimeCounts[i] == 0)
+            continue;
+        double time = processTimeSums[i] / processTimeCounts[i];
+        std::cout << std::setw(7) << i << std::setw(19) << time << std::setw(9);
+        if(baseTime > 0)
+            std::cout << baseTime / time;
+        else
+            std::cout << "-";
+        std::cout << std::setw(8) << processTimeCounts[i] << "\n";
+    }
+    std::cout << std::resetiosflags(std::ios_base::fixed | std::ios_base::floatfield) << std::flush;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// write the percentiles of the last frames to --stats file
+///////////////////////////////////////////////////////////////////////////////
+void writeTimingStats()
+{
+    const std::string& fileName = benchmark.getStatsFile();
+    if(fileName.empty())
+        return;
+
+    if(timingStats.writeCsv(fileName))
+        std::cout << "Stats: " << fileName << std::endl;
+    else
+        std::cout << "[ERROR] Failed to write " << fileName << std::endl;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// write the profiled zones to --trace file, and print the totals of zones
+///////////////////////////////////////////////////////////////////////////////
+void writeTrace()
+{
+    const std::string& fileName = benchmark.getTraceFile();
+    if(fileName.empty())
+        return;
+
+    Profiler& profiler = Profiler::getInstance();
+    profiler.printSummary();
+    if(profiler.writeTrace(fileName))
+        std::cout << "Trace: " << fileName << std::endl;
+    else
+        std::cout << "[ERROR] Failed to write " << fileName << std::endl;
+}
+
+
 ///////////////////////////////////////////////////////////////////////////////
 // change the brightness
+// The colour components are added with saturation by the SIMD kernel selected
+// at run-time (AVX2, SSE2 or plain C++), and alpha is copied as is.
+// The rows are split into cache-sized bands, and processed by all threads.
 ///////////////////////////////////////////////////////////////////////////////
 void add(unsigned char* src, int width, int height, int shift, unsigned char* dst)
 {
     if(!src || !dst)
         return;
 
-    int value;
-    for(int i = 0; i < height; ++i)
+    // process the bands of scanlines in parallel, it returns after all bands are done
+    std::size_t rowSize = (std::size_t)width * CHANNEL_COUNT;
+    threadPool.run(height, ThreadPool::computeBandRows(rowSize), [=](int firstRow, int lastRow)
     {
-        for(int j = 0; j < width; ++j)
-        {
-            value = *src + shift;
-            if(value > 255) *dst = (unsigned char)255;
-            else            *dst = (unsigned char)value;
-            ++src;
-            ++dst;
-
-            value = *src + shift;
-            if(value > 255) *dst = (unsigned char)255;
-            else            *dst = (unsigned char)value;
-            ++src;
-            ++dst;
-
-            value = *src + shift;
-            if(value > 255) *dst = (unsigned char)255;
-            else            *dst = (unsigned char)value;
-            ++src;
-            ++dst;
-
-            ++src;    // skip alpha
-            ++dst;
-        }
+        PROFILE_ZONE("add band");
+        std::size_t offset = firstRow * rowSize;
+        Pixel::addBrightness(src + offset, dst + offset, (std::size_t)(lastRow - firstRow) * width, shift);
+    });
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// convert the read-back frame in the transfer format to colorBuffer format
+// src is read once, e.g., from the mapped PBO, and the bands are converted by
+// all threads.
+///////////////////////////////////////////////////////////////////////////////
+void unpackFrame(const unsigned char* src, unsigned char* dst)
+{
+    if(!src || !dst)
+        return;
+
+    int srcPixelSize = Format::getPixelSize(transferType);
+    threadPool.run(screenHeight, ThreadPool::computeBandRows((std::size_t)screenWidth * CHANNEL_COUNT), [=](int firstRow, int lastRow)
+    {
+        PROFILE_ZONE("unpack band");
+        std::size_t offset = (std::size_t)firstRow * screenWidth;
+        Format::convert(src + offset * srcPixelSize, transferType, dst + offset * CHANNEL_COUNT, memoryType,
+                        (std::size_t)(lastRow - firstRow) * screenWidth);
+    });
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+// start recording the read-back frames to the file
+///////////////////////////////////////////////////////////////////////////////
+bool startCapture(const std::string& fileName)
+{
+    // Y4M uses the matrix of --yuv (or Y key), BT.601 if it is off
+    Yuv::Matrix matrix = (yuvMode == 2) ? Yuv::BT709 : Yuv::BT601;
+    if(!recorder.open(fileName, screenWidth, screenHeight, pixelFormat == GL_BGRA,
+                      CAPTURE_BUFFER_COUNT, capturePolicy, matrix))
+    {
+        std::cout << "[ERROR] " << recorder.getError() << std::endl;
+        return false;
     }
+    std::cout << "Capture: " << fileName << " (" << FrameRecorder::getPolicyName(capturePolicy)
+              << ", " << CAPTURE_BUFFER_COUNT << " buffers";
+    if(FrameRecorder::getFormat(fileName) == FrameRecorder::FORMAT_Y4M)
+        std::cout << ", " << Yuv::getMatrixName(matrix);
+    std::cout << ")" << std::endl;
+    return true;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// write the remaining frames and close the file
+///////////////////////////////////////////////////////////////////////////////
+void stopCapture()
+{
+    if(!recorder.isOpen())
+        return;
+
+    recorder.close();
+    std::cout << "Capture: " << recorder.getWrittenCount() << " frames written, "
+              << recorder.getDroppedCount() << " dropped" << std::endl;
+    if(!recorder.getError().empty())
+        std::cout << "[ERROR] " << recorder.getError() << std::endl;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// pass a read-back frame to the recorder, only a memcpy on this thread
+///////////////////////////////////////////////////////////////////////////////
+void captureFrame(const unsigned char* src)
+{
+    captureTime = 0;
+    if(!recorder.isOpen())
+        return;
+
+    ScopedTimer t(timingStats, "capture", &captureTime);
+    recorder.addFrame(src);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// convert a read-back frame (bottom-up) to YUV 4:2:0 with all threads
+// A band of chroma rows reads 2 scanlines of the source once.
+///////////////////////////////////////////////////////////////////////////////
+void convertToYuv(const unsigned char* src)
+{
+    convertTime = 0;
+    if(yuvMode == 0)
+        return;
+
+    ScopedTimer t(timingStats, "convert", &convertTime);
+    yuvBuffer.resize(Yuv::getFrameSize(screenWidth, screenHeight));
+    Yuv::Matrix matrix = (yuvMode == 2) ? Yuv::BT709 : Yuv::BT601;
+    bool bgra = (pixelFormat == GL_BGRA);
+    int bandRows = ThreadPool::computeBandRows((std::size_t)screenWidth * CHANNEL_COUNT * 2);
+    threadPool.run(Yuv::getChromaHeight(screenHeight), bandRows, [&](int firstRow, int lastRow)
+    {
+        PROFILE_ZONE("yuv band");
+        Yuv::convertToYuv420(src, screenWidth, screenHeight, bgra, true, matrix, &yuvBuffer[0], firstRow, lastRow);
+    });
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// save the last processed frame (colorBuffer) with each image writer, then
+// print the file sizes and the speeds (MB/s of the uncompressed frame)
+// Tga and Bmp take RGB(A) order, so the frame is converted first; the time is
+// printed separately. Qoi encodes the BGRA/RGBA frame in bottom-up rows as is,
+// then the QOI file is read back to verify it is lossless.
+///////////////////////////////////////////////////////////////////////////////
+void saveScreenshot(const std::string& name)
+{
+    struct Result
+    {
+        std::string label;
+        std::string fileName;
+        double time;
+        bool saved;
+    };
+    std::vector<Result> results;
+    Timer t;
+
+    // RGBA in bottom-up rows for Bmp, and in top-down rows for Tga
+    t.start();
+    std::vector<unsigned char> bottomUp(colorBuffer, colorBuffer + dataSize);
+    if(pixelFormat == GL_BGRA)
+        Pixel::swapRedBlue(&bottomUp[0], dataSize, CHANNEL_COUNT);
+    std::vector<unsigned char> topDown(bottomUp);
+    Pixel::flipImage(&topDown[0], screenWidth, screenHeight, CHANNEL_COUNT);
+    t.stop();
+    double rgbaTime = t.getElapsedTimeInMilliSec();
+
+    Result result;
+    result.label = "tga";
+    result.fileName = name + ".tga";
+    t.start();
+    result.saved = Image::Tga::save(result.fileName.c_str(), screenWidth, screenHeight, CHANNEL_COUNT, &topDown[0]);
+    t.stop();
+    result.time = t.getElapsedTimeInMilliSec();
+    results.push_back(result);
+
+    result.label = "tga rle";
+    result.fileName = name + "_rle.tga";
+    t.start();
+    result.saved = Image::Tga::save(result.fileName.c_str(), screenWidth, screenHeight, CHANNEL_COUNT, &topDown[0], true);
+    t.stop();
+    result.time = t.getElapsedTimeInMilliSec();
+    results.push_back(result);
+
+    Image::Bmp bmp;
+    result.label = "bmp";
+    result.fileName = name + ".bmp";
+    t.start();
+    result.saved = bmp.save(result.fileName.c_str(), screenWidth, screenHeight, CHANNEL_COUNT, &bottomUp[0]);
+    t.stop();
+    result.time = t.getElapsedTimeInMilliSec();
+    results.push_back(result);
+
+    // QOI with a thread, then with all CPU cores (overwrite the same file)
+    std::vector<unsigned char> encoded;
+    for(int threadCount = 1; threadCount >= 0; --threadCount)
+    {
+        result.label = (threadCount == 1) ? "qoi 1 thread" : "qoi threads";
+        result.fileName = name + ".qoi";
+        t.start();
+        Image::Qoi::encode(colorBuffer, screenWidth, screenHeight, CHANNEL_COUNT, pixelFormat == GL_BGRA, true,
+                           threadCount, encoded);
+        std::ofstream outFile(result.fileName.c_str(), std::ios::binary);
+        outFile.write((const char*)&encoded[0], encoded.size());
+        outFile.close();
+        result.saved = outFile.good();
+        t.stop();
+        result.time = t.getElapsedTimeInMilliSec();
+        results.push_back(result);
+    }
+
+    Image::Qoi qoi;
+    bool lossless = qoi.read((name + ".qoi").c_str()) && qoi.getDataSize() == topDown.size() &&
+                    memcmp(qoi.getData(), &topDown[0], topDown.size()) == 0;
+
+    std::cout << "Screenshot: " << screenWidth << "x" << screenHeight << " " << benchmark.getFormat()
+              << ", " << dataSize << " bytes" << std::endl;
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "Writer          File Size   Ratio   Time (ms)     MB/s\n";
+    for(std::size_t i = 0; i < results.size(); ++i)
+    {
+        std::ifstream inFile(results[i].fileName.c_str(), std::ios::binary | std::ios::ate);
+        long long size = results[i].saved ? (long long)inFile.tellg() : 0;
+        std::cout << std::left << std::setw(14) << results[i].label << std::right
+                  << std::setw(11) << size
+                  << std::setw(8) << std::setprecision(2) << (size > 0 ? (double)dataSize / size : 0.0)
+                  << std::setw(12) << std::setprecision(3) << results[i].time
+                  << std::setw(9) << std::setprecision(1) << dataSize / (results[i].time * 1000) << "\n";
+    }
+    std::cout << std::setprecision(3) << "RGBA conversion for TGA/BMP: " << rgbaTime << " ms\n"
+              << "QOI round trip: " << (lossless ? "lossless" : "FAILED") << "\n";
+    std::cout << std::resetiosflags(std::ios_base::fixed | std::ios_base::floatfield) << std::flush;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// render the high-resolution image of --hires-size in tiles of --tile
+// The frustum of gluPerspective() is split per tile, so the image is the
+// same view as the window at the higher resolution.
+///////////////////////////////////////////////////////////////////////////////
+bool saveHighRes(const std::string& fileName)
+{
+    int width = 0, height = 0;
+    char separator = 0;
+    std::istringstream iss(benchmark.getHiresSize());
+    if(!(iss >> width >> separator >> height) || separator != 'x' || width <= 0 || height <= 0)
+    {
+        std::cout << "[ERROR] Invalid high-resolution size: " << benchmark.getHiresSize() << " (WxH)" << std::endl;
+        return false;
+    }
+
+    // the tiles are not larger than the image
+    int tileSize = benchmark.getTileSize();
+    int tileWidth = std::min(tileSize, width);
+    int tileHeight = std::min(tileSize, height);
+    int pboCount = pboRing.getCount() > 0 ? pboRing.getCount() : PBO_COUNT;
+
+    Timer t;
+    t.start();
+    TiledCapture capture;
+    bool result = capture.init(tileWidth, tileHeight, pboCount);
+    if(result)
+    {
+        // the frustum of gluPerspective() with the aspect ratio of the image
+        double top = NEAR_PLANE * tan(FOV_Y * 0.5 * 3.14159265358979323846 / 180.0);
+        double right = top * width / height;
+        double frustum[6] = {-right, right, -top, top, NEAR_PLANE, FAR_PLANE};
+        result = capture.save(fileName.c_str(), width, height, frustum, drawScene);
+    }
+    capture.release();
+    t.stop();
+
+    if(!result)
+    {
+        std::cout << "[ERROR] " << capture.getError() << std::endl;
+        return false;
+    }
+
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "High-res: " << fileName << ", " << width << "x" << height << ", "
+              << capture.getTileCount() << " tiles of " << tileWidth << "x" << tileHeight << ", "
+              << pboCount << " PBOs, " << t.getElapsedTimeInMilliSec() << " ms (stall "
+              << capture.getStallTime() << " ms)" << std::endl;
+    std::cout << std::resetiosflags(std::ios_base::fixed | std::ios_base::floatfield);
+    return true;
 }
 
 
+
+///////////////////////////////////////////////////////////////////////////////
+// clear and draw the scene with the current projection and viewport
+///////////////////////////////////////////////////////////////////////////////
+void drawScene()
+{
+    // clear buffer
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
+
+    // tramsform camera
+    glMatrixMode(GL_MODELVIEW);
+    glLoadIdentity();
+    glTranslatef(0, 0, -cameraDistance);
+    glRotatef(cameraAngleX, 1, 0, 0);   // pitch
+    glRotatef(cameraAngleY, 0, 1, 0);   // heading
+
+    // draw a cube
+    glPushMatrix();
+    draw();
+    glPopMatrix();
+}
+
+
+
 ///////////////////////////////////////////////////////////////////////////////
 // set projection matrix as orthogonal
 ///////////////////////////////////////////////////////////////////////////////
 void toOrtho()
 {
     // set viewport to be the entire window
-    glViewport((GLsizei)SCREEN_WIDTH, 0, (GLsizei)SCREEN_WIDTH, (GLsizei)SCREEN_HEIGHT);
+    glViewport((GLsizei)screenWidth, 0, (GLsizei)screenWidth, (GLsizei)screenHeight);
 
     // set orthographic viewing frustum
     glMatrixMode(GL_PROJECTION);
     glLoadIdentity();
-    glOrtho(0, SCREEN_WIDTH, 0, SCREEN_HEIGHT, -1, 1);
+    glOrtho(0, screenWidth, 0, screenHeight, -1, 1);
 
     // switch to modelview matrix in order to set scene
     glMatrixMode(GL_MODELVIEW);
@@ -602,12 +1360,12 @@ void toOrtho()
 void toPerspective()
 {
     // set viewport to be the entire window
-    glViewport(0, 0, (GLsizei)SCREEN_WIDTH, (GLsizei)SCREEN_HEIGHT);
+    glViewport(0, 0, (GLsizei)screenWidth, (GLsizei)screenHeight);
 
     // set perspective viewing frustum
     glMatrixMode(GL_PROJECTION);
     glLoadIdentity();
-    gluPerspective(60.0f, (float)(SCREEN_WIDTH)/SCREEN_HEIGHT, 0.1f, 1000.0f); // FOV, AspectRatio, NearClip, FarClip
+    gluPerspective(FOV_Y, (float)(screenWidth)/screenHeight, NEAR_PLANE, FAR_PLANE); // FOV, AspectRatio, NearClip, FarClip
 
     // switch to modelview matrix in order to set scene
     glMatrixMode(GL_MODELVIEW);
@@ -625,105 +1383,125 @@ void toPerspective()
 
 void displayCB()
 {
+    PROFILE_FRAME();                                // collect the zones of the previous frame
+    PROFILE_ZONE("displayCB");
+    ScopedTimer frameTimer(timingStats, "frame");   // added when returned
     static int shift = 0;
-    static int index = 0;
-    int nextIndex = 0;                  // pbo index used for next frame
 
     // brightness shift amount
     ++shift;
     shift %= 200;
 
-    // increment current index first then get the next index
-    // "index" is used to read pixels from a framebuffer to a PBO
-    // "nextIndex" is used to process pixels in the other PBO
-    index = (index + 1) % 2;
-    nextIndex = (index + 1) % 2;
-
     // set the framebuffer to read
-    glReadBuffer(GL_FRONT);
+    glReadBuffer(readBufferMode);
 
     if(pboUsed) // with PBO
     {
         // read framebuffer ///////////////////////////////
-        t1.start();
-
-        // copy pixels from framebuffer to PBO
+        // copy pixels from framebuffer to the next PBO in the ring
         // Use offset instead of ponter.
         // OpenGL should perform asynch DMA transfer, so glReadPixels() will return immediately.
-        glBindBuffer(GL_PIXEL_PACK_BUFFER, pboIds[index]);
-        glReadPixels(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, PIXEL_FORMAT, GL_UNSIGNED_BYTE, 0);
-
-        // measure the time reading framebuffer
-        t1.stop();
-        readTime = t1.getElapsedTimeInMilliSec();
+        // acquire() waits only if the oldest read is still in flight (stall time).
+        {
+            PROFILE_GPU_ZONE("read");
+            ScopedTimer t(timingStats, "read", &readTime);
+            pboRing.resetStallTime();
+            int index = pboRing.acquire();
+            glReadPixels(0, 0, screenWidth, screenHeight, TRANSFER_FORMATS[transferType], TRANSFER_TYPES[transferType], 0);
+            pboRing.fence(index);
+            pboRing.unbind();
+        }
         ///////////////////////////////////////////////////
 
         // process pixel data /////////////////////////////
-        t1.start();
-
-        // map the PBO that contain framebuffer pixels before processing it
-        glBindBuffer(GL_PIXEL_PACK_BUFFER, pboIds[nextIndex]);
-        GLubyte* src = (GLubyte*)glMapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY);
-        if(src)
+        // map the newest PBO whose read is finished, so glMapBuffer() does not block
+        // If no read is finished yet, keep the previous frame in colorBuffer.
         {
-            // change brightness
-            add(src, SCREEN_WIDTH, SCREEN_HEIGHT, shift, colorBuffer);
-            glUnmapBuffer(GL_PIXEL_PACK_BUFFER);        // release pointer to the mapped buffer
+            PROFILE_ZONE("process");
+            ScopedTimer t(timingStats, "process", &processTime);
+            captureTime = convertTime = 0;
+            int readyIndex = pboRing.getLatestReady();
+            if(readyIndex >= 0)
+            {
+                GLubyte* src = (GLubyte*)pboRing.map(readyIndex, GL_READ_ONLY);
+                if(src)
+                {
+                    // unpack the smaller format to colorBuffer in a pass over
+                    // the mapped PBO, then process colorBuffer in place
+                    if(transferType != memoryType)
+                    {
+                        unpackFrame(src, colorBuffer);
+                        src = colorBuffer;
+                    }
+
+                    // record the frame before it is unmapped
+                    captureFrame(src);
+                    convertToYuv(src);
+
+                    // change brightness
+                    add(src, screenWidth, screenHeight, shift, colorBuffer);
+                }
+                pboRing.unmap();                        // release pointer to the mapped buffer
+            }
         }
-
-        // measure the time reading framebuffer
-        t1.stop();
-        processTime = t1.getElapsedTimeInMilliSec();
+        stallTime = pboRing.getStallTime();
+        timingStats.add("stall", stallTime);
         ///////////////////////////////////////////////////
-
-        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
     }
 
     else        // without PBO
     {
         // read framebuffer ///////////////////////////////
-        t1.start();
-
-        glReadPixels(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, PIXEL_FORMAT, GL_UNSIGNED_BYTE, colorBuffer);
-
-        // measure the time reading framebuffer
-        t1.stop();
-        readTime = t1.getElapsedTimeInMilliSec();
+        {
+            PROFILE_GPU_ZONE("read");
+            ScopedTimer t(timingStats, "read", &readTime);
+            glReadPixels(0, 0, screenWidth, screenHeight, TRANSFER_FORMATS[transferType], TRANSFER_TYPES[transferType],
+                         transferBuffer ? transferBuffer : colorBuffer);
+        }
         ///////////////////////////////////////////////////
 
         // covert to greyscale ////////////////////////////
-        t1.start();
+        {
+            PROFILE_ZONE("process");
+            ScopedTimer t(timingStats, "process", &processTime);
+            if(transferBuffer)
+                unpackFrame(transferBuffer, colorBuffer);
 
-        // change brightness
-        add(colorBuffer, SCREEN_WIDTH, SCREEN_HEIGHT, shift, colorBuffer);
+            // record the frame before it is changed
+            captureFrame(colorBuffer);
+            convertToYuv(colorBuffer);
 
-        // measure the time reading framebuffer
-        t1.stop();
-        processTime = t1.getElapsedTimeInMilliSec();
+            // change brightness
+            add(colorBuffer, screenWidth, screenHeight, shift, colorBuffer);
+        }
+        stallTime = 0;
         ///////////////////////////////////////////////////
     }
 
-    // render to the framebuffer //////////////////////////
-    glDrawBuffer(GL_BACK);
-    toPerspective(); // set to perspective on the left side of the window
+    recordProcessTime();
 
-    // clear buffer
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
-
-    // tramsform camera
-    glTranslatef(0, 0, -cameraDistance);
-    glRotatef(cameraAngleX, 1, 0, 0);   // pitch
-    glRotatef(cameraAngleY, 0, 1, 0);   // heading
-
-    // draw a cube
-    glPushMatrix();
-    draw();
-    glPopMatrix();
+    // render to the framebuffer //////////////////////////
+    glDrawBuffer(drawBufferMode);
+    {
+        PROFILE_GPU_ZONE("drawScene");
+        toPerspective(); // set to perspective on the left side of the window
+        drawScene();
+    }
 
     // draw the read color buffer to the right side of the window
-    toOrtho();      // set to orthographic on the right side of the window
-    glRasterPos2i(0, 0);
-    glDrawPixels(SCREEN_WIDTH, SCREEN_HEIGHT, PIXEL_FORMAT, GL_UNSIGNED_BYTE, colorBuffer);
+    {
+        PROFILE_GPU_ZONE("drawPixels");
+        toOrtho();      // set to orthographic on the right side of the window
+        glRasterPos2i(0, 0);
+        glDrawPixels(screenWidth, screenHeight, pixelFormat, GL_UNSIGNED_BYTE, colorBuffer);
+    }
+
+    // no window to draw text and swap in headless mode
+    if(benchmark.isHeadless())
+    {
+        glFlush();
+        return;
+    }
 
     // draw info messages
     showInfo();
@@ -766,6 +1544,58 @@ void keyboardCB(unsigned char key, int x, int y)
         std::cout << "PBO mode: " << (pboUsed ? "on" : "off") << std::endl;
          break;
 
+    case '+': // deeper PBO ring, more latency but less stall
+    case '=':
+    case '-': // shallower PBO ring
+    case '_':
+        if(pboSupported)
+        {
+            int count = pboRing.getCount() + ((key == '+' || key == '=') ? 1 : -1);
+            if(count >= 1 && count <= PBO_MAX_COUNT)
+                pboRing.init(GL_PIXEL_PACK_BUFFER, count, transferSize, GL_STREAM_READ);
+            std::cout << "PBO count: " << pboRing.getCount() << std::endl;
+        }
+        break;
+
+    case 'c': // start/stop recording
+    case 'C':
+        if(recorder.isOpen())
+            stopCapture();
+        else
+            startCapture(benchmark.getCaptureFile().empty() ? CAPTURE_FILE : benchmark.getCaptureFile());
+        break;
+
+    case 'i': // save the last frame and compare the image writers
+    case 'I':
+        saveScreenshot(benchmark.getScreenshotName().empty() ? SCREENSHOT_NAME : benchmark.getScreenshotName());
+        break;
+
+    case 'h': // render the high-resolution image in tiles
+    case 'H':
+        saveHighRes(benchmark.getHiresFile().empty() ? HIRES_FILE : benchmark.getHiresFile());
+        break;
+
+    case 'y': // change YUV conversion (off -> BT.601 -> BT.709)
+    case 'Y':
+        yuvMode = (yuvMode + 1) % 3;
+        std::cout << "YUV 4:2:0: " << YUV_MODE_NAMES[yuvMode] << std::endl;
+        break;
+
+    case 's': // switch between SIMD and plain C++ kernels
+    case 'S':
+        if(Pixel::getSimdLevel() == Pixel::SIMD_NONE)
+            Pixel::setSimdLevel(Pixel::getMaxSimdLevel());
+        else
+            Pixel::setSimdLevel(Pixel::SIMD_NONE);
+        std::cout << "SIMD: " << Pixel::getSimdLevelName(Pixel::getSimdLevel()) << std::endl;
+        break;
+
+    case 't': // change the number of threads (1 -> 2 -> ... -> # of cores)
+    case 'T':
+        threadPool.setThreadCount(threadPool.getThreadCount() % ThreadPool::getMaxThreadCount() + 1);
+        std::cout << "Threads: " << threadPool.getThreadCount() << std::endl;
+        break;
+
     case 'd': // switch rendering modes (fill -> wire -> point)
     case 'D':
         ++drawMode;
@@ -846,5 +1676,9 @@ void mouseMotionCB(int x, int y)
 
 void exitCB()
 {
+    stopCapture();
+    printProcessTimes();
+    writeTimingStats();
+    writeTrace();
     clearSharedMem();
 }
@@ -0,0 +1,434 @@
+///////////////////////////////////////////////////////////////////////////////
+// yuvUtils.cpp
+// ============
+// Colour conversion of 4-channel pixels (BGRA or RGBA) to YUV 4:2:0 planar
+//
+//  AUTHOR: Song Ho Ahn (song.ahn@gmail.com)
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cmath>                        // for floor()
+#include <cstring>                      // for memcpy()
+#include "yuvUtils.h"
+#include "pixelUtils.h"                 // SIMD level and PIXEL_TARGET
+
+#ifdef PIXEL_X86
+#include <immintrin.h>
+#endif
+
+
+
+namespace Yuv
+{
+// constants
+static const int PIXEL_SIZE = 4;
+static const int SHIFT = 14;                                        // fixed-point bits
+static const int Y_BIAS = (16 << SHIFT) + (1 << (SHIFT - 1));       // offset + rounding
+static const int C_BIAS = (128 << (SHIFT + 2)) + (1 << (SHIFT + 1));// chroma from sum of 4 pixels
+
+// coefficients of R, G and B from Kr and Kb of the matrix, scaled to the
+// limited range (219 for Y, 224 for UV)
+struct Matrix3
+{
+    double y[3];
+    double u[3];
+    double v[3];
+};
+
+static Matrix3 getMatrix(Matrix matrix)
+{
+    double kr = (matrix == BT709) ? 0.2126 : 0.299;
+    double kb = (matrix == BT709) ? 0.0722 : 0.114;
+    double kg = 1.0 - kr - kb;
+    double sy = 219.0 / 255.0;
+    double sc = 224.0 / 255.0;
+
+    Matrix3 m;
+    m.y[0] = kr * sy;
+    m.y[1] = kg * sy;
+    m.y[2] = kb * sy;
+    m.u[0] = -kr / (2 * (1 - kb)) * sc;
+    m.u[1] = -kg / (2 * (1 - kb)) * sc;
+    m.u[2] = 0.5 * sc;
+    m.v[0] = 0.5 * sc;
+    m.v[1] = -kg / (2 * (1 - kr)) * sc;
+    m.v[2] = -kb / (2 * (1 - kr)) * sc;
+    return m;
+}
+
+// fixed-point coefficients in the byte order of the pixel, BGR or RGB
+struct Coeffs
+{
+    int y[3];
+    int u[3];
+    int v[3];
+};
+
+static Coeffs computeCoeffs(Matrix matrix, bool bgra)
+{
+    Matrix3 m = getMatrix(matrix);
+    Coeffs k;
+    for(int i = 0; i < 3; ++i)
+    {
+        int j = bgra ? 2 - i : i;       // byte i of pixel is component j (RGB)
+        k.y[i] = (int)floor(m.y[j] * (1 << SHIFT) + 0.5);
+        k.u[i] = (int)floor(m.u[j] * (1 << SHIFT) + 0.5);
+        k.v[i] = (int)floor(m.v[j] * (1 << SHIFT) + 0.5);
+    }
+    return k;
+}
+
+static inline unsigned char clamp(int value)
+{
+    return (unsigned char)(value < 0 ? 0 : (value > 255 ? 255 : value));
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// plain C++ kernel, converts the pixels from x of 2 rows
+// row2 is the same as row1 if the height is odd, then y2 is null.
+///////////////////////////////////////////////////////////////////////////////
+static void convertRows1(const unsigned char* row1, const unsigned char* row2, int x, int width,
+                         const Coeffs& k, unsigned char* y1, unsigned char* y2, unsigned char* u, unsigned char* v)
+{
+    for(; x < width; x += 2)
+    {
+        const unsigned char* p[4];
+        p[0] = row1 + x * PIXEL_SIZE;
+        p[1] = (x + 1 < width) ? p[0] + PIXEL_SIZE : p[0];
+        p[2] = row2 + x * PIXEL_SIZE;
+        p[3] = (x + 1 < width) ? p[2] + PIXEL_SIZE : p[2];
+
+        y1[x] = clamp((k.y[0] * p[0][0] + k.y[1] * p[0][1] + k.y[2] * p[0][2] + Y_BIAS) >> SHIFT);
+        if(x + 1 < width)
+            y1[x + 1] = clamp((k.y[0] * p[1][0] + k.y[1] * p[1][1] + k.y[2] * p[1][2] + Y_BIAS) >> SHIFT);
+        if(y2)
+        {
+            y2[x] = clamp((k.y[0] * p[2][0] + k.y[1] * p[2][1] + k.y[2] * p[2][2] + Y_BIAS) >> SHIFT);
+            if(x + 1 < width)
+                y2[x + 1] = clamp((k.y[0] * p[3][0] + k.y[1] * p[3][1] + k.y[2] * p[3][2] + Y_BIAS) >> SHIFT);
+        }
+
+        int s0 = p[0][0] + p[1][0] + p[2][0] + p[3][0];
+        int s1 = p[0][1] + p[1][1] + p[2][1] + p[3][1];
+        int s2 = p[0][2] + p[1][2] + p[2][2] + p[3][2];
+        u[x / 2] = clamp((k.u[0] * s0 + k.u[1] * s1 + k.u[2] * s2 + C_BIAS) >> (SHIFT + 2));
+        v[x / 2] = clamp((k.v[0] * s0 + k.v[1] * s1 + k.v[2] * s2 + C_BIAS) >> (SHIFT + 2));
+    }
+}
+
+
+
+#ifdef PIXEL_X86
+///////////////////////////////////////////////////////////////////////////////
+// SSE2 kernels, 8 pixels of 2 rows per iteration
+// pmaddwd multiplies the 16-bit components with [c0, c1, c2, 0] and adds the
+// pairs, then shufps gathers the 2 halves of 4 pixels to add them.
+///////////////////////////////////////////////////////////////////////////////
+PIXEL_TARGET("sse2")
+static inline __m128i sumPairsSSE2(__m128i m0, __m128i m1)
+{
+    __m128 a = _mm_shuffle_ps(_mm_castsi128_ps(m0), _mm_castsi128_ps(m1), _MM_SHUFFLE(2, 0, 2, 0));
+    __m128 b = _mm_shuffle_ps(_mm_castsi128_ps(m0), _mm_castsi128_ps(m1), _MM_SHUFFLE(3, 1, 3, 1));
+    return _mm_add_epi32(_mm_castps_si128(a), _mm_castps_si128(b));
+}
+
+// luma of 4 pixels to 4 int32
+PIXEL_TARGET("sse2")
+static inline __m128i lumaSSE2(__m128i pixels, __m128i coeffs)
+{
+    const __m128i zero = _mm_setzero_si128();
+    __m128i m0 = _mm_madd_epi16(_mm_unpacklo_epi8(pixels, zero), coeffs);
+    __m128i m1 = _mm_madd_epi16(_mm_unpackhi_epi8(pixels, zero), coeffs);
+    return _mm_srai_epi32(_mm_add_epi32(sumPairsSSE2(m0, m1), _mm_set1_epi32(Y_BIAS)), SHIFT);
+}
+
+// sum of 2x2 pixels of 4 pixels in 2 rows, the 16-bit components of 2 chroma samples
+PIXEL_TARGET("sse2")
+static inline __m128i sum2x2SSE2(__m128i pixels1, __m128i pixels2)
+{
+    const __m128i zero = _mm_setzero_si128();
+    __m128i lo = _mm_add_epi16(_mm_unpacklo_epi8(pixels1, zero), _mm_unpacklo_epi8(pixels2, zero));
+    __m128i hi = _mm_add_epi16(_mm_unpackhi_epi8(pixels1, zero), _mm_unpackhi_epi8(pixels2, zero));
+    lo = _mm_add_epi16(lo, _mm_srli_si128(lo, 8));
+    hi = _mm_add_epi16(hi, _mm_srli_si128(hi, 8));
+    return _mm_unpacklo_epi64(lo, hi);
+}
+
+// chroma of 4 samples to 4 int32
+PIXEL_TARGET("sse2")
+static inline __m128i chromaSSE2(__m128i sum0, __m128i sum1, __m128i coeffs)
+{
+    __m128i c = sumPairsSSE2(_mm_madd_epi16(sum0, coeffs), _mm_madd_epi16(sum1, coeffs));
+    return _mm_srai_epi32(_mm_add_epi32(c, _mm_set1_epi32(C_BIAS)), SHIFT + 2);
+}
+
+PIXEL_TARGET("sse2")
+static int convertRowsSSE2(const unsigned char* row1, const unsigned char* row2, int width,
+                           const Coeffs& k, unsigned char* y1, unsigned char* y2, unsigned char* u, unsigned char* v)
+{
+    const __m128i yCoeffs = _mm_setr_epi16((short)k.y[0], (short)k.y[1], (short)k.y[2], 0, (short)k.y[0], (short)k.y[1], (short)k.y[2], 0);
+    const __m128i uCoeffs = _mm_setr_epi16((short)k.u[0], (short)k.u[1], (short)k.u[2], 0, (short)k.u[0], (short)k.u[1], (short)k.u[2], 0);
+    const __m128i vCoeffs = _mm_setr_epi16((short)k.v[0], (short)k.v[1], (short)k.v[2], 0, (short)k.v[0], (short)k.v[1], (short)k.v[2], 0);
+
+    int x = 0;
+    for(; x + 8 <= width; x += 8)
+    {
+        __m128i p10 = _mm_loadu_si128((const __m128i*)(row1 + x * PIXEL_SIZE));
+        __m128i p11 = _mm_loadu_si128((const __m128i*)(row1 + x * PIXEL_SIZE + 16));
+        __m128i p20 = _mm_loadu_si128((const __m128i*)(row2 + x * PIXEL_SIZE));
+        __m128i p21 = _mm_loadu_si128((const __m128i*)(row2 + x * PIXEL_SIZE + 16));
+
+        __m128i l = _mm_packs_epi32(lumaSSE2(p10, yCoeffs), lumaSSE2(p11, yCoeffs));
+        _mm_storel_epi64((__m128i*)(y1 + x), _mm_packus_epi16(l, l));
+        if(y2)
+        {
+            l = _mm_packs_epi32(lumaSSE2(p20, yCoeffs), lumaSSE2(p21, yCoeffs));
+            _mm_storel_epi64((__m128i*)(y2 + x), _mm_packus_epi16(l, l));
+        }
+
+        // [U0~U3, V0~V3] to bytes
+        __m128i sum0 = sum2x2SSE2(p10, p20);
+        __m128i sum1 = sum2x2SSE2(p11, p21);
+        __m128i c = _mm_packs_epi32(chromaSSE2(sum0, sum1, uCoeffs), chromaSSE2(sum0, sum1, vCoeffs));
+        c = _mm_packus_epi16(c, c);
+        int u4 = _mm_cvtsi128_si32(c);
+        int v4 = _mm_cvtsi128_si32(_mm_srli_si128(c, 4));
+        memcpy(u + x / 2, &u4, 4);
+        memcpy(v + x / 2, &v4, 4);
+    }
+    return x;                           // # of processed pixels
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// AVX2 kernels, 16 pixels of 2 rows per iteration
+// The instructions work within 128-bit lanes, so the lanes hold the pixels
+// 0~3 and 4~7 of each 8 pixels, then the results are reordered at the end.
+///////////////////////////////////////////////////////////////////////////////
+PIXEL_TARGET("avx2")
+static inline __m256i sumPairsAVX2(__m256i m0, __m256i m1)
+{
+    __m256 a = _mm256_shuffle_ps(_mm256_castsi256_ps(m0), _mm256_castsi256_ps(m1), _MM_SHUFFLE(2, 0, 2, 0));
+    __m256 b = _mm256_shuffle_ps(_mm256_castsi256_ps(m0), _mm256_castsi256_ps(m1), _MM_SHUFFLE(3, 1, 3, 1));
+    return _mm256_add_epi32(_mm256_castps_si256(a), _mm256_castps_si256(b));
+}
+
+// luma of 8 pixels to 8 int32 in order
+PIXEL_TARGET("avx2")
+static inline __m256i lumaAVX2(__m256i pixels, __m256i coeffs)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i m0 = _mm256_madd_epi16(_mm256_unpacklo_epi8(pixels, zero), coeffs);
+    __m256i m1 = _mm256_madd_epi16(_mm256_unpackhi_epi8(pixels, zero), coeffs);
+    return _mm256_srai_epi32(_mm256_add_epi32(sumPairsAVX2(m0, m1), _mm256_set1_epi32(Y_BIAS)), SHIFT);
+}
+
+// 16 luma values to bytes; packssdw gives [0~3, 8~11 | 4~7, 12~15]
+PIXEL_TARGET("avx2")
+static inline __m128i packLumaAVX2(__m256i y0, __m256i y1)
+{
+    __m256i w = _mm256_permute4x64_epi64(_mm256_packs_epi32(y0, y1), 0xd8);
+    return _mm_packus_epi16(_mm256_castsi256_si128(w), _mm256_extracti128_si256(w, 1));
+}
+
+PIXEL_TARGET("avx2")
+static inline __m256i sum2x2AVX2(__m256i pixels1, __m256i pixels2)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i lo = _mm256_add_epi16(_mm256_unpacklo_epi8(pixels1, zero), _mm256_unpacklo_epi8(pixels2, zero));
+    __m256i hi = _mm256_add_epi16(_mm256_unpackhi_epi8(pixels1, zero), _mm256_unpackhi_epi8(pixels2, zero));
+    lo = _mm256_add_epi16(lo, _mm256_srli_si256(lo, 8));
+    hi = _mm256_add_epi16(hi, _mm256_srli_si256(hi, 8));
+    return _mm256_unpacklo_epi64(lo, hi);
+}
+
+// chroma of 8 samples to 8 int32; the lanes are [0, 1, 4, 5 | 2, 3, 6, 7]
+PIXEL_TARGET("avx2")
+static inline __m256i chromaAVX2(__m256i sum0, __m256i sum1, __m256i coeffs)
+{
+    __m256i c = sumPairsAVX2(_mm256_madd_epi16(sum0, coeffs), _mm256_madd_epi16(sum1, coeffs));
+    c = _mm256_permutevar8x32_epi32(c, _mm256_setr_epi32(0, 1, 4, 5, 2, 3, 6, 7));
+    return _mm256_srai_epi32(_mm256_add_epi32(c, _mm256_set1_epi32(C_BIAS)), SHIFT + 2);
+}
+
+PIXEL_TARGET("avx2")
+static int convertRowsAVX2(const unsigned char* row1, const unsigned char* row2, int width,
+                           const Coeffs& k, unsigned char* y1, unsigned char* y2, unsigned char* u, unsigned char* v)
+{
+    const __m256i yCoeffs = _mm256_setr_epi16((short)k.y[0], (short)k.y[1], (short)k.y[2], 0, (short)k.y[0], (short)k.y[1], (short)k.y[2], 0,
+                                              (short)k.y[0], (short)k.y[1], (short)k.y[2], 0, (short)k.y[0], (short)k.y[1], (short)k.y[2], 0);
+    const __m256i uCoeffs = _mm256_setr_epi16((short)k.u[0], (short)k.u[1], (short)k.u[2], 0, (short)k.u[0], (short)k.u[1], (short)k.u[2], 0,
+                                              (short)k.u[0], (short)k.u[1], (short)k.u[2], 0, (short)k.u[0], (short)k.u[1], (short)k.u[2], 0);
+    const __m256i vCoeffs = _mm256_setr_epi16((short)k.v[0], (short)k.v[1], (short)k.v[2], 0, (short)k.v[0], (short)k.v[1], (short)k.v[2], 0,
+                                              (short)k.v[0], (short)k.v[1], (short)k.v[2], 0, (short)k.v[0], (short)k.v[1], (short)k.v[2], 0);
+
+    int x = 0;
+    for(; x + 16 <= width; x += 16)
+    {
+        __m256i p10 = _mm256_loadu_si256((const __m256i*)(row1 + x * PIXEL_SIZE));
+        __m256i p11 = _mm256_loadu_si256((const __m256i*)(row1 + x * PIXEL_SIZE + 32));
+        __m256i p20 = _mm256_loadu_si256((const __m256i*)(row2 + x * PIXEL_SIZE));
+        __m256i p21 = _mm256_loadu_si256((const __m256i*)(row2 + x * PIXEL_SIZE + 32));
+
+        _mm_storeu_si128((__m128i*)(y1 + x), packLumaAVX2(lumaAVX2(p10, yCoeffs), lumaAVX2(p11, yCoeffs)));
+        if(y2)
+            _mm_storeu_si128((__m128i*)(y2 + x), packLumaAVX2(lumaAVX2(p20, yCoeffs), lumaAVX2(p21, yCoeffs)));
+
+        // [U0~U7, V0~V7] to bytes
+        __m256i sum0 = sum2x2AVX2(p10, p20);
+        __m256i sum1 = sum2x2AVX2(p11, p21);
+        __m256i cu = chromaAVX2(sum0, sum1, uCoeffs);
+        __m256i cv = chromaAVX2(sum0, sum1, vCoeffs);
+        __m128i u16 = _mm_packs_epi32(_mm256_castsi256_si128(cu), _mm256_extracti128_si256(cu, 1));
+        __m128i v16 = _mm_packs_epi32(_mm256_castsi256_si128(cv), _mm256_extracti128_si256(cv, 1));
+        __m128i c = _mm_packus_epi16(u16, v16);
+        _mm_storel_epi64((__m128i*)(u + x / 2), c);
+        _mm_storel_epi64((__m128i*)(v + x / 2), _mm_srli_si128(c, 8));
+    }
+    return x;
+}
+#endif // PIXEL_X86
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// return the name of matrix for the options and reports
+///////////////////////////////////////////////////////////////////////////////
+const char* getMatrixName(Matrix matrix)
+{
+    return (matrix == BT709) ? "bt709" : "bt601";
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// size of chroma planes and I420 frame
+///////////////////////////////////////////////////////////////////////////////
+int getChromaWidth(int width)
+{
+    return (width + 1) / 2;
+}
+
+int getChromaHeight(int height)
+{
+    return (height + 1) / 2;
+}
+
+std::size_t getFrameSize(int width, int height)
+{
+    return (std::size_t)width * height + (std::size_t)getChromaWidth(width) * getChromaHeight(height) * 2;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// convert the chroma rows [firstRow, lastRow) to I420
+// Each chroma row reads 2 source rows once, and writes 2 rows of Y and a row
+// of U and V.
+///////////////////////////////////////////////////////////////////////////////
+void convertToYuv420(const unsigned char* src, int width, int height, bool bgra, bool flip,
+                     Matrix matrix, unsigned char* dst, int firstRow, int lastRow)
+{
+    if(!src || !dst || width <= 0 || height <= 0)
+        return;
+
+    Coeffs k = computeCoeffs(matrix, bgra);
+    int chromaWidth = getChromaWidth(width);
+    unsigned char* yPlane = dst;
+    unsigned char* uPlane = yPlane + (std::size_t)width * height;
+    unsigned char* vPlane = uPlane + (std::size_t)chromaWidth * getChromaHeight(height);
+    std::size_t pitch = (std::size_t)width * PIXEL_SIZE;
+#ifdef PIXEL_X86
+    Pixel::SimdLevel level = Pixel::getSimdLevel();
+#endif
+
+    if(lastRow > getChromaHeight(height))
+        lastRow = getChromaHeight(height);
+    for(int i = firstRow; i < lastRow; ++i)
+    {
+        // the last row of odd height is used twice for chroma
+        int row1 = 2 * i;
+        int row2 = (row1 + 1 < height) ? row1 + 1 : row1;
+        const unsigned char* src1 = src + (flip ? height - 1 - row1 : row1) * pitch;
+        const unsigned char* src2 = src + (flip ? height - 1 - row2 : row2) * pitch;
+        unsigned char* y1 = yPlane + (std::size_t)row1 * width;
+        unsigned char* y2 = (row2 != row1) ? y1 + width : 0;
+        unsigned char* u = uPlane + (std::size_t)i * chromaWidth;
+        unsigned char* v = vPlane + (std::size_t)i * chromaWidth;
+
+        int done = 0;
+#ifdef PIXEL_X86
+        if(level >= Pixel::SIMD_AVX2)
+            done = convertRowsAVX2(src1, src2, width, k, y1, y2, u, v);
+        else if(level >= Pixel::SIMD_SSE2)
+            done = convertRowsSSE2(src1, src2, width, k, y1, y2, u, v);
+#endif
+        convertRows1(src1, src2, done, width, k, y1, y2, u, v);
+    }
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// floating-point reference of convertToYuv420()
+// The chroma is from the average colour of 2x2 pixels.
+///////////////////////////////////////////////////////////////////////////////
+void convertToYuv420Reference(const unsigned char* src, int width, int height, bool bgra, bool flip,
+                              Matrix matrix, unsigned char* dst)
+{
+    if(!src || !dst || width <= 0 || height <= 0)
+        return;
+
+    Matrix3 m = getMatrix(matrix);
+    int r = bgra ? 2 : 0;               // offset of red
+    int b = bgra ? 0 : 2;               // offset of blue
+    int chromaWidth = getChromaWidth(width);
+    int chromaHeight = getChromaHeight(height);
+    unsigned char* yPlane = dst;
+    unsigned char* uPlane = yPlane + (std::size_t)width * height;
+    unsigned char* vPlane = uPlane + (std::size_t)chromaWidth * chromaHeight;
+    std::size_t pitch = (std::size_t)width * PIXEL_SIZE;
+
+    for(int i = 0; i < height; ++i)
+    {
+        const unsigned char* p = src + (flip ? height - 1 - i : i) * pitch;
+        for(int j = 0; j < width; ++j, p += PIXEL_SIZE)
+        {
+            double y = m.y[0] * p[r] + m.y[1] * p[1] + m.y[2] * p[b] + 16;
+            yPlane[(std::size_t)i * width + j] = clamp((int)floor(y + 0.5));
+        }
+    }
+
+    for(int i = 0; i < chromaHeight; ++i)
+    {
+        for(int j = 0; j < chromaWidth; ++j)
+        {
+            double red = 0, green = 0, blue = 0;
+            for(int dy = 0; dy < 2; ++dy)
+            {
+                int row = (2 * i + dy < height) ? 2 * i + dy : 2 * i;
+                for(int dx = 0; dx < 2; ++dx)
+                {
+                    int column = (2 * j + dx < width) ? 2 * j + dx : 2 * j;
+                    const unsigned char* p = src + (flip ? height - 1 - row : row) * pitch + column * PIXEL_SIZE;
+                    red += p[r];
+                    green += p[1];
+                    blue += p[b];
+                }
+            }
+            red *= 0.25;
+            green *= 0.25;
+            blue *= 0.25;
+            double u = m.u[0] * red + m.u[1] * green + m.u[2] * blue + 128;
+            double v = m.v[0] * red + m.v[1] * green + m.v[2] * blue + 128;
+            uPlane[(std::size_t)i * chromaWidth + j] = clamp((int)floor(u + 0.5));
+            vPlane[(std::size_t)i * chromaWidth + j] = clamp((int)floor(v + 0.5));
+        }
+    }
+}
+
+} // namespace Yuv
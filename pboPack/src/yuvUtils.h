@@ -0,0 +1,60 @@
+///////////////////////////////////////////////////////////////////////////////
+// yuvUtils.h
+// ==========
+// Colour conversion of 4-channel pixels (BGRA or RGBA) to YUV 4:2:0 planar
+// (I420), e.g., to feed the read-back frames to video encoders
+// A pass over a pair of scanlines writes 2 rows of Y and a row of U and V;
+// each chroma sample is from the sum of 2x2 pixels, so the source is read
+// once. The kernels use 14-bit fixed-point coefficients of BT.601 or BT.709
+// (limited range, Y: 16~235, UV: 16~240), and the SIMD level of pixelUtils
+// (Pixel::getSimdLevel()). The results are the same at all SIMD levels.
+//
+// The frame is processed in bands of chroma rows [firstRow, lastRow), so the
+// bands can be converted by multiple threads, for example,
+//     threadPool.run(Yuv::getChromaHeight(h), bandRows, [&](int first, int last)
+//     {
+//         Yuv::convertToYuv420(src, w, h, true, true, Yuv::BT601, dst, first, last);
+//     });
+//
+//  AUTHOR: Song Ho Ahn (song.ahn@gmail.com)
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef YUV_UTILS_H
+#define YUV_UTILS_H
+
+#include <cstddef>
+
+namespace Yuv
+{
+    // colour matrices
+    enum Matrix
+    {
+        BT601 = 0,                      // SD video
+        BT709                           // HD video
+    };
+
+    const char* getMatrixName(Matrix matrix);
+
+    // size of U and V planes, the last column/row of odd size is repeated
+    int getChromaWidth(int width);
+    int getChromaHeight(int height);
+
+    // bytes of an I420 frame; Y plane, then U and V planes
+    std::size_t getFrameSize(int width, int height);
+
+    // convert the chroma rows [firstRow, lastRow) of an image of 4-byte pixels
+    // to the Y, U and V planes in dst (getFrameSize() bytes)
+    // bgra is false for RGBA, and flip is true for bottom-up source rows, e.g.,
+    // glReadPixels(), so dst is always top-down.
+    void convertToYuv420(const unsigned char* src, int width, int height, bool bgra, bool flip,
+                         Matrix matrix, unsigned char* dst, int firstRow, int lastRow);
+
+    // floating-point version of convertToYuv420() for the whole image, to
+    // verify the fixed-point kernels (the difference is at most 1)
+    void convertToYuv420Reference(const unsigned char* src, int width, int height, bool bgra, bool flip,
+                                  Matrix matrix, unsigned char* dst);
+}
+
+#endif // YUV_UTILS_H
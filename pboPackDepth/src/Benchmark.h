@@ -0,0 +1,179 @@
+///////////////////////////////////////////////////////////////////////////////
+// Benchmark.h
+// ===========
+// Command-line options and per-frame timing report for the headless benchmark
+// mode of the PBO samples
+// The timings of each frame are added with addFrame(), and writeReport()
+// writes all frames and the statistics (mean, min, max and percentiles) of
+// each column to a CSV or JSON file, chosen by the file extension.
+//
+// options:
+//     --headless          render offscreen without window, then exit
+//     --bench-kernels     check and measure the CPU kernels at all SIMD levels, then exit
+//     --width N           image width
+//     --height N          image height
+//     --format NAME       pixel format, e.g., bgra, rgba
+//     --transfer NAME     pixel format in PBO, e.g., rgb565, rgba4444, "format" is the same as --format
+//     --pbo N             PBO mode, 0 means no PBO
+//     --mode NAME         transfer mode of the sample, e.g., map, persistent
+//     --tiles NAME        dirty tile tracking of the sample, e.g., off, mark, detect
+//     --dirty N           changed area of the image in percent (0 ~ 100)
+//     --fill NAME         pixel fill kernel of the sample, e.g., loop, simd, stream
+//     --yuv NAME          YUV 4:2:0 conversion of the sample, e.g., off, bt601, bt709
+//     --culling NAME      occlusion culling of the sample, e.g., off, test, on
+//     --points FILE       save the last depth as a point cloud to FILE (.ply)
+//     --point-format NAME point type of the PLY file, e.g., float, short
+//     --voxel SIZE        keep 1 point per voxel of SIZE, 0 keeps all points
+//     --threads N         # of threads processing pixels, 0 is the default of the sample
+//     --capture FILE      record the read-back frames to FILE (.raw, .y4m, .tga or .qoi)
+//     --capture-policy NAME   drop or block the frame if the recorder is full
+//     --screenshot NAME   save the last frame to NAME.tga, NAME.bmp and NAME.qoi
+//     --hires FILE        render a high-resolution image in tiles to FILE (.tga)
+//     --hires-size WxH    size of the high-resolution image, e.g., 16384x16384
+//     --tile N            tile size of the high-resolution image
+//     --frames N          # of frames to measure (default 300)
+//     --warmup N          # of frames to skip before measuring (default 10)
+//     --report FILE       write per-frame timings to FILE (.csv or .json)
+//     --stats FILE        write rolling percentiles of the named timings to FILE (.csv)
+//     --trace FILE        profile the zones of each frame, and write Chrome trace to FILE (.json)
+//
+//  AUTHOR: Song Ho Ahn (song.ahn@gmail.com)
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <string>
+#include <vector>
+
+class Benchmark
+{
+public:
+    // ctor/dtor
+    Benchmark();
+    ~Benchmark() {}
+
+    // parse command-line arguments, return false if an argument is invalid
+    // The values not in arguments are unchanged, so set the defaults first.
+    bool parse(int argc, char** argv);
+    void printUsage(const char* name) const;
+
+    // options
+    bool isHeadless() const                         { return headless; }
+    bool isKernelBench() const                      { return kernelBench; }
+    int getWidth() const                            { return width; }
+    int getHeight() const                           { return height; }
+    const std::string& getFormat() const            { return format; }
+    const std::string& getTransfer() const          { return transfer; }
+    int getPboMode() const                          { return pboMode; }
+    const std::string& getMode() const              { return mode; }
+    const std::string& getTileMode() const          { return tileMode; }
+    int getDirtyPercent() const                     { return dirtyPercent; }
+    const std::string& getFillMode() const          { return fillMode; }
+    const std::string& getYuvMode() const           { return yuvMode; }
+    const std::string& getCullMode() const          { return cullMode; }
+    const std::string& getPointFile() const         { return pointFile; }
+    const std::string& getPointFormat() const       { return pointFormat; }
+    double getVoxelSize() const                     { return voxelSize; }
+    int getThreadCount() const                      { return threadCount; }
+    const std::string& getCaptureFile() const       { return captureFile; }
+    const std::string& getCapturePolicy() const     { return capturePolicy; }
+    const std::string& getScreenshotName() const    { return screenshotName; }
+    const std::string& getHiresFile() const         { return hiresFile; }
+    const std::string& getHiresSize() const         { return hiresSize; }
+    int getTileSize() const                         { return tileSize; }
+    int getFrameCount() const                       { return frameCount; }
+    int getWarmupCount() const                      { return warmupCount; }
+    const std::string& getReportFile() const        { return reportFile; }
+    const std::string& getStatsFile() const         { return statsFile; }
+    const std::string& getTraceFile() const         { return traceFile; }
+
+    void setWidth(int w)                            { width = w; }
+    void setHeight(int h)                           { height = h; }
+    void setFormat(const std::string& name)         { format = name; }
+    void setTransfer(const std::string& name)       { transfer = name; }
+    void setPboMode(int mode)                       { pboMode = mode; }
+    void setMode(const std::string& name)           { mode = name; }
+    void setTileMode(const std::string& name)       { tileMode = name; }
+    void setDirtyPercent(int percent)               { dirtyPercent = percent; }
+    void setFillMode(const std::string& name)       { fillMode = name; }
+    void setYuvMode(const std::string& name)        { yuvMode = name; }
+    void setCullMode(const std::string& name)       { cullMode = name; }
+    void setPointFormat(const std::string& name)    { pointFormat = name; }
+    void setVoxelSize(double size)                  { voxelSize = size; }
+    void setCapturePolicy(const std::string& name)  { capturePolicy = name; }
+    void setHiresSize(const std::string& size)      { hiresSize = size; }
+    void setTileSize(int size)                      { tileSize = size; }
+
+    // report
+    void setName(const std::string& name)           { this->name = name; }
+    void setColumns(const std::vector<std::string>& names);
+    void addParameter(const std::string& key, const std::string& value);
+    void addParameter(const std::string& key, double value);
+    void addFrame(const std::vector<double>& times);    // ms per column
+    void setTotalTime(double sec)                   { totalTime = sec; }
+    int getRecordedFrameCount() const               { return (int)frames.size(); }
+
+    bool writeReport(const std::string& fileName) const;
+    void printSummary() const;                      // print statistics to stdout
+
+protected:
+
+private:
+    struct Stats
+    {
+        double mean, min, max, p50, p90, p95, p99;
+    };
+
+    struct Parameter
+    {
+        std::string key;
+        std::string value;
+        bool number;                                // write without quotes in JSON
+    };
+
+    // member functions
+    Stats computeStats(int column) const;
+    bool writeCsv(const std::string& fileName) const;
+    bool writeJson(const std::string& fileName) const;
+
+    // member variables
+    bool headless;
+    bool kernelBench;
+    int width;
+    int height;
+    std::string format;
+    std::string transfer;
+    int pboMode;
+    std::string mode;
+    std::string tileMode;
+    int dirtyPercent;
+    std::string fillMode;
+    std::string yuvMode;
+    std::string cullMode;
+    std::string pointFile;
+    std::string pointFormat;
+    double voxelSize;
+    int threadCount;
+    std::string captureFile;
+    std::string capturePolicy;
+    std::string screenshotName;
+    std::string hiresFile;
+    std::string hiresSize;
+    int tileSize;
+    int frameCount;
+    int warmupCount;
+    std::string reportFile;
+    std::string statsFile;
+    std::string traceFile;
+
+    std::string name;
+    std::vector<std::string> columns;
+    std::vector<Parameter> parameters;
+    std::vector<std::vector<double> > frames;
+    double totalTime;                               // seconds of all measured frames
+};
+
+#endif // BENCHMARK_H
@@ -0,0 +1,170 @@
+///////////////////////////////////////////////////////////////////////////////
+// DepthPyramid.cpp
+// ================
+// Hierarchical-Z (Hi-Z) pyramid of a depth image for occlusion culling
+//
+//  AUTHOR: Song Ho Ahn (song.ahn@gmail.com)
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#include "DepthPyramid.h"
+#include "depthUtils.h"
+#include "ThreadPool.h"
+
+// constants
+static const float MIN_CLIP_W = 1.0e-5f;    // corners behind the eye cannot be projected
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// ctor
+///////////////////////////////////////////////////////////////////////////////
+DepthPyramid::DepthPyramid() : width(0), height(0)
+{
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// build the levels of the pyramid
+// The odd column and row of a level are reduced with their neighbour only, so
+// every pixel of the image is covered by the texels of all levels.
+///////////////////////////////////////////////////////////////////////////////
+void DepthPyramid::build(const float* depth, int width, int height, ThreadPool& threadPool)
+{
+    if(!depth || width <= 0 || height <= 0)
+        return;
+
+    // resize the levels only if the image size is changed
+    if(this->width != width || this->height != height || levels.empty())
+    {
+        this->width = width;
+        this->height = height;
+        levelWidths.clear();
+        levelHeights.clear();
+        levels.clear();
+
+        int w = width;
+        int h = height;
+        do
+        {
+            w = (w + 1) / 2;
+            h = (h + 1) / 2;
+            levelWidths.push_back(w);
+            levelHeights.push_back(h);
+            levels.push_back(std::vector<float>((std::size_t)w * h));
+        }
+        while(w > 1 || h > 1);
+    }
+
+    const float* src = depth;
+    int srcWidth = width;
+    int srcHeight = height;
+    for(int i = 0; i < (int)levels.size(); ++i)
+    {
+        float* dst = &levels[i][0];
+        int dstWidth = levelWidths[i];
+        int pairCount = srcWidth / 2;
+        int bandRows = ThreadPool::computeBandRows(srcWidth * 2 * sizeof(float));
+        threadPool.run(levelHeights[i], bandRows, [&](int firstRow, int lastRow)
+        {
+            for(int y = firstRow; y < lastRow; ++y)
+            {
+                const float* src0 = src + (std::size_t)(2 * y) * srcWidth;
+                const float* src1 = (2 * y + 1 < srcHeight) ? src0 + srcWidth : src0;
+                float* row = dst + (std::size_t)y * dstWidth;
+                Depth::reduceMax(src0, src1, row, pairCount);
+                if(srcWidth & 1)
+                    row[dstWidth - 1] = src0[srcWidth - 1] > src1[srcWidth - 1] ? src0[srcWidth - 1] : src1[srcWidth - 1];
+            }
+        });
+
+        src = dst;
+        srcWidth = dstWidth;
+        srcHeight = levelHeights[i];
+    }
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// test if the box is behind the depth of the pyramid
+// At level i, a texel covers 2^(i+1) x 2^(i+1) pixels of the image, so the
+// pixel (x, y) is in the texel (x >> (i+1), y >> (i+1)).
+///////////////////////////////////////////////////////////////////////////////
+bool DepthPyramid::isOccluded(const float boxMin[3], const float boxMax[3], const float viewProj[16]) const
+{
+    if(levels.empty())
+        return false;
+
+    // project 8 corners to NDC, and find the rectangle and the nearest depth
+    float minX = 0, minY = 0, maxX = 0, maxY = 0, minZ = 0;
+    const float* m = viewProj;
+    for(int i = 0; i < 8; ++i)
+    {
+        float x = (i & 1) ? boxMax[0] : boxMin[0];
+        float y = (i & 2) ? boxMax[1] : boxMin[1];
+        float z = (i & 4) ? boxMax[2] : boxMin[2];
+        float w = m[3]*x + m[7]*y + m[11]*z + m[15];
+        if(w < MIN_CLIP_W)
+            return false;       // crossing the near plane, draw it
+
+        float invW = 1.0f / w;
+        float ndcX = (m[0]*x + m[4]*y + m[8]*z + m[12]) * invW;
+        float ndcY = (m[1]*x + m[5]*y + m[9]*z + m[13]) * invW;
+        float ndcZ = (m[2]*x + m[6]*y + m[10]*z + m[14]) * invW;
+        if(i == 0 || ndcX < minX) minX = ndcX;
+        if(i == 0 || ndcX > maxX) maxX = ndcX;
+        if(i == 0 || ndcY < minY) minY = ndcY;
+        if(i == 0 || ndcY > maxY) maxY = ndcY;
+        if(i == 0 || ndcZ < minZ) minZ = ndcZ;
+    }
+
+    // NDC to window coords of the depth image (glDepthRange(0, 1))
+    float left = (minX * 0.5f + 0.5f) * width;
+    float right = (maxX * 0.5f + 0.5f) * width;
+    float bottom = (minY * 0.5f + 0.5f) * height;
+    float top = (maxY * 0.5f + 0.5f) * height;
+    float nearDepth = minZ * 0.5f + 0.5f;
+    if(right < 0 || left >= width || top < 0 || bottom >= height)
+        return false;           // outside of the image, clipped by OpenGL
+
+    // the pixels covered by the rectangle, inclusive
+    int x0 = left > 0 ? (int)left : 0;
+    int y0 = bottom > 0 ? (int)bottom : 0;
+    int x1 = right < width - 1 ? (int)right : width - 1;
+    int y1 = top < height - 1 ? (int)top : height - 1;
+
+    // find the finest level where the rectangle covers 2x2 texels at most
+    int level = 0;
+    int lastLevel = (int)levels.size() - 1;
+    while(level < lastLevel &&
+          ((x1 >> (level + 1)) - (x0 >> (level + 1)) > 1 || (y1 >> (level + 1)) - (y0 >> (level + 1)) > 1))
+        ++level;
+
+    int shift = level + 1;
+    return nearDepth > findMaxDepth(level, x0 >> shift, y0 >> shift, x1 >> shift, y1 >> shift);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// max depth of the texels [x0, x1] x [y0, y1] of a level
+///////////////////////////////////////////////////////////////////////////////
+float DepthPyramid::findMaxDepth(int level, int x0, int y0, int x1, int y1) const
+{
+    const float* texels = &levels[level][0];
+    int w = levelWidths[level];
+    float maxDepth = 0;
+    for(int y = y0; y <= y1; ++y)
+    {
+        for(int x = x0; x <= x1; ++x)
+        {
+            float d = texels[y * w + x];
+            if(d > maxDepth)
+                maxDepth = d;
+        }
+    }
+    return maxDepth;
+}
@@ -0,0 +1,77 @@
+///////////////////////////////////////////////////////////////////////////////
+// DepthPyramid.h
+// ==============
+// Hierarchical-Z (Hi-Z) pyramid of a depth image for occlusion culling
+// build() halves the depth image read by glReadPixels(GL_FLOAT) repeatedly,
+// and each texel keeps the max (farthest) depth of the pixels it covers. The
+// first level is 1/2 size of the image, and the last level is 1x1.
+//
+// isOccluded() projects the 8 corners of a bounding box with the matrix of
+// the frame the depth image was read from, then picks the level where the
+// projected rectangle covers 2x2 texels at most. The box is hidden if its
+// nearest depth is farther than the max depth of those texels. The test is
+// conservative; a box crossing the near plane or outside of the image is
+// never occluded.
+//
+//  AUTHOR: Song Ho Ahn (song.ahn@gmail.com)
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef DEPTH_PYRAMID_H
+#define DEPTH_PYRAMID_H
+
+#include <vector>
+
+class ThreadPool;
+
+class DepthPyramid
+{
+public:
+    // ctor/dtor
+    DepthPyramid();
+    ~DepthPyramid() {}
+
+    // build all levels from window-space depth [0, 1], bottom-to-top scanlines
+    // The rows of each level are reduced in bands by all threads of the pool.
+    void build(const float* depth, int width, int height, ThreadPool& threadPool);
+
+    // test a world-space bounding box against the pyramid
+    // viewProj is column-major (projection * view) matrix of the depth image.
+    bool isOccluded(const float boxMin[3], const float boxMax[3], const float viewProj[16]) const;
+
+    // getters
+    int getWidth() const;                           // size of the depth image
+    int getHeight() const;
+    int getLevelCount() const;
+    int getLevelWidth(int level) const;
+    int getLevelHeight(int level) const;
+    const float* getLevel(int level) const;         // max depth of each texel
+
+protected:
+
+private:
+    // member functions
+    float findMaxDepth(int level, int x0, int y0, int x1, int y1) const;
+
+    // member variables
+    int width;
+    int height;
+    std::vector<int> levelWidths;
+    std::vector<int> levelHeights;
+    std::vector<std::vector<float> > levels;
+};
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// inline functions
+///////////////////////////////////////////////////////////////////////////////
+inline int DepthPyramid::getWidth() const { return width; }
+inline int DepthPyramid::getHeight() const { return height; }
+inline int DepthPyramid::getLevelCount() const { return (int)levels.size(); }
+inline int DepthPyramid::getLevelWidth(int level) const { return levelWidths[level]; }
+inline int DepthPyramid::getLevelHeight(int level) const { return levelHeights[level]; }
+inline const float* DepthPyramid::getLevel(int level) const { return &levels[level][0]; }
+
+#endif // DEPTH_PYRAMID_H
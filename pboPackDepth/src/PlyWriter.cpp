@@ -0,0 +1,116 @@
+///////////////////////////////////////////////////////////////////////////////
+// PlyWriter.cpp
+// =============
+// Streaming writer of binary PLY point clouds
+//
+//  AUTHOR: Song Ho Ahn (song.ahn@gmail.com)
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#include <sstream>
+#include <iomanip>
+#include "PlyWriter.h"
+
+// constants
+static const int COUNT_WIDTH = 10;          // digits reserved for the vertex count
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// ctor/dtor
+///////////////////////////////////////////////////////////////////////////////
+PlyWriter::PlyWriter() : countPos(0), quantizeStep(0), pointCount(0)
+{
+}
+
+PlyWriter::~PlyWriter()
+{
+    if(file.is_open())
+        close();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// create the file and write the header
+// The count is padded with spaces, then overwritten by close().
+///////////////////////////////////////////////////////////////////////////////
+bool PlyWriter::open(const char* fileName, float quantizeStep)
+{
+    if(file.is_open())
+        close();
+
+    this->quantizeStep = quantizeStep > 0 ? quantizeStep : 0;
+    pointCount = 0;
+    errorMessage.clear();
+
+    file.open(fileName, std::ios::out | std::ios::binary | std::ios::trunc);
+    if(!file.is_open())
+    {
+        errorMessage = std::string("Failed to open a PLY file: ") + fileName;
+        return false;
+    }
+
+    const char* type = isQuantized() ? "short" : "float";
+    std::ostringstream header;
+    header << "ply\n"
+           << "format binary_little_endian 1.0\n"
+           << "comment pboPackDepth point cloud\n";
+    if(isQuantized())
+        header << "comment scale " << std::setprecision(9) << this->quantizeStep << "\n";
+    header << "element vertex ";
+    file << header.str();
+    countPos = file.tellp();
+    file << std::string(COUNT_WIDTH, ' ') << "\n"
+         << "property " << type << " x\n"
+         << "property " << type << " y\n"
+         << "property " << type << " z\n"
+         << "end_header\n";
+    return file.good();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// write the vertex count to the header and close the file
+///////////////////////////////////////////////////////////////////////////////
+bool PlyWriter::close()
+{
+    if(!file.is_open())
+        return false;
+
+    file.seekp(countPos);
+    file << std::left << std::setw(COUNT_WIDTH) << pointCount;
+    bool result = file.good();
+    file.close();
+    if(!result)
+        errorMessage = "Failed to write the PLY file";
+    return result;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// append points, the type must match the format of open()
+// x86 and ARM are little-endian, so the values are written as they are.
+///////////////////////////////////////////////////////////////////////////////
+bool PlyWriter::write(const float* points, std::size_t count)
+{
+    if(!file.is_open() || isQuantized())
+        return false;
+
+    file.write((const char*)points, count * 3 * sizeof(float));
+    pointCount += count;
+    return file.good();
+}
+
+bool PlyWriter::write(const short* points, std::size_t count)
+{
+    if(!file.is_open() || !isQuantized())
+        return false;
+
+    file.write((const char*)points, count * 3 * sizeof(short));
+    pointCount += count;
+    return file.good();
+}
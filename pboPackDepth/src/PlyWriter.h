@@ -0,0 +1,68 @@
+///////////////////////////////////////////////////////////////////////////////
+// PlyWriter.h
+// ===========
+// Streaming writer of binary PLY point clouds
+// open() writes the header with a blank vertex count, then the points are
+// appended by write() as they are produced, and close() fills in the count.
+// So the number of points does not need to be known in advance, and the
+// points do not need to be stored in memory.
+// The vertices are float or 16-bit integer xyz, little-endian. The integer
+// points have "comment scale" in the header; multiply xyz by the scale.
+//
+//  AUTHOR: Song Ho Ahn (song.ahn@gmail.com)
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef PLY_WRITER_H
+#define PLY_WRITER_H
+
+#include <fstream>
+#include <string>
+#include <cstddef>
+
+class PlyWriter
+{
+public:
+    // ctor/dtor
+    PlyWriter();
+    ~PlyWriter();                                   // close the file if opened
+
+    // create a PLY file, quantizeStep > 0 writes 16-bit integer xyz
+    bool open(const char* fileName, float quantizeStep=0);
+    bool close();                                   // fill in the count and close
+
+    // append count points, 3 values per point
+    bool write(const float* points, std::size_t count);
+    bool write(const short* points, std::size_t count);
+
+    // getters
+    bool isOpen() const;
+    bool isQuantized() const;                       // true for 16-bit integer xyz
+    float getQuantizeStep() const;
+    std::size_t getPointCount() const;              // # of written points
+    const char* getError() const;
+
+protected:
+
+private:
+    // member variables
+    std::ofstream file;
+    std::streampos countPos;                        // file position of the vertex count
+    float quantizeStep;
+    std::size_t pointCount;
+    std::string errorMessage;
+};
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// inline functions
+///////////////////////////////////////////////////////////////////////////////
+inline bool PlyWriter::isOpen() const { return file.is_open(); }
+inline bool PlyWriter::isQuantized() const { return quantizeStep > 0; }
+inline float PlyWriter::getQuantizeStep() const { return quantizeStep; }
+inline std::size_t PlyWriter::getPointCount() const { return pointCount; }
+inline const char* PlyWriter::getError() const { return errorMessage.c_str(); }
+
+#endif // PLY_WRITER_H
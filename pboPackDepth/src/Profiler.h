@@ -0,0 +1,196 @@
+///////////////////////////////////////////////////////////////////////////////
+// Profiler.h
+// ==========
+// Frame profiler with nested CPU zones, GPU timer queries and Chrome trace
+// PROFILE_ZONE("name") measures the rest of the scope on the calling thread.
+// Each thread writes its zones to its own ring buffer without lock; the ring
+// is single-producer/single-consumer, and newFrame() on the main thread
+// drains all rings to the trace and the per-zone totals. If a ring is full,
+// the zone is dropped and counted, instead of blocking the thread.
+// PROFILE_GPU_ZONE("name") also measures the GPU time of the GL commands in
+// the scope with GL_TIME_ELAPSED query. The result is read a few frames
+// later without stall. GL_TIME_ELAPSED queries cannot be nested, so a GPU
+// zone inside another GPU zone is measured on CPU only. GPU zones must be
+// used on the thread of the GL context.
+//
+// writeTrace() writes the events to Chrome trace JSON, open it with
+// chrome://tracing or https://ui.perfetto.dev. The GPU zones are drawn on a
+// separate "GPU" track from the CPU start time, because GL_TIME_ELAPSED has
+// the duration only.
+//
+// Define PROFILER_DISABLED to compile the macros out; then the zones cost
+// nothing, and the trace has no event.
+// The zone names must be string literals (static storage), only the pointers
+// are stored.
+//
+// usage:
+//     Profiler::getInstance().initGpu();          // optional, GL context is current
+//     void display()
+//     {
+//         PROFILE_FRAME();                        // collect the previous frame
+//         PROFILE_GPU_ZONE("draw");
+//         ...
+//     }
+//     Profiler::getInstance().writeTrace("trace.json");
+//
+//  AUTHOR: Song Ho Ahn (song.ahn@gmail.com)
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <string>
+#include <vector>
+#include <atomic>
+#include <mutex>
+#include "glExtension.h"
+
+#define PROFILER_CONCAT2(a, b)  a##b
+#define PROFILER_CONCAT(a, b)   PROFILER_CONCAT2(a, b)
+
+#ifndef PROFILER_DISABLED
+#define PROFILE_ZONE(name)      Profiler::CpuZone PROFILER_CONCAT(profileZone, __LINE__)(name)
+#define PROFILE_GPU_ZONE(name)  Profiler::GpuZone PROFILER_CONCAT(profileZone, __LINE__)(name)
+#define PROFILE_FRAME()         Profiler::getInstance().newFrame()
+#else
+#define PROFILE_ZONE(name)      ((void)0)
+#define PROFILE_GPU_ZONE(name)  ((void)0)
+#define PROFILE_FRAME()         ((void)0)
+#endif
+
+class Profiler
+{
+public:
+    // total time of a zone since reset()
+    struct ZoneStats
+    {
+        const char* name;
+        long long count;
+        double totalTime;                           // CPU ms
+        double maxTime;
+        long long gpuCount;
+        double gpuTotalTime;                        // GPU ms
+    };
+
+    // RAII zones used by the macros
+    class CpuZone
+    {
+    public:
+        explicit CpuZone(const char* name);
+        ~CpuZone();
+    private:
+        const char* name;                           // NULL if disabled
+        long long begin;
+    };
+
+    class GpuZone
+    {
+    public:
+        explicit GpuZone(const char* name);
+        ~GpuZone();
+    private:
+        const char* name;
+        long long begin;
+        int query;                                  // index of query, -1 if CPU only
+    };
+
+    static Profiler& getInstance();
+
+    // create GL_TIME_ELAPSED queries, GL context must be current
+    // return false if GL_ARB_timer_query is not supported, then CPU only
+    bool initGpu();
+    void releaseGpu();                              // delete queries, GL context must be current
+
+    // collect the zones of all threads and the finished GPU queries, and
+    // mark the start of a new frame, call it on the GL thread once per frame
+    void newFrame();
+    void reset();                                   // clear the trace and stats
+
+    // collect the zones, then write Chrome trace JSON, no GL call
+    bool writeTrace(const std::string& fileName);
+    void printSummary();                            // print stats of zones to stdout
+
+    // setters/getters
+    void setEnabled(bool flag)                      { enabled.store(flag, std::memory_order_relaxed); }
+    bool isEnabled() const                          { return enabled.load(std::memory_order_relaxed); }
+    bool isGpuEnabled() const                       { return gpuReady; }
+    const std::vector<ZoneStats>& getZoneStats() const { return zoneStats; }
+    int getFrameCount() const                       { return frameCount; }
+    long long getDroppedCount() const;              // zones dropped by full rings or trace
+
+protected:
+
+private:
+    // zone written by a thread
+    struct Event
+    {
+        const char* name;
+        long long begin;                            // ns of monotonic clock
+        long long end;
+    };
+
+    // SPSC ring of a thread, written by the thread and read by newFrame()
+    struct ThreadRing
+    {
+        std::vector<Event> events;
+        int threadId;                               // tid of trace, 1, 2, ...
+        alignas(64) std::atomic<unsigned int> head; // next slot to write, written by producer
+        alignas(64) std::atomic<unsigned int> tail; // next slot to read, written by consumer
+        std::atomic<long long> droppedCount;
+    };
+
+    // event of trace, threadId 0 is GPU
+    struct TraceEvent
+    {
+        const char* name;
+        long long begin;                            // ns from startTime
+        long long duration;
+        int threadId;
+    };
+
+    // GL_TIME_ELAPSED query in flight
+    struct GpuQuery
+    {
+        GLuint id;
+        const char* name;
+        long long begin;                            // CPU time of begin
+    };
+
+    // ctor/dtor, singleton
+    Profiler();
+    ~Profiler();
+    Profiler(const Profiler&);                      // no copy
+    Profiler& operator=(const Profiler&);
+
+    // member functions
+    ThreadRing* getThreadRing();                    // ring of the calling thread
+    void addEvent(const char* name, long long begin, long long end);
+    int beginGpuQuery();
+    void endGpuQuery(int index, const char* name, long long begin);
+    void collect();                                 // drain rings
+    void readGpuQueries();                          // read the finished queries in order
+    void addTraceEvent(const char* name, long long begin, long long duration, int threadId);
+    ZoneStats& getZoneStats(const char* name);
+
+    // member variables
+    std::atomic<bool> enabled;
+    long long startTime;                            // ns at construction, 0 of trace
+    mutable std::mutex ringMutex;                   // guards rings, zones take it only once per thread
+    std::vector<ThreadRing*> rings;
+    std::vector<TraceEvent> traceEvents;
+    std::vector<long long> frameTimes;              // start of each frame
+    std::vector<ZoneStats> zoneStats;
+    long long droppedTraceCount;
+    int frameCount;
+    int mainThreadId;                               // tid calling newFrame(), 0 if none
+
+    bool gpuReady;
+    bool gpuActive;                                 // a GL_TIME_ELAPSED query is open
+    std::vector<GpuQuery> gpuQueries;
+    std::vector<int> freeQueries;                   // indices of gpuQueries
+    std::vector<int> pendingQueries;                // ended, in order
+};
+
+#endif // PROFILER_H
@@ -2,12 +2,12 @@
 // Timer.cpp
 // =========
 // High Resolution Timer.
-// This timer is able to measure the elapsed time with 1 micro-second accuracy
-// in both Windows, Linux and Unix system 
+// This timer is able to measure the elapsed time with 1 nano-second resolution
+// in both Windows, Linux and Unix system
 //
 //  AUTHOR: Song Ho Ahn (song.ahn@gmail.com)
 // CREATED: 2003-01-13
-// UPDATED: 2017-03-30
+// UPDATED: 2026-10-18
 //
 // Copyright (c) 2003 Song Ho Ahn
 //////////////////////////////////////////////////////////////////////////////
@@ -20,18 +20,9 @@
 ///////////////////////////////////////////////////////////////////////////////
 Timer::Timer()
 {
-#if defined(WIN32) || defined(_WIN32)
-    QueryPerformanceFrequency(&frequency);
-    startCount.QuadPart = 0;
-    endCount.QuadPart = 0;
-#else
-    startCount.tv_sec = startCount.tv_usec = 0;
-    endCount.tv_sec = endCount.tv_usec = 0;
-#endif
-
     stopped = 0;
-    startTimeInMicroSec = 0;
-    endTimeInMicroSec = 0;
+    startTimeInNanoSec = getNanoTime();
+    endTimeInNanoSec = startTimeInNanoSec;
 }
 
 
@@ -47,78 +38,94 @@ Timer::~Timer()
 
 ///////////////////////////////////////////////////////////////////////////////
 // start timer.
-// startCount will be set at this point.
+// startTimeInNanoSec will be set at this point.
 ///////////////////////////////////////////////////////////////////////////////
 void Timer::start()
 {
     stopped = 0; // reset stop flag
-#if defined(WIN32) || defined(_WIN32)
-    QueryPerformanceCounter(&startCount);
-#else
-    gettimeofday(&startCount, NULL);
-#endif
+    startTimeInNanoSec = getNanoTime();
 }
 
 
 
 ///////////////////////////////////////////////////////////////////////////////
 // stop the timer.
-// endCount will be set at this point.
+// endTimeInNanoSec will be set at this point.
 ///////////////////////////////////////////////////////////////////////////////
 void Timer::stop()
 {
     stopped = 1; // set timer stopped flag
+    endTimeInNanoSec = getNanoTime();
+}
+
 
+
+///////////////////////////////////////////////////////////////////////////////
+// read the monotonic clock in nano-second
+// The counter of QueryPerformanceCounter() is split to seconds and remainder
+// before multiplying by 10^9, so it does not overflow 64-bit.
+///////////////////////////////////////////////////////////////////////////////
+long long Timer::getNanoTime()
+{
 #if defined(WIN32) || defined(_WIN32)
-    QueryPerformanceCounter(&endCount);
+    static LARGE_INTEGER frequency = {};
+    if(frequency.QuadPart == 0)
+        QueryPerformanceFrequency(&frequency);  // fixed at boot, never 0 since WinXP
+
+    LARGE_INTEGER count;
+    QueryPerformanceCounter(&count);
+    long long sec = count.QuadPart / frequency.QuadPart;
+    long long rem = count.QuadPart % frequency.QuadPart;
+    return sec * 1000000000LL + rem * 1000000000LL / frequency.QuadPart;
 #else
-    gettimeofday(&endCount, NULL);
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
 #endif
 }
 
 
 
 ///////////////////////////////////////////////////////////////////////////////
-// compute elapsed time in micro-second resolution.
+// compute elapsed time in nano-second resolution.
 // other getElapsedTime will call this first, then convert to correspond resolution.
 ///////////////////////////////////////////////////////////////////////////////
-double Timer::getElapsedTimeInMicroSec()
+long long Timer::getElapsedTimeInNanoSec()
 {
-#if defined(WIN32) || defined(_WIN32)
     if(!stopped)
-        QueryPerformanceCounter(&endCount);
+        endTimeInNanoSec = getNanoTime();
+
+    return endTimeInNanoSec - startTimeInNanoSec;
+}
 
-    startTimeInMicroSec = startCount.QuadPart * (1000000.0 / frequency.QuadPart);
-    endTimeInMicroSec = endCount.QuadPart * (1000000.0 / frequency.QuadPart);
-#else
-    if(!stopped)
-        gettimeofday(&endCount, NULL);
 
-    startTimeInMicroSec = (startCount.tv_sec * 1000000.0) + startCount.tv_usec;
-    endTimeInMicroSec = (endCount.tv_sec * 1000000.0) + endCount.tv_usec;
-#endif
 
-    return endTimeInMicroSec - startTimeInMicroSec;
+///////////////////////////////////////////////////////////////////////////////
+// divide elapsedTimeInNanoSec by 1000
+///////////////////////////////////////////////////////////////////////////////
+double Timer::getElapsedTimeInMicroSec()
+{
+    return this->getElapsedTimeInNanoSec() * 0.001;
 }
 
 
 
 ///////////////////////////////////////////////////////////////////////////////
-// divide elapsedTimeInMicroSec by 1000
+// divide elapsedTimeInNanoSec by 1000000
 ///////////////////////////////////////////////////////////////////////////////
 double Timer::getElapsedTimeInMilliSec()
 {
-    return this->getElapsedTimeInMicroSec() * 0.001;
+    return this->getElapsedTimeInNanoSec() * 0.000001;
 }
 
 
 
 ///////////////////////////////////////////////////////////////////////////////
-// divide elapsedTimeInMicroSec by 1000000
+// divide elapsedTimeInNanoSec by 1000000000
 ///////////////////////////////////////////////////////////////////////////////
 double Timer::getElapsedTimeInSec()
 {
-    return this->getElapsedTimeInMicroSec() * 0.000001;
+    return this->getElapsedTimeInNanoSec() * 0.000000001;
 }
 
 
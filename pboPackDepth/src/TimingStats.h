@@ -0,0 +1,119 @@
+///////////////////////////////////////////////////////////////////////////////
+// TimingStats.h
+// =============
+// Named accumulators of timings with rolling statistics
+// Each accumulator keeps the last windowSize samples in a ring, and
+// getSummary() computes min, mean, percentiles (p50, p95, p99) and max of the
+// window, so the overlay shows the distribution of the recent frames instead
+// of a single noisy number. The accumulators are created by the first add()
+// of the name, and listed in that order.
+// ScopedTimer measures the time of its scope with the monotonic Timer, and
+// adds it to the accumulator when it goes out of scope.
+// It is not thread-safe, add the timings from the thread owning the stats.
+//
+// usage:
+//     TimingStats stats(300);                     // last 300 samples per name
+//     {
+//         ScopedTimer t(stats, "read");           // added at the end of scope
+//         glReadPixels(...);
+//     }
+//     std::string line = stats.formatSummary("read");
+//     stats.writeCsv("stats.csv");
+//
+//  AUTHOR: Song Ho Ahn (song.ahn@gmail.com)
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef TIMING_STATS_H
+#define TIMING_STATS_H
+
+#include <string>
+#include <vector>
+#include <map>
+#include "Timer.h"
+
+class TimingStats
+{
+public:
+    // statistics of the samples in the window, in milliseconds
+    struct Summary
+    {
+        int count;                                  // # of samples in the window
+        long long totalCount;                       // # of samples since reset()
+        double last;
+        double min;
+        double mean;
+        double p50;
+        double p95;
+        double p99;
+        double max;
+    };
+
+    // ctor/dtor
+    TimingStats(int windowSize=300);
+    ~TimingStats() {}
+
+    void add(const std::string& name, double ms);   // add a sample to the accumulator of name
+    void reset();                                   // remove all accumulators
+
+    // return false if there is no sample of name
+    bool getSummary(const std::string& name, Summary& summary) const;
+
+    // "p50 1.234 / p95 2.345 / p99 3.456 ms" for the overlay, "-" if no sample
+    std::string formatSummary(const std::string& name, int precision=3) const;
+
+    // a row per accumulator: name,count,total,last,min,mean,p50,p95,p99,max
+    bool writeCsv(const std::string& fileName) const;
+
+    // getters
+    int getWindowSize() const                       { return windowSize; }
+    const std::vector<std::string>& getNames() const{ return names; }
+
+    // percentile (0 ~ 100) of sorted values, interpolated between 2 ranks
+    static double computePercentile(const std::vector<double>& sortedValues, double percent);
+
+protected:
+
+private:
+    // ring of the last samples
+    struct Accumulator
+    {
+        std::vector<float> samples;
+        int next;                                   // index of the next sample
+        long long totalCount;
+        double last;
+    };
+
+    // member variables
+    int windowSize;
+    std::vector<std::string> names;                 // in order of the first add()
+    std::vector<Accumulator> accumulators;          // same order as names
+    std::map<std::string, int> indices;             // name to index of accumulators
+};
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// RAII timer of a scope, adds the elapsed ms to the stats in the destructor
+// If result is not NULL, the elapsed ms is also stored there, e.g., to keep
+// the last value for the per-frame benchmark report.
+///////////////////////////////////////////////////////////////////////////////
+class ScopedTimer
+{
+public:
+    ScopedTimer(TimingStats& stats, const char* name, float* result=0)
+        : stats(stats), name(name), result(result)  { timer.start(); }
+    ~ScopedTimer();
+
+private:
+    ScopedTimer(const ScopedTimer&);                // no copy
+    ScopedTimer& operator=(const ScopedTimer&);
+
+    TimingStats& stats;
+    const char* name;
+    float* result;
+    Timer timer;
+};
+
+#endif // TIMING_STATS_H
@@ -0,0 +1,377 @@
+///////////////////////////////////////////////////////////////////////////////
+// depthUtils.cpp
+// ==============
+// SIMD kernels to process depth images read by glReadPixels(GL_FLOAT)
+//
+//  AUTHOR: Song Ho Ahn (song.ahn@gmail.com)
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cmath>                        // for lrintf()
+#include "depthUtils.h"
+#include "pixelUtils.h"                 // SIMD level and PIXEL_TARGET
+
+#ifdef PIXEL_X86
+#include <immintrin.h>
+#endif
+
+
+
+namespace Depth
+{
+// coefficients of normalize() computed once per image
+// linear depth = a / (b - depth * c), and the result = (value - low) * scale + shift
+struct Coeffs
+{
+    float low;
+    float scale;
+    float shift;
+    bool linear;
+    float a;
+    float b;
+    float c;
+};
+
+static Coeffs computeCoeffs(const Params& params)
+{
+    Coeffs k;
+    float low = params.minValue;
+    float high = params.maxValue;
+    k.linear = params.linear;
+    k.a = params.nearPlane * params.farPlane;
+    k.b = params.farPlane;
+    k.c = params.farPlane - params.nearPlane;
+    if(k.linear)
+    {
+        // linearization is monotonic, so the range is linearized as well
+        low = linearize(low, params.nearPlane, params.farPlane);
+        high = linearize(high, params.nearPlane, params.farPlane);
+    }
+    k.low = low;
+    k.scale = (high > low) ? 1.0f / (high - low) : 0.0f;
+    k.shift = params.shift;
+    return k;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// plain C++ kernels
+///////////////////////////////////////////////////////////////////////////////
+static void findRange1(const float* src, std::size_t count, float& minValue, float& maxValue)
+{
+    for(std::size_t i = 0; i < count; ++i)
+    {
+        if(src[i] < minValue) minValue = src[i];
+        if(src[i] > maxValue) maxValue = src[i];
+    }
+}
+
+static inline float normalize1(float value, const Coeffs& k)
+{
+    if(k.linear)
+        value = k.a / (k.b - value * k.c);
+    value = (value - k.low) * k.scale + k.shift;
+    if(value < 0.0f) value = 0.0f;
+    if(value > 1.0f) value = 1.0f;
+    return value;
+}
+
+static void normalizeFloat1(const float* src, float* dst, std::size_t count, const Coeffs& k)
+{
+    for(std::size_t i = 0; i < count; ++i)
+        dst[i] = normalize1(src[i], k);
+}
+
+static void normalizeUnorm1(const float* src, unsigned short* dst, std::size_t count, const Coeffs& k)
+{
+    for(std::size_t i = 0; i < count; ++i)
+        dst[i] = (unsigned short)lrintf(normalize1(src[i], k) * 65535.0f);    // round to nearest like cvtps2dq
+}
+
+static void reduceMax1(const float* src0, const float* src1, float* dst, std::size_t count)
+{
+    for(std::size_t i = 0; i < count; ++i)
+    {
+        float m0 = src0[2*i] > src0[2*i+1] ? src0[2*i] : src0[2*i+1];
+        float m1 = src1[2*i] > src1[2*i+1] ? src1[2*i] : src1[2*i+1];
+        dst[i] = m0 > m1 ? m0 : m1;
+    }
+}
+
+
+
+#ifdef PIXEL_X86
+///////////////////////////////////////////////////////////////////////////////
+// SSE2 kernels
+///////////////////////////////////////////////////////////////////////////////
+// 2 accumulators per min/max to hide the latency of minps/maxps
+PIXEL_TARGET("sse2")
+static std::size_t findRangeSSE2(const float* src, std::size_t count, float& minValue, float& maxValue)
+{
+    __m128 min0 = _mm_set1_ps(minValue);
+    __m128 max0 = _mm_set1_ps(maxValue);
+    __m128 min1 = min0;
+    __m128 max1 = max0;
+    std::size_t i = 0;
+    for(; i + 8 <= count; i += 8)
+    {
+        __m128 v0 = _mm_loadu_ps(src + i);
+        __m128 v1 = _mm_loadu_ps(src + i + 4);
+        min0 = _mm_min_ps(min0, v0);
+        max0 = _mm_max_ps(max0, v0);
+        min1 = _mm_min_ps(min1, v1);
+        max1 = _mm_max_ps(max1, v1);
+    }
+
+    float mins[4], maxs[4];
+    _mm_storeu_ps(mins, _mm_min_ps(min0, min1));
+    _mm_storeu_ps(maxs, _mm_max_ps(max0, max1));
+    findRange1(mins, 4, minValue, maxValue);
+    findRange1(maxs, 4, minValue, maxValue);
+    return i;                           // # of processed values
+}
+
+PIXEL_TARGET("sse2")
+static inline __m128 normalizeSSE2(__m128 v, const Coeffs& k)
+{
+    if(k.linear)
+        v = _mm_div_ps(_mm_set1_ps(k.a), _mm_sub_ps(_mm_set1_ps(k.b), _mm_mul_ps(v, _mm_set1_ps(k.c))));
+    v = _mm_add_ps(_mm_mul_ps(_mm_sub_ps(v, _mm_set1_ps(k.low)), _mm_set1_ps(k.scale)), _mm_set1_ps(k.shift));
+    return _mm_min_ps(_mm_max_ps(v, _mm_setzero_ps()), _mm_set1_ps(1.0f));
+}
+
+PIXEL_TARGET("sse2")
+static std::size_t normalizeFloatSSE2(const float* src, float* dst, std::size_t count, const Coeffs& k)
+{
+    std::size_t i = 0;
+    for(; i + 8 <= count; i += 8)
+    {
+        __m128 v0 = normalizeSSE2(_mm_loadu_ps(src + i), k);
+        __m128 v1 = normalizeSSE2(_mm_loadu_ps(src + i + 4), k);
+        _mm_storeu_ps(dst + i, v0);
+        _mm_storeu_ps(dst + i + 4, v1);
+    }
+    return i;
+}
+
+// no unsigned 32-to-16 pack in SSE2 (packusdw is SSE4.1), so the values are
+// biased by -32768 for the signed pack, then the sign bit is flipped back
+PIXEL_TARGET("sse2")
+static std::size_t normalizeUnormSSE2(const float* src, unsigned short* dst, std::size_t count, const Coeffs& k)
+{
+    const __m128 unormMax = _mm_set1_ps(65535.0f);
+    const __m128i bias32 = _mm_set1_epi32(32768);
+    const __m128i bias16 = _mm_set1_epi16((short)0x8000);
+    std::size_t i = 0;
+    for(; i + 8 <= count; i += 8)
+    {
+        __m128i i0 = _mm_cvtps_epi32(_mm_mul_ps(normalizeSSE2(_mm_loadu_ps(src + i), k), unormMax));
+        __m128i i1 = _mm_cvtps_epi32(_mm_mul_ps(normalizeSSE2(_mm_loadu_ps(src + i + 4), k), unormMax));
+        __m128i p = _mm_packs_epi32(_mm_sub_epi32(i0, bias32), _mm_sub_epi32(i1, bias32));
+        _mm_storeu_si128((__m128i*)(dst + i), _mm_xor_si128(p, bias16));
+    }
+    return i;
+}
+
+// the vertical max of 8 pixels, then the even and odd pixels are shuffled to
+// 2 vectors for the horizontal max
+PIXEL_TARGET("sse2")
+static std::size_t reduceMaxSSE2(const float* src0, const float* src1, float* dst, std::size_t count)
+{
+    std::size_t i = 0;
+    for(; i + 4 <= count; i += 4)
+    {
+        __m128 v0 = _mm_max_ps(_mm_loadu_ps(src0 + 2*i), _mm_loadu_ps(src1 + 2*i));
+        __m128 v1 = _mm_max_ps(_mm_loadu_ps(src0 + 2*i + 4), _mm_loadu_ps(src1 + 2*i + 4));
+        __m128 even = _mm_shuffle_ps(v0, v1, _MM_SHUFFLE(2, 0, 2, 0));
+        __m128 odd = _mm_shuffle_ps(v0, v1, _MM_SHUFFLE(3, 1, 3, 1));
+        _mm_storeu_ps(dst + i, _mm_max_ps(even, odd));
+    }
+    return i;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// AVX2 kernels
+///////////////////////////////////////////////////////////////////////////////
+PIXEL_TARGET("avx2")
+static std::size_t findRangeAVX2(const float* src, std::size_t count, float& minValue, float& maxValue)
+{
+    __m256 min0 = _mm256_set1_ps(minValue);
+    __m256 max0 = _mm256_set1_ps(maxValue);
+    __m256 min1 = min0;
+    __m256 max1 = max0;
+    std::size_t i = 0;
+    for(; i + 16 <= count; i += 16)
+    {
+        __m256 v0 = _mm256_loadu_ps(src + i);
+        __m256 v1 = _mm256_loadu_ps(src + i + 8);
+        min0 = _mm256_min_ps(min0, v0);
+        max0 = _mm256_max_ps(max0, v0);
+        min1 = _mm256_min_ps(min1, v1);
+        max1 = _mm256_max_ps(max1, v1);
+    }
+
+    float mins[8], maxs[8];
+    _mm256_storeu_ps(mins, _mm256_min_ps(min0, min1));
+    _mm256_storeu_ps(maxs, _mm256_max_ps(max0, max1));
+    findRange1(mins, 8, minValue, maxValue);
+    findRange1(maxs, 8, minValue, maxValue);
+    return i;
+}
+
+PIXEL_TARGET("avx2")
+static inline __m256 normalizeAVX2(__m256 v, const Coeffs& k)
+{
+    if(k.linear)
+        v = _mm256_div_ps(_mm256_set1_ps(k.a), _mm256_sub_ps(_mm256_set1_ps(k.b), _mm256_mul_ps(v, _mm256_set1_ps(k.c))));
+    v = _mm256_add_ps(_mm256_mul_ps(_mm256_sub_ps(v, _mm256_set1_ps(k.low)), _mm256_set1_ps(k.scale)), _mm256_set1_ps(k.shift));
+    return _mm256_min_ps(_mm256_max_ps(v, _mm256_setzero_ps()), _mm256_set1_ps(1.0f));
+}
+
+PIXEL_TARGET("avx2")
+static std::size_t normalizeFloatAVX2(const float* src, float* dst, std::size_t count, const Coeffs& k)
+{
+    std::size_t i = 0;
+    for(; i + 16 <= count; i += 16)
+    {
+        __m256 v0 = normalizeAVX2(_mm256_loadu_ps(src + i), k);
+        __m256 v1 = normalizeAVX2(_mm256_loadu_ps(src + i + 8), k);
+        _mm256_storeu_ps(dst + i, v0);
+        _mm256_storeu_ps(dst + i + 8, v1);
+    }
+    return i;
+}
+
+// vpackusdw packs within 128-bit lanes, so the 64-bit blocks are reordered
+PIXEL_TARGET("avx2")
+static std::size_t normalizeUnormAVX2(const float* src, unsigned short* dst, std::size_t count, const Coeffs& k)
+{
+    const __m256 unormMax = _mm256_set1_ps(65535.0f);
+    std::size_t i = 0;
+    for(; i + 16 <= count; i += 16)
+    {
+        __m256i i0 = _mm256_cvtps_epi32(_mm256_mul_ps(normalizeAVX2(_mm256_loadu_ps(src + i), k), unormMax));
+        __m256i i1 = _mm256_cvtps_epi32(_mm256_mul_ps(normalizeAVX2(_mm256_loadu_ps(src + i + 8), k), unormMax));
+        __m256i p = _mm256_permute4x64_epi64(_mm256_packus_epi32(i0, i1), 0xd8);
+        _mm256_storeu_si256((__m256i*)(dst + i), p);
+    }
+    return i;
+}
+
+// vshufps shuffles within 128-bit lanes like vpackusdw, so the 64-bit blocks
+// are reordered
+PIXEL_TARGET("avx2")
+static std::size_t reduceMaxAVX2(const float* src0, const float* src1, float* dst, std::size_t count)
+{
+    std::size_t i = 0;
+    for(; i + 8 <= count; i += 8)
+    {
+        __m256 v0 = _mm256_max_ps(_mm256_loadu_ps(src0 + 2*i), _mm256_loadu_ps(src1 + 2*i));
+        __m256 v1 = _mm256_max_ps(_mm256_loadu_ps(src0 + 2*i + 8), _mm256_loadu_ps(src1 + 2*i + 8));
+        __m256 even = _mm256_shuffle_ps(v0, v1, _MM_SHUFFLE(2, 0, 2, 0));
+        __m256 odd = _mm256_shuffle_ps(v0, v1, _MM_SHUFFLE(3, 1, 3, 1));
+        __m256d m = _mm256_castps_pd(_mm256_max_ps(even, odd));
+        _mm256_storeu_ps(dst + i, _mm256_castpd_ps(_mm256_permute4x64_pd(m, 0xd8)));
+    }
+    return i;
+}
+#endif // PIXEL_X86
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// find the range of depth values
+// minValue and maxValue are not initialized here, so the ranges of multiple
+// blocks can be accumulated, e.g., per band of the image.
+///////////////////////////////////////////////////////////////////////////////
+void findRange(const float* src, std::size_t count, float& minValue, float& maxValue)
+{
+    if(!src) return;
+
+    std::size_t done = 0;
+#ifdef PIXEL_X86
+    Pixel::SimdLevel level = Pixel::getSimdLevel();
+    if(level >= Pixel::SIMD_AVX2)
+        done = findRangeAVX2(src, count, minValue, maxValue);
+    else if(level >= Pixel::SIMD_SSE2)
+        done = findRangeSSE2(src, count, minValue, maxValue);
+#endif
+    findRange1(src + done, count - done, minValue, maxValue);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// window-space depth to eye-space distance
+// The perspective depth is d = (f / (f - n)) * (1 - n / z), so
+// z = n * f / (f - d * (f - n)).
+///////////////////////////////////////////////////////////////////////////////
+float linearize(float depth, float nearPlane, float farPlane)
+{
+    return nearPlane * farPlane / (farPlane - depth * (farPlane - nearPlane));
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// linearize (optional), normalize, shift and clamp depth values in one pass
+// The unorm16 output stores round(value * 65535).
+///////////////////////////////////////////////////////////////////////////////
+void normalize(const float* src, float* dst, std::size_t count, const Params& params)
+{
+    if(!src || !dst) return;
+
+    Coeffs k = computeCoeffs(params);
+    std::size_t done = 0;
+#ifdef PIXEL_X86
+    Pixel::SimdLevel level = Pixel::getSimdLevel();
+    if(level >= Pixel::SIMD_AVX2)
+        done = normalizeFloatAVX2(src, dst, count, k);
+    else if(level >= Pixel::SIMD_SSE2)
+        done = normalizeFloatSSE2(src, dst, count, k);
+#endif
+    normalizeFloat1(src + done, dst + done, count - done, k);
+}
+
+void normalize(const float* src, unsigned short* dst, std::size_t count, const Params& params)
+{
+    if(!src || !dst) return;
+
+    Coeffs k = computeCoeffs(params);
+    std::size_t done = 0;
+#ifdef PIXEL_X86
+    Pixel::SimdLevel level = Pixel::getSimdLevel();
+    if(level >= Pixel::SIMD_AVX2)
+        done = normalizeUnormAVX2(src, dst, count, k);
+    else if(level >= Pixel::SIMD_SSE2)
+        done = normalizeUnormSSE2(src, dst, count, k);
+#endif
+    normalizeUnorm1(src + done, dst + done, count - done, k);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// halve 2 scanlines to the max of each 2x2 pixels
+// The source scanlines have 2 * count values at least.
+///////////////////////////////////////////////////////////////////////////////
+void reduceMax(const float* src0, const float* src1, float* dst, std::size_t count)
+{
+    if(!src0 || !src1 || !dst) return;
+
+    std::size_t done = 0;
+#ifdef PIXEL_X86
+    Pixel::SimdLevel level = Pixel::getSimdLevel();
+    if(level >= Pixel::SIMD_AVX2)
+        done = reduceMaxAVX2(src0, src1, dst, count);
+    else if(level >= Pixel::SIMD_SSE2)
+        done = reduceMaxSSE2(src0, src1, dst, count);
+#endif
+    reduceMax1(src0 + 2*done, src1 + 2*done, dst + done, count - done);
+}
+
+} // namespace Depth
@@ -0,0 +1,53 @@
+///////////////////////////////////////////////////////////////////////////////
+// depthUtils.h
+// ============
+// SIMD kernels to process depth images read by glReadPixels(GL_FLOAT)
+// findRange() finds the min/max depth, then normalize() maps [min, max] to
+// [0, 1] in a single pass; linearize, normalize, shift and clamp each value,
+// and write it as float or 16-bit unorm (1/2 size of float).
+// reduceMax() halves 2 scanlines to the max of each 2x2 pixels for the
+// Hi-Z pyramid of DepthPyramid.
+// The kernels use the SIMD level of pixelUtils (Pixel::getSimdLevel()), so
+// Pixel::setSimdLevel() switches them to plain C++ for comparison.
+//
+//  AUTHOR: Song Ho Ahn (song.ahn@gmail.com)
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef DEPTH_UTILS_H
+#define DEPTH_UTILS_H
+
+#include <cstddef>
+
+namespace Depth
+{
+    // parameters of normalize()
+    struct Params
+    {
+        float minValue;     // range of the source depth values, from findRange()
+        float maxValue;
+        float shift;        // added after normalizing, then clamped to [0, 1]
+        bool linear;        // convert the window-space depth to linear eye distance
+        float nearPlane;    // clipping planes of the projection for linear depth
+        float farPlane;
+    };
+
+    // find min and max values of depth
+    void findRange(const float* src, std::size_t count, float& minValue, float& maxValue);
+
+    // convert a window-space depth [0, 1] of the perspective projection to the
+    // eye-space distance [near, far]
+    float linearize(float depth, float nearPlane, float farPlane);
+
+    // normalize depth values to [0, 1] in a single pass, src and dst can be
+    // the same buffer for the float output
+    void normalize(const float* src, float* dst, std::size_t count, const Params& params);
+    void normalize(const float* src, unsigned short* dst, std::size_t count, const Params& params);
+
+    // max of each 2x2 pixels of 2 scanlines, dst[i] = max(src0[2i], src0[2i+1],
+    // src1[2i], src1[2i+1]) for count output values
+    void reduceMax(const float* src0, const float* src1, float* dst, std::size_t count);
+}
+
+#endif // DEPTH_UTILS_H
@@ -19,6 +19,7 @@
 // GL_ARB_shader_objects, GL_ARB_vertex_program, GL_ARB_fragment_program, GL_ARB_vertex_shader, GL_ARB_fragment_shader
 // GL_ARB_sync
 // GL_ARB_vertex_array_object
+// GL_ARB_buffer_storage, GL_ARB_map_buffer_range
 // WGL_ARB_extensions_string
 // WGL_ARB_pixel_format
 // WGL_ARB_create_context
@@ -26,7 +27,7 @@
 //
 //  AUTHOR: Song Ho Ahn (song.ahn@gmail.com)
 // CREATED: 2013-03-05
-// UPDATED: 2018-08-09
+// UPDATED: 2026-10-18
 ///////////////////////////////////////////////////////////////////////////////
 
 #include <iostream>
@@ -181,6 +182,15 @@ PFNGLWAITSYNCPROC           pglWaitSync = 0;
 PFNGLGETINTEGER64VPROC      pglGetInteger64v = 0;
 PFNGLGETSYNCIVPROC          pglGetSynciv = 0;
 
+// GL_ARB_timer_query
+PFNGLGENQUERIESPROC             pglGenQueries = 0;
+PFNGLDELETEQUERIESPROC          pglDeleteQueries = 0;
+PFNGLBEGINQUERYPROC             pglBeginQuery = 0;
+PFNGLENDQUERYPROC               pglEndQuery = 0;
+PFNGLGETQUERYOBJECTIVPROC       pglGetQueryObjectiv = 0;
+PFNGLQUERYCOUNTERPROC           pglQueryCounter = 0;          // GL_TIMESTAMP
+PFNGLGETQUERYOBJECTUI64VPROC    pglGetQueryObjectui64v = 0;   // 64-bit result in ns
+
 // GL_ARB_vertex_array_object
 PFNGLGENVERTEXARRAYSPROC    pglGenVertexArrays = 0;     // VAO name generation procedure
 PFNGLDELETEVERTEXARRAYSPROC pglDeleteVertexArrays = 0;  // VAO deletion procedure
@@ -423,6 +433,13 @@ PFNGLGETQUERYBUFFEROBJECTUIVPROC                  pglGetQueryBufferObjectuiv = 0
 PFNGLGETQUERYBUFFEROBJECTI64VPROC                 pglGetQueryBufferObjecti64v = 0;
 PFNGLGETQUERYBUFFEROBJECTUI64VPROC                pglGetQueryBufferObjectui64v = 0;
 
+// GL_ARB_buffer_storage
+PFNGLBUFFERSTORAGEPROC          pglBufferStorage = 0;           // immutable storage for persistent mapping
+
+// GL_ARB_map_buffer_range
+PFNGLMAPBUFFERRANGEPROC         pglMapBufferRange = 0;          // map a range of buffer
+PFNGLFLUSHMAPPEDBUFFERRANGEPROC pglFlushMappedBufferRange = 0;  // flush a range of mapped buffer
+
 
 // WGL_ARB_extensions_string
 PFNWGLGETEXTENSIONSSTRINGARBPROC    pwglGetExtensionsStringARB = 0;
@@ -735,6 +752,16 @@ void glExtension::getFunctionPointers()
             glGetInteger64v     = (PFNGLGETINTEGER64VPROC)wglGetProcAddress("glGetInteger64v");
             glGetSynciv         = (PFNGLGETSYNCIVPROC)wglGetProcAddress("glGetSynciv");
         }
+        else if(extensions[i] == "GL_ARB_timer_query")
+        {
+            glGenQueries            = (PFNGLGENQUERIESPROC)wglGetProcAddress("glGenQueries");
+            glDeleteQueries         = (PFNGLDELETEQUERIESPROC)wglGetProcAddress("glDeleteQueries");
+            glBeginQuery            = (PFNGLBEGINQUERYPROC)wglGetProcAddress("glBeginQuery");
+            glEndQuery              = (PFNGLENDQUERYPROC)wglGetProcAddress("glEndQuery");
+            glGetQueryObjectiv      = (PFNGLGETQUERYOBJECTIVPROC)wglGetProcAddress("glGetQueryObjectiv");
+            glQueryCounter          = (PFNGLQUERYCOUNTERPROC)wglGetProcAddress("glQueryCounter");
+            glGetQueryObjectui64v   = (PFNGLGETQUERYOBJECTUI64VPROC)wglGetProcAddress("glGetQueryObjectui64v");
+        }
         else if(extensions[i] == "GL_ARB_vertex_array_object")
         {
             glGenVertexArrays       = (PFNGLGENVERTEXARRAYSPROC)wglGetProcAddress("glGenVertexArrays");
@@ -987,6 +1014,15 @@ void glExtension::getFunctionPointers()
             glGetQueryBufferObjecti64v                 = (PFNGLGETQUERYBUFFEROBJECTI64VPROC)wglGetProcAddress("glGetQueryBufferObjecti64v");
             glGetQueryBufferObjectui64v                = (PFNGLGETQUERYBUFFEROBJECTUI64VPROC)wglGetProcAddress("glGetQueryBufferObjectui64v");
         }
+        else if(extensions[i] == "GL_ARB_buffer_storage")
+        {
+            glBufferStorage = (PFNGLBUFFERSTORAGEPROC)wglGetProcAddress("glBufferStorage");
+        }
+        else if(extensions[i] == "GL_ARB_map_buffer_range")
+        {
+            glMapBufferRange            = (PFNGLMAPBUFFERRANGEPROC)wglGetProcAddress("glMapBufferRange");
+            glFlushMappedBufferRange    = (PFNGLFLUSHMAPPEDBUFFERRANGEPROC)wglGetProcAddress("glFlushMappedBufferRange");
+        }
 
 
         // WGL extensions =====================================================
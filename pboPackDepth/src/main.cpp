@@ -3,12 +3,32 @@
 // ========
 // testing Pixel Buffer Object for packing (read-back) pixel data from
 // framebuffer to a PBO using GL_ARB_pixel_buffer_object extension
+// The depth values are normalized by the SIMD kernels of depthUtils; find the
+// range, then linearize (optional), normalize and clamp in a single pass, and
+// write them as float or 16-bit unorm.
+// The read depth also drives Hi-Z occlusion culling of a grid of small cubes
+// behind the cube; DepthPyramid builds the max-depth pyramid from the mapped
+// PBO, and the cubes hidden in that frame are skipped in the next draw.
+// P key (or --points in headless mode) reads the depth to a PBO, unprojects
+// the mapped buffer to world-space points, and streams them to a PLY file.
+// The 16-bit xyz of --point-format short are multiplied by the step in the
+// "comment scale" line of the header to get the world-space positions, e.g.,
+//     pboPackDepth --headless --frames 1 --points out.ply --point-format short
+// With --headless, it renders to an offscreen FBO without window, and writes
+// the timings of each frame to a CSV/JSON report, e.g.,
+//     pboPackDepth --headless --width 1024 --height 1024 --report out.csv
+// With --bench-kernels, the CPU kernels are checked and measured at all SIMD
+// levels without GL, then it exits with 1 if any output is different.
 //
 //  AUTHOR: Song Ho Ahn (song.ahn@gmail.com)
 // CREATED: 2007-11-30
-// UPDATED: 2019-05-06
+// UPDATED: 2026-10-18
 ///////////////////////////////////////////////////////////////////////////////
 
+// glExtension.h defines GL_GLEXT_PROTOTYPES, so it must be included before
+// GLUT includes gl.h
+#include "glExtension.h"                            // extension helper
+
 #ifdef __APPLE__
 #include <GLUT/glut.h>
 #else
@@ -20,8 +40,20 @@
 #include <iomanip>
 #include <cstdlib>
 #include <cstring>
-#include "glExtension.h"                            // extension helper
+#include <vector>
+#include <algorithm>
 #include "Timer.h"
+#include "TimingStats.h"                            // rolling percentiles of timings
+#include "Profiler.h"                               // CPU/GPU zones and Chrome trace
+#include "ThreadPool.h"                             // worker threads for pixel processing
+#include "pixelUtils.h"                             // SIMD level
+#include "depthUtils.h"                             // SIMD depth kernels
+#include "DepthPyramid.h"                           // Hi-Z occlusion culling
+#include "pointUtils.h"                             // depth to point cloud
+#include "PlyWriter.h"                              // binary PLY file
+#include "Benchmark.h"                              // command-line options and report
+#include "KernelBench.h"                            // SIMD kernel check and throughput
+#include "OffscreenContext.h"                       // context without window
 
 
 
@@ -39,6 +71,7 @@ void exitCB();
 
 void initGL();
 int  initGLUT(int argc, char **argv);
+bool initOptions();
 bool initSharedMem();
 void clearSharedMem();
 void initLights();
@@ -48,23 +81,77 @@ void drawString3D(const char *str, float pos[3], float color[4], void *font);
 void showInfo();
 void showTransferRate();
 void printTransferRate();
+void recordProcessTime();
+void printProcessTimes();
+int  runBenchmark();
+int  runKernelBench();
 void draw();
-void shift(GLfloat* src, int width, int height, float shift, GLfloat* dst);
+void initObjects();
+void drawObjects();
+void updateViewProj();
+void cullObjects(const GLfloat* depth, const float* matrix);
+bool savePointCloud(const char* fileName);
+void shiftDepth(GLfloat* src, int width, int height, float shift, GLfloat* dst, GLushort* dst16);
+bool isUnorm16();
 void toOrtho();
 void toPerspective();
+void writeTimingStats();
+void writeTrace();
 
 
 // constants
-const int SCREEN_WIDTH = 512;
+const int SCREEN_WIDTH = 512;       // default image size, --width/--height
 const int SCREEN_HEIGHT = 512;
 const float CAMERA_DISTANCE = 5.0f;
 const int CHANNEL_COUNT = 1;
-const int DATA_SIZE = SCREEN_WIDTH * SCREEN_HEIGHT * sizeof(GLfloat);
 const GLenum PIXEL_FORMAT = GL_DEPTH_COMPONENT; // depth buffer
 const int PBO_COUNT = 2;
+const float NEAR_PLANE = 0.1f;      // clipping planes of perspective projection
+const float FAR_PLANE = 1000.0f;
+const int STATS_WINDOW = 300;       // # of last frames of the percentiles
+
+// output of normalized depth, L and U keys toggle the bits
+enum DepthMode
+{
+    DEPTH_FLOAT = 0,                // normalized window-space depth
+    DEPTH_LINEAR,                   // normalized eye-space distance
+    DEPTH_UNORM16,                  // 16-bit unorm of DEPTH_FLOAT
+    DEPTH_LINEAR16,                 // 16-bit unorm of DEPTH_LINEAR
+    DEPTH_MODE_COUNT
+};
+const char* DEPTH_MODE_NAMES[DEPTH_MODE_COUNT] = {"float", "linear", "unorm16", "linear16"};
+
+// grid of small cubes behind the cube for occlusion culling
+const int OBJECT_COLUMNS = 10;
+const int OBJECT_ROWS = 10;
+const int OBJECT_LAYERS = 4;
+const float OBJECT_SIZE = 0.15f;    // half size of a small cube
+const float OBJECT_SPACING = 0.6f;  // distance between small cubes in a layer
+const float LAYER_DEPTH = -3.0f;    // z of the first layer
+const float LAYER_SPACING = 1.5f;
+
+// Hi-Z occlusion culling of the small cubes, O key cycles the modes
+enum CullMode
+{
+    CULL_OFF = 0,                   // draw all without testing
+    CULL_TEST,                      // test and count, draw all and verify with occlusion queries
+    CULL_ON,                        // skip the occluded cubes
+    CULL_MODE_COUNT
+};
+const char* CULL_MODE_NAMES[CULL_MODE_COUNT] = {"off", "test", "on"};
+
+// point cloud of the depth, P key
+const char* POINT_FILE = "points.ply";
 
 // global variables
 void *font = GLUT_BITMAP_8_BY_13;
+int screenWidth = SCREEN_WIDTH;     // size of each half of the window
+int screenHeight = SCREEN_HEIGHT;
+int dataSize;                       // bytes of a depth image
+GLenum readBufferMode = GL_FRONT;   // GL_COLOR_ATTACHMENT0 in headless mode
+GLenum drawBufferMode = GL_BACK;
+Benchmark benchmark;                // command-line options and headless report
+OffscreenContext offscreen;         // GL context for headless mode
 GLuint pboIds[PBO_COUNT];           // IDs of PBOs
 bool mouseLeftDown;
 bool mouseRightDown;
@@ -75,10 +162,30 @@ float cameraDistance;
 bool pboSupported;
 bool pboUsed;
 int drawMode = 0;
-Timer timer, t1;
-float readTime, processTime;
+Timer timer;
+float readTime, processTime;        // last frame, for the benchmark report
+TimingStats timingStats(STATS_WINDOW);  // percentiles of the last frames
+ThreadPool threadPool;              // persistent workers, all CPU cores by default
+std::vector<double> processTimeSums;    // sum of process time per thread count
+std::vector<int> processTimeCounts;     // # of frames per thread count
 //GLubyte* colorBuffer = 0;
 GLfloat* depthBuffer = 0;
+GLushort* depthBuffer16 = 0;        // 16-bit unorm depth, 1/2 size of float
+int depthMode = DEPTH_FLOAT;
+int cullMode = CULL_ON;
+DepthPyramid depthPyramid;          // max depth pyramid of the read depth
+std::vector<float> objectCenters;   // x, y, z of each small cube
+std::vector<char> occludedFlags;    // 1 if the small cube is hidden
+int occludedCount;
+int visibleOccludedCount;           // occluded cubes with visible samples, test mode only
+std::vector<GLuint> objectQueryIds; // occlusion queries of the small cubes in test mode
+float cullTime;                     // ms to build the pyramid and test all cubes
+float viewProj[16];                 // projection * view of the last rendered frame
+bool viewProjValid = false;
+float pboViewProjs[PBO_COUNT][16];  // viewProj of the frame read to each PBO
+bool pboViewProjValid[PBO_COUNT] = {false, false};
+bool pointQuantized = false;        // 16-bit integer xyz instead of float
+float voxelSize = 0;                // voxel downsampling of point cloud, 0 is off
 
 
 
@@ -159,21 +266,272 @@ void draw()
 
 
 
+///////////////////////////////////////////////////////////////////////////////
+// place the small cubes in layers behind the cube
+///////////////////////////////////////////////////////////////////////////////
+void initObjects()
+{
+    objectCenters.clear();
+    for(int k = 0; k < OBJECT_LAYERS; ++k)
+    {
+        for(int j = 0; j < OBJECT_ROWS; ++j)
+        {
+            for(int i = 0; i < OBJECT_COLUMNS; ++i)
+            {
+                objectCenters.push_back((i - (OBJECT_COLUMNS - 1) * 0.5f) * OBJECT_SPACING);
+                objectCenters.push_back((j - (OBJECT_ROWS - 1) * 0.5f) * OBJECT_SPACING);
+                objectCenters.push_back(LAYER_DEPTH - k * LAYER_SPACING);
+            }
+        }
+    }
+    occludedFlags.assign(objectCenters.size() / 3, 0);
+    occludedCount = 0;
+    visibleOccludedCount = 0;
+    cullTime = 0;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// draw the small cubes, the occluded ones are skipped if culling is on
+// In test mode, each cube is drawn with an occlusion query, and the cubes
+// tested as occluded but with any visible sample are counted. The results are
+// waited for in the same frame, so test mode is slower than the others.
+///////////////////////////////////////////////////////////////////////////////
+void drawObjects()
+{
+    bool queryUsed = (cullMode == CULL_TEST);
+    if(queryUsed && objectQueryIds.empty())
+    {
+        objectQueryIds.resize(occludedFlags.size());
+        glGenQueries((GLsizei)objectQueryIds.size(), &objectQueryIds[0]);
+    }
+
+    for(std::size_t i = 0; i < occludedFlags.size(); ++i)
+    {
+        if(cullMode == CULL_ON && occludedFlags[i])
+            continue;
+
+        const float* center = &objectCenters[i * 3];
+        if(queryUsed)
+            glBeginQuery(GL_SAMPLES_PASSED, objectQueryIds[i]);
+        glPushMatrix();
+        glTranslatef(center[0], center[1], center[2]);
+        glScalef(OBJECT_SIZE, OBJECT_SIZE, OBJECT_SIZE);
+        draw();
+        glPopMatrix();
+        if(queryUsed)
+            glEndQuery(GL_SAMPLES_PASSED);
+    }
+
+    visibleOccludedCount = 0;
+    if(!queryUsed)
+        return;
+
+    for(std::size_t i = 0; i < occludedFlags.size(); ++i)
+    {
+        if(!occludedFlags[i])
+            continue;
+
+        GLint samples = 0;
+        glGetQueryObjectiv(objectQueryIds[i], GL_QUERY_RESULT, &samples);
+        if(samples > 0)
+            ++visibleOccludedCount;
+    }
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// keep projection * view of the current frame, so the objects are tested
+// with the matrix of the frame when its depth is read back
+///////////////////////////////////////////////////////////////////////////////
+void updateViewProj()
+{
+    float projection[16], view[16];
+    glGetFloatv(GL_PROJECTION_MATRIX, projection);
+    glGetFloatv(GL_MODELVIEW_MATRIX, view);
+
+    // column-major, viewProj[col*4+row]
+    for(int col = 0; col < 4; ++col)
+    {
+        for(int row = 0; row < 4; ++row)
+        {
+            viewProj[col * 4 + row] = projection[row]      * view[col * 4]     +
+                                      projection[4 + row]  * view[col * 4 + 1] +
+                                      projection[8 + row]  * view[col * 4 + 2] +
+                                      projection[12 + row] * view[col * 4 + 3];
+        }
+    }
+    viewProjValid = true;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// build the Hi-Z pyramid from the read depth, and test the bounding box of
+// each small cube with the matrix of the frame the depth was rendered with
+// matrix is null if the depth is not rendered yet, e.g., the first frames.
+// The result is used for the next draw, so a fast camera motion can pop in
+// the cubes that are just uncovered for 1 or 2 frames.
+///////////////////////////////////////////////////////////////////////////////
+void cullObjects(const GLfloat* depth, const float* matrix)
+{
+    occludedCount = 0;
+    if(cullMode == CULL_OFF || !depth || !matrix)
+    {
+        std::fill(occludedFlags.begin(), occludedFlags.end(), 0);
+        cullTime = 0;
+        return;
+    }
+
+    PROFILE_ZONE("cull");
+    ScopedTimer cullTimer(timingStats, "cull", &cullTime);
+    depthPyramid.build(depth, screenWidth, screenHeight, threadPool);
+    for(std::size_t i = 0; i < occludedFlags.size(); ++i)
+    {
+        const float* center = &objectCenters[i * 3];
+        float boxMin[3] = {center[0] - OBJECT_SIZE, center[1] - OBJECT_SIZE, center[2] - OBJECT_SIZE};
+        float boxMax[3] = {center[0] + OBJECT_SIZE, center[1] + OBJECT_SIZE, center[2] + OBJECT_SIZE};
+        occludedFlags[i] = depthPyramid.isOccluded(boxMin, boxMax, matrix) ? 1 : 0;
+        occludedCount += occludedFlags[i];
+    }
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// save the depth of the last rendered frame as PLY point cloud
+// The depth is read to a PBO, and the mapped buffer is unprojected with the
+// inverse of viewProj and written in bands, so the depth is not copied.
+///////////////////////////////////////////////////////////////////////////////
+bool savePointCloud(const char* fileName)
+{
+    Point::Params params;
+    if(!viewProjValid || !Point::invertMatrix(viewProj, params.invViewProj))
+    {
+        std::cout << "[ERROR] No frame is rendered to save point cloud." << std::endl;
+        return false;
+    }
+    params.width = screenWidth;
+    params.height = screenHeight;
+    params.maxDepth = 1.0f;             // cleared background
+    params.voxelSize = voxelSize;
+
+    Timer pointTimer;
+    pointTimer.start();
+
+    glReadBuffer(readBufferMode);
+    const GLfloat* depth = depthBuffer;
+    if(pboSupported)
+    {
+        // the PBO has the last frame now, so it is tested with viewProj
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, pboIds[0]);
+        glReadPixels(0, 0, screenWidth, screenHeight, PIXEL_FORMAT, GL_FLOAT, 0);
+        memcpy(pboViewProjs[0], viewProj, sizeof(viewProj));
+        pboViewProjValid[0] = true;
+        depth = (const GLfloat*)glMapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY);
+    }
+    else
+    {
+        glReadPixels(0, 0, screenWidth, screenHeight, PIXEL_FORMAT, GL_FLOAT, depthBuffer);
+    }
+
+    // the step of 16-bit integer xyz fits the bounding box of the points, and
+    // is written to the header as "comment scale"
+    float pointStep = 0;
+    if(pointQuantized)
+    {
+        float minPoint[3], maxPoint[3];
+        Point::computeBounds(depth, params, threadPool, minPoint, maxPoint);
+        pointStep = Point::computeQuantizeStep(minPoint, maxPoint);
+    }
+
+    PlyWriter writer;
+    bool opened = writer.open(fileName, pointStep);
+    if(opened && depth)
+        Point::writePly(depth, params, threadPool, writer);
+
+    if(pboSupported)
+    {
+        if(depth)
+            glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    }
+    if(!opened)
+    {
+        std::cout << "[ERROR] " << writer.getError() << std::endl;
+        return false;
+    }
+
+    std::size_t pointCount = writer.getPointCount();
+    bool result = writer.close();
+    pointTimer.stop();
+    if(!result)
+    {
+        std::cout << "[ERROR] " << writer.getError() << std::endl;
+        return false;
+    }
+
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "Point cloud: " << fileName << ", " << pointCount << " points of "
+              << screenWidth * screenHeight << " pixels (" << (pointQuantized ? "short" : "float");
+    if(pointQuantized)
+        std::cout << " step " << std::setprecision(6) << pointStep << std::setprecision(3);
+    std::cout << ", voxel " << voxelSize << "), " << pointTimer.getElapsedTimeInMilliSec() << " ms" << std::endl;
+    std::cout << std::resetiosflags(std::ios_base::fixed | std::ios_base::floatfield);
+    return true;
+}
+
+
+
 ///////////////////////////////////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
+    // parse command-line options, the defaults are the constants
+    benchmark.setWidth(SCREEN_WIDTH);
+    benchmark.setHeight(SCREEN_HEIGHT);
+    benchmark.setFormat("float");
+    benchmark.setPboMode(PBO_COUNT);
+    benchmark.setMode("float");
+    benchmark.setCullMode(CULL_MODE_NAMES[cullMode]);
+    benchmark.setPointFormat("float");
+    if(!benchmark.parse(argc, argv) || !initOptions())
+    {
+        benchmark.printUsage(argv[0]);
+        return 1;
+    }
+
+    // check and measure the CPU kernels, no GL is needed
+    if(benchmark.isKernelBench())
+        return runKernelBench();
+
     initSharedMem();
 
     // register exit callback
     atexit(exitCB);
 
-    // init GLUT and GL
-    initGLUT(argc, argv);
+    // init GLUT and GL, or offscreen framebuffer without window
+    if(benchmark.isHeadless())
+    {
+        // render the both sides (2 x width) to FBO
+        if(!offscreen.create(screenWidth * 2, screenHeight))
+        {
+            std::cout << "[ERROR] " << offscreen.getError() << std::endl;
+            return 1;
+        }
+        readBufferMode = drawBufferMode = GL_COLOR_ATTACHMENT0;
+    }
+    else
+    {
+        initGLUT(argc, argv);
+    }
     initGL();
 
     // get OpenGL extensions
     glExtension& ext = glExtension::getInstance();
-    pboSupported = pboUsed = ext.isSupported("GL_ARB_pixel_buffer_object");
+    pboSupported = ext.isSupported("GL_ARB_pixel_buffer_object");
+    pboUsed = pboSupported && benchmark.getPboMode() > 0;
     if(pboSupported)
     {
         std::cout << "Video card supports GL_ARB_pixel_buffer_object." << std::endl;
@@ -183,6 +541,15 @@ int main(int argc, char **argv)
         std::cout << "[ERROR] Video card does not supports GL_ARB_pixel_buffer_object." << std::endl;
     }
 
+    // profile the zones only if --trace is given, GPU time needs GL_ARB_timer_query
+    Profiler& profiler = Profiler::getInstance();
+    profiler.setEnabled(!benchmark.getTraceFile().empty());
+    if(profiler.isEnabled())
+        std::cout << "Profiler: GPU timer query " << (profiler.initGpu() ? "on" : "off") << std::endl;
+
+    // select the depth kernels for this CPU
+    std::cout << "SIMD: " << Pixel::getSimdLevelName(Pixel::getSimdLevel()) << std::endl;
+
 #ifdef _WIN32
     // check EXT_swap_control is supported
     if(ext.isSupported("WGL_EXT_swap_control"))
@@ -199,13 +566,17 @@ int main(int argc, char **argv)
         // glBufferData() with NULL pointer reserves only memory space.
         glGenBuffers(PBO_COUNT, pboIds);
         glBindBuffer(GL_PIXEL_PACK_BUFFER, pboIds[0]);
-        glBufferData(GL_PIXEL_PACK_BUFFER, DATA_SIZE, 0, GL_STREAM_READ);
+        glBufferData(GL_PIXEL_PACK_BUFFER, dataSize, 0, GL_STREAM_READ);
         glBindBuffer(GL_PIXEL_PACK_BUFFER, pboIds[1]);
-        glBufferData(GL_PIXEL_PACK_BUFFER, DATA_SIZE, 0, GL_STREAM_READ);
+        glBufferData(GL_PIXEL_PACK_BUFFER, dataSize, 0, GL_STREAM_READ);
 
         glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
     }
 
+    // run the given frames without window, then exit
+    if(benchmark.isHeadless())
+        return runBenchmark();
+
     // start timer, the elapsed time will be used for updateVertices()
     timer.start();
 
@@ -230,7 +601,7 @@ int initGLUT(int argc, char **argv)
 
     glutInitDisplayMode(GLUT_RGB | GLUT_DOUBLE | GLUT_ALPHA); // display mode
 
-    glutInitWindowSize(SCREEN_WIDTH*2, SCREEN_HEIGHT);    // window size
+    glutInitWindowSize(screenWidth*2, screenHeight);    // window size
 
     glutInitWindowPosition(100, 100);           // window location
 
@@ -339,6 +710,56 @@ void drawString3D(const char *str, float pos[3], float color[4], void *font)
 
 
 
+///////////////////////////////////////////////////////////////////////////////
+// apply the command-line options to global variables
+// The depth is always read as GL_FLOAT, and --pbo greater than 0 uses 2 PBOs.
+// --format is the output format of the normalized depth; unorm16 adds the
+// 16-bit output to --mode, e.g., --mode linear --format unorm16 is linear16.
+///////////////////////////////////////////////////////////////////////////////
+bool initOptions()
+{
+    screenWidth = benchmark.getWidth();
+    screenHeight = benchmark.getHeight();
+    dataSize = screenWidth * screenHeight * sizeof(GLfloat);
+
+    if(benchmark.getFormat() != "float" && benchmark.getFormat() != "unorm16")
+    {
+        std::cout << "[ERROR] Unsupported pixel format: " << benchmark.getFormat() << " (float or unorm16)" << std::endl;
+        return false;
+    }
+
+    depthMode = (int)(std::find(DEPTH_MODE_NAMES, DEPTH_MODE_NAMES + DEPTH_MODE_COUNT, benchmark.getMode()) - DEPTH_MODE_NAMES);
+    if(depthMode == DEPTH_MODE_COUNT)
+    {
+        std::cout << "[ERROR] Unsupported mode: " << benchmark.getMode() << " (float, linear, unorm16 or linear16)" << std::endl;
+        return false;
+    }
+    if(benchmark.getFormat() == "unorm16")
+        depthMode |= DEPTH_UNORM16;
+
+    cullMode = (int)(std::find(CULL_MODE_NAMES, CULL_MODE_NAMES + CULL_MODE_COUNT, benchmark.getCullMode()) - CULL_MODE_NAMES);
+    if(cullMode == CULL_MODE_COUNT)
+    {
+        std::cout << "[ERROR] Unsupported culling: " << benchmark.getCullMode() << " (off, test or on)" << std::endl;
+        return false;
+    }
+
+    if(benchmark.getPointFormat() != "float" && benchmark.getPointFormat() != "short")
+    {
+        std::cout << "[ERROR] Unsupported point format: " << benchmark.getPointFormat() << " (float or short)" << std::endl;
+        return false;
+    }
+    pointQuantized = (benchmark.getPointFormat() == "short");
+    voxelSize = (float)benchmark.getVoxelSize();
+
+    // 0 keeps all CPU cores
+    if(benchmark.getThreadCount() > 0)
+        threadPool.setThreadCount(benchmark.getThreadCount());
+    return true;
+}
+
+
+
 ///////////////////////////////////////////////////////////////////////////////
 // initialize global variables
 ///////////////////////////////////////////////////////////////////////////////
@@ -353,10 +774,16 @@ bool initSharedMem()
     drawMode = 0; // 0:fill, 1:wireframe, 2:point
 
     // allocate buffers to store frames
-    //colorBuffer = new GLubyte[DATA_SIZE];
-    //memset(colorBuffer, 255, DATA_SIZE);
-    depthBuffer = new GLfloat[DATA_SIZE];
-    memset(depthBuffer, 0, DATA_SIZE);
+    //colorBuffer = new GLubyte[dataSize];
+    //memset(colorBuffer, 255, dataSize);
+    // dataSize is in bytes, so allocate by the number of pixels
+    int pixelCount = screenWidth * screenHeight;
+    depthBuffer = new GLfloat[pixelCount];
+    memset(depthBuffer, 0, dataSize);
+    depthBuffer16 = new GLushort[pixelCount];
+    memset(depthBuffer16, 0, pixelCount * sizeof(GLushort));
+
+    initObjects();
 
     return true;
 }
@@ -373,12 +800,23 @@ void clearSharedMem()
     //colorBuffer = 0;
     delete [] depthBuffer;
     depthBuffer = 0;
+    delete [] depthBuffer16;
+    depthBuffer16 = 0;
 
     // clean up PBOs
     if(pboSupported)
     {
         glDeleteBuffers(PBO_COUNT, pboIds);
     }
+
+    if(!objectQueryIds.empty())
+    {
+        glDeleteQueries((GLsizei)objectQueryIds.size(), &objectQueryIds[0]);
+        objectQueryIds.clear();
+    }
+
+    // delete GPU timer queries
+    Profiler::getInstance().releaseGpu();
 }
 
 
@@ -430,7 +868,7 @@ void showInfo()
     glMatrixMode(GL_PROJECTION);     // switch to projection matrix
     glPushMatrix();                  // save current projection matrix
     glLoadIdentity();                // reset projection matrix
-    gluOrtho2D(0, SCREEN_WIDTH, 0, SCREEN_HEIGHT);  // set to orthogonal projection
+    gluOrtho2D(0, screenWidth, 0, screenHeight);  // set to orthogonal projection
 
     const int FONT_HEIGHT = 14;
     float color[4] = {0, 0, 0, 1};
@@ -442,19 +880,44 @@ void showInfo()
     else
         ss << "off" << std::ends;
 
-    drawString(ss.str().c_str(), 1, SCREEN_HEIGHT-FONT_HEIGHT, color, font);
+    drawString(ss.str().c_str(), 1, screenHeight-FONT_HEIGHT, color, font);
     ss.str(""); // clear buffer
 
-    ss << "Read Time: " << readTime << " ms" << std::ends;
-    drawString(ss.str().c_str(), 1, SCREEN_HEIGHT-(2*FONT_HEIGHT), color, font);
+    ss << "Read Time: " << timingStats.formatSummary("read") << std::ends;
+    drawString(ss.str().c_str(), 1, screenHeight-(2*FONT_HEIGHT), color, font);
     ss.str("");
 
     ss << std::fixed << std::setprecision(3);
-    ss << "Process Time: " << processTime << " ms" << std::ends;
-    drawString(ss.str().c_str(), 1, SCREEN_HEIGHT-(3*FONT_HEIGHT), color, font);
+    ss << "Process Time: " << timingStats.formatSummary("process") << " (" << threadPool.getThreadCount() << " threads)" << std::ends;
+    drawString(ss.str().c_str(), 1, screenHeight-(3*FONT_HEIGHT), color, font);
+    ss.str("");
+
+    ss << "Depth: " << DEPTH_MODE_NAMES[depthMode] << ", SIMD: "
+       << Pixel::getSimdLevelName(Pixel::getSimdLevel()) << std::ends;
+    drawString(ss.str().c_str(), 1, screenHeight-(4*FONT_HEIGHT), color, font);
+    ss.str("");
+
+    ss << "Culling: " << CULL_MODE_NAMES[cullMode] << ", " << occludedCount << "/" << occludedFlags.size()
+       << " occluded";
+    if(cullMode == CULL_TEST)
+        ss << ", " << visibleOccludedCount << " visible";
+    ss << " (" << timingStats.formatSummary("cull") << ")" << std::ends;
+    drawString(ss.str().c_str(), 1, screenHeight-(5*FONT_HEIGHT), color, font);
+    ss.str("");
+
+    ss << "Press O to change culling, P to save point cloud." << std::ends;
+    drawString(ss.str().c_str(), 1, 1 + 3*FONT_HEIGHT, color, font);
+    ss.str("");
+
+    ss << "Press L/U to toggle linear/unorm16, S to toggle SIMD." << std::ends;
+    drawString(ss.str().c_str(), 1, 1 + 2*FONT_HEIGHT, color, font);
     ss.str("");
 
     ss << "Press SPACE to toggle PBO." << std::ends;
+    drawString(ss.str().c_str(), 1, 1 + FONT_HEIGHT, color, font);
+    ss.str("");
+
+    ss << "Press T to change threads." << std::ends;
     drawString(ss.str().c_str(), 1, 1, color, font);
 
     // unset floating format
@@ -486,7 +949,7 @@ void showTransferRate()
     {
         ss.str("");
         ss << std::fixed << std::setprecision(1);
-        ss << "Transfer Rate: " << (count / elapsedTime) * (SCREEN_WIDTH * SCREEN_HEIGHT) / (1024 * 1024) << " Mp" << std::ends; // update fps string
+        ss << "Transfer Rate: " << (count / elapsedTime) * (screenWidth * screenHeight) / (1024 * 1024) << " Mp" << std::ends; // update fps string
         ss << std::resetiosflags(std::ios_base::fixed | std::ios_base::floatfield);
         count = 0;                      // reset counter
         timer.start();                  // restart timer
@@ -500,7 +963,7 @@ void showTransferRate()
     glMatrixMode(GL_PROJECTION);        // switch to projection matrix
     glPushMatrix();                     // save current projection matrix
     glLoadIdentity();                   // reset projection matrix
-    gluOrtho2D(0, SCREEN_WIDTH, 0, SCREEN_HEIGHT); // set to orthogonal projection
+    gluOrtho2D(0, screenWidth, 0, screenHeight); // set to orthogonal projection
 
     float color[4] = {1, 1, 0, 1};
     drawString(ss.str().c_str(), 200, 286, color, font);
@@ -535,7 +998,10 @@ void printTransferRate()
     else
     {
         std::cout << std::fixed << std::setprecision(1);
-        std::cout << "Transfer Rate: " << (count / elapsedTime) * (SCREEN_WIDTH * SCREEN_HEIGHT) * INV_MEGA << " Mpixels/s. (" << count / elapsedTime << " FPS)\n";
+        std::cout << "Transfer Rate: " << (count / elapsedTime) * (screenWidth * screenHeight) * INV_MEGA << " Mpixels/s. (" << count / elapsedTime << " FPS), "
+                  << "Process Time: " << timingStats.formatSummary("process") << " (" << threadPool.getThreadCount() << " threads, "
+                  << DEPTH_MODE_NAMES[depthMode] << ", " << Pixel::getSimdLevelName(Pixel::getSimdLevel()) << "), "
+                  << "Occluded: " << occludedCount << "/" << occludedFlags.size() << " (" << CULL_MODE_NAMES[cullMode] << ")\n";
         std::cout << std::resetiosflags(std::ios_base::fixed | std::ios_base::floatfield);
         count = 0;                      // reset counter
         timer.start();                  // restart timer
@@ -543,37 +1009,275 @@ void printTransferRate()
 }
 
 
+
 ///////////////////////////////////////////////////////////////////////////////
-// change depth value
+// accumulate the process time of the current thread count
 ///////////////////////////////////////////////////////////////////////////////
-void shiftDepth(GLfloat* src, int width, int height, float shift, GLfloat* dst)
+void recordProcessTime()
 {
-    if(!src || !dst)
-        return;
-
-    // get range of values
-    float minValue = 9999.0f;
-    float maxValue = 0.0f;
-    int count = width * height;
-    for(int i = 0; i < count; ++i)
+    int threadCount = threadPool.getThreadCount();
+    if((int)processTimeSums.size() <= threadCount)
     {
-        if(src[i] > maxValue) maxValue = src[i];
-        if(src[i] < minValue) minValue = src[i];
+        processTimeSums.resize(threadCount + 1, 0.0);
+        processTimeCounts.resize(threadCount + 1, 0);
     }
-    float scale = 1.0f  / (maxValue - minValue);
+    processTimeSums[threadCount] += processTime;
+    ++processTimeCounts[threadCount];
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// check the CPU kernels at all SIMD levels against the plain C++ kernels, and
+// print the throughput, return 1 if any output is different
+///////////////////////////////////////////////////////////////////////////////
+int runKernelBench()
+{
+    KernelBench bench;
+    bench.addPixelKernels();
+
+    // the random bytes are converted to depth values [0, 1) once per size, so
+    // the conversion is not measured; src is the same image for a size
+    std::vector<float> depths;
+    auto toDepth = [&depths](const unsigned char* src, int w, int h) -> const float*
+    {
+        std::size_t count = (std::size_t)w * h;
+        if(depths.size() != count)
+        {
+            depths.resize(count);
+            for(std::size_t i = 0; i < count; ++i)
+            {
+                unsigned int value;
+                memcpy(&value, src + i * 4, 4);
+                depths[i] = (value >> 8) / 16777216.0f;
+            }
+        }
+        return &depths[0];
+    };
+
+    bench.addKernel("depth range", 4, 0, false, [&toDepth](const unsigned char* src, unsigned char* dst, int w, int h)
+    {
+        float minValue = 9999.0f;
+        float maxValue = 0.0f;
+        Depth::findRange(toDepth(src, w, h), (std::size_t)w * h, minValue, maxValue);
+        memcpy(dst, &minValue, 4);
+        memcpy(dst + 4, &maxValue, 4);
+    });
+
+    // the range is narrower than the values, so both sides are clamped
+    Depth::Params params = {0.25f, 0.75f, 0.1f, false, NEAR_PLANE, FAR_PLANE};
+    bench.addKernel("depth normalize", 4, 4, false, [&toDepth, params](const unsigned char* src, unsigned char* dst, int w, int h)
+    {
+        Depth::normalize(toDepth(src, w, h), (float*)dst, (std::size_t)w * h, params);
+    });
+    bench.addKernel("depth unorm16", 4, 2, false, [&toDepth, params](const unsigned char* src, unsigned char* dst, int w, int h)
+    {
+        Depth::normalize(toDepth(src, w, h), (unsigned short*)dst, (std::size_t)w * h, params);
+    });
+
+    Depth::Params linearParams = params;
+    linearParams.linear = true;
+    bench.addKernel("depth linear", 4, 4, false, [&toDepth, linearParams](const unsigned char* src, unsigned char* dst, int w, int h)
+    {
+        Depth::normalize(toDepth(src, w, h), (float*)dst, (std::size_t)w * h, linearParams);
+    });
+    bench.addKernel("depth linear16", 4, 2, false, [&toDepth, linearParams](const unsigned char* src, unsigned char* dst, int w, int h)
+    {
+        Depth::normalize(toDepth(src, w, h), (unsigned short*)dst, (std::size_t)w * h, linearParams);
+    });
 
-    float value;
-    for(int i = 0; i < height; ++i)
+    // 2x2 max of the Hi-Z pyramid, writes 1/4 of the pixels
+    bench.addKernel("depth reduceMax", 4, 1, false, [&toDepth](const unsigned char* src, unsigned char* dst, int w, int h)
     {
-        for(int j = 0; j < width; ++j)
+        const float* depth = toDepth(src, w, h);
+        float* dst32 = (float*)dst;
+        for(int y = 0; y < h / 2; ++y)
+            Depth::reduceMax(depth + (2 * y) * w, depth + (2 * y + 1) * w, dst32 + y * (w / 2), w / 2);
+    });
+
+    return bench.run() ? 0 : 1;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// render the frames to the offscreen framebuffer without window, and write
+// the timings of each frame to the report
+///////////////////////////////////////////////////////////////////////////////
+int runBenchmark()
+{
+    benchmark.setName("pboPackDepth");
+    benchmark.addParameter("width", screenWidth);
+    benchmark.addParameter("height", screenHeight);
+    benchmark.addParameter("format", isUnorm16() ? "unorm16" : "float");
+    benchmark.addParameter("pbo", pboUsed ? PBO_COUNT : 0);
+    benchmark.addParameter("threads", threadPool.getThreadCount());
+    benchmark.addParameter("mode", DEPTH_MODE_NAMES[depthMode]);
+    benchmark.addParameter("simd", Pixel::getSimdLevelName(Pixel::getSimdLevel()));
+    benchmark.addParameter("culling", CULL_MODE_NAMES[cullMode]);
+    benchmark.addParameter("objects", (double)occludedFlags.size());
+    benchmark.addParameter("renderer", (const char*)glGetString(GL_RENDERER));
+    benchmark.setColumns({"frameTime", "readTime", "processTime", "cullTime"});
+
+    Timer frameTimer, totalTimer;
+    double occludedSum = 0;
+    double visibleOccludedSum = 0;
+    int warmupCount = benchmark.getWarmupCount();
+    int frameCount = warmupCount + benchmark.getFrameCount();
+    for(int i = 0; i < frameCount; ++i)
+    {
+        if(i == warmupCount)
+            totalTimer.start();
+
+        frameTimer.start();
+        displayCB();
+        frameTimer.stop();
+
+        if(i >= warmupCount)
         {
-            value = scale * (*src - minValue) + shift;
-            if(value > 1.0f) *dst = 1.0f;
-            else             *dst = value;
-            ++src;
-            ++dst;
+            benchmark.addFrame({frameTimer.getElapsedTimeInMilliSec(), readTime, processTime, cullTime});
+            occludedSum += occludedCount;
+            visibleOccludedSum += visibleOccludedCount;
         }
     }
+    glFinish();
+    totalTimer.stop();
+    benchmark.setTotalTime(totalTimer.getElapsedTime());
+    benchmark.addParameter("occluded", occludedSum / benchmark.getFrameCount());   // mean per frame
+    if(cullMode == CULL_TEST)
+        benchmark.addParameter("visibleOccluded", visibleOccludedSum / benchmark.getFrameCount());
+
+    benchmark.printSummary();
+    if(!benchmark.getPointFile().empty() && !savePointCloud(benchmark.getPointFile().c_str()))
+        return 1;
+    if(!benchmark.getReportFile().empty())
+    {
+        if(!benchmark.writeReport(benchmark.getReportFile()))
+            return 1;
+        std::cout << "Report: " << benchmark.getReportFile() << std::endl;
+    }
+    return 0;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// print the average process time and speedup per thread count
+///////////////////////////////////////////////////////////////////////////////
+void printProcessTimes()
+{
+    double baseTime = 0;
+    if(processTimeCounts.size() > 1 && processTimeCounts[1] > 0)
+        baseTime = processTimeSums[1] / processTimeCounts[1];
+
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "Threads  Process Time (ms)  Speedup  Frames\n";
+    for(std::size_t i = 1; i < processTimeCounts.size(); ++i)
+    {
+        if(processTimeCounts[i] == 0)
+            continue;
+        double time = processTimeSums[i] / processTimeCounts[i];
+        std::cout << std::setw(7) << i << std::setw(19) << time << std::setw(9);
+        if(baseTime > 0)
+            std::cout << baseTime / time;
+        else
+            std::cout << "-";
+        std::cout << std::setw(8) << processTimeCounts[i] << "\n";
+    }
+    std::cout << std::resetiosflags(std::ios_base::fixed | std::ios_base::floatfield) << std::flush;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// write the percentiles of the last frames to --stats file
+///////////////////////////////////////////////////////////////////////////////
+void writeTimingStats()
+{
+    const std::string& fileName = benchmark.getStatsFile();
+    if(fileName.empty())
+        return;
+
+    if(timingStats.writeCsv(fileName))
+        std::cout << "Stats: " << fileName << std::endl;
+    else
+        std::cout << "[ERROR] Failed to write " << fileName << std::endl;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// write the profiled zones to --trace file, and print the totals of zones
+///////////////////////////////////////////////////////////////////////////////
+void writeTrace()
+{
+    const std::string& fileName = benchmark.getTraceFile();
+    if(fileName.empty())
+        return;
+
+    Profiler& profiler = Profiler::getInstance();
+    profiler.printSummary();
+    if(profiler.writeTrace(fileName))
+        std::cout << "Trace: " << fileName << std::endl;
+    else
+        std::cout << "[ERROR] Failed to write " << fileName << std::endl;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+// change depth value
+// The rows are split into cache-sized bands, and processed by all threads in
+// 2 passes; find the range of each band with SIMD min/max, then normalize
+// with the whole range. The 2nd pass linearizes (optional), normalizes and
+// clamps each value at once, and writes to dst16 as 16-bit unorm instead of
+// dst if dst16 is not null.
+///////////////////////////////////////////////////////////////////////////////
+void shiftDepth(GLfloat* src, int width, int height, float shift, GLfloat* dst, GLushort* dst16)
+{
+    if(!src || (!dst && !dst16))
+        return;
+
+    int bandRows = ThreadPool::computeBandRows(width * sizeof(GLfloat));
+    int bandCount = (height + bandRows - 1) / bandRows;
+    std::vector<float> minValues(bandCount);
+    std::vector<float> maxValues(bandCount);
+
+    // get range of values per band
+    threadPool.run(height, bandRows, [&](int firstRow, int lastRow)
+    {
+        float minValue = 9999.0f;
+        float maxValue = 0.0f;
+        Depth::findRange(src + firstRow * width, (std::size_t)(lastRow - firstRow) * width, minValue, maxValue);
+        minValues[firstRow / bandRows] = minValue;
+        maxValues[firstRow / bandRows] = maxValue;
+    });
+
+    Depth::Params params;
+    params.minValue = *std::min_element(minValues.begin(), minValues.end());
+    params.maxValue = *std::max_element(maxValues.begin(), maxValues.end());
+    params.shift = shift;
+    params.linear = (depthMode == DEPTH_LINEAR || depthMode == DEPTH_LINEAR16);
+    params.nearPlane = NEAR_PLANE;
+    params.farPlane = FAR_PLANE;
+
+    threadPool.run(height, bandRows, [&](int firstRow, int lastRow)
+    {
+        std::size_t offset = (std::size_t)firstRow * width;
+        std::size_t count = (std::size_t)(lastRow - firstRow) * width;
+        if(dst16)
+            Depth::normalize(src + offset, dst16 + offset, count, params);
+        else
+            Depth::normalize(src + offset, dst + offset, count, params);
+    });
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+// return true if the depth is written as 16-bit unorm
+///////////////////////////////////////////////////////////////////////////////
+bool isUnorm16()
+{
+    return depthMode == DEPTH_UNORM16 || depthMode == DEPTH_LINEAR16;
 }
 
 
@@ -583,12 +1287,12 @@ void shiftDepth(GLfloat* src, int width, int height, float shift, GLfloat* dst)
 void toOrtho()
 {
     // set viewport to be the entire window
-    glViewport((GLsizei)SCREEN_WIDTH, 0, (GLsizei)SCREEN_WIDTH, (GLsizei)SCREEN_HEIGHT);
+    glViewport((GLsizei)screenWidth, 0, (GLsizei)screenWidth, (GLsizei)screenHeight);
 
     // set orthographic viewing frustum
     glMatrixMode(GL_PROJECTION);
     glLoadIdentity();
-    glOrtho(0, SCREEN_WIDTH, 0, SCREEN_HEIGHT, -1, 1);
+    glOrtho(0, screenWidth, 0, screenHeight, -1, 1);
 
     // switch to modelview matrix in order to set scene
     glMatrixMode(GL_MODELVIEW);
@@ -603,12 +1307,12 @@ void toOrtho()
 void toPerspective()
 {
     // set viewport to be the entire window
-    glViewport(0, 0, (GLsizei)SCREEN_WIDTH, (GLsizei)SCREEN_HEIGHT);
+    glViewport(0, 0, (GLsizei)screenWidth, (GLsizei)screenHeight);
 
     // set perspective viewing frustum
     glMatrixMode(GL_PROJECTION);
     glLoadIdentity();
-    gluPerspective(60.0f, (float)(SCREEN_WIDTH)/SCREEN_HEIGHT, 0.1f, 1000.0f); // FOV, AspectRatio, NearClip, FarClip
+    gluPerspective(60.0f, (float)(screenWidth)/screenHeight, NEAR_PLANE, FAR_PLANE); // FOV, AspectRatio, NearClip, FarClip
 
     // switch to modelview matrix in order to set scene
     glMatrixMode(GL_MODELVIEW);
@@ -626,6 +1330,9 @@ void toPerspective()
 
 void displayCB()
 {
+    PROFILE_FRAME();                                // collect the zones of the previous frame
+    PROFILE_ZONE("displayCB");
+    ScopedTimer frameTimer(timingStats, "frame");   // added when returned
     static float shift = 0.0f;
     static int index = 0;
     int nextIndex = 0;                  // pbo index used for next frame
@@ -642,39 +1349,40 @@ void displayCB()
     nextIndex = (index + 1) % 2;
 
     // set the framebuffer to read
-    glReadBuffer(GL_FRONT);
+    glReadBuffer(readBufferMode);
 
     if(pboUsed) // with PBO
     {
         // read framebuffer ///////////////////////////////
-        t1.start();
-
         // copy pixels from framebuffer to PBO
         // Use offset instead of ponter.
         // OpenGL should perform asynch DMA transfer, so glReadPixels() will return immediately.
-        glBindBuffer(GL_PIXEL_PACK_BUFFER, pboIds[index]);
-        glReadPixels(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, PIXEL_FORMAT, GL_FLOAT, 0);
-
-        // measure the time reading framebuffer
-        t1.stop();
-        readTime = t1.getElapsedTimeInMilliSec();
+        {
+            PROFILE_GPU_ZONE("read");
+            ScopedTimer t(timingStats, "read", &readTime);
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, pboIds[index]);
+            glReadPixels(0, 0, screenWidth, screenHeight, PIXEL_FORMAT, GL_FLOAT, 0);
+
+            // the framebuffer has the last frame rendered with viewProj
+            memcpy(pboViewProjs[index], viewProj, sizeof(viewProj));
+            pboViewProjValid[index] = viewProjValid;
+        }
         ///////////////////////////////////////////////////
 
         // process pixel data /////////////////////////////
-        t1.start();
-
         // map the PBO that contain framebuffer pixels before processing it
-        glBindBuffer(GL_PIXEL_PACK_BUFFER, pboIds[nextIndex]);
-        GLfloat* src = (GLfloat*)glMapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY);
-        if(src)
         {
-            shiftDepth(src, SCREEN_WIDTH, SCREEN_HEIGHT, shift, depthBuffer);
-            glUnmapBuffer(GL_PIXEL_PACK_BUFFER);        // release pointer to the mapped buffer
+            PROFILE_ZONE("process");
+            ScopedTimer t(timingStats, "process", &processTime);
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, pboIds[nextIndex]);
+            GLfloat* src = (GLfloat*)glMapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY);
+            if(src)
+            {
+                cullObjects(src, pboViewProjValid[nextIndex] ? pboViewProjs[nextIndex] : 0);
+                shiftDepth(src, screenWidth, screenHeight, shift, depthBuffer, isUnorm16() ? depthBuffer16 : 0);
+                glUnmapBuffer(GL_PIXEL_PACK_BUFFER);    // release pointer to the mapped buffer
+            }
         }
-
-        // measure the time reading framebuffer
-        t1.stop();
-        processTime = t1.getElapsedTimeInMilliSec();
         ///////////////////////////////////////////////////
 
         glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
@@ -683,29 +1391,32 @@ void displayCB()
     else        // without PBO
     {
         // read framebuffer ///////////////////////////////
-        t1.start();
-
-        glReadPixels(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, PIXEL_FORMAT, GL_FLOAT, depthBuffer);
-
-        // measure the time reading framebuffer
-        t1.stop();
-        readTime = t1.getElapsedTimeInMilliSec();
+        {
+            PROFILE_GPU_ZONE("read");
+            ScopedTimer t(timingStats, "read", &readTime);
+            glReadPixels(0, 0, screenWidth, screenHeight, PIXEL_FORMAT, GL_FLOAT, depthBuffer);
+        }
         ///////////////////////////////////////////////////
 
         // covert to greyscale ////////////////////////////
-        t1.start();
+        {
+            PROFILE_ZONE("process");
+            ScopedTimer t(timingStats, "process", &processTime);
 
-        // change brightness
-        shiftDepth(depthBuffer, SCREEN_WIDTH, SCREEN_HEIGHT, shift, depthBuffer);
+            // test the objects before the depth is overwritten
+            cullObjects(depthBuffer, viewProjValid ? viewProj : 0);
 
-        // measure the time reading framebuffer
-        t1.stop();
-        processTime = t1.getElapsedTimeInMilliSec();
+            // change brightness
+            shiftDepth(depthBuffer, screenWidth, screenHeight, shift, depthBuffer, isUnorm16() ? depthBuffer16 : 0);
+        }
         ///////////////////////////////////////////////////
     }
 
+    recordProcessTime();
+
     // render to the framebuffer //////////////////////////
-    glDrawBuffer(GL_BACK);
+    PROFILE_GPU_ZONE("draw");                       // measured until the end of frame
+    glDrawBuffer(drawBufferMode);
     toPerspective(); // set to perspective on the left side of the window
 
     // clear buffer
@@ -715,16 +1426,36 @@ void displayCB()
     glTranslatef(0, 0, -cameraDistance);
     glRotatef(cameraAngleX, 1, 0, 0);   // pitch
     glRotatef(cameraAngleY, 0, 1, 0);   // heading
+    updateViewProj();
 
     // draw a cube
     glPushMatrix();
     draw();
     glPopMatrix();
 
+    // draw the small cubes behind it, the occluded ones are skipped
+    drawObjects();
+
     // draw the read depthbuffer to the right side of the window as luminace
     toOrtho();      // set to orthographic on the right side of the window
     glRasterPos2i(0, 0);
-    glDrawPixels(SCREEN_WIDTH, SCREEN_HEIGHT, GL_LUMINANCE, GL_FLOAT, depthBuffer);
+    if(isUnorm16())
+    {
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 2);  // rows of odd width are 2-byte aligned
+        glDrawPixels(screenWidth, screenHeight, GL_LUMINANCE, GL_UNSIGNED_SHORT, depthBuffer16);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    }
+    else
+    {
+        glDrawPixels(screenWidth, screenHeight, GL_LUMINANCE, GL_FLOAT, depthBuffer);
+    }
+
+    // no window to draw text and swap in headless mode
+    if(benchmark.isHeadless())
+    {
+        glFlush();
+        return;
+    }
 
     // draw info messages
     showInfo();
@@ -764,9 +1495,48 @@ void keyboardCB(unsigned char key, int x, int y)
     case ' ':
         if(pboSupported)
             pboUsed = !pboUsed;
+        pboViewProjValid[0] = pboViewProjValid[1] = false;  // PBOs are not read in the other mode
         std::cout << "PBO mode: " << (pboUsed ? "on" : "off") << std::endl;
          break;
 
+    case 't': // change the number of threads (1 -> 2 -> ... -> # of cores)
+    case 'T':
+        threadPool.setThreadCount(threadPool.getThreadCount() % ThreadPool::getMaxThreadCount() + 1);
+        std::cout << "Threads: " << threadPool.getThreadCount() << std::endl;
+        break;
+
+    case 'l': // toggle linear depth
+    case 'L':
+        depthMode ^= DEPTH_LINEAR;
+        std::cout << "Depth: " << DEPTH_MODE_NAMES[depthMode] << std::endl;
+        break;
+
+    case 'u': // toggle 16-bit unorm output
+    case 'U':
+        depthMode ^= DEPTH_UNORM16;
+        std::cout << "Depth: " << DEPTH_MODE_NAMES[depthMode] << std::endl;
+        break;
+
+    case 's': // switch between SIMD and plain C++ kernels
+    case 'S':
+        if(Pixel::getSimdLevel() == Pixel::SIMD_NONE)
+            Pixel::setSimdLevel(Pixel::getMaxSimdLevel());
+        else
+            Pixel::setSimdLevel(Pixel::SIMD_NONE);
+        std::cout << "SIMD: " << Pixel::getSimdLevelName(Pixel::getSimdLevel()) << std::endl;
+        break;
+
+    case 'o': // change culling (off -> test -> on)
+    case 'O':
+        cullMode = (cullMode + 1) % CULL_MODE_COUNT;
+        std::cout << "Culling: " << CULL_MODE_NAMES[cullMode] << std::endl;
+        break;
+
+    case 'p': // save the depth of the last frame as point cloud
+    case 'P':
+        savePointCloud(POINT_FILE);
+        break;
+
     case 'd': // switch rendering modes (fill -> wire -> point)
     case 'D':
         ++drawMode;
@@ -847,5 +1617,8 @@ void mouseMotionCB(int x, int y)
 
 void exitCB()
 {
+    printProcessTimes();
+    writeTimingStats();
+    writeTrace();
     clearSharedMem();
 }
@@ -0,0 +1,82 @@
+///////////////////////////////////////////////////////////////////////////////
+// pixelUtils.h
+// ============
+// SIMD pixel kernels shared by image codecs (Tga, Bmp) and other samples
+// The fastest kernel for the running CPU (AVX2, SSSE3, SSE2 or plain C++) is
+// selected at run-time with CPUID, so the same binary runs on any x86 CPU.
+// On non-x86 platforms, only the plain C++ kernels are compiled.
+//
+//  AUTHOR: Song Ho Ahn (song.ahn@gmail.com)
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef PIXEL_UTILS_H
+#define PIXEL_UTILS_H
+
+#include <cstddef>
+
+// x86 SIMD is available if compiled for x86/x64
+// Each SIMD function is compiled for its own instruction set with PIXEL_TARGET,
+// so no global compiler flags (-mavx2, /arch:AVX2) are required.
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define PIXEL_X86 1
+#if defined(_MSC_VER) && !defined(__clang__)
+#define PIXEL_TARGET(isa)
+#else
+#define PIXEL_TARGET(isa) __attribute__((target(isa)))
+#endif
+#endif
+
+namespace Pixel
+{
+    // instruction set levels, higher level includes lower ones
+    enum SimdLevel
+    {
+        SIMD_NONE = 0,      // plain C++
+        SIMD_SSE2,
+        SIMD_SSSE3,         // for pshufb
+        SIMD_AVX2
+    };
+
+    // get the SIMD level currently used by kernels
+    // It is detected at the first call, and can be lowered by setSimdLevel().
+    SimdLevel getSimdLevel();
+
+    // get the highest SIMD level supported by CPU and OS
+    SimdLevel getMaxSimdLevel();
+
+    // force a lower SIMD level, for example, to compare with plain C++ kernels
+    // The level is clamped to getMaxSimdLevel().
+    void setSimdLevel(SimdLevel level);
+
+    const char* getSimdLevelName(SimdLevel level);
+
+    // swap the position of the 1st and 3rd colour components (RGB <-> BGR)
+    // channelCount must be 3 or 4, and the alpha channel is not changed.
+    void swapRedBlue(unsigned char* data, std::size_t dataSize, int channelCount);
+
+    // flip the vertical orientation of an image in place
+    // It swaps the top and bottom scanlines directly, without a temp buffer.
+    void flipImage(unsigned char* data, int width, int height, int channelCount);
+
+    // change the brightness of 4-channel pixels (BGRA or RGBA) with saturation
+    // shift is added to the colour components and clamped to [0, 255], and the
+    // alpha channel is copied as is. src and dst can be the same buffer.
+    void addBrightness(const unsigned char* src, unsigned char* dst, std::size_t pixelCount, int shift);
+
+    // return true if 2 memory blocks are the same, like memcmp() == 0
+    // It compares 32 or 64 bytes at once, and stops at the first different block.
+    bool isEqual(const unsigned char* data1, const unsigned char* data2, std::size_t size);
+
+    // fill 4-byte pixels with a value, or copy memory
+    // If nonTemporal is true, the SIMD kernels use streaming stores, which
+    // bypass cache and write full cache lines in order. It is faster for a
+    // large buffer not read again soon, for example, a mapped PBO in
+    // write-combined memory. It ends with a store fence, so the data are
+    // visible before glUnmapBuffer() or glTexSubImage2D().
+    void fillPixels(unsigned char* dst, std::size_t pixelCount, unsigned int value, bool nonTemporal);
+    void copyPixels(unsigned char* dst, const unsigned char* src, std::size_t size, bool nonTemporal);
+}
+
+#endif // PIXEL_UTILS_H
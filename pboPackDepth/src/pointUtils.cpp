@@ -0,0 +1,491 @@
+///////////////////////////////////////////////////////////////////////////////
+// pointUtils.cpp
+// ==============
+// Reprojection of depth images to world-space point clouds
+//
+//  AUTHOR: Song Ho Ahn (song.ahn@gmail.com)
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cmath>                        // for floorf(), lrintf(), fabsf()
+#include <vector>
+#include <algorithm>
+#include <unordered_set>
+#include "pointUtils.h"
+#include "PlyWriter.h"
+#include "ThreadPool.h"
+#include "pixelUtils.h"                 // SIMD level and PIXEL_TARGET
+
+#ifdef PIXEL_X86
+#include <immintrin.h>
+#endif
+
+
+
+namespace Point
+{
+// coefficients of a scanline computed once per row
+// ndc x = x * ax + bx, ndc z = depth * 2 - 1, and each component of the
+// homogeneous point is (nx * cx + nz * cz) + c0, where c0 has the ndc y term
+struct RowCoeffs
+{
+    float ax;
+    float bx;
+    float cx[4];
+    float cz[4];
+    float c0[4];
+    float maxDepth;
+};
+
+static RowCoeffs computeCoeffs(int y, const Params& params)
+{
+    const float* m = params.invViewProj;
+    float ny = (y + 0.5f) * 2.0f / params.height - 1.0f;
+
+    RowCoeffs k;
+    k.ax = 2.0f / params.width;
+    k.bx = 1.0f / params.width - 1.0f;          // pixel centre, (x + 0.5) * ax - 1
+    for(int i = 0; i < 4; ++i)
+    {
+        k.cx[i] = m[i];
+        k.cz[i] = m[8 + i];
+        k.c0[i] = m[4 + i] * ny + m[12 + i];
+    }
+    k.maxDepth = params.maxDepth;
+    return k;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// plain C++ kernels
+///////////////////////////////////////////////////////////////////////////////
+static int unprojectRow1(const float* depth, int firstX, int lastX, const RowCoeffs& k, float* points)
+{
+    int count = 0;
+    for(int x = firstX; x < lastX; ++x)
+    {
+        float d = depth[x];
+        if(!(d < k.maxDepth))
+            continue;
+
+        float nx = (float)x * k.ax + k.bx;
+        float nz = d * 2.0f - 1.0f;
+        float invW = 1.0f / ((nx * k.cx[3] + nz * k.cz[3]) + k.c0[3]);
+        points[count * 3]     = ((nx * k.cx[0] + nz * k.cz[0]) + k.c0[0]) * invW;
+        points[count * 3 + 1] = ((nx * k.cx[1] + nz * k.cz[1]) + k.c0[1]) * invW;
+        points[count * 3 + 2] = ((nx * k.cx[2] + nz * k.cz[2]) + k.c0[2]) * invW;
+        ++count;
+    }
+    return count;
+}
+
+static void quantize1(const float* src, std::size_t count, float scale, short* dst)
+{
+    for(std::size_t i = 0; i < count; ++i)
+    {
+        float v = src[i] * scale;
+        v = v < -32768.0f ? -32768.0f : (v > 32767.0f ? 32767.0f : v);
+        dst[i] = (short)lrintf(v);      // round to nearest like cvtps2dq
+    }
+}
+
+// append the points of the set bits of mask from the SIMD lanes
+static inline int storePoints(const float* xs, const float* ys, const float* zs, int mask, float* points)
+{
+    int count = 0;
+    for(int i = 0; mask; ++i, mask >>= 1)
+    {
+        if(mask & 1)
+        {
+            points[count * 3]     = xs[i];
+            points[count * 3 + 1] = ys[i];
+            points[count * 3 + 2] = zs[i];
+            ++count;
+        }
+    }
+    return count;
+}
+
+
+
+#ifdef PIXEL_X86
+///////////////////////////////////////////////////////////////////////////////
+// SSE2 kernels
+///////////////////////////////////////////////////////////////////////////////
+// the background pixels are removed by the mask of the depth comparison, so
+// only the lanes of the visible pixels are stored
+PIXEL_TARGET("sse2")
+static int unprojectRowSSE2(const float* depth, int width, const RowCoeffs& k, float* points, int& count)
+{
+    const __m128 maxDepth = _mm_set1_ps(k.maxDepth);
+    const __m128 two = _mm_set1_ps(2.0f);
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 four = _mm_set1_ps(4.0f);
+    __m128 xs = _mm_setr_ps(0, 1, 2, 3);
+    float tx[4], ty[4], tz[4];
+    int x = 0;
+    count = 0;
+    for(; x + 4 <= width; x += 4, xs = _mm_add_ps(xs, four))
+    {
+        __m128 d = _mm_loadu_ps(depth + x);
+        int mask = _mm_movemask_ps(_mm_cmplt_ps(d, maxDepth));
+        if(!mask)
+            continue;
+
+        __m128 nx = _mm_add_ps(_mm_mul_ps(xs, _mm_set1_ps(k.ax)), _mm_set1_ps(k.bx));
+        __m128 nz = _mm_sub_ps(_mm_mul_ps(d, two), one);
+        __m128 v[4];
+        for(int i = 0; i < 4; ++i)
+            v[i] = _mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, _mm_set1_ps(k.cx[i])), _mm_mul_ps(nz, _mm_set1_ps(k.cz[i]))),
+                              _mm_set1_ps(k.c0[i]));
+        __m128 invW = _mm_div_ps(one, v[3]);
+        _mm_storeu_ps(tx, _mm_mul_ps(v[0], invW));
+        _mm_storeu_ps(ty, _mm_mul_ps(v[1], invW));
+        _mm_storeu_ps(tz, _mm_mul_ps(v[2], invW));
+        count += storePoints(tx, ty, tz, mask, points + count * 3);
+    }
+    return x;                           // # of processed pixels
+}
+
+// clamped before cvtps2dq, which returns 0x80000000 for large values, then
+// cvtps2dq rounds to nearest like lrintf()
+PIXEL_TARGET("sse2")
+static inline __m128i quantizeSSE2(__m128 v, __m128 scale)
+{
+    v = _mm_min_ps(_mm_max_ps(_mm_mul_ps(v, scale), _mm_set1_ps(-32768.0f)), _mm_set1_ps(32767.0f));
+    return _mm_cvtps_epi32(v);
+}
+
+PIXEL_TARGET("sse2")
+static std::size_t quantizeSSE2(const float* src, std::size_t count, float scale, short* dst)
+{
+    const __m128 s = _mm_set1_ps(scale);
+    std::size_t i = 0;
+    for(; i + 8 <= count; i += 8)
+    {
+        __m128i i0 = quantizeSSE2(_mm_loadu_ps(src + i), s);
+        __m128i i1 = quantizeSSE2(_mm_loadu_ps(src + i + 4), s);
+        _mm_storeu_si128((__m128i*)(dst + i), _mm_packs_epi32(i0, i1));
+    }
+    return i;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// AVX2 kernels
+///////////////////////////////////////////////////////////////////////////////
+PIXEL_TARGET("avx2")
+static int unprojectRowAVX2(const float* depth, int width, const RowCoeffs& k, float* points, int& count)
+{
+    const __m256 maxDepth = _mm256_set1_ps(k.maxDepth);
+    const __m256 two = _mm256_set1_ps(2.0f);
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 eight = _mm256_set1_ps(8.0f);
+    __m256 xs = _mm256_setr_ps(0, 1, 2, 3, 4, 5, 6, 7);
+    float tx[8], ty[8], tz[8];
+    int x = 0;
+    count = 0;
+    for(; x + 8 <= width; x += 8, xs = _mm256_add_ps(xs, eight))
+    {
+        __m256 d = _mm256_loadu_ps(depth + x);
+        int mask = _mm256_movemask_ps(_mm256_cmp_ps(d, maxDepth, _CMP_LT_OQ));
+        if(!mask)
+            continue;
+
+        __m256 nx = _mm256_add_ps(_mm256_mul_ps(xs, _mm256_set1_ps(k.ax)), _mm256_set1_ps(k.bx));
+        __m256 nz = _mm256_sub_ps(_mm256_mul_ps(d, two), one);
+        __m256 v[4];
+        for(int i = 0; i < 4; ++i)
+            v[i] = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(nx, _mm256_set1_ps(k.cx[i])), _mm256_mul_ps(nz, _mm256_set1_ps(k.cz[i]))),
+                                 _mm256_set1_ps(k.c0[i]));
+        __m256 invW = _mm256_div_ps(one, v[3]);
+        _mm256_storeu_ps(tx, _mm256_mul_ps(v[0], invW));
+        _mm256_storeu_ps(ty, _mm256_mul_ps(v[1], invW));
+        _mm256_storeu_ps(tz, _mm256_mul_ps(v[2], invW));
+        count += storePoints(tx, ty, tz, mask, points + count * 3);
+    }
+    return x;
+}
+
+PIXEL_TARGET("avx2")
+static inline __m256i quantizeAVX2(__m256 v, __m256 scale)
+{
+    v = _mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(v, scale), _mm256_set1_ps(-32768.0f)), _mm256_set1_ps(32767.0f));
+    return _mm256_cvtps_epi32(v);
+}
+
+// vpackssdw packs within 128-bit lanes, so the 64-bit blocks are reordered
+PIXEL_TARGET("avx2")
+static std::size_t quantizeAVX2(const float* src, std::size_t count, float scale, short* dst)
+{
+    const __m256 s = _mm256_set1_ps(scale);
+    std::size_t i = 0;
+    for(; i + 16 <= count; i += 16)
+    {
+        __m256i i0 = quantizeAVX2(_mm256_loadu_ps(src + i), s);
+        __m256i i1 = quantizeAVX2(_mm256_loadu_ps(src + i + 8), s);
+        __m256i p = _mm256_permute4x64_epi64(_mm256_packs_epi32(i0, i1), 0xd8);
+        _mm256_storeu_si256((__m256i*)(dst + i), p);
+    }
+    return i;
+}
+#endif // PIXEL_X86
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// inverse of 4x4 matrix with the cofactors
+///////////////////////////////////////////////////////////////////////////////
+bool invertMatrix(const float m[16], float inv[16])
+{
+    float t[16];
+    t[0]  =  m[5]*m[10]*m[15] - m[5]*m[11]*m[14] - m[9]*m[6]*m[15] + m[9]*m[7]*m[14] + m[13]*m[6]*m[11] - m[13]*m[7]*m[10];
+    t[4]  = -m[4]*m[10]*m[15] + m[4]*m[11]*m[14] + m[8]*m[6]*m[15] - m[8]*m[7]*m[14] - m[12]*m[6]*m[11] + m[12]*m[7]*m[10];
+    t[8]  =  m[4]*m[9]*m[15]  - m[4]*m[11]*m[13] - m[8]*m[5]*m[15] + m[8]*m[7]*m[13] + m[12]*m[5]*m[11] - m[12]*m[7]*m[9];
+    t[12] = -m[4]*m[9]*m[14]  + m[4]*m[10]*m[13] + m[8]*m[5]*m[14] - m[8]*m[6]*m[13] - m[12]*m[5]*m[10] + m[12]*m[6]*m[9];
+    t[1]  = -m[1]*m[10]*m[15] + m[1]*m[11]*m[14] + m[9]*m[2]*m[15] - m[9]*m[3]*m[14] - m[13]*m[2]*m[11] + m[13]*m[3]*m[10];
+    t[5]  =  m[0]*m[10]*m[15] - m[0]*m[11]*m[14] - m[8]*m[2]*m[15] + m[8]*m[3]*m[14] + m[12]*m[2]*m[11] - m[12]*m[3]*m[10];
+    t[9]  = -m[0]*m[9]*m[15]  + m[0]*m[11]*m[13] + m[8]*m[1]*m[15] - m[8]*m[3]*m[13] - m[12]*m[1]*m[11] + m[12]*m[3]*m[9];
+    t[13] =  m[0]*m[9]*m[14]  - m[0]*m[10]*m[13] - m[8]*m[1]*m[14] + m[8]*m[2]*m[13] + m[12]*m[1]*m[10] - m[12]*m[2]*m[9];
+    t[2]  =  m[1]*m[6]*m[15]  - m[1]*m[7]*m[14]  - m[5]*m[2]*m[15] + m[5]*m[3]*m[14] + m[13]*m[2]*m[7]  - m[13]*m[3]*m[6];
+    t[6]  = -m[0]*m[6]*m[15]  + m[0]*m[7]*m[14]  + m[4]*m[2]*m[15] - m[4]*m[3]*m[14] - m[12]*m[2]*m[7]  + m[12]*m[3]*m[6];
+    t[10] =  m[0]*m[5]*m[15]  - m[0]*m[7]*m[13]  - m[4]*m[1]*m[15] + m[4]*m[3]*m[13] + m[12]*m[1]*m[7]  - m[12]*m[3]*m[5];
+    t[14] = -m[0]*m[5]*m[14]  + m[0]*m[6]*m[13]  + m[4]*m[1]*m[14] - m[4]*m[2]*m[13] - m[12]*m[1]*m[6]  + m[12]*m[2]*m[5];
+    t[3]  = -m[1]*m[6]*m[11]  + m[1]*m[7]*m[10]  + m[5]*m[2]*m[11] - m[5]*m[3]*m[10] - m[9]*m[2]*m[7]   + m[9]*m[3]*m[6];
+    t[7]  =  m[0]*m[6]*m[11]  - m[0]*m[7]*m[10]  - m[4]*m[2]*m[11] + m[4]*m[3]*m[10] + m[8]*m[2]*m[7]   - m[8]*m[3]*m[6];
+    t[11] = -m[0]*m[5]*m[11]  + m[0]*m[7]*m[9]   + m[4]*m[1]*m[11] - m[4]*m[3]*m[9]  - m[8]*m[1]*m[7]   + m[8]*m[3]*m[5];
+    t[15] =  m[0]*m[5]*m[10]  - m[0]*m[6]*m[9]   - m[4]*m[1]*m[10] + m[4]*m[2]*m[9]  + m[8]*m[1]*m[6]   - m[8]*m[2]*m[5];
+
+    float det = m[0]*t[0] + m[1]*t[4] + m[2]*t[8] + m[3]*t[12];
+    if(det == 0)
+        return false;
+
+    float invDet = 1.0f / det;
+    for(int i = 0; i < 16; ++i)
+        inv[i] = t[i] * invDet;
+    return true;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// unproject a scanline of depth to xyz points
+// The window coords of a pixel centre are converted to NDC, then multiplied
+// by the inverse matrix and divided by w. The depth >= maxDepth is skipped.
+///////////////////////////////////////////////////////////////////////////////
+int unprojectRow(const float* depth, int y, const Params& params, float* points)
+{
+    if(!depth || !points) return 0;
+
+    RowCoeffs k = computeCoeffs(y, params);
+    int done = 0;
+    int count = 0;
+#ifdef PIXEL_X86
+    Pixel::SimdLevel level = Pixel::getSimdLevel();
+    if(level >= Pixel::SIMD_AVX2)
+        done = unprojectRowAVX2(depth, params.width, k, points, count);
+    else if(level >= Pixel::SIMD_SSE2)
+        done = unprojectRowSSE2(depth, params.width, k, points, count);
+#endif
+    return count + unprojectRow1(depth, done, params.width, k, points + count * 3);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// quantize xyz values to 16-bit integers
+// count is the number of values (3 per point).
+///////////////////////////////////////////////////////////////////////////////
+void quantize(const float* points, std::size_t count, float step, short* dst)
+{
+    if(!points || !dst || step <= 0) return;
+
+    float scale = 1.0f / step;
+    std::size_t done = 0;
+#ifdef PIXEL_X86
+    Pixel::SimdLevel level = Pixel::getSimdLevel();
+    if(level >= Pixel::SIMD_AVX2)
+        done = quantizeAVX2(points, count, scale, dst);
+    else if(level >= Pixel::SIMD_SSE2)
+        done = quantizeSSE2(points, count, scale, dst);
+#endif
+    quantize1(points + done, count - done, scale, dst + done);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// step of quantize() from the largest absolute coordinate of the box
+///////////////////////////////////////////////////////////////////////////////
+float computeQuantizeStep(const float minPoint[3], const float maxPoint[3])
+{
+    float maxAbs = 0;
+    for(int i = 0; i < 3; ++i)
+        maxAbs = std::max(maxAbs, std::max(fabsf(minPoint[i]), fabsf(maxPoint[i])));
+    return (maxAbs > 0) ? maxAbs / 32767.0f : 1.0f;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// pack the voxel indices of a point, offset by 2^20 to be positive
+///////////////////////////////////////////////////////////////////////////////
+unsigned long long getVoxelKey(const float* point, float voxelSize)
+{
+    const long long OFFSET = 1 << 20;
+    const unsigned long long MASK = (1 << 21) - 1;
+    unsigned long long x = (unsigned long long)((long long)floorf(point[0] / voxelSize) + OFFSET) & MASK;
+    unsigned long long y = (unsigned long long)((long long)floorf(point[1] / voxelSize) + OFFSET) & MASK;
+    unsigned long long z = (unsigned long long)((long long)floorf(point[2] / voxelSize) + OFFSET) & MASK;
+    return (z << 42) | (y << 21) | x;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// unproject the depth image in bands by all threads, and merge the bounding
+// boxes of the bands
+// The points are not kept, so writePly() unprojects the rows again.
+///////////////////////////////////////////////////////////////////////////////
+std::size_t computeBounds(const float* depth, const Params& params, ThreadPool& threadPool,
+                          float minPoint[3], float maxPoint[3])
+{
+    for(int i = 0; i < 3; ++i)
+        minPoint[i] = maxPoint[i] = 0;
+    if(!depth || params.width <= 0 || params.height <= 0)
+        return 0;
+
+    // bounds of each band, [minX, minY, minZ, maxX, maxY, maxZ]
+    int width = params.width;
+    int bandRows = ThreadPool::computeBandRows(width * 3 * sizeof(float));
+    int bandCount = (params.height + bandRows - 1) / bandRows;
+    std::vector<float> bandBounds((std::size_t)bandCount * 6);
+    std::vector<std::size_t> pointCounts(bandCount);
+
+    threadPool.run(params.height, bandRows, [&](int firstRow, int lastRow)
+    {
+        int band = firstRow / bandRows;
+        float* bounds = &bandBounds[(std::size_t)band * 6];
+        std::vector<float> points((std::size_t)width * 3);
+        std::size_t total = 0;
+        for(int y = firstRow; y < lastRow; ++y)
+        {
+            int count = unprojectRow(depth + (std::size_t)y * width, y, params, &points[0]);
+            for(int j = 0; j < count; ++j)
+            {
+                const float* p = &points[(std::size_t)j * 3];
+                for(int k = 0; k < 3; ++k)
+                {
+                    if(total == 0 && j == 0)
+                        bounds[k] = bounds[k + 3] = p[k];
+                    bounds[k] = std::min(bounds[k], p[k]);
+                    bounds[k + 3] = std::max(bounds[k + 3], p[k]);
+                }
+            }
+            total += count;
+        }
+        pointCounts[band] = total;
+    });
+
+    std::size_t total = 0;
+    for(int i = 0; i < bandCount; ++i)
+    {
+        if(pointCounts[i] == 0)
+            continue;
+
+        const float* bounds = &bandBounds[(std::size_t)i * 6];
+        for(int k = 0; k < 3; ++k)
+        {
+            minPoint[k] = (total == 0) ? bounds[k] : std::min(minPoint[k], bounds[k]);
+            maxPoint[k] = (total == 0) ? bounds[k + 3] : std::max(maxPoint[k], bounds[k + 3]);
+        }
+        total += pointCounts[i];
+    }
+    return total;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// unproject the depth image and stream the points to the PLY writer
+// A group of bands, 1 band per thread, is unprojected in parallel, then the
+// points of the bands are filtered by voxels, quantized and written in order.
+// So the points are the same for any thread count, and only 1 group of bands
+// is in memory at a time.
+///////////////////////////////////////////////////////////////////////////////
+std::size_t writePly(const float* depth, const Params& params, ThreadPool& threadPool, PlyWriter& writer)
+{
+    if(!depth || !writer.isOpen() || params.width <= 0 || params.height <= 0)
+        return 0;
+
+    int width = params.width;
+    int bandRows = ThreadPool::computeBandRows(width * 3 * sizeof(float));
+    int bandCount = threadPool.getThreadCount();
+    int groupRows = bandRows * bandCount;
+    std::vector<std::vector<float> > bandPoints(bandCount);
+    std::vector<int> pointCounts(bandCount);
+    std::vector<short> quantized;
+    std::unordered_set<unsigned long long> voxels;
+    std::size_t written = 0;
+
+    for(int groupRow = 0; groupRow < params.height; groupRow += groupRows)
+    {
+        int rowCount = std::min(groupRows, params.height - groupRow);
+        threadPool.run(rowCount, bandRows, [&](int firstRow, int lastRow)
+        {
+            int band = firstRow / bandRows;
+            std::vector<float>& points = bandPoints[band];
+            points.resize((std::size_t)(lastRow - firstRow) * width * 3);
+            int count = 0;
+            for(int y = groupRow + firstRow; y < groupRow + lastRow; ++y)
+                count += unprojectRow(depth + (std::size_t)y * width, y, params, &points[(std::size_t)count * 3]);
+            pointCounts[band] = count;
+        });
+
+        int groupBands = (rowCount + bandRows - 1) / bandRows;
+        for(int i = 0; i < groupBands; ++i)
+        {
+            float* points = bandPoints[i].empty() ? 0 : &bandPoints[i][0];
+            int count = pointCounts[i];
+
+            // keep the first point of each voxel
+            if(params.voxelSize > 0)
+            {
+                int kept = 0;
+                for(int j = 0; j < count; ++j)
+                {
+                    if(!voxels.insert(getVoxelKey(points + j * 3, params.voxelSize)).second)
+                        continue;
+                    if(kept != j)
+                    {
+                        points[kept * 3]     = points[j * 3];
+                        points[kept * 3 + 1] = points[j * 3 + 1];
+                        points[kept * 3 + 2] = points[j * 3 + 2];
+                    }
+                    ++kept;
+                }
+                count = kept;
+            }
+            if(count == 0)
+                continue;
+
+            if(writer.isQuantized())
+            {
+                quantized.resize((std::size_t)count * 3);
+                quantize(points, (std::size_t)count * 3, writer.getQuantizeStep(), &quantized[0]);
+                writer.write(&quantized[0], count);
+            }
+            else
+            {
+                writer.write(points, count);
+            }
+            written += count;
+        }
+    }
+    return written;
+}
+
+} // namespace Point
@@ -0,0 +1,72 @@
+///////////////////////////////////////////////////////////////////////////////
+// pointUtils.h
+// ============
+// Reprojection of depth images to world-space point clouds
+// unprojectRow() converts a scanline of window-space depth read by
+// glReadPixels(GL_DEPTH_COMPONENT, GL_FLOAT) to xyz points with the inverse of
+// projection * view matrix, and skips the background pixels. quantize()
+// converts the points to 16-bit integers (1/2 size of float) with a step,
+// and computeQuantizeStep() chooses the step from the bounding box of the
+// points (computeBounds()), so any scene fits in 16 bits without clamping.
+//
+// writePly() unprojects the rows in bands by all threads of the pool, and
+// writes the points of each group of bands to PlyWriter in order, so the
+// whole point cloud is never copied to memory. With voxelSize > 0, only the
+// first point of each voxel is kept.
+// The kernels use the SIMD level of pixelUtils (Pixel::getSimdLevel()).
+//
+//  AUTHOR: Song Ho Ahn (song.ahn@gmail.com)
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef POINT_UTILS_H
+#define POINT_UTILS_H
+
+#include <cstddef>
+
+class ThreadPool;
+class PlyWriter;
+
+namespace Point
+{
+    // parameters of unprojectRow() and writePly()
+    struct Params
+    {
+        float invViewProj[16];  // inverse of (projection * view), column-major
+        int width;              // size of the depth image (viewport)
+        int height;
+        float maxDepth;         // skip depth >= maxDepth, e.g., 1 is background
+        float voxelSize;        // keep 1 point per voxel if > 0
+    };
+
+    // invert 4x4 column-major matrix, return false if it is singular
+    bool invertMatrix(const float m[16], float inv[16]);
+
+    // unproject the scanline y to xyz points, and return the number of points
+    // points must have width * 3 floats at least
+    int unprojectRow(const float* depth, int y, const Params& params, float* points);
+
+    // round (xyz / step) to 16-bit integers, saturated to [-32768, 32767]
+    void quantize(const float* points, std::size_t count, float step, short* dst);
+
+    // the smallest step to fit the bounding box in [-32767, 32767]
+    // It is 1 if all points are at the origin or there is no point.
+    float computeQuantizeStep(const float minPoint[3], const float maxPoint[3]);
+
+    // voxel of a point, 21 bits per axis
+    unsigned long long getVoxelKey(const float* point, float voxelSize);
+
+    // unproject all rows of the depth image by all threads, and compute the
+    // bounding box of the points, return the number of points
+    // The box is (0, 0, 0) if there is no point.
+    std::size_t computeBounds(const float* depth, const Params& params, ThreadPool& threadPool,
+                              float minPoint[3], float maxPoint[3]);
+
+    // unproject all rows of the depth image and write the points to the
+    // opened writer, return the number of written points
+    // The points are quantized if the writer is opened with quantizeStep > 0.
+    std::size_t writePly(const float* depth, const Params& params, ThreadPool& threadPool, PlyWriter& writer);
+}
+
+#endif // POINT_UTILS_H
@@ -0,0 +1,438 @@
+///////////////////////////////////////////////////////////////////////////////
+// Benchmark.cpp
+// =============
+// Command-line options and per-frame timing report for the headless benchmark
+// mode of the PBO samples
+//
+//  AUTHOR: Song Ho Ahn (song.ahn@gmail.com)
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+#include <cstdlib>
+#include <cctype>
+#include "Benchmark.h"
+#include "TimingStats.h"
+
+// constants
+static const int DEFAULT_FRAME_COUNT = 300;
+static const int DEFAULT_WARMUP_COUNT = 10;
+
+// escape quotes and backslashes for JSON string
+static std::string escapeJson(const std::string& str)
+{
+    std::string result;
+    for(std::size_t i = 0; i < str.size(); ++i)
+    {
+        if(str[i] == '"' || str[i] == '\\')
+            result += '\\';
+        result += str[i];
+    }
+    return result;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// ctor
+///////////////////////////////////////////////////////////////////////////////
+Benchmark::Benchmark() : headless(false), kernelBench(false), width(0), height(0), pboMode(0),
+                         dirtyPercent(100), voxelSize(0), threadCount(0), tileSize(0), frameCount(DEFAULT_FRAME_COUNT),
+                         warmupCount(DEFAULT_WARMUP_COUNT), totalTime(0)
+{
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// parse "--name value" or "--name=value" arguments
+// The arguments not starting with "--" are left for GLUT, e.g., -display.
+///////////////////////////////////////////////////////////////////////////////
+bool Benchmark::parse(int argc, char** argv)
+{
+    for(int i = 1; i < argc; ++i)
+    {
+        std::string arg = argv[i];
+        if(arg.compare(0, 2, "--") != 0)
+            continue;
+
+        // split "--name=value"
+        std::string value;
+        bool hasValue = false;
+        std::size_t pos = arg.find('=');
+        if(pos != std::string::npos)
+        {
+            value = arg.substr(pos + 1);
+            arg = arg.substr(0, pos);
+            hasValue = true;
+        }
+
+        if(arg == "--headless")
+        {
+            headless = true;
+            continue;
+        }
+        else if(arg == "--bench-kernels")
+        {
+            kernelBench = true;
+            continue;
+        }
+        else if(arg == "--help")
+        {
+            return false;
+        }
+
+        // the other options need a value
+        if(!hasValue)
+        {
+            if(i + 1 >= argc)
+            {
+                std::cout << "[ERROR] " << arg << " needs a value." << std::endl;
+                return false;
+            }
+            value = argv[++i];
+        }
+
+        char* end = 0;
+        long number = std::strtol(value.c_str(), &end, 10);
+        bool isNumber = !value.empty() && *end == '\0';
+        double real = std::strtod(value.c_str(), &end);
+        bool isReal = !value.empty() && *end == '\0';
+
+        if(arg == "--format")
+            format = value;
+        else if(arg == "--transfer")
+            transfer = value;
+        else if(arg == "--mode")
+            mode = value;
+        else if(arg == "--tiles")
+            tileMode = value;
+        else if(arg == "--fill")
+            fillMode = value;
+        else if(arg == "--yuv")
+            yuvMode = value;
+        else if(arg == "--culling")
+            cullMode = value;
+        else if(arg == "--points")
+            pointFile = value;
+        else if(arg == "--point-format")
+            pointFormat = value;
+        else if(arg == "--report")
+            reportFile = value;
+        else if(arg == "--stats")
+            statsFile = value;
+        else if(arg == "--trace")
+            traceFile = value;
+        else if(arg == "--capture")
+            captureFile = value;
+        else if(arg == "--capture-policy")
+            capturePolicy = value;
+        else if(arg == "--screenshot")
+            screenshotName = value;
+        else if(arg == "--hires")
+            hiresFile = value;
+        else if(arg == "--hires-size")
+            hiresSize = value;
+        else if(arg == "--width" && isNumber && number > 0)
+            width = (int)number;
+        else if(arg == "--height" && isNumber && number > 0)
+            height = (int)number;
+        else if(arg == "--pbo" && isNumber && number >= 0)
+            pboMode = (int)number;
+        else if(arg == "--dirty" && isNumber && number >= 0 && number <= 100)
+            dirtyPercent = (int)number;
+        else if(arg == "--voxel" && isReal && real >= 0)
+            voxelSize = real;
+        else if(arg == "--threads" && isNumber && number >= 0)
+            threadCount = (int)number;
+        else if(arg == "--tile" && isNumber && number > 0)
+            tileSize = (int)number;
+        else if(arg == "--frames" && isNumber && number > 0)
+            frameCount = (int)number;
+        else if(arg == "--warmup" && isNumber && number >= 0)
+            warmupCount = (int)number;
+        else
+        {
+            std::cout << "[ERROR] Invalid option: " << arg << " " << value << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// print the options with the current (default) values
+///////////////////////////////////////////////////////////////////////////////
+void Benchmark::printUsage(const char* name) const
+{
+    std::cout << "Usage: " << name << " [options]\n"
+              << "  --headless          render offscreen without window, then exit\n"
+              << "  --bench-kernels     check and measure CPU kernels at all SIMD levels, then exit\n"
+              << "  --width N           image width (" << width << ")\n"
+              << "  --height N          image height (" << height << ")\n"
+              << "  --format NAME       pixel format (" << format << ")\n";
+    if(!transfer.empty())
+        std::cout << "  --transfer NAME     pixel format in PBO (" << transfer << ")\n";
+    std::cout << "  --pbo N             PBO mode, 0 is off (" << pboMode << ")\n";
+    if(!mode.empty())
+        std::cout << "  --mode NAME         transfer mode (" << mode << ")\n";
+    if(!tileMode.empty())
+        std::cout << "  --tiles NAME        dirty tile tracking (" << tileMode << ")\n"
+                  << "  --dirty N           changed area in percent (" << dirtyPercent << ")\n";
+    if(!fillMode.empty())
+        std::cout << "  --fill NAME         pixel fill kernel (" << fillMode << ")\n";
+    if(!yuvMode.empty())
+        std::cout << "  --yuv NAME          YUV 4:2:0 conversion (" << yuvMode << ")\n";
+    if(!cullMode.empty())
+        std::cout << "  --culling NAME      Hi-Z occlusion culling (" << cullMode << ")\n";
+    if(!pointFormat.empty())
+        std::cout << "  --points FILE       save last depth as point cloud to .ply file\n"
+                  << "  --point-format NAME float or 16-bit short xyz (" << pointFormat << ")\n"
+                  << "  --voxel SIZE        voxel size of downsampling, 0 is off (" << voxelSize << ")\n";
+    std::cout << "  --threads N         # of threads, 0 is default (" << threadCount << ")\n";
+    if(!capturePolicy.empty())
+        std::cout << "  --capture FILE      record frames to .raw, .y4m, .tga or .qoi file\n"
+                  << "  --capture-policy NAME   drop or block if recorder is full (" << capturePolicy << ")\n"
+                  << "  --screenshot NAME   save last frame as TGA, BMP and QOI, and compare\n";
+    if(!hiresSize.empty())
+        std::cout << "  --hires FILE        render high-resolution image in tiles to .tga file\n"
+                  << "  --hires-size WxH    size of high-resolution image (" << hiresSize << ")\n"
+                  << "  --tile N            tile size of high-resolution image (" << tileSize << ")\n";
+    std::cout << "  --frames N          # of frames to measure (" << frameCount << ")\n"
+              << "  --warmup N          # of frames before measuring (" << warmupCount << ")\n"
+              << "  --report FILE       write per-frame timings to .csv or .json file\n"
+              << "  --stats FILE        write percentiles of timings to .csv file at exit\n"
+              << "  --trace FILE        profile frames and write Chrome trace .json file at exit\n"
+              << std::flush;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// set the names of timing columns, and clear the previous frames
+///////////////////////////////////////////////////////////////////////////////
+void Benchmark::setColumns(const std::vector<std::string>& names)
+{
+    columns = names;
+    frames.clear();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// add a parameter of the run, written in the header of JSON report
+///////////////////////////////////////////////////////////////////////////////
+void Benchmark::addParameter(const std::string& key, const std::string& value)
+{
+    Parameter param = {key, value, false};
+    parameters.push_back(param);
+}
+
+void Benchmark::addParameter(const std::string& key, double value)
+{
+    std::ostringstream oss;
+    oss << value;
+    Parameter param = {key, oss.str(), true};
+    parameters.push_back(param);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// add the timings of a frame, the same order as columns
+///////////////////////////////////////////////////////////////////////////////
+void Benchmark::addFrame(const std::vector<double>& times)
+{
+    frames.push_back(times);
+    frames.back().resize(columns.size(), 0.0);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// compute mean, min, max and percentiles of a column
+///////////////////////////////////////////////////////////////////////////////
+Benchmark::Stats Benchmark::computeStats(int column) const
+{
+    Stats stats = {0, 0, 0, 0, 0, 0, 0};
+    if(frames.empty())
+        return stats;
+
+    std::vector<double> values(frames.size());
+    double sum = 0;
+    for(std::size_t i = 0; i < frames.size(); ++i)
+    {
+        values[i] = frames[i][column];
+        sum += values[i];
+    }
+    std::sort(values.begin(), values.end());
+
+    stats.mean = sum / values.size();
+    stats.min = values.front();
+    stats.max = values.back();
+    stats.p50 = TimingStats::computePercentile(values, 50);
+    stats.p90 = TimingStats::computePercentile(values, 90);
+    stats.p95 = TimingStats::computePercentile(values, 95);
+    stats.p99 = TimingStats::computePercentile(values, 99);
+    return stats;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// write the report to CSV or JSON file, JSON if the extension is .json
+///////////////////////////////////////////////////////////////////////////////
+bool Benchmark::writeReport(const std::string& fileName) const
+{
+    std::string ext;
+    std::size_t pos = fileName.find_last_of('.');
+    if(pos != std::string::npos)
+        ext = fileName.substr(pos + 1);
+    std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+
+    bool result = (ext == "json") ? writeJson(fileName) : writeCsv(fileName);
+    if(!result)
+        std::cout << "[ERROR] Failed to write " << fileName << std::endl;
+    return result;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// write a row per frame, then a row per statistic
+// The first column is the frame number, or the name of the statistic, e.g.,
+// "p99", so the statistics can be filtered out by the first column.
+///////////////////////////////////////////////////////////////////////////////
+bool Benchmark::writeCsv(const std::string& fileName) const
+{
+    std::ofstream file(fileName.c_str());
+    if(!file)
+        return false;
+
+    file << "frame";
+    for(std::size_t i = 0; i < columns.size(); ++i)
+        file << "," << columns[i];
+    file << "\n";
+
+    file << std::fixed << std::setprecision(4);
+    for(std::size_t i = 0; i < frames.size(); ++i)
+    {
+        file << i;
+        for(std::size_t j = 0; j < columns.size(); ++j)
+            file << "," << frames[i][j];
+        file << "\n";
+    }
+
+    std::vector<Stats> stats;
+    for(std::size_t i = 0; i < columns.size(); ++i)
+        stats.push_back(computeStats((int)i));
+
+    const char* names[] = {"mean", "min", "p50", "p90", "p95", "p99", "max"};
+    for(int k = 0; k < 7; ++k)
+    {
+        file << names[k];
+        for(std::size_t i = 0; i < stats.size(); ++i)
+        {
+            const Stats& s = stats[i];
+            double values[] = {s.mean, s.min, s.p50, s.p90, s.p95, s.p99, s.max};
+            file << "," << values[k];
+        }
+        file << "\n";
+    }
+
+    return (bool)file;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// write parameters, statistics and frames to JSON
+///////////////////////////////////////////////////////////////////////////////
+bool Benchmark::writeJson(const std::string& fileName) const
+{
+    std::ofstream file(fileName.c_str());
+    if(!file)
+        return false;
+
+    file << std::fixed << std::setprecision(4);
+    file << "{\n";
+    file << "  \"name\": \"" << escapeJson(name) << "\",\n";
+    for(std::size_t i = 0; i < parameters.size(); ++i)
+    {
+        const Parameter& param = parameters[i];
+        file << "  \"" << param.key << "\": ";
+        if(param.number)
+            file << param.value << ",\n";
+        else
+            file << "\"" << escapeJson(param.value) << "\",\n";
+    }
+    file << "  \"frameCount\": " << frames.size() << ",\n";
+    file << "  \"totalTime\": " << totalTime << ",\n";
+    file << "  \"fps\": " << ((totalTime > 0) ? frames.size() / totalTime : 0) << ",\n";
+
+    // statistics per column
+    file << "  \"summary\": {\n";
+    for(std::size_t i = 0; i < columns.size(); ++i)
+    {
+        Stats s = computeStats((int)i);
+        file << "    \"" << columns[i] << "\": {"
+             << "\"mean\": " << s.mean << ", \"min\": " << s.min
+             << ", \"p50\": " << s.p50 << ", \"p90\": " << s.p90
+             << ", \"p95\": " << s.p95 << ", \"p99\": " << s.p99
+             << ", \"max\": " << s.max << "}"
+             << ((i + 1 < columns.size()) ? ",\n" : "\n");
+    }
+    file << "  },\n";
+
+    // frames as arrays in the order of columns
+    file << "  \"columns\": [";
+    for(std::size_t i = 0; i < columns.size(); ++i)
+        file << ((i > 0) ? ", " : "") << "\"" << columns[i] << "\"";
+    file << "],\n";
+    file << "  \"frames\": [\n";
+    for(std::size_t i = 0; i < frames.size(); ++i)
+    {
+        file << "    [";
+        for(std::size_t j = 0; j < columns.size(); ++j)
+            file << ((j > 0) ? ", " : "") << frames[i][j];
+        file << "]" << ((i + 1 < frames.size()) ? ",\n" : "\n");
+    }
+    file << "  ]\n";
+    file << "}\n";
+
+    return (bool)file;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// print the statistics of all columns
+///////////////////////////////////////////////////////////////////////////////
+void Benchmark::printSummary() const
+{
+    std::cout << name << ": " << frames.size() << " frames";
+    for(std::size_t i = 0; i < parameters.size(); ++i)
+        std::cout << ", " << parameters[i].key << "=" << parameters[i].value;
+    std::cout << "\n";
+
+    std::cout << std::fixed << std::setprecision(3);
+    if(totalTime > 0)
+        std::cout << "FPS: " << frames.size() / totalTime << "\n";
+    std::cout << "Time (ms)             mean      min      p50      p90      p99      max\n";
+    for(std::size_t i = 0; i < columns.size(); ++i)
+    {
+        Stats s = computeStats((int)i);
+        std::cout << std::left << std::setw(16) << columns[i] << std::right
+                  << std::setw(9) << s.mean << std::setw(9) << s.min
+                  << std::setw(9) << s.p50 << std::setw(9) << s.p90
+                  << std::setw(9) << s.p99 << std::setw(9) << s.max << "\n";
+    }
+    std::cout << std::resetiosflags(std::ios_base::fixed | std::ios_base::floatfield) << std::flush;
+}
@@ -0,0 +1,269 @@
+///////////////////////////////////////////////////////////////////////////////
+// DirtyTiles.cpp
+// ==============
+// Change tracker of an image divided into square tiles
+//
+//  AUTHOR: Song Ho Ahn (song.ahn@gmail.com)
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cstring>
+#include <algorithm>
+#include "DirtyTiles.h"
+#include "pixelUtils.h"
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// ctor
+///////////////////////////////////////////////////////////////////////////////
+DirtyTiles::DirtyTiles() : rectsUpdated(false), width(0), height(0), tileSize(0),
+                           bytesPerPixel(0), columns(0), rows(0)
+{
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// set the size of image and tiles, the last column/row of tiles may be
+// smaller than tileSize
+///////////////////////////////////////////////////////////////////////////////
+void DirtyTiles::init(int width, int height, int tileSize, int bytesPerPixel)
+{
+    this->width = width;
+    this->height = height;
+    this->tileSize = (tileSize > 0) ? tileSize : 1;
+    this->bytesPerPixel = bytesPerPixel;
+    columns = (width + this->tileSize - 1) / this->tileSize;
+    rows = (height + this->tileSize - 1) / this->tileSize;
+    flags.assign(columns * rows, 0);
+    rects.clear();
+    rectsUpdated = true;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// mark/clear tiles
+///////////////////////////////////////////////////////////////////////////////
+void DirtyTiles::markAll()
+{
+    std::fill(flags.begin(), flags.end(), 1);
+    rectsUpdated = false;
+}
+
+void DirtyTiles::markRect(int x, int y, int width, int height)
+{
+    // clip to the image
+    int x2 = std::min(x + width, this->width);
+    int y2 = std::min(y + height, this->height);
+    x = std::max(x, 0);
+    y = std::max(y, 0);
+    if(x >= x2 || y >= y2)
+        return;
+
+    int column1 = x / tileSize;
+    int column2 = (x2 - 1) / tileSize;
+    int row1 = y / tileSize;
+    int row2 = (y2 - 1) / tileSize;
+    for(int i = row1; i <= row2; ++i)
+    {
+        for(int j = column1; j <= column2; ++j)
+            flags[i * columns + j] = 1;
+    }
+    rectsUpdated = false;
+}
+
+void DirtyTiles::clear()
+{
+    std::fill(flags.begin(), flags.end(), 0);
+    rects.clear();
+    rectsUpdated = true;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// find the changed tiles by comparing with the previous image
+// The scanlines of a tile are compared with SIMD, and the comparison stops at
+// the first different scanline. The changed tiles are copied to prevImage.
+///////////////////////////////////////////////////////////////////////////////
+int DirtyTiles::detect(const unsigned char* image, unsigned char* prevImage)
+{
+    if(!image || !prevImage)
+        return 0;
+
+    int count = 0;
+    for(int i = 0; i < rows; ++i)
+    {
+        for(int j = 0; j < columns; ++j)
+        {
+            Rect rect = getTileRect(j, i);
+            if(isTileEqual(image, prevImage, rect))
+                continue;
+
+            // update the previous image with the changed tile
+            std::size_t pitch = (std::size_t)width * bytesPerPixel;
+            std::size_t offset = rect.y * pitch + (std::size_t)rect.x * bytesPerPixel;
+            for(int k = 0; k < rect.height; ++k, offset += pitch)
+                memcpy(prevImage + offset, image + offset, (std::size_t)rect.width * bytesPerPixel);
+
+            flags[i * columns + j] = 1;
+            ++count;
+        }
+    }
+    if(count > 0)
+        rectsUpdated = false;
+    return count;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// merge dirty tiles to rectangles
+// The runs of dirty tiles in each tile row are extended downward if the
+// previous tile row has a rectangle of the same columns.
+///////////////////////////////////////////////////////////////////////////////
+const std::vector<DirtyTiles::Rect>& DirtyTiles::getRects()
+{
+    if(rectsUpdated)
+        return rects;
+
+    rects.clear();
+    std::vector<int> prevIndices;               // rects ending at the previous tile row
+    std::vector<int> currIndices;               // rects ending at the current tile row
+    for(int i = 0; i < rows; ++i)
+    {
+        currIndices.clear();
+        int j = 0;
+        while(j < columns)
+        {
+            if(!flags[i * columns + j])
+            {
+                ++j;
+                continue;
+            }
+
+            // find a run of dirty tiles
+            int first = j;
+            while(j < columns && flags[i * columns + j])
+                ++j;
+            Rect rect1 = getTileRect(first, i);
+            Rect rect2 = getTileRect(j - 1, i);
+            Rect run = {rect1.x, rect1.y, rect2.x + rect2.width - rect1.x, rect1.height};
+
+            // extend the rectangle of the same columns in the previous tile row
+            int index = -1;
+            for(std::size_t k = 0; k < prevIndices.size(); ++k)
+            {
+                const Rect& rect = rects[prevIndices[k]];
+                if(rect.x == run.x && rect.width == run.width)
+                {
+                    index = prevIndices[k];
+                    break;
+                }
+            }
+            if(index >= 0)
+            {
+                rects[index].height += run.height;
+            }
+            else
+            {
+                index = (int)rects.size();
+                rects.push_back(run);
+            }
+            currIndices.push_back(index);
+        }
+        prevIndices.swap(currIndices);
+    }
+
+    rectsUpdated = true;
+    return rects;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// copy the dirty rectangles from src to dst, both have the layout of image
+///////////////////////////////////////////////////////////////////////////////
+void DirtyTiles::copyRects(const unsigned char* src, unsigned char* dst, bool nonTemporal)
+{
+    if(!src || !dst || src == dst)
+        return;
+
+    const std::vector<Rect>& rects = getRects();
+    std::size_t pitch = (std::size_t)width * bytesPerPixel;
+    for(std::size_t i = 0; i < rects.size(); ++i)
+    {
+        const Rect& rect = rects[i];
+        std::size_t size = (std::size_t)rect.width * bytesPerPixel;
+        std::size_t offset = rect.y * pitch + (std::size_t)rect.x * bytesPerPixel;
+
+        // a rectangle of full scanlines is a contiguous block
+        if(rect.width == width)
+        {
+            Pixel::copyPixels(dst + offset, src + offset, size * rect.height, nonTemporal);
+            continue;
+        }
+        for(int j = 0; j < rect.height; ++j, offset += pitch)
+            Pixel::copyPixels(dst + offset, src + offset, size, nonTemporal);
+    }
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// return the number of dirty tiles
+///////////////////////////////////////////////////////////////////////////////
+int DirtyTiles::getDirtyCount() const
+{
+    return (int)std::count(flags.begin(), flags.end(), 1);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// return the bytes of the dirty rectangles, the size of uploading data
+///////////////////////////////////////////////////////////////////////////////
+long long DirtyTiles::getDirtyBytes()
+{
+    const std::vector<Rect>& rects = getRects();
+    long long bytes = 0;
+    for(std::size_t i = 0; i < rects.size(); ++i)
+        bytes += (long long)rects[i].width * rects[i].height * bytesPerPixel;
+    return bytes;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// compare the scanlines of a tile, stop at the first different scanline
+///////////////////////////////////////////////////////////////////////////////
+bool DirtyTiles::isTileEqual(const unsigned char* image1, const unsigned char* image2, const Rect& rect) const
+{
+    std::size_t pitch = (std::size_t)width * bytesPerPixel;
+    std::size_t size = (std::size_t)rect.width * bytesPerPixel;
+    std::size_t offset = rect.y * pitch + (std::size_t)rect.x * bytesPerPixel;
+    for(int i = 0; i < rect.height; ++i, offset += pitch)
+    {
+        if(!Pixel::isEqual(image1 + offset, image2 + offset, size))
+            return false;
+    }
+    return true;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// return the rectangle of a tile, clipped by the image
+///////////////////////////////////////////////////////////////////////////////
+DirtyTiles::Rect DirtyTiles::getTileRect(int column, int row) const
+{
+    Rect rect;
+    rect.x = column * tileSize;
+    rect.y = row * tileSize;
+    rect.width = std::min(tileSize, width - rect.x);
+    rect.height = std::min(tileSize, height - rect.y);
+    return rect;
+}
@@ -0,0 +1,93 @@
+///////////////////////////////////////////////////////////////////////////////
+// DirtyTiles.h
+// ============
+// Change tracker of an image divided into square tiles
+// The producer marks the changed area with markRect(), or detect() compares
+// the image with the previous frame to find the changed tiles. getRects()
+// merges the dirty tiles into rectangles, the adjacent tiles in a tile row
+// first, then the rectangles of the same columns in the next tile rows, so a
+// fully changed image becomes a single rectangle.
+//
+// The rectangles keep the layout of the source image, so they can be uploaded
+// from the image (or a PBO of the same layout) with GL_UNPACK_ROW_LENGTH,
+// GL_UNPACK_SKIP_PIXELS and GL_UNPACK_SKIP_ROWS:
+//     tiles.markRect(x, y, w, h);
+//     tiles.copyRects(image, pboPtr);     // pack only dirty tiles into PBO
+//     glPixelStorei(GL_UNPACK_ROW_LENGTH, imageWidth);
+//     for each rect:
+//         glPixelStorei(GL_UNPACK_SKIP_PIXELS, rect.x);
+//         glPixelStorei(GL_UNPACK_SKIP_ROWS, rect.y);
+//         glTexSubImage2D(..., rect.x, rect.y, rect.width, rect.height, ..., 0);
+//     tiles.clear();
+//
+//  AUTHOR: Song Ho Ahn (song.ahn@gmail.com)
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef DIRTY_TILES_H
+#define DIRTY_TILES_H
+
+#include <vector>
+
+class DirtyTiles
+{
+public:
+    // rectangle in pixels
+    struct Rect
+    {
+        int x;
+        int y;
+        int width;
+        int height;
+    };
+
+    // ctor/dtor
+    DirtyTiles();
+    ~DirtyTiles() {}
+
+    // set the image size and tile size, all tiles are clean
+    void init(int width, int height, int tileSize, int bytesPerPixel);
+
+    void markAll();
+    void markRect(int x, int y, int width, int height);   // mark the tiles overlapping the rect
+    void clear();                                           // all tiles are clean
+
+    // compare each tile with the previous image, then mark the changed tiles
+    // and copy them to prevImage, so prevImage becomes the same as image.
+    // It returns the number of the changed tiles.
+    int detect(const unsigned char* image, unsigned char* prevImage);
+
+    // merge dirty tiles to rectangles
+    const std::vector<Rect>& getRects();
+
+    // copy the pixels of the rectangles from src to dst of the same layout
+    // nonTemporal uses streaming stores for write-combined memory, e.g., PBO
+    void copyRects(const unsigned char* src, unsigned char* dst, bool nonTemporal=false);
+
+    // getters
+    int getTileSize() const                     { return tileSize; }
+    int getTileCount() const                    { return (int)flags.size(); }
+    int getDirtyCount() const;                  // # of dirty tiles
+    long long getDirtyBytes();                  // bytes of the dirty rectangles
+
+protected:
+
+private:
+    // member functions
+    bool isTileEqual(const unsigned char* image1, const unsigned char* image2, const Rect& rect) const;
+    Rect getTileRect(int column, int row) const;
+
+    // member variables
+    std::vector<unsigned char> flags;           // 1 if the tile is dirty
+    std::vector<Rect> rects;                    // merged dirty rectangles
+    bool rectsUpdated;                          // rects match flags
+    int width;
+    int height;
+    int tileSize;
+    int bytesPerPixel;
+    int columns;                                // # of tiles in a row
+    int rows;                                   // # of tiles in a column
+};
+
+#endif // DIRTY_TILES_H
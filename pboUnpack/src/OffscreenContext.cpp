@@ -0,0 +1,185 @@
+///////////////////////////////////////////////////////////////////////////////
+// OffscreenContext.cpp
+// ====================
+// OpenGL context without window for the headless benchmark mode
+//
+//  AUTHOR: Song Ho Ahn (song.ahn@gmail.com)
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#include "OffscreenContext.h"
+
+#ifdef __linux__
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#include <cstring>
+#endif
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// ctor/dtor
+///////////////////////////////////////////////////////////////////////////////
+OffscreenContext::OffscreenContext() : display(0), surface(0), context(0), fboId(0),
+                                       width(0), height(0)
+{
+    rboIds[0] = rboIds[1] = 0;
+}
+
+OffscreenContext::~OffscreenContext()
+{
+    destroy();
+}
+
+
+
+#ifdef __linux__ //=============================================================
+///////////////////////////////////////////////////////////////////////////////
+// create EGL context for desktop OpenGL
+// It prefers the surfaceless platform of Mesa, so no X server is required.
+///////////////////////////////////////////////////////////////////////////////
+bool OffscreenContext::create(int width, int height)
+{
+    destroy();
+    this->width = width;
+    this->height = height;
+
+    // get display, surfaceless platform first
+    EGLDisplay dpy = EGL_NO_DISPLAY;
+    const char* clientExts = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+    PFNEGLGETPLATFORMDISPLAYEXTPROC getPlatformDisplay =
+        (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+    if(getPlatformDisplay && clientExts && strstr(clientExts, "EGL_MESA_platform_surfaceless"))
+        dpy = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, 0);
+    if(dpy == EGL_NO_DISPLAY)
+        dpy = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+
+    EGLint major, minor;
+    if(dpy == EGL_NO_DISPLAY || !eglInitialize(dpy, &major, &minor))
+    {
+        errorMessage = "Failed to initialize EGL display.";
+        return false;
+    }
+    display = dpy;
+
+    if(!eglBindAPI(EGL_OPENGL_API))
+    {
+        errorMessage = "EGL does not support desktop OpenGL.";
+        destroy();
+        return false;
+    }
+
+    // choose config for a small pbuffer, the rendering goes to FBO
+    const EGLint configAttribs[] = {
+        EGL_SURFACE_TYPE,    EGL_PBUFFER_BIT,
+        EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+        EGL_NONE
+    };
+    EGLConfig config = 0;
+    EGLint configCount = 0;
+    eglChooseConfig(dpy, configAttribs, &config, 1, &configCount);
+
+    // compatibility profile context, the samples use the fixed pipeline
+    EGLContext ctx = eglCreateContext(dpy, (configCount > 0) ? config : 0, EGL_NO_CONTEXT, 0);
+    if(ctx == EGL_NO_CONTEXT)
+    {
+        errorMessage = "Failed to create EGL context.";
+        destroy();
+        return false;
+    }
+    context = ctx;
+
+    // make current without surface, or with 1x1 pbuffer
+    const char* displayExts = eglQueryString(dpy, EGL_EXTENSIONS);
+    bool surfaceless = displayExts && strstr(displayExts, "EGL_KHR_surfaceless_context");
+    if(!surfaceless && configCount > 0)
+    {
+        const EGLint pbufferAttribs[] = {EGL_WIDTH, 1, EGL_HEIGHT, 1, EGL_NONE};
+        EGLSurface pbuffer = eglCreatePbufferSurface(dpy, config, pbufferAttribs);
+        if(pbuffer != EGL_NO_SURFACE)
+            surface = pbuffer;
+    }
+    if(!eglMakeCurrent(dpy, (EGLSurface)surface, (EGLSurface)surface, ctx))
+    {
+        errorMessage = "Failed to make EGL context current.";
+        destroy();
+        return false;
+    }
+
+    return createFramebuffer();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// delete FBO and EGL objects
+///////////////////////////////////////////////////////////////////////////////
+void OffscreenContext::destroy()
+{
+    if(context)
+    {
+        if(fboId)
+        {
+            glBindFramebuffer(GL_FRAMEBUFFER, 0);
+            glDeleteFramebuffers(1, &fboId);
+            glDeleteRenderbuffers(2, rboIds);
+            fboId = rboIds[0] = rboIds[1] = 0;
+        }
+        eglMakeCurrent((EGLDisplay)display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        eglDestroyContext((EGLDisplay)display, (EGLContext)context);
+        context = 0;
+    }
+    if(surface)
+    {
+        eglDestroySurface((EGLDisplay)display, (EGLSurface)surface);
+        surface = 0;
+    }
+    if(display)
+    {
+        eglTerminate((EGLDisplay)display);
+        display = 0;
+    }
+}
+
+#else //========================================================================
+bool OffscreenContext::create(int width, int height)
+{
+    errorMessage = "Headless mode is supported on Linux (EGL) only.";
+    return false;
+}
+
+void OffscreenContext::destroy()
+{
+}
+#endif //=======================================================================
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// create FBO with colour and depth renderbuffers, and bind it
+///////////////////////////////////////////////////////////////////////////////
+bool OffscreenContext::createFramebuffer()
+{
+    glGenRenderbuffers(2, rboIds);
+    glBindRenderbuffer(GL_RENDERBUFFER, rboIds[0]);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+    glBindRenderbuffer(GL_RENDERBUFFER, rboIds[1]);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, width, height);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    glGenFramebuffers(1, &fboId);
+    glBindFramebuffer(GL_FRAMEBUFFER, fboId);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, rboIds[0]);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, rboIds[1]);
+
+    if(glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+    {
+        errorMessage = "Framebuffer object is not complete.";
+        return false;
+    }
+
+    glReadBuffer(GL_COLOR_ATTACHMENT0);
+    glDrawBuffer(GL_COLOR_ATTACHMENT0);
+    return true;
+}
@@ -0,0 +1,113 @@
+///////////////////////////////////////////////////////////////////////////////
+// PboRing.h
+// =========
+// Ring of pixel buffer objects (PBO) with fence sync objects
+// A fence is inserted after the GL command reading from or writing to a PBO
+// (glReadPixels() for packing, glTexSubImage2D() for unpacking), so the PBO
+// is mapped only after the GPU has finished with it, instead of stalling in
+// glMapBuffer(). The depth of the ring is set at run-time; a deeper ring
+// hides more latency of the GPU, but the result is older by more frames.
+//
+// Packing (read-back):
+//     int i = ring.acquire();                 // bind the next PBO
+//     glReadPixels(..., 0);
+//     ring.fence(i);
+//     int j = ring.getLatestReady();          // the newest finished read, or -1
+//     if(j >= 0) { void* p = ring.map(j, GL_READ_ONLY); ...; ring.unmap(); }
+//
+// Unpacking (upload):
+//     int i = ring.acquire();                 // wait if the GPU still reads it
+//     void* p = ring.map(i, GL_WRITE_ONLY); ...; ring.unmap();
+//     ring.bind(i);
+//     glTexSubImage2D(..., 0);
+//     ring.fence(i);
+//
+// Packing every result in order (e.g., tiles of a large image):
+//     if(ring.getPendingCount() == ring.getCount())
+//         consume(ring.waitOldest());         // before acquire() discards it
+//     int i = ring.acquire(); glReadPixels(..., 0); ring.fence(i);
+//     ...
+//     while(ring.getPendingCount() > 0) consume(ring.waitOldest());
+//
+// If GL_ARB_sync is not supported, it works without fences; a PBO is regarded
+// as finished after the other PBOs in the ring are used.
+//
+//  AUTHOR: Song Ho Ahn (song.ahn@gmail.com)
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef PBO_RING_H
+#define PBO_RING_H
+
+#include <vector>
+#include "glExtension.h"
+
+class PboRing
+{
+public:
+    // ctor/dtor
+    PboRing();
+    ~PboRing();                                 // GL objects must be deleted by release()
+
+    // create PBOs of GL_PIXEL_PACK_BUFFER or GL_PIXEL_UNPACK_BUFFER
+    bool init(GLenum target, int count, GLsizeiptr size, GLenum usage);
+    void release();                             // delete PBOs and fences
+
+    // take the next PBO in the ring, and bind it
+    // If the GPU has not finished with it yet, it waits and adds the stall time.
+    int acquire();
+
+    // insert a fence after the GL command using the PBO
+    void fence(int index);
+
+    // return the newest PBO whose fence is signalled, or -1 (non-blocking)
+    // It frees the returned PBO and the older PBOs, and updates the latency.
+    int getLatestReady();
+
+    // return the oldest pending PBO after its fence is signalled (blocking),
+    // or -1 if no PBO is pending. It frees the returned PBO only.
+    int waitOldest();
+    int getPendingCount() const;
+
+    // bind/map
+    void bind(int index);
+    void unbind();
+    void* map(int index, GLenum access);        // bind and map
+    void unmap();                               // unmap and unbind
+
+    // getters
+    int getCount() const                        { return (int)slots.size(); }
+    GLuint getId(int index) const               { return slots[index].id; }
+    bool isSyncUsed() const                     { return syncUsed; }
+    int getLatency() const                      { return latency; }     // frames between fence and ready
+    double getStallTime() const                 { return stallTime; }   // ms waited since resetStallTime()
+    void resetStallTime()                       { stallTime = 0; }
+
+protected:
+
+private:
+    struct Slot
+    {
+        GLuint id;
+        GLsync sync;                            // fence of the last GL command
+        bool pending;                           // the GL command is not finished or the result is not used
+        int serial;                             // fence count at the fence
+    };
+
+    // member functions
+    bool isSignaled(Slot& slot);
+    void wait(Slot& slot);
+    void clearFence(Slot& slot);
+
+    // member variables
+    std::vector<Slot> slots;
+    GLenum target;
+    int head;                                   // next PBO to acquire
+    int fenceCount;
+    int latency;
+    double stallTime;
+    bool syncUsed;
+};
+
+#endif // PBO_RING_H
@@ -0,0 +1,178 @@
+///////////////////////////////////////////////////////////////////////////////
+// PersistentPbo.cpp
+// =================
+// Pixel buffer object mapped once for its lifetime, split into N regions
+//
+//  AUTHOR: Song Ho Ahn (song.ahn@gmail.com)
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#include "PersistentPbo.h"
+#include "Timer.h"
+
+// constants
+static const GLsizeiptr REGION_ALIGNMENT = 256;     // bytes, safe for any pixel format and cache line
+static const GLuint64 WAIT_TIMEOUT = 100000000;     // 100 ms in nanoseconds, per glClientWaitSync()
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// ctor/dtor
+///////////////////////////////////////////////////////////////////////////////
+PersistentPbo::PersistentPbo() : id(0), target(GL_PIXEL_UNPACK_BUFFER), pointer(0),
+                                 regionStride(0), head(0), stallTime(0)
+{
+}
+
+PersistentPbo::~PersistentPbo()
+{
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// persistent mapping needs immutable storage and fences
+///////////////////////////////////////////////////////////////////////////////
+bool PersistentPbo::isSupported()
+{
+    glExtension& ext = glExtension::getInstance();
+    return ext.isSupported("GL_ARB_buffer_storage") && ext.isSupported("GL_ARB_sync");
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// allocate immutable storage for all regions, and map it for the lifetime
+// COHERENT makes the CPU writes visible to GL without glFlushMappedBufferRange().
+///////////////////////////////////////////////////////////////////////////////
+bool PersistentPbo::init(GLenum target, int count, GLsizeiptr regionSize)
+{
+    release();
+    if(count < 1 || regionSize <= 0 || !isSupported())
+        return false;
+
+    this->target = target;
+    regionStride = (regionSize + REGION_ALIGNMENT - 1) / REGION_ALIGNMENT * REGION_ALIGNMENT;
+
+    GLbitfield access = (target == GL_PIXEL_PACK_BUFFER) ? GL_MAP_READ_BIT : GL_MAP_WRITE_BIT;
+    GLbitfield flags = access | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+    glGenBuffers(1, &id);
+    glBindBuffer(target, id);
+    glBufferStorage(target, regionStride * count, 0, flags);
+    pointer = glMapBufferRange(target, 0, regionStride * count, flags);
+    glBindBuffer(target, 0);
+    if(!pointer)
+    {
+        release();
+        return false;
+    }
+
+    syncs.assign(count, (GLsync)0);
+    head = 0;
+    stallTime = 0;
+    return true;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// unmap and delete the buffer
+///////////////////////////////////////////////////////////////////////////////
+void PersistentPbo::release()
+{
+    for(std::size_t i = 0; i < syncs.size(); ++i)
+    {
+        if(syncs[i])
+            glDeleteSync(syncs[i]);
+    }
+    syncs.clear();
+
+    if(id)
+    {
+        if(pointer)
+        {
+            glBindBuffer(target, id);
+            glUnmapBuffer(target);
+            glBindBuffer(target, 0);
+        }
+        glDeleteBuffers(1, &id);
+    }
+    id = 0;
+    pointer = 0;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// take the next region, the CPU can access it after this call
+///////////////////////////////////////////////////////////////////////////////
+int PersistentPbo::acquire()
+{
+    if(syncs.empty())
+        return -1;
+
+    int index = head;
+    head = (head + 1) % (int)syncs.size();
+    wait(index);
+    return index;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// insert a fence after the GL command reading/writing the region
+///////////////////////////////////////////////////////////////////////////////
+void PersistentPbo::fence(int index)
+{
+    if(syncs[index])
+        glDeleteSync(syncs[index]);
+    syncs[index] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// bind the buffer, then use getOffset() instead of pointer for GL commands
+///////////////////////////////////////////////////////////////////////////////
+void PersistentPbo::bind()
+{
+    glBindBuffer(target, id);
+}
+
+void PersistentPbo::unbind()
+{
+    glBindBuffer(target, 0);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// block until the fence of the region is signalled, and add the waiting time
+// The fence is checked first without waiting, so no time is added if the GPU
+// has already finished.
+///////////////////////////////////////////////////////////////////////////////
+void PersistentPbo::wait(int index)
+{
+    GLsync sync = syncs[index];
+    if(!sync)
+        return;
+
+    GLenum result = glClientWaitSync(sync, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+    if(result == GL_TIMEOUT_EXPIRED)
+    {
+        Timer timer;
+        timer.start();
+        do
+        {
+            result = glClientWaitSync(sync, GL_SYNC_FLUSH_COMMANDS_BIT, WAIT_TIMEOUT);
+        }
+        while(result == GL_TIMEOUT_EXPIRED);
+        timer.stop();
+        stallTime += timer.getElapsedTimeInMilliSec();
+    }
+
+    glDeleteSync(sync);
+    syncs[index] = 0;
+}
@@ -0,0 +1,77 @@
+///////////////////////////////////////////////////////////////////////////////
+// PersistentPbo.h
+// ===============
+// Pixel buffer object mapped once for its lifetime, split into N regions
+// The buffer is allocated by glBufferStorage() with GL_MAP_PERSISTENT_BIT and
+// GL_MAP_COHERENT_BIT, and mapped by glMapBufferRange() only once, so there
+// is no driver allocation (orphaning) or map/unmap per frame. The CPU writes
+// a region while the GPU reads the others, and a fence per region prevents
+// the CPU from overwriting a region that the GPU has not finished reading.
+//
+// Unpacking (upload):
+//     int i = pbo.acquire();                  // wait if the GPU still reads it
+//     write pixels to pbo.getPointer(i)
+//     pbo.bind();
+//     glTexSubImage2D(..., (GLvoid*)pbo.getOffset(i));
+//     pbo.fence(i);
+//
+// It requires GL_ARB_buffer_storage (OpenGL 4.4) and GL_ARB_sync.
+//
+//  AUTHOR: Song Ho Ahn (song.ahn@gmail.com)
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef PERSISTENT_PBO_H
+#define PERSISTENT_PBO_H
+
+#include <vector>
+#include "glExtension.h"
+
+class PersistentPbo
+{
+public:
+    // ctor/dtor
+    PersistentPbo();
+    ~PersistentPbo();                           // GL objects must be deleted by release()
+
+    static bool isSupported();                  // check GL_ARB_buffer_storage and GL_ARB_sync
+
+    // create a buffer of count regions of GL_PIXEL_UNPACK_BUFFER or GL_PIXEL_PACK_BUFFER, and map it
+    bool init(GLenum target, int count, GLsizeiptr regionSize);
+    void release();                             // unmap and delete the buffer and fences
+
+    // take the next region, and wait for its fence if the GPU still uses it
+    int acquire();
+
+    // insert a fence after the GL command using the region
+    void fence(int index);
+
+    void bind();
+    void unbind();
+
+    // getters
+    int getCount() const                        { return (int)syncs.size(); }
+    GLuint getId() const                        { return id; }
+    void* getPointer(int index) const           { return (char*)pointer + getOffset(index); }
+    GLintptr getOffset(int index) const         { return (GLintptr)index * regionStride; }
+    double getStallTime() const                 { return stallTime; }   // ms waited since resetStallTime()
+    void resetStallTime()                       { stallTime = 0; }
+
+protected:
+
+private:
+    // member functions
+    void wait(int index);
+
+    // member variables
+    std::vector<GLsync> syncs;                  // fence per region
+    GLuint id;
+    GLenum target;
+    void* pointer;                              // persistently mapped address of the buffer
+    GLsizeiptr regionStride;                    // region size aligned
+    int head;                                   // next region to acquire
+    double stallTime;
+};
+
+#endif // PERSISTENT_PBO_H
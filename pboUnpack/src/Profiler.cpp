@@ -0,0 +1,450 @@
+///////////////////////////////////////////////////////////////////////////////
+// Profiler.cpp
+// ============
+// Frame profiler with nested CPU zones, GPU timer queries and Chrome trace
+//
+//  AUTHOR: Song Ho Ahn (song.ahn@gmail.com)
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <cstring>
+#include "Profiler.h"
+#include "Timer.h"
+
+// constants
+static const unsigned int RING_SIZE = 4096;         // zones per thread between newFrame(), power of 2
+static const std::size_t MAX_TRACE_EVENTS = 1 << 20;// 32 MB, the rest is dropped
+static const int GPU_QUERY_COUNT = 64;              // GPU zones in flight, about 4 frames
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// ctor/dtor
+///////////////////////////////////////////////////////////////////////////////
+Profiler::Profiler() : enabled(true), startTime(Timer::getNanoTime()), droppedTraceCount(0),
+                       frameCount(0), mainThreadId(0), gpuReady(false), gpuActive(false)
+{
+}
+
+Profiler::~Profiler()
+{
+    for(std::size_t i = 0; i < rings.size(); ++i)
+        delete rings[i];
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// return the single instance, created at the first call
+// It is never destroyed, so the zones in atexit() handlers and the worker
+// threads still running at exit do not touch a destroyed object.
+///////////////////////////////////////////////////////////////////////////////
+Profiler& Profiler::getInstance()
+{
+    static Profiler* self = new Profiler();
+    return *self;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// create the pool of GL_TIME_ELAPSED queries
+///////////////////////////////////////////////////////////////////////////////
+bool Profiler::initGpu()
+{
+    releaseGpu();
+
+    glExtension& ext = glExtension::getInstance();
+    if(!ext.isSupported("GL_ARB_timer_query"))
+        return false;
+
+    std::vector<GLuint> ids(GPU_QUERY_COUNT);
+    glGenQueries(GPU_QUERY_COUNT, &ids[0]);
+    gpuQueries.resize(GPU_QUERY_COUNT);
+    for(int i = 0; i < GPU_QUERY_COUNT; ++i)
+    {
+        gpuQueries[i].id = ids[i];
+        gpuQueries[i].name = 0;
+        gpuQueries[i].begin = 0;
+        freeQueries.push_back(GPU_QUERY_COUNT - 1 - i);
+    }
+    gpuReady = true;
+    return true;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// delete the queries, the pending results are discarded
+///////////////////////////////////////////////////////////////////////////////
+void Profiler::releaseGpu()
+{
+    for(std::size_t i = 0; i < gpuQueries.size(); ++i)
+        glDeleteQueries(1, &gpuQueries[i].id);
+    gpuQueries.clear();
+    freeQueries.clear();
+    pendingQueries.clear();
+    gpuReady = gpuActive = false;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// collect the zones of the previous frame, and add a frame marker
+///////////////////////////////////////////////////////////////////////////////
+void Profiler::newFrame()
+{
+    if(mainThreadId == 0)
+        mainThreadId = getThreadRing()->threadId;
+
+    collect();
+    if(gpuReady)
+        readGpuQueries();
+
+    if(traceEvents.size() < MAX_TRACE_EVENTS)
+        frameTimes.push_back(Timer::getNanoTime() - startTime);
+    ++frameCount;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// drain the rings and clear the trace and stats
+// The queries in flight are kept, their results are added after reset.
+///////////////////////////////////////////////////////////////////////////////
+void Profiler::reset()
+{
+    collect();
+    traceEvents.clear();
+    frameTimes.clear();
+    zoneStats.clear();
+    droppedTraceCount = 0;
+    frameCount = 0;
+
+    std::lock_guard<std::mutex> lock(ringMutex);
+    for(std::size_t i = 0; i < rings.size(); ++i)
+        rings[i]->droppedCount.store(0, std::memory_order_relaxed);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// return the total # of zones not in the trace
+///////////////////////////////////////////////////////////////////////////////
+long long Profiler::getDroppedCount() const
+{
+    std::lock_guard<std::mutex> lock(ringMutex);
+    long long count = droppedTraceCount;
+    for(std::size_t i = 0; i < rings.size(); ++i)
+        count += rings[i]->droppedCount.load(std::memory_order_relaxed);
+    return count;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// write the trace in Chrome trace event format
+// The zones are complete events ("ph":"X") in micro-seconds, and each frame
+// is a global instant event ("ph":"i"). The threads are named with metadata.
+///////////////////////////////////////////////////////////////////////////////
+bool Profiler::writeTrace(const std::string& fileName)
+{
+    collect();
+
+    std::ofstream file(fileName.c_str());
+    if(!file)
+        return false;
+
+    file << std::fixed << std::setprecision(3);
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    file << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"Profiler\"}}";
+    if(gpuReady)
+        file << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"GPU\"}}";
+    {
+        std::lock_guard<std::mutex> lock(ringMutex);
+        for(std::size_t i = 0; i < rings.size(); ++i)
+        {
+            int tid = rings[i]->threadId;
+            file << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << tid
+                 << ",\"args\":{\"name\":\"";
+            if(tid == mainThreadId)
+                file << "main";
+            else
+                file << "thread " << tid;
+            file << "\"}}";
+        }
+    }
+
+    for(std::size_t i = 0; i < frameTimes.size(); ++i)
+    {
+        file << ",\n{\"name\":\"frame " << i << "\",\"ph\":\"i\",\"s\":\"g\",\"pid\":1,\"tid\":" << mainThreadId << ",\"ts\":"
+             << frameTimes[i] * 0.001 << "}";
+    }
+
+    for(std::size_t i = 0; i < traceEvents.size(); ++i)
+    {
+        const TraceEvent& e = traceEvents[i];
+        file << ",\n{\"name\":\"" << e.name << "\",\"cat\":\"" << ((e.threadId == 0) ? "gpu" : "cpu")
+             << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << e.threadId
+             << ",\"ts\":" << e.begin * 0.001 << ",\"dur\":" << e.duration * 0.001 << "}";
+    }
+    file << "\n]}\n";
+
+    return (bool)file;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// print count, mean and max of each zone
+///////////////////////////////////////////////////////////////////////////////
+void Profiler::printSummary()
+{
+    collect();
+
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "Zone                    Count   CPU Mean    CPU Max   GPU Mean (ms)\n";
+    for(std::size_t i = 0; i < zoneStats.size(); ++i)
+    {
+        const ZoneStats& s = zoneStats[i];
+        std::cout << std::left << std::setw(20) << s.name << std::right << std::setw(9) << s.count
+                  << std::setw(11) << (s.count > 0 ? s.totalTime / s.count : 0.0)
+                  << std::setw(11) << s.maxTime << std::setw(11);
+        if(s.gpuCount > 0)
+            std::cout << s.gpuTotalTime / s.gpuCount;
+        else
+            std::cout << "-";
+        std::cout << "\n";
+    }
+    std::cout << "Frames: " << frameCount << ", dropped zones: " << getDroppedCount() << "\n";
+    std::cout << std::resetiosflags(std::ios_base::fixed | std::ios_base::floatfield) << std::flush;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// return the ring of the calling thread, register a new ring at first call
+// The rings are owned by Profiler, and live after the thread exits.
+///////////////////////////////////////////////////////////////////////////////
+Profiler::ThreadRing* Profiler::getThreadRing()
+{
+    static thread_local ThreadRing* ring = 0;
+    if(!ring)
+    {
+        ring = new ThreadRing();
+        ring->events.resize(RING_SIZE);
+        ring->head.store(0, std::memory_order_relaxed);
+        ring->tail.store(0, std::memory_order_relaxed);
+        ring->droppedCount.store(0, std::memory_order_relaxed);
+
+        std::lock_guard<std::mutex> lock(ringMutex);
+        ring->threadId = (int)rings.size() + 1;
+        rings.push_back(ring);
+    }
+    return ring;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// write a zone to the ring of the calling thread, drop it if full
+///////////////////////////////////////////////////////////////////////////////
+void Profiler::addEvent(const char* name, long long begin, long long end)
+{
+    ThreadRing* ring = getThreadRing();
+    unsigned int head = ring->head.load(std::memory_order_relaxed);
+    unsigned int tail = ring->tail.load(std::memory_order_acquire);
+    if(head - tail >= RING_SIZE)
+    {
+        ring->droppedCount.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    Event& e = ring->events[head & (RING_SIZE - 1)];
+    e.name = name;
+    e.begin = begin;
+    e.end = end;
+    ring->head.store(head + 1, std::memory_order_release);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// move the zones of all rings to the trace and stats
+// The ring list is locked only to iterate; the producers never take the lock
+// except for the first zone of a thread.
+///////////////////////////////////////////////////////////////////////////////
+void Profiler::collect()
+{
+    std::lock_guard<std::mutex> lock(ringMutex);
+    for(std::size_t i = 0; i < rings.size(); ++i)
+    {
+        ThreadRing* ring = rings[i];
+        unsigned int head = ring->head.load(std::memory_order_acquire);
+        unsigned int tail = ring->tail.load(std::memory_order_relaxed);
+        for(; tail != head; ++tail)
+        {
+            const Event& e = ring->events[tail & (RING_SIZE - 1)];
+            long long duration = e.end - e.begin;
+            ZoneStats& s = getZoneStats(e.name);
+            double ms = duration * 0.000001;
+            ++s.count;
+            s.totalTime += ms;
+            if(ms > s.maxTime)
+                s.maxTime = ms;
+            addTraceEvent(e.name, e.begin - startTime, duration, ring->threadId);
+        }
+        ring->tail.store(tail, std::memory_order_release);
+    }
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// begin a GL_TIME_ELAPSED query, return -1 if nested or no free query
+///////////////////////////////////////////////////////////////////////////////
+int Profiler::beginGpuQuery()
+{
+    if(!gpuReady || gpuActive || freeQueries.empty())
+        return -1;
+
+    int index = freeQueries.back();
+    freeQueries.pop_back();
+    glBeginQuery(GL_TIME_ELAPSED, gpuQueries[index].id);
+    gpuActive = true;
+    return index;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// end the query, the result is read by newFrame() later
+///////////////////////////////////////////////////////////////////////////////
+void Profiler::endGpuQuery(int index, const char* name, long long begin)
+{
+    glEndQuery(GL_TIME_ELAPSED);
+    gpuActive = false;
+    gpuQueries[index].name = name;
+    gpuQueries[index].begin = begin;
+    pendingQueries.push_back(index);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// read the results of the finished queries without waiting
+// The queries finish in order, so stop at the first unfinished one.
+///////////////////////////////////////////////////////////////////////////////
+void Profiler::readGpuQueries()
+{
+    long long now = Timer::getNanoTime();
+    std::size_t count = 0;
+    for(; count < pendingQueries.size(); ++count)
+    {
+        GpuQuery& query = gpuQueries[pendingQueries[count]];
+        GLint available = 0;
+        glGetQueryObjectiv(query.id, GL_QUERY_RESULT_AVAILABLE, &available);
+        if(!available)
+            break;
+
+        // the GPU time cannot be longer than the time since the zone began,
+        // some drivers return garbage for the first query of the context
+        GLuint64 elapsed = 0;
+        glGetQueryObjectui64v(query.id, GL_QUERY_RESULT, &elapsed);
+        if((long long)elapsed <= now - query.begin)
+        {
+            ZoneStats& s = getZoneStats(query.name);
+            ++s.gpuCount;
+            s.gpuTotalTime += elapsed * 0.000001;
+            addTraceEvent(query.name, query.begin - startTime, (long long)elapsed, 0);
+        }
+        freeQueries.push_back(pendingQueries[count]);
+    }
+    pendingQueries.erase(pendingQueries.begin(), pendingQueries.begin() + count);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// append an event to the trace, or count it if the trace is full
+///////////////////////////////////////////////////////////////////////////////
+void Profiler::addTraceEvent(const char* name, long long begin, long long duration, int threadId)
+{
+    if(traceEvents.size() >= MAX_TRACE_EVENTS)
+    {
+        ++droppedTraceCount;
+        return;
+    }
+    TraceEvent e = {name, begin, duration, threadId};
+    traceEvents.push_back(e);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// find the stats of the zone, or add new one
+// The same literal may have different addresses in different files, so the
+// strings are compared if the pointers differ.
+///////////////////////////////////////////////////////////////////////////////
+Profiler::ZoneStats& Profiler::getZoneStats(const char* name)
+{
+    for(std::size_t i = 0; i < zoneStats.size(); ++i)
+    {
+        if(zoneStats[i].name == name || strcmp(zoneStats[i].name, name) == 0)
+            return zoneStats[i];
+    }
+    ZoneStats s = {name, 0, 0, 0, 0, 0};
+    zoneStats.push_back(s);
+    return zoneStats.back();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// CPU zone
+///////////////////////////////////////////////////////////////////////////////
+Profiler::CpuZone::CpuZone(const char* name) : name(0), begin(0)
+{
+    if(Profiler::getInstance().isEnabled())
+    {
+        this->name = name;
+        begin = Timer::getNanoTime();
+    }
+}
+
+Profiler::CpuZone::~CpuZone()
+{
+    if(name)
+        Profiler::getInstance().addEvent(name, begin, Timer::getNanoTime());
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// GPU zone, also measured on CPU
+///////////////////////////////////////////////////////////////////////////////
+Profiler::GpuZone::GpuZone(const char* name) : name(0), begin(0), query(-1)
+{
+    Profiler& profiler = Profiler::getInstance();
+    if(profiler.isEnabled())
+    {
+        this->name = name;
+        begin = Timer::getNanoTime();
+        query = profiler.beginGpuQuery();
+    }
+}
+
+Profiler::GpuZone::~GpuZone()
+{
+    if(!name)
+        return;
+
+    Profiler& profiler = Profiler::getInstance();
+    if(query >= 0)
+        profiler.endGpuQuery(query, name, begin);
+    profiler.addEvent(name, begin, Timer::getNanoTime());
+}
@@ -0,0 +1,179 @@
+///////////////////////////////////////////////////////////////////////////////
+// TimingStats.cpp
+// ===============
+// Named accumulators of timings with rolling statistics
+//
+//  AUTHOR: Song Ho Ahn (song.ahn@gmail.com)
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include "TimingStats.h"
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// ctor
+///////////////////////////////////////////////////////////////////////////////
+TimingStats::TimingStats(int windowSize) : windowSize(windowSize > 0 ? windowSize : 1)
+{
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// add a sample in ms, the oldest sample is overwritten if the window is full
+///////////////////////////////////////////////////////////////////////////////
+void TimingStats::add(const std::string& name, double ms)
+{
+    int index;
+    std::map<std::string, int>::const_iterator it = indices.find(name);
+    if(it != indices.end())
+    {
+        index = it->second;
+    }
+    else
+    {
+        index = (int)accumulators.size();
+        indices[name] = index;
+        names.push_back(name);
+        accumulators.push_back(Accumulator());
+        accumulators.back().samples.reserve(windowSize);
+        accumulators.back().next = 0;
+        accumulators.back().totalCount = 0;
+    }
+
+    Accumulator& acc = accumulators[index];
+    if((int)acc.samples.size() < windowSize)
+        acc.samples.push_back((float)ms);
+    else
+        acc.samples[acc.next] = (float)ms;
+    acc.next = (acc.next + 1) % windowSize;
+    acc.last = ms;
+    ++acc.totalCount;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// remove all accumulators and samples
+///////////////////////////////////////////////////////////////////////////////
+void TimingStats::reset()
+{
+    names.clear();
+    accumulators.clear();
+    indices.clear();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// compute the statistics of the window
+// The window is copied and sorted, it is cheap for a few hundred samples.
+///////////////////////////////////////////////////////////////////////////////
+bool TimingStats::getSummary(const std::string& name, Summary& summary) const
+{
+    std::map<std::string, int>::const_iterator it = indices.find(name);
+    if(it == indices.end())
+        return false;
+
+    const Accumulator& acc = accumulators[it->second];
+    std::vector<double> values(acc.samples.begin(), acc.samples.end());
+    std::sort(values.begin(), values.end());
+
+    double sum = 0;
+    for(std::size_t i = 0; i < values.size(); ++i)
+        sum += values[i];
+
+    summary.count = (int)values.size();
+    summary.totalCount = acc.totalCount;
+    summary.last = acc.last;
+    summary.min = values.front();
+    summary.mean = sum / values.size();
+    summary.p50 = computePercentile(values, 50);
+    summary.p95 = computePercentile(values, 95);
+    summary.p99 = computePercentile(values, 99);
+    summary.max = values.back();
+    return true;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// format the percentiles of name for a line of the overlay
+///////////////////////////////////////////////////////////////////////////////
+std::string TimingStats::formatSummary(const std::string& name, int precision) const
+{
+    Summary s;
+    if(!getSummary(name, s))
+        return "-";
+
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(precision)
+        << "p50 " << s.p50 << " / p95 " << s.p95 << " / p99 " << s.p99 << " ms";
+    return oss.str();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// write the summary of all accumulators to CSV file
+///////////////////////////////////////////////////////////////////////////////
+bool TimingStats::writeCsv(const std::string& fileName) const
+{
+    std::ofstream file(fileName.c_str());
+    if(!file)
+        return false;
+
+    file << "name,count,total,last,min,mean,p50,p95,p99,max\n";
+    file << std::fixed << std::setprecision(4);
+    for(std::size_t i = 0; i < names.size(); ++i)
+    {
+        Summary s;
+        getSummary(names[i], s);
+        file << names[i] << "," << s.count << "," << s.totalCount << "," << s.last << ","
+             << s.min << "," << s.mean << "," << s.p50 << "," << s.p95 << "," << s.p99 << ","
+             << s.max << "\n";
+    }
+    return (bool)file;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// return the percentile of sorted values with linear interpolation between
+// ranks, also used by the benchmark report
+///////////////////////////////////////////////////////////////////////////////
+double TimingStats::computePercentile(const std::vector<double>& sortedValues, double percent)
+{
+    if(sortedValues.empty())
+        return 0;
+
+    double rank = percent / 100.0 * (sortedValues.size() - 1);
+    if(rank <= 0)
+        return sortedValues.front();
+    if(rank >= sortedValues.size() - 1)
+        return sortedValues.back();
+
+    std::size_t lower = (std::size_t)rank;
+    double fraction = rank - lower;
+    return sortedValues[lower] + (sortedValues[lower + 1] - sortedValues[lower]) * fraction;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// add the elapsed time of the scope
+///////////////////////////////////////////////////////////////////////////////
+ScopedTimer::~ScopedTimer()
+{
+    timer.stop();
+    double ms = timer.getElapsedTimeInMilliSec();
+    stats.add(name, ms);
+    if(result)
+        *result = (float)ms;
+}
@@ -0,0 +1,983 @@
+///////////////////////////////////////////////////////////////////////////////
+// formatUtils.cpp
+// ===============
+// Pixel format conversions between the image in memory and the data in PBO
+//
+//  AUTHOR: Song Ho Ahn (song.ahn@gmail.com)
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cmath>                        // for pow(), floor(), lrintf()
+#include <cstring>                      // for memcpy(), strcmp()
+#include "formatUtils.h"
+#include "pixelUtils.h"                 // SIMD level and PIXEL_TARGET
+
+#ifdef PIXEL_X86
+#include <immintrin.h>
+#endif
+
+
+
+namespace Format
+{
+// constants
+static const int LINEAR_BITS = 12;                                  // index bits of linear to sRGB table
+static const int LINEAR_SIZE = 1 << LINEAR_BITS;
+
+// names of Type
+static const char* TYPE_NAMES[] = { "bgra", "rgba", "rgb565", "rgba4444", "red" };
+static const int TYPE_COUNT = sizeof(TYPE_NAMES) / sizeof(TYPE_NAMES[0]);
+
+// lookup tables of sRGB, built at the first use
+// The entries are 32-bit for AVX2 gather.
+struct Tables
+{
+    unsigned int toLinear[256];                 // sRGB 8-bit to linear 16-bit
+    unsigned int toSrgb[LINEAR_SIZE];           // linear 16-bit >> 4 to sRGB 8-bit
+
+    Tables()
+    {
+        for(int i = 0; i < 256; ++i)
+        {
+            double c = i / 255.0;
+            double l = (c <= 0.04045) ? c / 12.92 : pow((c + 0.055) / 1.055, 2.4);
+            toLinear[i] = (unsigned int)floor(l * 65535 + 0.5);
+        }
+        // each entry is the centre of 16 linear values
+        for(int i = 0; i < LINEAR_SIZE; ++i)
+        {
+            double l = (i * 16 + 7.5) / 65535.0;
+            double c = (l <= 0.0031308) ? l * 12.92 : 1.055 * pow(l, 1 / 2.4) - 0.055;
+            toSrgb[i] = (unsigned int)floor(c * 255 + 0.5);
+        }
+    }
+};
+
+static const Tables& getTables()
+{
+    static const Tables tables;                 // thread-safe initialization
+    return tables;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// plain C++ kernels
+// The packed formats are computed from the pixel as a 32-bit word of BGRA,
+// which is 0xAARRGGBB in little-endian. RGBA is swapped to BGRA first.
+///////////////////////////////////////////////////////////////////////////////
+static inline unsigned int swapWord(unsigned int p)
+{
+    return (p & 0xff00ff00) | ((p >> 16) & 0xff) | ((p & 0xff) << 16);
+}
+
+static void swapRedBlue1(const unsigned char* src, unsigned char* dst, std::size_t count)
+{
+    unsigned int p;
+    for(std::size_t i = 0; i < count; ++i, src += 4, dst += 4)
+    {
+        memcpy(&p, src, 4);
+        p = swapWord(p);
+        memcpy(dst, &p, 4);
+    }
+}
+
+static void packRgb5651(const unsigned char* src, bool bgra, unsigned short* dst, std::size_t count)
+{
+    unsigned int p;
+    for(std::size_t i = 0; i < count; ++i, src += 4)
+    {
+        memcpy(&p, src, 4);
+        if(!bgra)
+            p = swapWord(p);
+        dst[i] = (unsigned short)(((p >> 8) & 0xf800) | ((p >> 5) & 0x07e0) | ((p >> 3) & 0x001f));
+    }
+}
+
+static void packRgba44441(const unsigned char* src, bool bgra, unsigned short* dst, std::size_t count)
+{
+    unsigned int p;
+    for(std::size_t i = 0; i < count; ++i, src += 4)
+    {
+        memcpy(&p, src, 4);
+        if(!bgra)
+            p = swapWord(p);
+        dst[i] = (unsigned short)(((p >> 8) & 0xf000) | ((p >> 4) & 0x0f00) | (p & 0x00f0) | (p >> 28));
+    }
+}
+
+static void unpackRgb5651(const unsigned short* src, bool bgra, unsigned char* dst, std::size_t count)
+{
+    for(std::size_t i = 0; i < count; ++i, dst += 4)
+    {
+        unsigned int v = src[i];
+        unsigned int r = v >> 11;
+        unsigned int g = (v >> 5) & 0x3f;
+        unsigned int b = v & 0x1f;
+        r = (r << 3) | (r >> 2);
+        g = (g << 2) | (g >> 4);
+        b = (b << 3) | (b >> 2);
+        dst[0] = (unsigned char)(bgra ? b : r);
+        dst[1] = (unsigned char)g;
+        dst[2] = (unsigned char)(bgra ? r : b);
+        dst[3] = 255;
+    }
+}
+
+static void unpackRgba44441(const unsigned short* src, bool bgra, unsigned char* dst, std::size_t count)
+{
+    for(std::size_t i = 0; i < count; ++i, dst += 4)
+    {
+        unsigned int v = src[i];
+        unsigned int r = (v >> 12) * 17;        // 4 bits to 8 bits, 0xf -> 0xff
+        unsigned int g = ((v >> 8) & 0xf) * 17;
+        unsigned int b = ((v >> 4) & 0xf) * 17;
+        unsigned int a = (v & 0xf) * 17;
+        dst[0] = (unsigned char)(bgra ? b : r);
+        dst[1] = (unsigned char)g;
+        dst[2] = (unsigned char)(bgra ? r : b);
+        dst[3] = (unsigned char)a;
+    }
+}
+
+static void extractChannel1(const unsigned char* src, int channel, unsigned char* dst, std::size_t count)
+{
+    src += channel;
+    for(std::size_t i = 0; i < count; ++i, src += 4)
+        dst[i] = *src;
+}
+
+static inline float clampUnit(float v)
+{
+    v = (v > 0) ? v : 0;                        // NaN is 0, the same as maxps
+    return (v < 1) ? v : 1;
+}
+
+static void floatToUnorm161(const float* src, unsigned short* dst, std::size_t count)
+{
+    for(std::size_t i = 0; i < count; ++i)
+        dst[i] = (unsigned short)lrintf(clampUnit(src[i]) * 65535.0f);
+}
+
+static void floatToUnorm81(const float* src, unsigned char* dst, std::size_t count)
+{
+    for(std::size_t i = 0; i < count; ++i)
+        dst[i] = (unsigned char)lrintf(clampUnit(src[i]) * 255.0f);
+}
+
+// alpha is scaled by 257 (0xff -> 0xffff), and divided back with rounding;
+// x / 65535 is (x + 1 + (x >> 16)) >> 16 for x < 2^24
+static inline unsigned int alphaToSrgb(unsigned int a)
+{
+    unsigned int x = a * 255 + 32767;
+    return (x + 1 + (x >> 16)) >> 16;
+}
+
+static void srgbToLinear1(const unsigned char* src, unsigned short* dst, std::size_t count)
+{
+    const unsigned int* lut = getTables().toLinear;
+    for(std::size_t i = 0; i < count; ++i, src += 4, dst += 4)
+    {
+        dst[0] = (unsigned short)lut[src[0]];
+        dst[1] = (unsigned short)lut[src[1]];
+        dst[2] = (unsigned short)lut[src[2]];
+        dst[3] = (unsigned short)(src[3] * 257);
+    }
+}
+
+static void linearToSrgb1(const unsigned short* src, unsigned char* dst, std::size_t count)
+{
+    const unsigned int* lut = getTables().toSrgb;
+    for(std::size_t i = 0; i < count; ++i, src += 4, dst += 4)
+    {
+        dst[0] = (unsigned char)lut[src[0] >> (16 - LINEAR_BITS)];
+        dst[1] = (unsigned char)lut[src[1] >> (16 - LINEAR_BITS)];
+        dst[2] = (unsigned char)lut[src[2] >> (16 - LINEAR_BITS)];
+        dst[3] = (unsigned char)alphaToSrgb(src[3]);
+    }
+}
+
+
+
+#ifdef PIXEL_X86
+///////////////////////////////////////////////////////////////////////////////
+// SSE2/SSSE3 kernels
+// SSE2 has no unsigned 32-bit to 16-bit pack, so the 16-bit results are
+// sign-extended first, then packssdw keeps the same bits.
+///////////////////////////////////////////////////////////////////////////////
+PIXEL_TARGET("sse2")
+static inline __m128i swapWordSSE2(__m128i p)
+{
+    const __m128i maskAG = _mm_set1_epi32((int)0xff00ff00);
+    const __m128i maskB  = _mm_set1_epi32(0x000000ff);
+    __m128i r = _mm_and_si128(_mm_srli_epi32(p, 16), maskB);
+    __m128i b = _mm_slli_epi32(_mm_and_si128(p, maskB), 16);
+    return _mm_or_si128(_mm_and_si128(p, maskAG), _mm_or_si128(r, b));
+}
+
+PIXEL_TARGET("sse2")
+static inline __m128i pack16SSE2(__m128i lo, __m128i hi)
+{
+    lo = _mm_srai_epi32(_mm_slli_epi32(lo, 16), 16);
+    hi = _mm_srai_epi32(_mm_slli_epi32(hi, 16), 16);
+    return _mm_packs_epi32(lo, hi);
+}
+
+// 4 BGRA pixels to 4 int32 of RGB565
+PIXEL_TARGET("sse2")
+static inline __m128i rgb565SSE2(__m128i p)
+{
+    __m128i r = _mm_and_si128(_mm_srli_epi32(p, 8), _mm_set1_epi32(0xf800));
+    __m128i g = _mm_and_si128(_mm_srli_epi32(p, 5), _mm_set1_epi32(0x07e0));
+    __m128i b = _mm_and_si128(_mm_srli_epi32(p, 3), _mm_set1_epi32(0x001f));
+    return _mm_or_si128(r, _mm_or_si128(g, b));
+}
+
+// 4 BGRA pixels to 4 int32 of RGBA4444
+PIXEL_TARGET("sse2")
+static inline __m128i rgba4444SSE2(__m128i p)
+{
+    __m128i r = _mm_and_si128(_mm_srli_epi32(p, 8), _mm_set1_epi32(0xf000));
+    __m128i g = _mm_and_si128(_mm_srli_epi32(p, 4), _mm_set1_epi32(0x0f00));
+    __m128i b = _mm_and_si128(p, _mm_set1_epi32(0x00f0));
+    __m128i a = _mm_srli_epi32(p, 28);
+    return _mm_or_si128(_mm_or_si128(r, g), _mm_or_si128(b, a));
+}
+
+// interleave 8 16-bit pairs of [c0 | c1 << 8] and [c2 | c3 << 8] to 8 pixels
+PIXEL_TARGET("sse2")
+static inline void storePixelsSSE2(unsigned char* dst, __m128i c01, __m128i c23)
+{
+    _mm_storeu_si128((__m128i*)dst, _mm_unpacklo_epi16(c01, c23));
+    _mm_storeu_si128((__m128i*)(dst + 16), _mm_unpackhi_epi16(c01, c23));
+}
+
+PIXEL_TARGET("sse2")
+static std::size_t swapRedBlueSSE2(const unsigned char* src, unsigned char* dst, std::size_t count)
+{
+    std::size_t i = 0;
+    for(; i + 4 <= count; i += 4)
+    {
+        __m128i p = _mm_loadu_si128((const __m128i*)(src + i * 4));
+        _mm_storeu_si128((__m128i*)(dst + i * 4), swapWordSSE2(p));
+    }
+    return i;                           // # of processed pixels
+}
+
+PIXEL_TARGET("ssse3")
+static std::size_t swapRedBlueSSSE3(const unsigned char* src, unsigned char* dst, std::size_t count)
+{
+    const __m128i mask = _mm_setr_epi8(2,1,0,3, 6,5,4,7, 10,9,8,11, 14,13,12,15);
+    std::size_t i = 0;
+    for(; i + 4 <= count; i += 4)
+    {
+        __m128i p = _mm_loadu_si128((const __m128i*)(src + i * 4));
+        _mm_storeu_si128((__m128i*)(dst + i * 4), _mm_shuffle_epi8(p, mask));
+    }
+    return i;
+}
+
+// 8 pixels per iteration
+PIXEL_TARGET("sse2")
+static std::size_t packRgb565SSE2(const unsigned char* src, bool bgra, unsigned short* dst, std::size_t count)
+{
+    std::size_t i = 0;
+    for(; i + 8 <= count; i += 8)
+    {
+        __m128i p0 = _mm_loadu_si128((const __m128i*)(src + i * 4));
+        __m128i p1 = _mm_loadu_si128((const __m128i*)(src + i * 4 + 16));
+        if(!bgra)
+        {
+            p0 = swapWordSSE2(p0);
+            p1 = swapWordSSE2(p1);
+        }
+        _mm_storeu_si128((__m128i*)(dst + i), pack16SSE2(rgb565SSE2(p0), rgb565SSE2(p1)));
+    }
+    return i;
+}
+
+PIXEL_TARGET("sse2")
+static std::size_t packRgba4444SSE2(const unsigned char* src, bool bgra, unsigned short* dst, std::size_t count)
+{
+    std::size_t i = 0;
+    for(; i + 8 <= count; i += 8)
+    {
+        __m128i p0 = _mm_loadu_si128((const __m128i*)(src + i * 4));
+        __m128i p1 = _mm_loadu_si128((const __m128i*)(src + i * 4 + 16));
+        if(!bgra)
+        {
+            p0 = swapWordSSE2(p0);
+            p1 = swapWordSSE2(p1);
+        }
+        _mm_storeu_si128((__m128i*)(dst + i), pack16SSE2(rgba4444SSE2(p0), rgba4444SSE2(p1)));
+    }
+    return i;
+}
+
+// the components are widened to 16 bits, then interleaved to bytes
+PIXEL_TARGET("sse2")
+static std::size_t unpackRgb565SSE2(const unsigned short* src, bool bgra, unsigned char* dst, std::size_t count)
+{
+    const __m128i mask5 = _mm_set1_epi16(0x1f);
+    const __m128i mask6 = _mm_set1_epi16(0x3f);
+    const __m128i alpha = _mm_set1_epi16((short)0xff00);
+    std::size_t i = 0;
+    for(; i + 8 <= count; i += 8)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i*)(src + i));
+        __m128i r = _mm_srli_epi16(v, 11);
+        __m128i g = _mm_and_si128(_mm_srli_epi16(v, 5), mask6);
+        __m128i b = _mm_and_si128(v, mask5);
+        r = _mm_or_si128(_mm_slli_epi16(r, 3), _mm_srli_epi16(r, 2));
+        g = _mm_or_si128(_mm_slli_epi16(g, 2), _mm_srli_epi16(g, 4));
+        b = _mm_or_si128(_mm_slli_epi16(b, 3), _mm_srli_epi16(b, 2));
+        __m128i c0 = bgra ? b : r;
+        __m128i c2 = bgra ? r : b;
+        storePixelsSSE2(dst + i * 4, _mm_or_si128(c0, _mm_slli_epi16(g, 8)), _mm_or_si128(c2, alpha));
+    }
+    return i;
+}
+
+PIXEL_TARGET("sse2")
+static std::size_t unpackRgba4444SSE2(const unsigned short* src, bool bgra, unsigned char* dst, std::size_t count)
+{
+    const __m128i mask4 = _mm_set1_epi16(0xf);
+    std::size_t i = 0;
+    for(; i + 8 <= count; i += 8)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i*)(src + i));
+        __m128i r = _mm_srli_epi16(v, 12);
+        __m128i g = _mm_and_si128(_mm_srli_epi16(v, 8), mask4);
+        __m128i b = _mm_and_si128(_mm_srli_epi16(v, 4), mask4);
+        __m128i a = _mm_and_si128(v, mask4);
+        r = _mm_or_si128(_mm_slli_epi16(r, 4), r);
+        g = _mm_or_si128(_mm_slli_epi16(g, 4), g);
+        b = _mm_or_si128(_mm_slli_epi16(b, 4), b);
+        a = _mm_or_si128(_mm_slli_epi16(a, 4), a);
+        __m128i c0 = bgra ? b : r;
+        __m128i c2 = bgra ? r : b;
+        storePixelsSSE2(dst + i * 4, _mm_or_si128(c0, _mm_slli_epi16(g, 8)), _mm_or_si128(c2, _mm_slli_epi16(a, 8)));
+    }
+    return i;
+}
+
+// 16 pixels per iteration
+PIXEL_TARGET("sse2")
+static std::size_t extractChannelSSE2(const unsigned char* src, int channel, unsigned char* dst, std::size_t count)
+{
+    const __m128i shift = _mm_cvtsi32_si128(channel * 8);
+    const __m128i mask = _mm_set1_epi32(0xff);
+    std::size_t i = 0;
+    for(; i + 16 <= count; i += 16)
+    {
+        const __m128i* p = (const __m128i*)(src + i * 4);
+        __m128i c0 = _mm_and_si128(_mm_srl_epi32(_mm_loadu_si128(p), shift), mask);
+        __m128i c1 = _mm_and_si128(_mm_srl_epi32(_mm_loadu_si128(p + 1), shift), mask);
+        __m128i c2 = _mm_and_si128(_mm_srl_epi32(_mm_loadu_si128(p + 2), shift), mask);
+        __m128i c3 = _mm_and_si128(_mm_srl_epi32(_mm_loadu_si128(p + 3), shift), mask);
+        __m128i c = _mm_packus_epi16(_mm_packs_epi32(c0, c1), _mm_packs_epi32(c2, c3));
+        _mm_storeu_si128((__m128i*)(dst + i), c);
+    }
+    return i;
+}
+
+// clamp 4 floats to [0, 1], then scale and round to int32
+// maxps returns the 2nd operand if either is NaN, so NaN is 0. cvtps2dq
+// rounds to nearest even, the same as lrintf() of plain C++.
+PIXEL_TARGET("sse2")
+static inline __m128i unormSSE2(__m128 v, __m128 scale)
+{
+    v = _mm_min_ps(_mm_max_ps(v, _mm_setzero_ps()), _mm_set1_ps(1.0f));
+    return _mm_cvtps_epi32(_mm_mul_ps(v, scale));
+}
+
+PIXEL_TARGET("sse2")
+static std::size_t floatToUnorm16SSE2(const float* src, unsigned short* dst, std::size_t count)
+{
+    const __m128 scale = _mm_set1_ps(65535.0f);
+    std::size_t i = 0;
+    for(; i + 8 <= count; i += 8)
+    {
+        __m128i v0 = unormSSE2(_mm_loadu_ps(src + i), scale);
+        __m128i v1 = unormSSE2(_mm_loadu_ps(src + i + 4), scale);
+        _mm_storeu_si128((__m128i*)(dst + i), pack16SSE2(v0, v1));
+    }
+    return i;
+}
+
+PIXEL_TARGET("sse2")
+static std::size_t floatToUnorm8SSE2(const float* src, unsigned char* dst, std::size_t count)
+{
+    const __m128 scale = _mm_set1_ps(255.0f);
+    std::size_t i = 0;
+    for(; i + 16 <= count; i += 16)
+    {
+        __m128i v0 = unormSSE2(_mm_loadu_ps(src + i), scale);
+        __m128i v1 = unormSSE2(_mm_loadu_ps(src + i + 4), scale);
+        __m128i v2 = unormSSE2(_mm_loadu_ps(src + i + 8), scale);
+        __m128i v3 = unormSSE2(_mm_loadu_ps(src + i + 12), scale);
+        __m128i v = _mm_packus_epi16(_mm_packs_epi32(v0, v1), _mm_packs_epi32(v2, v3));
+        _mm_storeu_si128((__m128i*)(dst + i), v);
+    }
+    return i;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// AVX2 kernels
+// pack and unpack work within 128-bit lanes, so the results are reordered
+// with vpermq or vperm2i128.
+///////////////////////////////////////////////////////////////////////////////
+PIXEL_TARGET("avx2")
+static inline __m256i swapWordAVX2(__m256i p)
+{
+    const __m256i mask = _mm256_setr_epi8(2,1,0,3, 6,5,4,7, 10,9,8,11, 14,13,12,15,
+                                          2,1,0,3, 6,5,4,7, 10,9,8,11, 14,13,12,15);
+    return _mm256_shuffle_epi8(p, mask);
+}
+
+// 16 int32 in [0, 65535] to 16 uint16 in order
+PIXEL_TARGET("avx2")
+static inline __m256i pack16AVX2(__m256i lo, __m256i hi)
+{
+    return _mm256_permute4x64_epi64(_mm256_packus_epi32(lo, hi), 0xd8);
+}
+
+PIXEL_TARGET("avx2")
+static inline __m256i rgb565AVX2(__m256i p)
+{
+    __m256i r = _mm256_and_si256(_mm256_srli_epi32(p, 8), _mm256_set1_epi32(0xf800));
+    __m256i g = _mm256_and_si256(_mm256_srli_epi32(p, 5), _mm256_set1_epi32(0x07e0));
+    __m256i b = _mm256_and_si256(_mm256_srli_epi32(p, 3), _mm256_set1_epi32(0x001f));
+    return _mm256_or_si256(r, _mm256_or_si256(g, b));
+}
+
+PIXEL_TARGET("avx2")
+static inline __m256i rgba4444AVX2(__m256i p)
+{
+    __m256i r = _mm256_and_si256(_mm256_srli_epi32(p, 8), _mm256_set1_epi32(0xf000));
+    __m256i g = _mm256_and_si256(_mm256_srli_epi32(p, 4), _mm256_set1_epi32(0x0f00));
+    __m256i b = _mm256_and_si256(p, _mm256_set1_epi32(0x00f0));
+    __m256i a = _mm256_srli_epi32(p, 28);
+    return _mm256_or_si256(_mm256_or_si256(r, g), _mm256_or_si256(b, a));
+}
+
+// interleave 16 pairs to 16 pixels; the lanes of unpack are [0~3, 8~11 | 4~7, 12~15]
+PIXEL_TARGET("avx2")
+static inline void storePixelsAVX2(unsigned char* dst, __m256i c01, __m256i c23)
+{
+    __m256i lo = _mm256_unpacklo_epi16(c01, c23);
+    __m256i hi = _mm256_unpackhi_epi16(c01, c23);
+    _mm256_storeu_si256((__m256i*)dst, _mm256_permute2x128_si256(lo, hi, 0x20));
+    _mm256_storeu_si256((__m256i*)(dst + 32), _mm256_permute2x128_si256(lo, hi, 0x31));
+}
+
+PIXEL_TARGET("avx2")
+static std::size_t swapRedBlueAVX2(const unsigned char* src, unsigned char* dst, std::size_t count)
+{
+    std::size_t i = 0;
+    for(; i + 8 <= count; i += 8)
+    {
+        __m256i p = _mm256_loadu_si256((const __m256i*)(src + i * 4));
+        _mm256_storeu_si256((__m256i*)(dst + i * 4), swapWordAVX2(p));
+    }
+    return i;
+}
+
+// 16 pixels per iteration
+PIXEL_TARGET("avx2")
+static std::size_t packRgb565AVX2(const unsigned char* src, bool bgra, unsigned short* dst, std::size_t count)
+{
+    std::size_t i = 0;
+    for(; i + 16 <= count; i += 16)
+    {
+        __m256i p0 = _mm256_loadu_si256((const __m256i*)(src + i * 4));
+        __m256i p1 = _mm256_loadu_si256((const __m256i*)(src + i * 4 + 32));
+        if(!bgra)
+        {
+            p0 = swapWordAVX2(p0);
+            p1 = swapWordAVX2(p1);
+        }
+        _mm256_storeu_si256((__m256i*)(dst + i), pack16AVX2(rgb565AVX2(p0), rgb565AVX2(p1)));
+    }
+    return i;
+}
+
+PIXEL_TARGET("avx2")
+static std::size_t packRgba4444AVX2(const unsigned char* src, bool bgra, unsigned short* dst, std::size_t count)
+{
+    std::size_t i = 0;
+    for(; i + 16 <= count; i += 16)
+    {
+        __m256i p0 = _mm256_loadu_si256((const __m256i*)(src + i * 4));
+        __m256i p1 = _mm256_loadu_si256((const __m256i*)(src + i * 4 + 32));
+        if(!bgra)
+        {
+            p0 = swapWordAVX2(p0);
+            p1 = swapWordAVX2(p1);
+        }
+        _mm256_storeu_si256((__m256i*)(dst + i), pack16AVX2(rgba4444AVX2(p0), rgba4444AVX2(p1)));
+    }
+    return i;
+}
+
+PIXEL_TARGET("avx2")
+static std::size_t unpackRgb565AVX2(const unsigned short* src, bool bgra, unsigned char* dst, std::size_t count)
+{
+    const __m256i mask5 = _mm256_set1_epi16(0x1f);
+    const __m256i mask6 = _mm256_set1_epi16(0x3f);
+    const __m256i alpha = _mm256_set1_epi16((short)0xff00);
+    std::size_t i = 0;
+    for(; i + 16 <= count; i += 16)
+    {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(src + i));
+        __m256i r = _mm256_srli_epi16(v, 11);
+        __m256i g = _mm256_and_si256(_mm256_srli_epi16(v, 5), mask6);
+        __m256i b = _mm256_and_si256(v, mask5);
+        r = _mm256_or_si256(_mm256_slli_epi16(r, 3), _mm256_srli_epi16(r, 2));
+        g = _mm256_or_si256(_mm256_slli_epi16(g, 2), _mm256_srli_epi16(g, 4));
+        b = _mm256_or_si256(_mm256_slli_epi16(b, 3), _mm256_srli_epi16(b, 2));
+        __m256i c0 = bgra ? b : r;
+        __m256i c2 = bgra ? r : b;
+        storePixelsAVX2(dst + i * 4, _mm256_or_si256(c0, _mm256_slli_epi16(g, 8)), _mm256_or_si256(c2, alpha));
+    }
+    return i;
+}
+
+PIXEL_TARGET("avx2")
+static std::size_t unpackRgba4444AVX2(const unsigned short* src, bool bgra, unsigned char* dst, std::size_t count)
+{
+    const __m256i mask4 = _mm256_set1_epi16(0xf);
+    std::size_t i = 0;
+    for(; i + 16 <= count; i += 16)
+    {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(src + i));
+        __m256i r = _mm256_srli_epi16(v, 12);
+        __m256i g = _mm256_and_si256(_mm256_srli_epi16(v, 8), mask4);
+        __m256i b = _mm256_and_si256(_mm256_srli_epi16(v, 4), mask4);
+        __m256i a = _mm256_and_si256(v, mask4);
+        r = _mm256_or_si256(_mm256_slli_epi16(r, 4), r);
+        g = _mm256_or_si256(_mm256_slli_epi16(g, 4), g);
+        b = _mm256_or_si256(_mm256_slli_epi16(b, 4), b);
+        a = _mm256_or_si256(_mm256_slli_epi16(a, 4), a);
+        __m256i c0 = bgra ? b : r;
+        __m256i c2 = bgra ? r : b;
+        storePixelsAVX2(dst + i * 4, _mm256_or_si256(c0, _mm256_slli_epi16(g, 8)),
+                        _mm256_or_si256(c2, _mm256_slli_epi16(a, 8)));
+    }
+    return i;
+}
+
+// 32 pixels per iteration; the packs give the dwords [0, 2, 4, 6 | 1, 3, 5, 7]
+PIXEL_TARGET("avx2")
+static std::size_t extractChannelAVX2(const unsigned char* src, int channel, unsigned char* dst, std::size_t count)
+{
+    const __m128i shift = _mm_cvtsi32_si128(channel * 8);
+    const __m256i mask = _mm256_set1_epi32(0xff);
+    const __m256i order = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+    std::size_t i = 0;
+    for(; i + 32 <= count; i += 32)
+    {
+        const __m256i* p = (const __m256i*)(src + i * 4);
+        __m256i c0 = _mm256_and_si256(_mm256_srl_epi32(_mm256_loadu_si256(p), shift), mask);
+        __m256i c1 = _mm256_and_si256(_mm256_srl_epi32(_mm256_loadu_si256(p + 1), shift), mask);
+        __m256i c2 = _mm256_and_si256(_mm256_srl_epi32(_mm256_loadu_si256(p + 2), shift), mask);
+        __m256i c3 = _mm256_and_si256(_mm256_srl_epi32(_mm256_loadu_si256(p + 3), shift), mask);
+        __m256i c = _mm256_packus_epi16(_mm256_packs_epi32(c0, c1), _mm256_packs_epi32(c2, c3));
+        _mm256_storeu_si256((__m256i*)(dst + i), _mm256_permutevar8x32_epi32(c, order));
+    }
+    return i;
+}
+
+PIXEL_TARGET("avx2")
+static inline __m256i unormAVX2(__m256 v, __m256 scale)
+{
+    v = _mm256_min_ps(_mm256_max_ps(v, _mm256_setzero_ps()), _mm256_set1_ps(1.0f));
+    return _mm256_cvtps_epi32(_mm256_mul_ps(v, scale));
+}
+
+PIXEL_TARGET("avx2")
+static std::size_t floatToUnorm16AVX2(const float* src, unsigned short* dst, std::size_t count)
+{
+    const __m256 scale = _mm256_set1_ps(65535.0f);
+    std::size_t i = 0;
+    for(; i + 16 <= count; i += 16)
+    {
+        __m256i v0 = unormAVX2(_mm256_loadu_ps(src + i), scale);
+        __m256i v1 = unormAVX2(_mm256_loadu_ps(src + i + 8), scale);
+        _mm256_storeu_si256((__m256i*)(dst + i), pack16AVX2(v0, v1));
+    }
+    return i;
+}
+
+PIXEL_TARGET("avx2")
+static std::size_t floatToUnorm8AVX2(const float* src, unsigned char* dst, std::size_t count)
+{
+    const __m256 scale = _mm256_set1_ps(255.0f);
+    std::size_t i = 0;
+    for(; i + 16 <= count; i += 16)
+    {
+        __m256i v0 = unormAVX2(_mm256_loadu_ps(src + i), scale);
+        __m256i v1 = unormAVX2(_mm256_loadu_ps(src + i + 8), scale);
+        __m256i v = pack16AVX2(v0, v1);
+        v = _mm256_packus_epi16(v, v);          // [0~7, 0~7 | 8~15, 8~15]
+        v = _mm256_permute4x64_epi64(v, 0x08);
+        _mm_storeu_si128((__m128i*)(dst + i), _mm256_castsi256_si128(v));
+    }
+    return i;
+}
+
+// 4 pixels per iteration; the colour channels are gathered from the table,
+// and the alpha channels (dword 3 and 7) are computed
+PIXEL_TARGET("avx2")
+static std::size_t srgbToLinearAVX2(const unsigned char* src, unsigned short* dst, std::size_t count)
+{
+    const int* lut = (const int*)getTables().toLinear;
+    std::size_t i = 0;
+    for(; i + 4 <= count; i += 4)
+    {
+        __m128i p = _mm_loadu_si128((const __m128i*)(src + i * 4));
+        __m256i c0 = _mm256_cvtepu8_epi32(p);
+        __m256i c1 = _mm256_cvtepu8_epi32(_mm_srli_si128(p, 8));
+        __m256i l0 = _mm256_i32gather_epi32(lut, c0, 4);
+        __m256i l1 = _mm256_i32gather_epi32(lut, c1, 4);
+        l0 = _mm256_blend_epi32(l0, _mm256_or_si256(_mm256_slli_epi32(c0, 8), c0), 0x88);
+        l1 = _mm256_blend_epi32(l1, _mm256_or_si256(_mm256_slli_epi32(c1, 8), c1), 0x88);
+        _mm256_storeu_si256((__m256i*)(dst + i * 4), pack16AVX2(l0, l1));
+    }
+    return i;
+}
+
+// the same as alphaToSrgb()
+PIXEL_TARGET("avx2")
+static inline __m256i alphaToSrgbAVX2(__m256i a)
+{
+    __m256i x = _mm256_add_epi32(_mm256_mullo_epi32(a, _mm256_set1_epi32(255)), _mm256_set1_epi32(32767));
+    x = _mm256_add_epi32(_mm256_add_epi32(x, _mm256_set1_epi32(1)), _mm256_srli_epi32(x, 16));
+    return _mm256_srli_epi32(x, 16);
+}
+
+PIXEL_TARGET("avx2")
+static std::size_t linearToSrgbAVX2(const unsigned short* src, unsigned char* dst, std::size_t count)
+{
+    const int* lut = (const int*)getTables().toSrgb;
+    std::size_t i = 0;
+    for(; i + 4 <= count; i += 4)
+    {
+        __m256i v0 = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)(src + i * 4)));
+        __m256i v1 = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)(src + i * 4 + 8)));
+        __m256i s0 = _mm256_i32gather_epi32(lut, _mm256_srli_epi32(v0, 16 - LINEAR_BITS), 4);
+        __m256i s1 = _mm256_i32gather_epi32(lut, _mm256_srli_epi32(v1, 16 - LINEAR_BITS), 4);
+
+        s0 = _mm256_blend_epi32(s0, alphaToSrgbAVX2(v0), 0x88);
+        s1 = _mm256_blend_epi32(s1, alphaToSrgbAVX2(v1), 0x88);
+
+        __m256i w = pack16AVX2(s0, s1);
+        __m128i b = _mm_packus_epi16(_mm256_castsi256_si128(w), _mm256_extracti128_si256(w, 1));
+        _mm_storeu_si128((__m128i*)(dst + i * 4), b);
+    }
+    return i;
+}
+#endif // PIXEL_X86
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// return the name of type for the options and reports
+///////////////////////////////////////////////////////////////////////////////
+const char* getTypeName(Type type)
+{
+    if(type < 0 || type >= TYPE_COUNT)
+        return "unknown";
+    return TYPE_NAMES[type];
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// find the type of the name, return false if unknown
+///////////////////////////////////////////////////////////////////////////////
+bool parseType(const char* name, Type& type)
+{
+    if(!name)
+        return false;
+    for(int i = 0; i < TYPE_COUNT; ++i)
+    {
+        if(strcmp(name, TYPE_NAMES[i]) == 0)
+        {
+            type = (Type)i;
+            return true;
+        }
+    }
+    return false;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// return bytes per pixel
+///////////////////////////////////////////////////////////////////////////////
+int getPixelSize(Type type)
+{
+    switch(type)
+    {
+    case BGRA8:
+    case RGBA8:
+        return 4;
+    case RGB565:
+    case RGBA4444:
+        return 2;
+    case RED8:
+        return 1;
+    default:
+        return 0;
+    }
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// return true if convert() supports src to dst
+///////////////////////////////////////////////////////////////////////////////
+bool isConvertible(Type srcType, Type dstType)
+{
+    if(srcType == dstType)
+        return getPixelSize(srcType) > 0;
+
+    bool src4 = (srcType == BGRA8 || srcType == RGBA8);
+    bool dst4 = (dstType == BGRA8 || dstType == RGBA8);
+    bool src2 = (srcType == RGB565 || srcType == RGBA4444);
+    return (src4 && getPixelSize(dstType) > 0) || (src2 && dst4);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// convert pixels between 2 types
+///////////////////////////////////////////////////////////////////////////////
+bool convert(const void* src, Type srcType, void* dst, Type dstType, std::size_t pixelCount)
+{
+    if(!src || !dst || !isConvertible(srcType, dstType))
+        return false;
+
+    const unsigned char* src8 = (const unsigned char*)src;
+    unsigned char* dst8 = (unsigned char*)dst;
+    if(srcType == dstType)
+    {
+        memcpy(dst, src, pixelCount * getPixelSize(srcType));
+        return true;
+    }
+
+    switch(dstType)
+    {
+    case BGRA8:
+    case RGBA8:
+        if(srcType == RGB565)
+            unpackRgb565((const unsigned short*)src, dstType == BGRA8, dst8, pixelCount);
+        else if(srcType == RGBA4444)
+            unpackRgba4444((const unsigned short*)src, dstType == BGRA8, dst8, pixelCount);
+        else
+            swapRedBlue(src8, dst8, pixelCount);
+        break;
+    case RGB565:
+        packRgb565(src8, srcType == BGRA8, (unsigned short*)dst, pixelCount);
+        break;
+    case RGBA4444:
+        packRgba4444(src8, srcType == BGRA8, (unsigned short*)dst, pixelCount);
+        break;
+    case RED8:
+        extractChannel(src8, (srcType == BGRA8) ? 2 : 0, dst8, pixelCount);
+        break;
+    }
+    return true;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// copy 4-byte pixels swapping red and blue
+///////////////////////////////////////////////////////////////////////////////
+void swapRedBlue(const unsigned char* src, unsigned char* dst, std::size_t pixelCount)
+{
+    if(!src || !dst)
+        return;
+
+    std::size_t done = 0;
+#ifdef PIXEL_X86
+    Pixel::SimdLevel level = Pixel::getSimdLevel();
+    if(level >= Pixel::SIMD_AVX2)
+        done = swapRedBlueAVX2(src, dst, pixelCount);
+    else if(level >= Pixel::SIMD_SSSE3)
+        done = swapRedBlueSSSE3(src, dst, pixelCount);
+    else if(level >= Pixel::SIMD_SSE2)
+        done = swapRedBlueSSE2(src, dst, pixelCount);
+#endif
+    swapRedBlue1(src + done * 4, dst + done * 4, pixelCount - done);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// pack 4-byte pixels to RGB565 or RGBA4444
+///////////////////////////////////////////////////////////////////////////////
+void packRgb565(const unsigned char* src, bool bgra, unsigned short* dst, std::size_t pixelCount)
+{
+    if(!src || !dst)
+        return;
+
+    std::size_t done = 0;
+#ifdef PIXEL_X86
+    Pixel::SimdLevel level = Pixel::getSimdLevel();
+    if(level >= Pixel::SIMD_AVX2)
+        done = packRgb565AVX2(src, bgra, dst, pixelCount);
+    else if(level >= Pixel::SIMD_SSE2)
+        done = packRgb565SSE2(src, bgra, dst, pixelCount);
+#endif
+    packRgb5651(src + done * 4, bgra, dst + done, pixelCount - done);
+}
+
+void packRgba4444(const unsigned char* src, bool bgra, unsigned short* dst, std::size_t pixelCount)
+{
+    if(!src || !dst)
+        return;
+
+    std::size_t done = 0;
+#ifdef PIXEL_X86
+    Pixel::SimdLevel level = Pixel::getSimdLevel();
+    if(level >= Pixel::SIMD_AVX2)
+        done = packRgba4444AVX2(src, bgra, dst, pixelCount);
+    else if(level >= Pixel::SIMD_SSE2)
+        done = packRgba4444SSE2(src, bgra, dst, pixelCount);
+#endif
+    packRgba44441(src + done * 4, bgra, dst + done, pixelCount - done);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// unpack RGB565 or RGBA4444 to 4-byte pixels
+///////////////////////////////////////////////////////////////////////////////
+void unpackRgb565(const unsigned short* src, bool bgra, unsigned char* dst, std::size_t pixelCount)
+{
+    if(!src || !dst)
+        return;
+
+    std::size_t done = 0;
+#ifdef PIXEL_X86
+    Pixel::SimdLevel level = Pixel::getSimdLevel();
+    if(level >= Pixel::SIMD_AVX2)
+        done = unpackRgb565AVX2(src, bgra, dst, pixelCount);
+    else if(level >= Pixel::SIMD_SSE2)
+        done = unpackRgb565SSE2(src, bgra, dst, pixelCount);
+#endif
+    unpackRgb5651(src + done, bgra, dst + done * 4, pixelCount - done);
+}
+
+void unpackRgba4444(const unsigned short* src, bool bgra, unsigned char* dst, std::size_t pixelCount)
+{
+    if(!src || !dst)
+        return;
+
+    std::size_t done = 0;
+#ifdef PIXEL_X86
+    Pixel::SimdLevel level = Pixel::getSimdLevel();
+    if(level >= Pixel::SIMD_AVX2)
+        done = unpackRgba4444AVX2(src, bgra, dst, pixelCount);
+    else if(level >= Pixel::SIMD_SSE2)
+        done = unpackRgba4444SSE2(src, bgra, dst, pixelCount);
+#endif
+    unpackRgba44441(src + done, bgra, dst + done * 4, pixelCount - done);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// copy a channel of 4-byte pixels
+///////////////////////////////////////////////////////////////////////////////
+void extractChannel(const unsigned char* src, int channel, unsigned char* dst, std::size_t pixelCount)
+{
+    if(!src || !dst || channel < 0 || channel > 3)
+        return;
+
+    std::size_t done = 0;
+#ifdef PIXEL_X86
+    Pixel::SimdLevel level = Pixel::getSimdLevel();
+    if(level >= Pixel::SIMD_AVX2)
+        done = extractChannelAVX2(src, channel, dst, pixelCount);
+    else if(level >= Pixel::SIMD_SSE2)
+        done = extractChannelSSE2(src, channel, dst, pixelCount);
+#endif
+    extractChannel1(src + done * 4, channel, dst + done, pixelCount - done);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// float to 16-bit or 8-bit normalized integer
+///////////////////////////////////////////////////////////////////////////////
+void floatToUnorm16(const float* src, unsigned short* dst, std::size_t count)
+{
+    if(!src || !dst)
+        return;
+
+    std::size_t done = 0;
+#ifdef PIXEL_X86
+    Pixel::SimdLevel level = Pixel::getSimdLevel();
+    if(level >= Pixel::SIMD_AVX2)
+        done = floatToUnorm16AVX2(src, dst, count);
+    else if(level >= Pixel::SIMD_SSE2)
+        done = floatToUnorm16SSE2(src, dst, count);
+#endif
+    floatToUnorm161(src + done, dst + done, count - done);
+}
+
+void floatToUnorm8(const float* src, unsigned char* dst, std::size_t count)
+{
+    if(!src || !dst)
+        return;
+
+    std::size_t done = 0;
+#ifdef PIXEL_X86
+    Pixel::SimdLevel level = Pixel::getSimdLevel();
+    if(level >= Pixel::SIMD_AVX2)
+        done = floatToUnorm8AVX2(src, dst, count);
+    else if(level >= Pixel::SIMD_SSE2)
+        done = floatToUnorm8SSE2(src, dst, count);
+#endif
+    floatToUnorm81(src + done, dst + done, count - done);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// sRGB 8-bit <-> linear 16-bit with the lookup tables
+///////////////////////////////////////////////////////////////////////////////
+void srgbToLinear(const unsigned char* src, unsigned short* dst, std::size_t pixelCount)
+{
+    if(!src || !dst)
+        return;
+
+    std::size_t done = 0;
+#ifdef PIXEL_X86
+    if(Pixel::getSimdLevel() >= Pixel::SIMD_AVX2)
+        done = srgbToLinearAVX2(src, dst, pixelCount);
+#endif
+    srgbToLinear1(src + done * 4, dst + done * 4, pixelCount - done);
+}
+
+void linearToSrgb(const unsigned short* src, unsigned char* dst, std::size_t pixelCount)
+{
+    if(!src || !dst)
+        return;
+
+    std::size_t done = 0;
+#ifdef PIXEL_X86
+    if(Pixel::getSimdLevel() >= Pixel::SIMD_AVX2)
+        done = linearToSrgbAVX2(src, dst, pixelCount);
+#endif
+    linearToSrgb1(src + done * 4, dst + done * 4, pixelCount - done);
+}
+
+} // namespace Format
@@ -0,0 +1,88 @@
+///////////////////////////////////////////////////////////////////////////////
+// formatUtils.h
+// =============
+// Pixel format conversions between the image in memory and the data in PBO
+// A smaller transfer format, e.g. RGB565, halves the bytes copied by the PBO
+// and the driver, but costs a conversion pass on CPU. The conversions read
+// the source once and write the destination once, so the pass can be fused
+// with the copy into (or out of) the mapped PBO instead of adding another
+// pass over the image.
+//
+// The kernels use the SIMD level of pixelUtils (Pixel::getSimdLevel()), and
+// the results are the same at all SIMD levels. The sRGB conversions use
+// lookup tables; the AVX2 kernels read the tables with gather, and the lower
+// levels use plain C++.
+// The pixel count of each function is the number of pixels (4 channels) for
+// 4-channel data, and the number of values for floatToUnorm*(). The buffers
+// are unaligned, so a band of pixels can be converted by each thread.
+//
+// packed formats (16-bit, the same as OpenGL packed pixel types):
+//     RGB565:   GL_RGB,  GL_UNSIGNED_SHORT_5_6_5,   R: bit 15~11, G: 10~5, B: 4~0
+//     RGBA4444: GL_RGBA, GL_UNSIGNED_SHORT_4_4_4_4, R: bit 15~12, G: 11~8, B: 7~4, A: 3~0
+// Packing truncates the low bits, and unpacking replicates the high bits to
+// the low bits, so 0 and 255 are kept.
+//
+//  AUTHOR: Song Ho Ahn (song.ahn@gmail.com)
+// CREATED: 2026-10-18
+// UPDATED: 2026-10-18
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef FORMAT_UTILS_H
+#define FORMAT_UTILS_H
+
+#include <cstddef>
+
+namespace Format
+{
+    // pixel formats of memory and PBO
+    enum Type
+    {
+        BGRA8 = 0,                      // 4 bytes
+        RGBA8,                          // 4 bytes
+        RGB565,                         // 2 bytes
+        RGBA4444,                       // 2 bytes
+        RED8                            // 1 byte, the red channel only
+    };
+
+    // name of the options and reports, e.g., "rgb565"
+    const char* getTypeName(Type type);
+    bool parseType(const char* name, Type& type);   // false if unknown name
+    int getPixelSize(Type type);                    // bytes per pixel
+
+    // return true if convert() supports src to dst
+    // 4-byte types convert to all types, and RGB565/RGBA4444 convert back to
+    // 4-byte types. RED8 cannot be converted back.
+    bool isConvertible(Type srcType, Type dstType);
+
+    // convert pixelCount pixels with the kernels below, or copy if the same
+    // type, return false if not convertible
+    bool convert(const void* src, Type srcType, void* dst, Type dstType, std::size_t pixelCount);
+
+    // copy 4-byte pixels swapping the 1st and 3rd bytes, BGRA <-> RGBA
+    void swapRedBlue(const unsigned char* src, unsigned char* dst, std::size_t pixelCount);
+
+    // pack 4-byte pixels to 16-bit, bgra is false for RGBA source
+    // RGB565 drops the alpha channel.
+    void packRgb565(const unsigned char* src, bool bgra, unsigned short* dst, std::size_t pixelCount);
+    void packRgba4444(const unsigned char* src, bool bgra, unsigned short* dst, std::size_t pixelCount);
+
+    // unpack 16-bit pixels to 4 bytes, bgra is false for RGBA destination
+    // The alpha of RGB565 is 255.
+    void unpackRgb565(const unsigned short* src, bool bgra, unsigned char* dst, std::size_t pixelCount);
+    void unpackRgba4444(const unsigned short* src, bool bgra, unsigned char* dst, std::size_t pixelCount);
+
+    // copy a channel (0 ~ 3) of 4-byte pixels to 1-byte pixels
+    void extractChannel(const unsigned char* src, int channel, unsigned char* dst, std::size_t pixelCount);
+
+    // float to normalized integer, clamped to [0, 1] and rounded to nearest, NaN is 0
+    void floatToUnorm16(const float* src, unsigned short* dst, std::size_t count);
+    void floatToUnorm8(const float* src, unsigned char* dst, std::size_t count);
+
+    // sRGB 8-bit to linear 16-bit of 4-channel pixels, and back
+    // The colour channels are converted with the sRGB transfer function, and
+    // the alpha channel (the 4th byte of BGRA or RGBA) is scaled linearly.
+    void srgbToLinear(const unsigned char* src, unsigned short* dst, std::size_t pixelCount);
+    void linearToSrgb(const unsigned short* src, unsigned char* dst, std::size_t pixelCount);
+}
+
+#endif // FORMAT_UTILS_H
@@ -3,12 +3,24 @@
 // ========
 // testing Pixel Buffer Object for unpacking (uploading) pixel data to PBO
 // using GL_ARB_pixel_buffer_object extension
-// It uses 2 PBOs to optimize uploading pipeline; application to PBO, and PBO to
-// texture object.
+// It uses a ring of PBOs to optimize uploading pipeline; application to PBO,
+// and PBO to texture object. A fence after glTexSubImage2D() tells when a PBO
+// can be written again without stalling.
+// The persistent mode maps a PBO of N regions only once with glBufferStorage()
+// (OpenGL 4.4), so there is no map/unmap or buffer allocation per frame.
+// With dirty tiles, only the changed tiles of the image are copied to PBO and
+// uploaded as sub-rectangles with GL_UNPACK_ROW_LENGTH/SKIP_PIXELS/SKIP_ROWS.
+// The pixels are filled by the scalar loop, SIMD, or SIMD streaming stores
+// for write-combined PBO memory, on 1 or more threads in bands of scanlines.
+// With --headless, it renders to an offscreen FBO without window, and writes
+// the timings of each frame to a CSV/JSON report, e.g.,
+//     pboUnpack --headless --width 4096 --height 4096 --pbo 3 --report out.json
+// With --bench-kernels, the CPU kernels are checked and measured at all SIMD
+// levels without GL, then it exits with 1 if any output is different.
 //
 //  AUTHOR: Song Ho Ahn (song.ahn@gmail.com)
 // CREATED: 2007-10-22
-// UPDATED: 2018-09-04
+// UPDATED: 2026-10-18
 ///////////////////////////////////////////////////////////////////////////////
 
 #ifdef __APPLE__
@@ -22,8 +34,22 @@
 #include <iomanip>
 #include <cstdlib>
 #include <cstring>
+#include <cmath>
+#include <algorithm>
+#include <vector>
 #include "glExtension.h"                        // glInfo struct
 #include "Timer.h"
+#include "TimingStats.h"                            // rolling percentiles of timings
+#include "Profiler.h"                               // CPU/GPU zones and Chrome trace
+#include "PboRing.h"                            // PBOs with fence sync
+#include "PersistentPbo.h"                      // persistently mapped PBO
+#include "DirtyTiles.h"                         // changed tiles of image
+#include "ThreadPool.h"                         // worker threads for pixel processing
+#include "pixelUtils.h"                         // SIMD fill kernels
+#include "formatUtils.h"                        // pixel format conversion for PBO
+#include "Benchmark.h"                          // command-line options and report
+#include "KernelBench.h"                        // SIMD kernel check and throughput
+#include "OffscreenContext.h"                   // context without window
 
 
 
@@ -41,16 +67,33 @@ void exitCB();
 
 void initGL();
 int  initGLUT(int argc, char **argv);
+bool initOptions();
 bool initSharedMem();
 void clearSharedMem();
 void initLights();
 void setCamera(float posX, float posY, float posZ, float targetX, float targetY, float targetZ);
 void updatePixels(GLubyte* dst, int size);
+void updateChangedPixels(GLubyte* dst);
+void fillImage(GLubyte* dst, bool background, GLubyte* converted=0);
+void fillSpan(unsigned int* dst, int count, unsigned int value);
+void getChangedRect(int& x, int& y, int& width, int& height);
+void initTiles();
+void updateTiles(GLubyte* dst);
+void uploadPixels(const GLvoid* src);
 void drawString(const char *str, int x, int y, float color[4], void *font);
 void drawString3D(const char *str, float pos[3], float color[4], void *font);
 void showInfo();
 void showTransferRate();
 void printTransferRate();
+int  runBenchmark();
+int  runKernelBench();
+void initPbos();
+void recordTransferRate();
+void printTransferRates();
+void toOrtho();
+void toPerspective();
+void writeTimingStats();
+void writeTrace();
 
 
 // constants
@@ -59,17 +102,76 @@ const int    SCREEN_HEIGHT   = 600;
 const float  CAMERA_DISTANCE = 2.0f;
 const int    TEXT_WIDTH      = 8;
 const int    TEXT_HEIGHT     = 13;
-const int    IMAGE_WIDTH     = 2048;
+const int    IMAGE_WIDTH     = 2048;            // default image size, --width/--height
 const int    IMAGE_HEIGHT    = 2048;
 const int    CHANNEL_COUNT   = 4;
-const int    DATA_SIZE       = IMAGE_WIDTH * IMAGE_HEIGHT * CHANNEL_COUNT;
-const GLenum PIXEL_FORMAT    = GL_BGRA;
+const int    PBO_COUNT       = 3;               // default depth of PBO ring
+const int    PBO_MAX_COUNT   = 8;
+const int    TILE_SIZE       = 64;              // dirty tile size in pixels
+const int    STATS_WINDOW    = 300;             // # of last frames of the percentiles
+const unsigned int BACKGROUND_COLOR = 0xff404040;   // unchanged area of image
+
+// PBO modes, SPACE key cycles them
+enum PboMode
+{
+    PBO_OFF = 0,                                // glTexSubImage2D() from system memory
+    PBO_MAP,                                    // ring of PBOs, glMapBuffer() per frame
+    PBO_PERSISTENT,                             // persistently mapped PBO regions
+    PBO_MODE_COUNT
+};
+const char*  PBO_MODE_NAMES[PBO_MODE_COUNT] = {"off", "map", "persistent"};
+
+// dirty tile modes, T key cycles them
+enum TileMode
+{
+    TILE_OFF = 0,                               // upload the whole image
+    TILE_MARK,                                  // producer marks the changed area
+    TILE_DETECT,                                // compare with the previous frame
+    TILE_MODE_COUNT
+};
+const char*  TILE_MODE_NAMES[TILE_MODE_COUNT] = {"off", "mark", "detect"};
+
+// pixel fill kernels, F key cycles them
+enum FillMode
+{
+    FILL_LOOP = 0,                              // scalar int loop
+    FILL_SIMD,                                  // SIMD stores
+    FILL_STREAM,                                // SIMD non-temporal (streaming) stores
+    FILL_MODE_COUNT
+};
+const char*  FILL_MODE_NAMES[FILL_MODE_COUNT] = {"loop", "simd", "stream"};
+
+// GL format and type of each Format::Type (bgra, rgba, rgb565, rgba4444, red)
+const GLenum TRANSFER_FORMATS[] = {GL_BGRA, GL_RGBA, GL_RGB, GL_RGBA, GL_RED};
+const GLenum TRANSFER_TYPES[] = {GL_UNSIGNED_BYTE, GL_UNSIGNED_BYTE, GL_UNSIGNED_SHORT_5_6_5,
+                                 GL_UNSIGNED_SHORT_4_4_4_4, GL_UNSIGNED_BYTE};
 
 // global variables
 void *font = GLUT_BITMAP_8_BY_13;
-GLuint pboIds[2];                   // IDs of PBO
+int imageWidth = IMAGE_WIDTH;       // size of texture
+int imageHeight = IMAGE_HEIGHT;
+int dataSize;                       // bytes of texture image
+GLenum pixelFormat = GL_BGRA;       // GL_BGRA or GL_RGBA, --format
+Format::Type memoryType = Format::BGRA8;     // format of imageData
+Format::Type transferType = Format::BGRA8;   // format in PBO and glTexSubImage2D(), --transfer
+int transferSize;                   // bytes of image in PBO
+GLubyte* transferData = 0;          // converted image without PBO, 0 if the same format
+Benchmark benchmark;                // command-line options and headless report
+OffscreenContext offscreen;         // GL context for headless mode
+PboRing pboRing;                    // ring of PBOs for uploading
+PersistentPbo persistentPbo;        // regions of a persistently mapped PBO
+int pboIndex = -1;                  // PBO (region) updated in the previous frame, -1 if none
+int pboCount = PBO_COUNT;           // # of PBOs (regions), +/- keys
 GLuint textureId;                   // ID of texture
 GLubyte* imageData = 0;             // pointer to texture buffer
+GLubyte* prevImageData = 0;         // previous frame to detect changed tiles
+DirtyTiles dirtyTiles;              // changed tiles of imageData
+std::vector<DirtyTiles::Rect> dirtyRects;   // rects to upload in the next frame
+int tileMode = TILE_OFF;
+int dirtyPercent = 100;             // changed area of image, [/] keys
+long long uploadSize;               // bytes uploaded to texture in a frame
+int fillMode = FILL_LOOP;
+ThreadPool threadPool(1);           // single thread by default, N key
 int screenWidth;
 int screenHeight;
 bool mouseLeftDown;
@@ -79,23 +181,59 @@ float cameraAngleX;
 float cameraAngleY;
 float cameraDistance;
 bool pboSupported;
+bool persistentSupported;
 int pboMode;
+double transferTimeSums[PBO_MODE_COUNT];    // sum of frame time per PBO mode
+double transferByteSums[PBO_MODE_COUNT];    // sum of uploaded bytes per PBO mode
+int transferFrameCounts[PBO_MODE_COUNT];    // # of frames per PBO mode
 int drawMode = 0;
-Timer timer, t1, t2;
-float copyTime, updateTime;
+Timer timer;
+float copyTime, updateTime, stallTime;      // last frame, for the benchmark report
+TimingStats timingStats(STATS_WINDOW);      // percentiles of the last frames
 
 
 
 ///////////////////////////////////////////////////////////////////////////////
 int main(int argc, char **argv)
 {
+    // parse command-line options, the defaults are the constants
+    benchmark.setWidth(IMAGE_WIDTH);
+    benchmark.setHeight(IMAGE_HEIGHT);
+    benchmark.setFormat("bgra");
+    benchmark.setTransfer("format");                // the same as --format
+    benchmark.setPboMode(0);
+    benchmark.setMode("map");
+    benchmark.setTileMode("off");
+    benchmark.setDirtyPercent(100);
+    benchmark.setFillMode("loop");
+    if(!benchmark.parse(argc, argv) || !initOptions())
+    {
+        benchmark.printUsage(argv[0]);
+        return 1;
+    }
+
+    // check and measure the CPU kernels, no GL is needed
+    if(benchmark.isKernelBench())
+        return runKernelBench();
+
     initSharedMem();
 
     // register exit callback
     atexit(exitCB);
 
-    // init GLUT and GL
-    initGLUT(argc, argv);
+    // init GLUT and GL, or offscreen framebuffer of window size without window
+    if(benchmark.isHeadless())
+    {
+        if(!offscreen.create(screenWidth, screenHeight))
+        {
+            std::cout << "[ERROR] " << offscreen.getError() << std::endl;
+            return 1;
+        }
+    }
+    else
+    {
+        initGLUT(argc, argv);
+    }
     initGL();
 
     // get OpenGL extensions
@@ -110,6 +248,12 @@ int main(int argc, char **argv)
         std::cout << "[ERROR] Video card does not supports GL_ARB_pixel_buffer_object." << std::endl;
     }
 
+    // profile the zones only if --trace is given, GPU time needs GL_ARB_timer_query
+    Profiler& profiler = Profiler::getInstance();
+    profiler.setEnabled(!benchmark.getTraceFile().empty());
+    if(profiler.isEnabled())
+        std::cout << "Profiler: GPU timer query " << (profiler.initGpu() ? "on" : "off") << std::endl;
+
     // init 2 texture objects
     glGenTextures(1, &textureId);
     glBindTexture(GL_TEXTURE_2D, textureId);
@@ -117,7 +261,7 @@ int main(int argc, char **argv)
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, IMAGE_WIDTH, IMAGE_HEIGHT, 0, PIXEL_FORMAT, GL_UNSIGNED_BYTE, (GLvoid*)imageData);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, imageWidth, imageHeight, 0, pixelFormat, GL_UNSIGNED_BYTE, (GLvoid*)imageData);
     glBindTexture(GL_TEXTURE_2D, 0);
 
 #ifdef _WIN32
@@ -130,18 +274,34 @@ int main(int argc, char **argv)
     }
 #endif
 
-    if(pboSupported)
+    // persistent mapping needs GL_ARB_buffer_storage (v4.4)
+    persistentSupported = pboSupported && PersistentPbo::isSupported();
+    if(persistentSupported)
     {
-        // create 2 pixel buffer objects, you need to delete them when program exits.
-        // glBufferData() with NULL pointer reserves only memory space.
-        glGenBuffers(2, pboIds);
-        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pboIds[0]);
-        glBufferData(GL_PIXEL_UNPACK_BUFFER, DATA_SIZE, 0, GL_STREAM_DRAW);
-        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pboIds[1]);
-        glBufferData(GL_PIXEL_UNPACK_BUFFER, DATA_SIZE, 0, GL_STREAM_DRAW);
-        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        std::cout << "Video card supports GL_ARB_buffer_storage." << std::endl;
     }
 
+    // select PBO mode from the options, --pbo 0 is off
+    pboMode = PBO_OFF;
+    if(pboSupported && benchmark.getPboMode() > 0)
+    {
+        pboCount = benchmark.getPboMode();
+        pboMode = PBO_MAP;
+        if(benchmark.getMode() == "persistent")
+        {
+            if(persistentSupported)
+                pboMode = PBO_PERSISTENT;
+            else
+                std::cout << "[WARNING] Persistent mapping is not supported, use map mode." << std::endl;
+        }
+    }
+    initPbos();
+    initTiles();
+
+    // run the given frames without window, then exit
+    if(benchmark.isHeadless())
+        return runBenchmark();
+
     // start timer, the elapsed time will be used for updateVertices()
     timer.start();
 
@@ -197,6 +357,8 @@ void initGL()
     //@glShadeModel(GL_SMOOTH);                    // shading mathod: GL_SMOOTH or GL_FLAT
     glShadeModel(GL_FLAT);                      // shading mathod: GL_SMOOTH or GL_FLAT
     glPixelStorei(GL_UNPACK_ALIGNMENT, 4);      // 4-byte pixel alignment
+    if(Format::getPixelSize(transferType) < 4)
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);  // rows of 2-byte or 1-byte pixels are not padded
 
     // enable /disable features
     //@glHint(GL_PERSPECTIVE_CORRECTION_HINT, GL_NICEST);
@@ -275,6 +437,76 @@ void drawString3D(const char *str, float pos[3], float color[4], void *font)
 
 
 
+///////////////////////////////////////////////////////////////////////////////
+// apply the command-line options to global variables
+///////////////////////////////////////////////////////////////////////////////
+bool initOptions()
+{
+    imageWidth = benchmark.getWidth();
+    imageHeight = benchmark.getHeight();
+    dataSize = imageWidth * imageHeight * CHANNEL_COUNT;
+
+    if(benchmark.getFormat() == "bgra")
+        pixelFormat = GL_BGRA;
+    else if(benchmark.getFormat() == "rgba")
+        pixelFormat = GL_RGBA;
+    else
+    {
+        std::cout << "[ERROR] Unsupported pixel format: " << benchmark.getFormat() << " (bgra or rgba)" << std::endl;
+        return false;
+    }
+    memoryType = (pixelFormat == GL_BGRA) ? Format::BGRA8 : Format::RGBA8;
+
+    // the image is converted to the smaller format while it is written to PBO
+    std::string transfer = benchmark.getTransfer();
+    if(transfer == "format")
+        transfer = benchmark.getFormat();
+    if(!Format::parseType(transfer.c_str(), transferType))
+    {
+        std::cout << "[ERROR] Unsupported transfer format: " << transfer << " (bgra, rgba, rgb565, rgba4444 or red)" << std::endl;
+        return false;
+    }
+    transferSize = imageWidth * imageHeight * Format::getPixelSize(transferType);
+
+    if(benchmark.getPboMode() > PBO_MAX_COUNT)
+    {
+        std::cout << "[ERROR] PBO count must be 0 ~ " << PBO_MAX_COUNT << std::endl;
+        return false;
+    }
+
+    if(benchmark.getMode() != "map" && benchmark.getMode() != "persistent")
+    {
+        std::cout << "[ERROR] Unsupported mode: " << benchmark.getMode() << " (map or persistent)" << std::endl;
+        return false;
+    }
+
+    tileMode = (int)(std::find(TILE_MODE_NAMES, TILE_MODE_NAMES + TILE_MODE_COUNT, benchmark.getTileMode()) - TILE_MODE_NAMES);
+    if(tileMode == TILE_MODE_COUNT)
+    {
+        std::cout << "[ERROR] Unsupported tile mode: " << benchmark.getTileMode() << " (off, mark or detect)" << std::endl;
+        return false;
+    }
+    dirtyPercent = benchmark.getDirtyPercent();
+    if(tileMode != TILE_OFF && transferType != memoryType)
+    {
+        std::cout << "[ERROR] Dirty tiles need the same transfer format as --format." << std::endl;
+        return false;
+    }
+
+    fillMode = (int)(std::find(FILL_MODE_NAMES, FILL_MODE_NAMES + FILL_MODE_COUNT, benchmark.getFillMode()) - FILL_MODE_NAMES);
+    if(fillMode == FILL_MODE_COUNT)
+    {
+        std::cout << "[ERROR] Unsupported fill mode: " << benchmark.getFillMode() << " (loop, simd or stream)" << std::endl;
+        return false;
+    }
+
+    if(benchmark.getThreadCount() > 0)
+        threadPool.setThreadCount(benchmark.getThreadCount());
+    return true;
+}
+
+
+
 ///////////////////////////////////////////////////////////////////////////////
 // initialize global variables
 ///////////////////////////////////////////////////////////////////////////////
@@ -292,8 +524,10 @@ bool initSharedMem()
     drawMode = 0; // 0:fill, 1: wireframe, 2:points
 
     // allocate texture buffer
-    imageData = new GLubyte[DATA_SIZE];
-    memset(imageData, 0, DATA_SIZE);
+    imageData = new GLubyte[dataSize];
+    memset(imageData, 0, dataSize);
+    if(transferType != memoryType)
+        transferData = new GLubyte[transferSize];
 
     return true;
 }
@@ -308,6 +542,10 @@ void clearSharedMem()
     // deallocate texture buffer
     delete [] imageData;
     imageData = 0;
+    delete [] transferData;
+    transferData = 0;
+    delete [] prevImageData;
+    prevImageData = 0;
 
     // clean up texture
     glDeleteTextures(1, &textureId);
@@ -315,8 +553,12 @@ void clearSharedMem()
     // clean up PBOs
     if(pboSupported)
     {
-        glDeleteBuffers(2, pboIds);
+        pboRing.release();
+        persistentPbo.release();
     }
+
+    // delete GPU timer queries
+    Profiler::getInstance().releaseGpu();
 }
 
 
@@ -357,27 +599,205 @@ void setCamera(float posX, float posY, float posZ, float targetX, float targetY,
 
 ///////////////////////////////////////////////////////////////////////////////
 // copy an image data to texture buffer
+// The area out of the changed rectangle is filled with the static background.
+// If the transfer format is different, imageData is filled, and each band is
+// converted to dst while it is still in cache.
 ///////////////////////////////////////////////////////////////////////////////
 void updatePixels(GLubyte* dst, int size)
 {
-    static int color = 0;
+    if(transferType != memoryType && dst != imageData)
+        fillImage(imageData, true, dst);
+    else
+        fillImage(dst, true);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// update the pixels in the changed rectangle only
+///////////////////////////////////////////////////////////////////////////////
+void updateChangedPixels(GLubyte* dst)
+{
+    fillImage(dst, false);
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// fill the scanlines of the changed rectangle with scrolling colours, and the
+// background if background is true
+// The scanlines are split into cache-sized bands, and processed by all
+// threads. The colour of each scanline is computed from its row, so the bands
+// can be filled in any order. Each scanline is written from left to right,
+// so the streaming stores fill whole cache lines in order.
+// If converted is not NULL, the filled scanlines of each band are converted to
+// the transfer format in converted, e.g., the mapped PBO.
+///////////////////////////////////////////////////////////////////////////////
+void fillImage(GLubyte* dst, bool background, GLubyte* converted)
+{
+    static unsigned int color = 0;
 
     if(!dst)
         return;
 
-    int* ptr = (int*)dst;
+    int x, y, w, h;
+    getChangedRect(x, y, w, h);
+    int firstRow = background ? 0 : y;
+    int rowCount = background ? imageHeight : h;
+    unsigned int baseColor = color;
+    std::size_t rowSize = (std::size_t)imageWidth * CHANNEL_COUNT;
+
+    // process the bands of scanlines in parallel, it returns after all bands are done
+    threadPool.run(rowCount, ThreadPool::computeBandRows(rowSize), [=](int first, int last)
+    {
+        PROFILE_ZONE("fill band");
+        for(int i = firstRow + first; i < firstRow + last; ++i)
+        {
+            unsigned int* ptr = (unsigned int*)dst + (std::size_t)i * imageWidth;
+            if(i < y || i >= y + h)
+            {
+                fillSpan(ptr, imageWidth, BACKGROUND_COLOR);
+                continue;
+            }
+
+            if(background)
+                fillSpan(ptr, x, BACKGROUND_COLOR);
+            fillSpan(ptr + x, w, baseColor + 257 * (i - y));
+            if(background)
+                fillSpan(ptr + x + w, imageWidth - x - w, BACKGROUND_COLOR);
+        }
+
+        if(converted)
+        {
+            PROFILE_ZONE("convert band");
+            std::size_t offset = (std::size_t)(firstRow + first) * imageWidth;
+            Format::convert(dst + offset * CHANNEL_COUNT, memoryType,
+                            converted + offset * Format::getPixelSize(transferType), transferType,
+                            (std::size_t)(last - first) * imageWidth);
+        }
+    });
+
+    color += 257 * h + 1;   // scroll down
+}
+
+
 
-    // copy 4 bytes at once
-    for(int i = 0; i < IMAGE_HEIGHT; ++i)
+///////////////////////////////////////////////////////////////////////////////
+// fill count pixels with the kernel of fillMode
+///////////////////////////////////////////////////////////////////////////////
+void fillSpan(unsigned int* dst, int count, unsigned int value)
+{
+    if(fillMode == FILL_LOOP)
     {
-        for(int j = 0; j < IMAGE_WIDTH; ++j)
+        // copy 4 bytes at once
+        for(int i = 0; i < count; ++i)
         {
-            *ptr = color;
-            ++ptr;
+            *dst = value;
+            ++dst;
         }
-        color += 257;
     }
-    ++color;            // scroll down
+    else
+    {
+        Pixel::fillPixels((unsigned char*)dst, count, value, fillMode == FILL_STREAM);
+    }
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// compute the changed rectangle at the centre of image from dirtyPercent
+///////////////////////////////////////////////////////////////////////////////
+void getChangedRect(int& x, int& y, int& width, int& height)
+{
+    double scale = sqrt(dirtyPercent / 100.0);
+    width = (int)(imageWidth * scale + 0.5);
+    height = (int)(imageHeight * scale + 0.5);
+    x = (imageWidth - width) / 2;
+    y = (imageHeight - height) / 2;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// reset the image and mark all tiles, so the whole image is uploaded once
+///////////////////////////////////////////////////////////////////////////////
+void initTiles()
+{
+    dirtyRects.clear();
+    if(tileMode == TILE_OFF)
+        return;
+
+    dirtyTiles.init(imageWidth, imageHeight, TILE_SIZE, CHANNEL_COUNT);
+    updatePixels(imageData, dataSize);
+    if(tileMode == TILE_DETECT)
+    {
+        if(!prevImageData)
+            prevImageData = new GLubyte[dataSize];
+        memcpy(prevImageData, imageData, dataSize);
+    }
+    dirtyTiles.markAll();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// update the changed area of imageData, then copy only the dirty tiles to dst
+// (PBO) with the same layout as imageData. The dirty rectangles are uploaded
+// to the texture in the next frame.
+///////////////////////////////////////////////////////////////////////////////
+void updateTiles(GLubyte* dst)
+{
+    updateChangedPixels(imageData);
+
+    if(tileMode == TILE_MARK)
+    {
+        // the producer knows the changed area
+        int x, y, w, h;
+        getChangedRect(x, y, w, h);
+        dirtyTiles.markRect(x, y, w, h);
+    }
+    else
+    {
+        dirtyTiles.detect(imageData, prevImageData);
+    }
+
+    dirtyTiles.copyRects(imageData, dst, fillMode == FILL_STREAM);  // no copy if dst is imageData
+    dirtyRects = dirtyTiles.getRects();
+    dirtyTiles.clear();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// copy the whole image or the dirty rectangles to the texture object
+// src is the pointer to system memory, or the offset in the bound PBO.
+// The dirty rectangles are sub-images of the full image, so the row length
+// and the skipped pixels/rows select them without packing.
+///////////////////////////////////////////////////////////////////////////////
+void uploadPixels(const GLvoid* src)
+{
+    glBindTexture(GL_TEXTURE_2D, textureId);
+    if(tileMode == TILE_OFF)
+    {
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, imageWidth, imageHeight,
+                        TRANSFER_FORMATS[transferType], TRANSFER_TYPES[transferType], src);
+        uploadSize = transferSize;
+        return;
+    }
+
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, imageWidth);
+    for(std::size_t i = 0; i < dirtyRects.size(); ++i)
+    {
+        const DirtyTiles::Rect& rect = dirtyRects[i];
+        glPixelStorei(GL_UNPACK_SKIP_PIXELS, rect.x);
+        glPixelStorei(GL_UNPACK_SKIP_ROWS, rect.y);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, rect.x, rect.y, rect.width, rect.height, pixelFormat, GL_UNSIGNED_BYTE, src);
+        uploadSize += (long long)rect.width * rect.height * CHANNEL_COUNT;
+    }
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    glPixelStorei(GL_UNPACK_SKIP_PIXELS, 0);
+    glPixelStorei(GL_UNPACK_SKIP_ROWS, 0);
+    dirtyRects.clear();
 }
 
 
@@ -401,26 +821,48 @@ void showInfo()
 
     std::stringstream ss;
     ss << "PBO: ";
-    if(pboMode == 0)
-        ss << "off" << std::ends;
-    else if(pboMode == 1)
-        ss << "1 PBO" << std::ends;
-    else if(pboMode == 2)
-        ss << "2 PBOs" << std::ends;
+    ss << PBO_MODE_NAMES[pboMode];
+    if(pboMode == PBO_MAP)
+        ss << " (" << pboCount << " PBO" << (pboCount > 1 ? "s" : "") << ")";
+    else if(pboMode == PBO_PERSISTENT)
+        ss << " (" << pboCount << " region" << (pboCount > 1 ? "s" : "") << ")";
+    ss << ", Transfer: " << Format::getTypeName(transferType) << std::ends;
 
     drawString(ss.str().c_str(), 1, screenHeight-TEXT_HEIGHT, color, font);
     ss.str(""); // clear buffer
 
     ss << std::fixed << std::setprecision(3);
-    ss << "Updating Time: " << updateTime << " ms" << std::ends;
+    ss << "Updating Time: " << timingStats.formatSummary("update") << " (" << FILL_MODE_NAMES[fillMode] << ", "
+       << threadPool.getThreadCount() << " thread" << (threadPool.getThreadCount() > 1 ? "s" : "") << ")" << std::ends;
     drawString(ss.str().c_str(), 1, screenHeight-(2*TEXT_HEIGHT), color, font);
     ss.str("");
 
-    ss << "Copying Time: " << copyTime << " ms" << std::ends;
+    ss << "Copying Time: " << timingStats.formatSummary("copy") << std::ends;
     drawString(ss.str().c_str(), 1, screenHeight-(3*TEXT_HEIGHT), color, font);
     ss.str("");
 
-    ss << "Press SPACE key to toggle PBO on/off." << std::ends;
+    ss << "Stall Time: " << timingStats.formatSummary("stall") << std::ends;
+    drawString(ss.str().c_str(), 1, screenHeight-(4*TEXT_HEIGHT), color, font);
+    ss.str("");
+
+    ss << "Dirty Tiles: " << TILE_MODE_NAMES[tileMode] << ", " << dirtyPercent << "% changed, "
+       << uploadSize / (1024.0 * 1024) << " MB uploaded" << std::ends;
+    drawString(ss.str().c_str(), 1, screenHeight-(5*TEXT_HEIGHT), color, font);
+    ss.str("");
+
+    ss << "Press T to change dirty tile mode, [/] to change area." << std::ends;
+    drawString(ss.str().c_str(), 1, 1 + 2*TEXT_HEIGHT, color, font);
+    ss.str("");
+
+    ss << "Press F to change fill kernel, N to change threads." << std::ends;
+    drawString(ss.str().c_str(), 1, 1 + 3*TEXT_HEIGHT, color, font);
+    ss.str("");
+
+    ss << "Press SPACE key to change PBO mode." << std::ends;
+    drawString(ss.str().c_str(), 1, 1 + TEXT_HEIGHT, color, font);
+    ss.str("");
+
+    ss << "Press +/- to change PBO count." << std::ends;
     drawString(ss.str().c_str(), 1, 1, color, font);
 
     // unset floating format
@@ -452,7 +894,7 @@ void showTransferRate()
     {
         ss.str("");
         ss << std::fixed << std::setprecision(1);
-        ss << "Transfer Rate: " << (count / elapsedTime) * DATA_SIZE / (1024 * 1024) << " MB" << std::ends; // update fps string
+        ss << "Transfer Rate: " << (count / elapsedTime) * transferSize / (1024 * 1024) << " MB" << std::ends; // update fps string
         ss << std::resetiosflags(std::ios_base::fixed | std::ios_base::floatfield);
         count = 0;                      // reset counter
         timer.start();                  // restart timer
@@ -466,7 +908,7 @@ void showTransferRate()
     glMatrixMode(GL_PROJECTION);        // switch to projection matrix
     glPushMatrix();                     // save current projection matrix
     glLoadIdentity();                   // reset projection matrix
-    //gluOrtho2D(0, IMAGE_WIDTH, 0, IMAGE_HEIGHT); // set to orthogonal projection
+    //gluOrtho2D(0, imageWidth, 0, imageHeight); // set to orthogonal projection
     gluOrtho2D(0, screenWidth, 0, screenHeight); // set to orthogonal projection
 
     float color[4] = {1, 1, 0, 1};
@@ -490,24 +932,298 @@ void printTransferRate()
     const double INV_MEGA = 1.0 / (1024 * 1024);
     static Timer timer;
     static int count = 0;
+    static double bytes = 0;
     static std::stringstream ss;
     double elapsedTime;
 
     // loop until 1 sec passed
     ++count;
+    bytes += uploadSize;
     elapsedTime = timer.getElapsedTime();
     if(elapsedTime > 1.0)
     {
         std::cout << std::fixed << std::setprecision(1);
-        std::cout << "Transfer Rate: " << (count / elapsedTime) * DATA_SIZE * INV_MEGA << " MB/s. (" << count / elapsedTime << " FPS)\n";
+        std::cout << "Transfer Rate: " << bytes / elapsedTime * INV_MEGA << " MB/s. (" << count / elapsedTime << " FPS), "
+                  << "PBO: " << PBO_MODE_NAMES[pboMode] << ", "
+                  << "Transfer: " << Format::getTypeName(transferType) << ", "
+                  << "Tiles: " << TILE_MODE_NAMES[tileMode] << ", "
+                  << "Update Time: " << timingStats.formatSummary("update") << " ("
+                  << FILL_MODE_NAMES[fillMode] << ", " << threadPool.getThreadCount() << " threads), "
+                  << "Stall Time: " << timingStats.formatSummary("stall") << "\n";
         std::cout << std::resetiosflags(std::ios_base::fixed | std::ios_base::floatfield);
         count = 0;                      // reset counter
+        bytes = 0;
         timer.start();                  // restart timer
     }
 }
 
 
 
+///////////////////////////////////////////////////////////////////////////////
+// accumulate the frame time to the current PBO mode
+///////////////////////////////////////////////////////////////////////////////
+void recordTransferRate()
+{
+    static Timer timer;
+    static int lastMode = -1;
+
+    // skip the frame after the mode is changed, it includes the re-allocation
+    timer.stop();
+    if(lastMode == pboMode)
+    {
+        transferTimeSums[pboMode] += timer.getElapsedTime();
+        transferByteSums[pboMode] += uploadSize;
+        ++transferFrameCounts[pboMode];
+    }
+    lastMode = pboMode;
+    timer.start();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// print the average transfer rate of each PBO mode side by side
+///////////////////////////////////////////////////////////////////////////////
+void printTransferRates()
+{
+    const double INV_MEGA = 1.0 / (1024 * 1024);
+
+    // nothing recorded in headless mode
+    int frameCount = 0;
+    for(int i = 0; i < PBO_MODE_COUNT; ++i)
+        frameCount += transferFrameCounts[i];
+    if(frameCount == 0)
+        return;
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "PBO Mode     Transfer Rate (MB/s)       FPS   Frames\n";
+    for(int i = 0; i < PBO_MODE_COUNT; ++i)
+    {
+        if(transferFrameCounts[i] == 0)
+            continue;
+        double fps = transferFrameCounts[i] / transferTimeSums[i];
+        std::cout << std::left << std::setw(12) << PBO_MODE_NAMES[i] << std::right
+                  << std::setw(21) << transferByteSums[i] / transferTimeSums[i] * INV_MEGA
+                  << std::setw(10) << fps
+                  << std::setw(9) << transferFrameCounts[i] << "\n";
+    }
+    std::cout << std::resetiosflags(std::ios_base::fixed | std::ios_base::floatfield) << std::flush;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// write the percentiles of the last frames to --stats file
+///////////////////////////////////////////////////////////////////////////////
+void writeTimingStats()
+{
+    const std::string& fileName = benchmark.getStatsFile();
+    if(fileName.empty())
+        return;
+
+    if(timingStats.writeCsv(fileName))
+        std::cout << "Stats: " << fileName << std::endl;
+    else
+        std::cout << "[ERROR] Failed to write " << fileName << std::endl;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// write the profiled zones to --trace file, and print the totals of zones
+///////////////////////////////////////////////////////////////////////////////
+void writeTrace()
+{
+    const std::string& fileName = benchmark.getTraceFile();
+    if(fileName.empty())
+        return;
+
+    Profiler& profiler = Profiler::getInstance();
+    profiler.printSummary();
+    if(profiler.writeTrace(fileName))
+        std::cout << "Trace: " << fileName << std::endl;
+    else
+        std::cout << "[ERROR] Failed to write " << fileName << std::endl;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// create the PBOs of the current mode, and delete the PBOs of the other mode
+///////////////////////////////////////////////////////////////////////////////
+void initPbos()
+{
+    pboIndex = -1;
+    if(!pboSupported)
+        return;
+
+    if(pboMode == PBO_MAP)
+    {
+        // create a ring of pixel buffer objects, you need to delete them when program exits.
+        // A fence is inserted after glTexSubImage2D() if GL_ARB_sync is supported.
+        persistentPbo.release();
+        pboRing.init(GL_PIXEL_UNPACK_BUFFER, pboCount, transferSize, GL_STREAM_DRAW);
+        std::cout << "PBO ring: " << pboRing.getCount() << " PBOs, fence sync "
+                  << (pboRing.isSyncUsed() ? "on" : "off") << std::endl;
+    }
+    else if(pboMode == PBO_PERSISTENT)
+    {
+        // create a PBO of pboCount regions, and map it until it is deleted
+        pboRing.release();
+        if(!persistentPbo.init(GL_PIXEL_UNPACK_BUFFER, pboCount, transferSize))
+        {
+            std::cout << "[ERROR] Failed to map PBO persistently, PBO mode is off." << std::endl;
+            pboMode = PBO_OFF;
+        }
+        else
+        {
+            std::cout << "Persistent PBO: " << persistentPbo.getCount() << " regions" << std::endl;
+        }
+    }
+    else
+    {
+        pboRing.release();
+        persistentPbo.release();
+    }
+
+    // the dirty tiles written to the previous PBOs are not uploaded
+    if(tileMode != TILE_OFF)
+        dirtyTiles.markAll();
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// check the CPU kernels at all SIMD levels against the plain C++ kernels, and
+// print the throughput, return 1 if any output is different
+///////////////////////////////////////////////////////////////////////////////
+int runKernelBench()
+{
+    KernelBench bench;
+    bench.addPixelKernels();
+
+    // pixel formats of formatUtils, with both byte orders
+    // The 16-bit and float sources are the random bytes too, so NaN, infinity
+    // and out-of-range floats are clamped as well. The sRGB kernels have 8
+    // bytes per pixel on one side, so they convert half of the pixels.
+    for(int i = 0; i < 2; ++i)
+    {
+        bool bgra = (i == 0);
+        std::string order = bgra ? " bgra" : " rgba";
+        bench.addKernel("packRgb565" + order, 4, 2, false, [bgra](const unsigned char* src, unsigned char* dst, int w, int h)
+        {
+            Format::packRgb565(src, bgra, (unsigned short*)dst, (std::size_t)w * h);
+        });
+        bench.addKernel("packRgba4444" + order, 4, 2, false, [bgra](const unsigned char* src, unsigned char* dst, int w, int h)
+        {
+            Format::packRgba4444(src, bgra, (unsigned short*)dst, (std::size_t)w * h);
+        });
+        bench.addKernel("unpackRgb565" + order, 2, 4, false, [bgra](const unsigned char* src, unsigned char* dst, int w, int h)
+        {
+            Format::unpackRgb565((const unsigned short*)src, bgra, dst, (std::size_t)w * h);
+        });
+        bench.addKernel("unpackRgba4444" + order, 2, 4, false, [bgra](const unsigned char* src, unsigned char* dst, int w, int h)
+        {
+            Format::unpackRgba4444((const unsigned short*)src, bgra, dst, (std::size_t)w * h);
+        });
+    }
+    bench.addKernel("swapRedBlue copy", 4, 4, false, [](const unsigned char* src, unsigned char* dst, int w, int h)
+    {
+        Format::swapRedBlue(src, dst, (std::size_t)w * h);
+    });
+    for(int channel = 0; channel < 4; ++channel)
+    {
+        bench.addKernel(std::string("extractChannel ") + (char)('0' + channel), 4, 1, false,
+                        [channel](const unsigned char* src, unsigned char* dst, int w, int h)
+        {
+            Format::extractChannel(src, channel, dst, (std::size_t)w * h);
+        });
+    }
+    bench.addKernel("floatToUnorm16", 4, 2, false, [](const unsigned char* src, unsigned char* dst, int w, int h)
+    {
+        Format::floatToUnorm16((const float*)src, (unsigned short*)dst, (std::size_t)w * h);
+    });
+    bench.addKernel("floatToUnorm8", 4, 1, false, [](const unsigned char* src, unsigned char* dst, int w, int h)
+    {
+        Format::floatToUnorm8((const float*)src, dst, (std::size_t)w * h);
+    });
+    bench.addKernel("srgbToLinear", 2, 4, false, [](const unsigned char* src, unsigned char* dst, int w, int h)
+    {
+        Format::srgbToLinear(src, (unsigned short*)dst, (std::size_t)w * h / 2);
+    });
+    bench.addKernel("linearToSrgb", 4, 2, false, [](const unsigned char* src, unsigned char* dst, int w, int h)
+    {
+        Format::linearToSrgb((const unsigned short*)src, dst, (std::size_t)w * h / 2);
+    });
+
+    return bench.run() ? 0 : 1;
+}
+
+
+
+///////////////////////////////////////////////////////////////////////////////
+// render the frames to the offscreen framebuffer without window, and write
+// the timings of each frame to the report
+///////////////////////////////////////////////////////////////////////////////
+int runBenchmark()
+{
+    benchmark.setName("pboUnpack");
+    benchmark.addParameter("width", imageWidth);
+    benchmark.addParameter("height", imageHeight);
+    benchmark.addParameter("format", benchmark.getFormat());
+    benchmark.addParameter("transfer", Format::getTypeName(transferType));
+    benchmark.addParameter("pbo", (pboMode != PBO_OFF) ? pboCount : 0);
+    benchmark.addParameter("mode", PBO_MODE_NAMES[pboMode]);
+    benchmark.addParameter("tiles", TILE_MODE_NAMES[tileMode]);
+    benchmark.addParameter("dirty", dirtyPercent);
+    benchmark.addParameter("fill", FILL_MODE_NAMES[fillMode]);
+    benchmark.addParameter("threads", threadPool.getThreadCount());
+    benchmark.addParameter("simd", Pixel::getSimdLevelName(Pixel::getSimdLevel()));
+    benchmark.addParameter("sync", (pboMode == PBO_PERSISTENT || pboRing.isSyncUsed()) ? "on" : "off");
+    benchmark.addParameter("renderer", (const char*)glGetString(GL_RENDERER));
+    benchmark.setColumns({"frameTime", "copyTime", "updateTime", "stallTime"});
+
+    // no reshape event without window
+    toPerspective();
+
+    Timer frameTimer, totalTimer;
+    double uploadBytes = 0;
+    int warmupCount = benchmark.getWarmupCount();
+    int frameCount = warmupCount + benchmark.getFrameCount();
+    for(int i = 0; i < frameCount; ++i)
+    {
+        if(i == warmupCount)
+            totalTimer.start();
+
+        frameTimer.start();
+        displayCB();
+        frameTimer.stop();
+
+        if(i >= warmupCount)
+        {
+            benchmark.addFrame({frameTimer.getElapsedTimeInMilliSec(), copyTime, updateTime, stallTime});
+            uploadBytes += uploadSize;
+        }
+    }
+    glFinish();
+    totalTimer.stop();
+    benchmark.setTotalTime(totalTimer.getElapsedTime());
+
+    // average MB uploaded per frame, less than the image size with dirty tiles
+    benchmark.addParameter("uploadMB", uploadBytes / benchmark.getFrameCount() / (1024 * 1024));
+
+    benchmark.printSummary();
+    if(!benchmark.getReportFile().empty())
+    {
+        if(!benchmark.writeReport(benchmark.getReportFile()))
+            return 1;
+        std::cout << "Report: " << benchmark.getReportFile() << std::endl;
+    }
+    return 0;
+}
+
+
+
 ///////////////////////////////////////////////////////////////////////////////
 // set projection matrix as orthogonal
 ///////////////////////////////////////////////////////////////////////////////
@@ -557,97 +1273,122 @@ void toPerspective()
 
 void displayCB()
 {
-    static int index = 0;
-    int nextIndex = 0;                  // pbo index used for next frame
+    PROFILE_FRAME();                                // collect the zones of the previous frame
+    PROFILE_ZONE("displayCB");
+    ScopedTimer frameTimer(timingStats, "frame");   // added when returned
+    uploadSize = 0;
 
-    if(pboMode > 0)
+    if(pboMode == PBO_MAP)
     {
-        // "index" is used to copy pixels from a PBO to a texture object
-        // "nextIndex" is used to update pixels in a PBO
-        if(pboMode == 1)
+        // start to copy from PBO to texture object ///////
+        // copy pixels from the PBO updated in the previous frame to texture object
+        // Use offset instead of ponter.
+        // Then, insert a fence, so the PBO is not written until GPU finishes copying.
         {
-            // In single PBO mode, the index and nextIndex are set to 0
-            index = nextIndex = 0;
+            PROFILE_GPU_ZONE("copy");
+            ScopedTimer t(timingStats, "copy", &copyTime);
+            if(pboIndex >= 0)
+            {
+                pboRing.bind(pboIndex);
+                uploadPixels(0);
+                pboRing.fence(pboIndex);
+            }
         }
-        else if(pboMode == 2)
+        ///////////////////////////////////////////////////
+
+
+        // start to modify pixel values ///////////////////
+        // take the next PBO in the ring to update pixel values
+        // Note that glMapBuffer() causes sync issue if GPU is working with
+        // this buffer. Instead of orphaning the buffer with glBufferData(),
+        // acquire() waits for the fence of the PBO, which is signalled
+        // immediately if the ring is deep enough. The waiting time is the
+        // stall time.
         {
-            // In dual PBO mode, increment current index first then get the next index
-            index = (index + 1) % 2;
-            nextIndex = (index + 1) % 2;
+            PROFILE_ZONE("update");
+            ScopedTimer t(timingStats, "update", &updateTime);
+            pboRing.resetStallTime();
+            pboIndex = pboRing.acquire();
+            GLubyte* ptr = (GLubyte*)pboRing.map(pboIndex, GL_WRITE_ONLY);
+            if(ptr)
+            {
+                // update data directly on the mapped buffer, or only dirty tiles
+                if(tileMode == TILE_OFF)
+                    updatePixels(ptr, transferSize);
+                else
+                    updateTiles(ptr);
+            }
+            pboRing.unmap();                    // release pointer to mapping buffer
         }
-
+        stallTime = pboRing.getStallTime();
+        timingStats.add("stall", stallTime);
+        ///////////////////////////////////////////////////
+    }
+    else if(pboMode == PBO_PERSISTENT)
+    {
         // start to copy from PBO to texture object ///////
-        t1.start();
-
-        // bind the texture and PBO
-        glBindTexture(GL_TEXTURE_2D, textureId);
-        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pboIds[index]);
-
-        // copy pixels from PBO to texture object
-        // Use offset instead of ponter.
-        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, IMAGE_WIDTH, IMAGE_HEIGHT, PIXEL_FORMAT, GL_UNSIGNED_BYTE, 0);
-
-        // measure the time copying data from PBO to texture object
-        t1.stop();
-        copyTime = t1.getElapsedTimeInMilliSec();
+        // copy pixels from the region updated in the previous frame, use
+        // the offset of the region instead of pointer
+        {
+            PROFILE_GPU_ZONE("copy");
+            ScopedTimer t(timingStats, "copy", &copyTime);
+            if(pboIndex >= 0)
+            {
+                persistentPbo.bind();
+                uploadPixels((GLvoid*)persistentPbo.getOffset(pboIndex));
+                persistentPbo.fence(pboIndex);
+                persistentPbo.unbind();
+            }
+        }
         ///////////////////////////////////////////////////
 
 
         // start to modify pixel values ///////////////////
-        t1.start();
-
-        // bind PBO to update pixel values
-        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pboIds[nextIndex]);
-
-        // map the buffer object into client's memory
-        // Note that glMapBuffer() causes sync issue.
-        // If GPU is working with this buffer, glMapBuffer() will wait(stall)
-        // for GPU to finish its job. To avoid waiting (stall), you can call
-        // first glBufferData() with NULL pointer before glMapBuffer().
-        // If you do that, the previous data in PBO will be discarded and
-        // glMapBuffer() returns a new allocated pointer immediately
-        // even if GPU is still working with the previous data.
-        glBufferData(GL_PIXEL_UNPACK_BUFFER, DATA_SIZE, 0, GL_STREAM_DRAW);
-        GLubyte* ptr = (GLubyte*)glMapBuffer(GL_PIXEL_UNPACK_BUFFER, GL_WRITE_ONLY);
-        if(ptr)
+        // the PBO is always mapped, so write pixels directly to the next
+        // region after its fence is signalled, without glMapBuffer()
         {
-            // update data directly on the mapped buffer
-            updatePixels(ptr, DATA_SIZE);
-            glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);  // release pointer to mapping buffer
+            PROFILE_ZONE("update");
+            ScopedTimer t(timingStats, "update", &updateTime);
+            persistentPbo.resetStallTime();
+            pboIndex = persistentPbo.acquire();
+            if(tileMode == TILE_OFF)
+                updatePixels((GLubyte*)persistentPbo.getPointer(pboIndex), transferSize);
+            else
+                updateTiles((GLubyte*)persistentPbo.getPointer(pboIndex));
         }
-
-        // measure the time modifying the mapped buffer
-        t1.stop();
-        updateTime = t1.getElapsedTimeInMilliSec();
+        stallTime = persistentPbo.getStallTime();
+        timingStats.add("stall", stallTime);
         ///////////////////////////////////////////////////
-
-        // it is good idea to release PBOs with ID 0 after use.
-        // Once bound with 0, all pixel operations behave normal ways.
-        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
     }
     else
     {
         ///////////////////////////////////////////////////
         // start to copy pixels from system memory to textrure object
-        t1.start();
-
-        glBindTexture(GL_TEXTURE_2D, textureId);
-        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, IMAGE_WIDTH, IMAGE_HEIGHT, PIXEL_FORMAT, GL_UNSIGNED_BYTE, (GLvoid*)imageData);
-
-        t1.stop();
-        copyTime = t1.getElapsedTimeInMilliSec();
+        {
+            PROFILE_GPU_ZONE("copy");
+            ScopedTimer t(timingStats, "copy", &copyTime);
+            uploadPixels(transferData ? transferData : imageData);
+        }
         ///////////////////////////////////////////////////
 
 
         // start to modify pixels /////////////////////////
-        t1.start();
-        updatePixels(imageData, DATA_SIZE);
-        t1.stop();
-        updateTime = t1.getElapsedTimeInMilliSec();
+        {
+            PROFILE_ZONE("update");
+            ScopedTimer t(timingStats, "update", &updateTime);
+            if(tileMode == TILE_OFF)
+                updatePixels(transferData ? transferData : imageData, transferSize);
+            else
+                updateTiles(imageData);
+        }
+        stallTime = 0;
         ///////////////////////////////////////////////////
     }
 
 
+    // draw the textured quad and the info, measured until the end of frame
+    PROFILE_GPU_ZONE("draw");
+
     // clear buffer
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
 
@@ -673,10 +1414,19 @@ void displayCB()
     // unbind texture
     glBindTexture(GL_TEXTURE_2D, 0);
 
+    // no window to draw text and swap in headless mode
+    if(benchmark.isHeadless())
+    {
+        glPopMatrix();
+        glFlush();
+        return;
+    }
+
     // draw info messages
     showInfo();
     //showTransferRate();
     printTransferRate();
+    recordTransferRate();
 
     glPopMatrix();
 
@@ -716,10 +1466,64 @@ void keyboardCB(unsigned char key, int x, int y)
     case ' ':
         if(pboSupported)
         {
+            // off -> map -> persistent, skip persistent if not supported
             ++pboMode;
-            pboMode %= 3;
+            if(pboMode == PBO_PERSISTENT && !persistentSupported)
+                ++pboMode;
+            pboMode %= PBO_MODE_COUNT;
+            initPbos();
+        }
+        std::cout << "PBO mode: " << PBO_MODE_NAMES[pboMode] << std::endl;
+        break;
+
+    case '+': // deeper PBO ring, less stall
+    case '=':
+    case '-': // shallower PBO ring
+    case '_':
+        if(pboSupported)
+        {
+            int count = pboCount + ((key == '+' || key == '=') ? 1 : -1);
+            if(count >= 1 && count <= PBO_MAX_COUNT)
+            {
+                pboCount = count;
+                initPbos();
+            }
+            std::cout << "PBO count: " << pboCount << std::endl;
+        }
+        break;
+
+    case 't': // switch dirty tile modes (off -> mark -> detect)
+    case 'T':
+        if(transferType != memoryType)
+        {
+            std::cout << "[WARNING] Dirty tiles need the same transfer format as --format." << std::endl;
+            break;
         }
-        std::cout << "PBO mode: " << pboMode << std::endl;
+        ++tileMode;
+        tileMode %= TILE_MODE_COUNT;
+        initTiles();
+        std::cout << "Dirty tiles: " << TILE_MODE_NAMES[tileMode] << std::endl;
+        break;
+
+    case '[': // smaller changed area
+    case ']': // larger changed area
+        dirtyPercent += (key == ']') ? 5 : -5;
+        dirtyPercent = std::max(0, std::min(dirtyPercent, 100));
+        initTiles();
+        std::cout << "Changed area: " << dirtyPercent << "%" << std::endl;
+        break;
+
+    case 'f': // switch fill kernels (loop -> simd -> stream)
+    case 'F':
+        ++fillMode;
+        fillMode %= FILL_MODE_COUNT;
+        std::cout << "Fill kernel: " << FILL_MODE_NAMES[fillMode] << std::endl;
+        break;
+
+    case 'n': // change the number of threads (1 -> 2 -> ... -> # of cores)
+    case 'N':
+        threadPool.setThreadCount(threadPool.getThreadCount() % ThreadPool::getMaxThreadCount() + 1);
+        std::cout << "Threads: " << threadPool.getThreadCount() << std::endl;
         break;
 
     case 'd': // switch rendering modes (fill -> wire -> point)
@@ -802,5 +1606,8 @@ void mouseMotionCB(int x, int y)
 
 void exitCB()
 {
+    printTransferRates();
+    writeTimingStats();
+    writeTrace();
     clearSharedMem();
 }